@@ -423,6 +423,43 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+std::unique_ptr<fml::Mapping> PersistentCache::LoadImpellerPipelineLog(
+    const std::string& gpu_model) const {
+  TRACE_EVENT0("flutter", "PersistentCache::LoadImpellerPipelineLog");
+  if (!IsValid()) {
+    return nullptr;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(
+      *cache_directory_, GetImpellerPipelineLogFileName(gpu_model));
+  if (!mapping || mapping->GetSize() == 0) {
+    return nullptr;
+  }
+  return mapping;
+}
+
+void PersistentCache::StoreImpellerPipelineLog(
+    const std::string& gpu_model,
+    std::unique_ptr<fml::Mapping> log) {
+  if (is_read_only_ || !IsValid() || !log) {
+    return;
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       GetImpellerPipelineLogFileName(gpu_model),
+                       std::move(log));
+}
+
+std::string PersistentCache::GetImpellerPipelineLogFileName(
+    const std::string& gpu_model) {
+  std::string key = std::string(GetFlutterEngineVersion()) + '\0' + gpu_model;
+
+  uint8_t sha_digest[SHA_DIGEST_LENGTH];
+  SHA1(reinterpret_cast<const uint8_t*>(key.data()), key.size(), sha_digest);
+
+  std::string_view view(reinterpret_cast<const char*>(sha_digest),
+                        SHA_DIGEST_LENGTH);
+  return kImpellerPipelineLogFilePrefix + fml::HexEncode(view);
+}
+
 void PersistentCache::DumpSkp(const SkData& data) {
   if (is_read_only_ || !IsValid()) {
     FML_LOG(ERROR) << "Could not dump SKP from read-only or invalid persistent "
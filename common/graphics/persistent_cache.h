@@ -113,6 +113,36 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Load the log of the Impeller pipelines that were created on
+  ///             the given GPU in previous runs of this engine build, so that
+  ///             they can be compiled before the first frame.
+  ///
+  /// @param[in]  gpu_model  Identifies the GPU, as described by the Impeller
+  ///                        context.
+  ///
+  /// @return     The serialized log, or nullptr if there is none.
+  ///
+  std::unique_ptr<fml::Mapping> LoadImpellerPipelineLog(
+      const std::string& gpu_model) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Store the log of the Impeller pipelines created on the given
+  ///             GPU in this run, replacing the previous log for the GPU. The
+  ///             log is written on a worker task runner.
+  ///
+  void StoreImpellerPipelineLog(const std::string& gpu_model,
+                                std::unique_ptr<fml::Mapping> log);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The name of the file that holds the pipeline log for the
+  ///             given GPU. Logs are keyed by the engine version as well as
+  ///             the GPU, as the pipelines that a log names only exist in the
+  ///             build that wrote it.
+  ///
+  static std::string GetImpellerPipelineLogFileName(
+      const std::string& gpu_model);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -131,6 +161,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kImpellerPipelineLogFilePrefix[] =
+      "impeller_pipelines_";
 
  private:
   static std::string cache_base_path_;
@@ -9,6 +9,8 @@
 namespace flutter {
 
 constexpr FrameTiming::Phase FrameTiming::kPhases[FrameTiming::kCount];
+constexpr FrameTiming::RasterPhase
+    FrameTiming::kRasterPhases[FrameTiming::kRasterPhaseCount];
 
 Settings::Settings() = default;
 
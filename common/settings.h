@@ -17,6 +17,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 
@@ -38,13 +39,52 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  /// The parts of rasterizing a frame whose durations are recorded in
+  /// addition to the timestamps of the |Phase|s. The durations are summed
+  /// over all views of the frame. Phases that do not apply to the rendering
+  /// backend in use have a zero duration.
+  enum RasterPhase {
+    /// Computing the damage between the frame and the previous frame.
+    kDiff,
+    /// Prerolling the layer tree.
+    kPreroll,
+    /// Rasterizing layers and pictures into the raster cache.
+    kRasterCache,
+    /// Dispatching the display lists of the frame to Impeller.
+    kDispatch,
+    /// Tessellating paths and shapes in Impeller.
+    kTessellation,
+    /// Updating the Impeller glyph atlases.
+    kGlyphAtlas,
+    /// Encoding Impeller render and compute passes into command buffers.
+    kEncode,
+    /// Submitting the command buffers of the frame.
+    kSubmit,
+    /// The GPU execution time of the most recent frame whose GPU work had
+    /// completed when the frame finished rasterizing. This typically lags
+    /// the frame by one or two frames.
+    kGpu,
+    kRasterPhaseCount
+  };
+
+  static constexpr RasterPhase kRasterPhases[kRasterPhaseCount] = {
+      kDiff,       kPreroll, kRasterCache, kDispatch, kTessellation,
+      kGlyphAtlas, kEncode,  kSubmit,      kGpu};
+
+  static constexpr int kStatisticsCount = kCount + 5 + kRasterPhaseCount;
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
     return data_[phase] = value;
   }
 
+  fml::TimeDelta GetRasterPhaseDuration(RasterPhase phase) const {
+    return raster_phase_durations_[phase];
+  }
+  void SetRasterPhaseDuration(RasterPhase phase, fml::TimeDelta duration) {
+    raster_phase_durations_[phase] = duration;
+  }
+
   uint64_t GetFrameNumber() const { return frame_number_; }
   void SetFrameNumber(uint64_t frame_number) { frame_number_ = frame_number; }
   uint64_t GetLayerCacheCount() const { return layer_cache_count_; }
@@ -63,6 +103,7 @@ class FrameTiming {
 
  private:
   fml::TimePoint data_[kCount];
+  fml::TimeDelta raster_phase_durations_[kRasterPhaseCount];
   uint64_t frame_number_;
   size_t layer_cache_count_;
   size_t layer_cache_bytes_;
@@ -154,6 +195,12 @@ struct Settings {
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // Cache the rendering of display lists by their content, so that content
+  // recorded again in a later frame can reuse an existing raster cache entry.
+  bool enable_content_keyed_raster_cache = false;
+  // Record pictures into the compact display list encoding, which uses less
+  // memory for retained pictures but decodes each op when it is rendered.
+  bool compact_display_lists = false;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
@@ -330,6 +377,14 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // The number of frames of each animated image that are decoded ahead of the
+  // frame being displayed, or 0 to decode each frame when it is requested.
+  int image_prefetch_frame_count = 2;
+
+  // The number of bytes that the frames decoded ahead of time may use across
+  // all animated images in the process.
+  size_t image_prefetch_budget_bytes = 32 * 1024 * 1024;
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
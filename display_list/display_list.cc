@@ -2,10 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string_view>
 #include <type_traits>
 
 #include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_compact_op_storage.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -23,7 +26,8 @@ DisplayList::DisplayList()
       bounds_({0, 0, 0, 0}),
       can_apply_group_opacity_(true),
       is_ui_thread_safe_(true),
-      modifies_transparent_black_(false) {}
+      modifies_transparent_black_(false),
+      has_backdrop_filter_(false) {}
 
 DisplayList::DisplayList(DisplayListStorage&& storage,
                          size_t byte_count,
@@ -34,6 +38,7 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
                          bool can_apply_group_opacity,
                          bool is_ui_thread_safe,
                          bool modifies_transparent_black,
+                         bool has_backdrop_filter,
                          sk_sp<const DlRTree> rtree)
     : storage_(std::move(storage)),
       byte_count_(byte_count),
@@ -45,11 +50,29 @@ DisplayList::DisplayList(DisplayListStorage&& storage,
       can_apply_group_opacity_(can_apply_group_opacity),
       is_ui_thread_safe_(is_ui_thread_safe),
       modifies_transparent_black_(modifies_transparent_black),
+      has_backdrop_filter_(has_backdrop_filter),
       rtree_(std::move(rtree)) {}
 
+DisplayList::DisplayList(std::unique_ptr<const DlCompactOpStorage> compact_ops,
+                         const DisplayList& source)
+    : compact_ops_(std::move(compact_ops)),
+      byte_count_(compact_ops_->bytes()),
+      op_count_(source.op_count_),
+      nested_byte_count_(source.nested_byte_count_),
+      nested_op_count_(source.nested_op_count_),
+      unique_id_(next_unique_id()),
+      bounds_(source.bounds_),
+      can_apply_group_opacity_(source.can_apply_group_opacity_),
+      is_ui_thread_safe_(source.is_ui_thread_safe_),
+      modifies_transparent_black_(source.modifies_transparent_black_),
+      has_backdrop_filter_(source.has_backdrop_filter_),
+      rtree_(source.rtree_) {}
+
 DisplayList::~DisplayList() {
-  uint8_t* ptr = storage_.get();
-  DisposeOps(ptr, ptr + byte_count_);
+  if (!compact_ops_) {
+    uint8_t* ptr = storage_.get();
+    DisposeOps(ptr, ptr + byte_count_);
+  }
 }
 
 uint32_t DisplayList::next_unique_id() {
@@ -61,12 +84,6 @@ uint32_t DisplayList::next_unique_id() {
   return id;
 }
 
-class Culler {
- public:
-  virtual ~Culler() = default;
-  virtual bool init(DispatchContext& context) = 0;
-  virtual void update(DispatchContext& context) = 0;
-};
 class NopCuller final : public Culler {
  public:
   static NopCuller instance;
@@ -139,8 +156,7 @@ class VectorCuller final : public Culler {
 };
 
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
-  uint8_t* ptr = storage_.get();
-  Dispatch(receiver, ptr, ptr + byte_count_, NopCuller::instance);
+  Dispatch(receiver, NopCuller::instance);
 }
 
 void DisplayList::Dispatch(DlOpReceiver& receiver,
@@ -159,17 +175,13 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   }
   const DlRTree* rtree = this->rtree().get();
   FML_DCHECK(rtree != nullptr);
-  uint8_t* ptr = storage_.get();
   std::vector<int> rect_indices;
   rtree->search(cull_rect, &rect_indices);
   VectorCuller culler(rtree, rect_indices);
-  Dispatch(receiver, ptr, ptr + byte_count_, culler);
+  Dispatch(receiver, culler);
 }
 
-void DisplayList::Dispatch(DlOpReceiver& receiver,
-                           uint8_t* ptr,
-                           uint8_t* end,
-                           Culler& culler) const {
+void DisplayList::Dispatch(DlOpReceiver& receiver, Culler& culler) const {
   DispatchContext context = {
       .receiver = receiver,
       .cur_index = 0,
@@ -179,6 +191,12 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   if (!culler.init(context)) {
     return;
   }
+  if (compact_ops_) {
+    compact_ops_->Dispatch(context, culler);
+    return;
+  }
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
   while (ptr < end) {
     auto op = reinterpret_cast<const DLOp*>(ptr);
     ptr += op->size;
@@ -307,6 +325,11 @@ bool DisplayList::Equals(const DisplayList* other) const {
   if (byte_count_ != other->byte_count_ || op_count_ != other->op_count_) {
     return false;
   }
+  if (compact_ops_ || other->compact_ops_) {
+    // Lists in different encodings are conservatively treated as different.
+    return compact_ops_ && other->compact_ops_ &&
+           compact_ops_->Equals(*other->compact_ops_);
+  }
   uint8_t* ptr = storage_.get();
   uint8_t* o_ptr = other->storage_.get();
   if (ptr == o_ptr) {
@@ -315,4 +338,108 @@ bool DisplayList::Equals(const DisplayList* other) const {
   return CompareOps(ptr, ptr + byte_count_, o_ptr, o_ptr + other->byte_count_);
 }
 
+// Ops that do not override DLOp::equals are compared byte for byte, so
+// their bytes can also be hashed directly.
+template <typename T>
+static constexpr bool kHashOpBytes =
+    std::is_same_v<decltype(&T::equals), decltype(&DLOp::equals)>;
+
+static void HashPath(size_t& hash, const SkPath& path) {
+  fml::HashCombineSeed(hash, static_cast<int>(path.getFillType()),
+                       path.countVerbs(), path.countPoints());
+  for (int i = 0; i < path.countPoints(); i++) {
+    SkPoint point = path.getPoint(i);
+    fml::HashCombineSeed(hash, point.fX, point.fY);
+  }
+}
+
+static size_t HashOps(const uint8_t* ptr, const uint8_t* end) {
+  size_t hash = fml::HashCombine();
+  const uint8_t* bulk_start = ptr;
+  auto hash_bulk_bytes = [&hash, &bulk_start](const uint8_t* bulk_end) {
+    if (bulk_end > bulk_start) {
+      std::string_view bytes(reinterpret_cast<const char*>(bulk_start),
+                             bulk_end - bulk_start);
+      fml::HashCombineSeed(hash, std::hash<std::string_view>{}(bytes));
+    }
+  };
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+    bool hash_bytes;
+    switch (op->type) {
+#define DL_OP_HASH_BYTES(name)           \
+  case DisplayListOpType::k##name:       \
+    hash_bytes = kHashOpBytes<name##Op>; \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_HASH_BYTES)
+#ifdef IMPELLER_ENABLE_3D
+      DL_OP_HASH_BYTES(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_HASH_BYTES
+
+      default:
+        FML_DCHECK(false);
+        return hash;
+    }
+    if (hash_bytes) {
+      continue;
+    }
+    // The op has a deep equals method that may consider ops with different
+    // bytes equal. Only the parts of the op that such a comparison can
+    // never ignore contribute to the hash.
+    hash_bulk_bytes(reinterpret_cast<const uint8_t*>(op));
+    bulk_start = ptr;
+    fml::HashCombineSeed(hash, static_cast<int>(op->type), op->size);
+    switch (op->type) {
+      case DisplayListOpType::kDrawDisplayList: {
+        auto draw_op = static_cast<const DrawDisplayListOp*>(op);
+        fml::HashCombineSeed(hash, draw_op->opacity,
+                             draw_op->display_list->content_hash());
+        break;
+      }
+      case DisplayListOpType::kDrawPath:
+        HashPath(hash, static_cast<const DrawPathOp*>(op)->path);
+        break;
+      case DisplayListOpType::kClipIntersectPath: {
+        auto clip_op = static_cast<const ClipIntersectPathOp*>(op);
+        fml::HashCombineSeed(hash, clip_op->is_aa);
+        HashPath(hash, clip_op->path);
+        break;
+      }
+      case DisplayListOpType::kClipDifferencePath: {
+        auto clip_op = static_cast<const ClipDifferencePathOp*>(op);
+        fml::HashCombineSeed(hash, clip_op->is_aa);
+        HashPath(hash, clip_op->path);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  hash_bulk_bytes(end);
+  return hash;
+}
+
+size_t DisplayList::content_hash() const {
+  size_t hash = content_hash_.load(std::memory_order_relaxed);
+  if (hash == 0) {
+    TRACE_EVENT0("flutter", "DisplayList::content_hash");
+    if (compact_ops_) {
+      hash = compact_ops_->Hash();
+    } else {
+      const uint8_t* ptr = storage_.get();
+      hash = HashOps(ptr, ptr + byte_count_);
+    }
+    if (hash == 0) {
+      hash = 1;
+    }
+    content_hash_.store(hash, std::memory_order_relaxed);
+  }
+  return hash;
+}
+
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 
@@ -224,6 +225,7 @@ class DisplayListStorage {
 };
 
 class Culler;
+class DlCompactOpStorage;
 
 // The base class that contains a sequence of rendering operations
 // for dispatch to a DlOpReceiver. These objects must be instantiated
@@ -263,6 +265,18 @@ class DisplayList : public SkRefCnt {
     return Equals(other.get());
   }
 
+  /// @brief     A hash of the rendering operations of this DisplayList that
+  ///            is the same for any two DisplayLists for which |Equals|
+  ///            returns true, even if they were recorded separately.
+  ///
+  /// Unlike the |unique_id|, the hash can be used to find the results of
+  /// rendering identical content that was recorded again, such as the
+  /// picture of a widget that was rebuilt without changes. Different
+  /// content may share a hash, so a match must be confirmed with |Equals|.
+  ///
+  /// The hash is computed on first use and remembered.
+  size_t content_hash() const;
+
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
   bool isUIThreadSafe() const { return is_ui_thread_safe_; }
 
@@ -279,6 +293,14 @@ class DisplayList : public SkRefCnt {
     return modifies_transparent_black_;
   }
 
+  /// @brief     Indicates if any saveLayer in this DisplayList, or in any
+  ///            DisplayList nested within it, specifies a backdrop filter.
+  ///
+  /// A backdrop filter samples the surface content outside of the bounds
+  /// of the layer it is applied to, so a DisplayList that contains one
+  /// cannot be rendered as independent tiles of its target surface.
+  bool has_backdrop_filter() const { return has_backdrop_filter_; }
+
  private:
   DisplayList(DisplayListStorage&& ptr,
               size_t byte_count,
@@ -289,13 +311,22 @@ class DisplayList : public SkRefCnt {
               bool can_apply_group_opacity,
               bool is_ui_thread_safe,
               bool modifies_transparent_black,
+              bool has_backdrop_filter,
               sk_sp<const DlRTree> rtree);
 
+  // Creates a list with the same contents and properties as |source| that
+  // holds its ops in the |compact_ops| encoding instead of op records.
+  DisplayList(std::unique_ptr<const DlCompactOpStorage> compact_ops,
+              const DisplayList& source);
+
   static uint32_t next_unique_id();
 
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
 
   const DisplayListStorage storage_;
+  // Null unless the ops are held in the compact encoding, in which case
+  // |storage_| is empty and |byte_count_| is the size of the encoding.
+  const std::unique_ptr<const DlCompactOpStorage> compact_ops_;
   const size_t byte_count_;
   const unsigned int op_count_;
 
@@ -308,13 +339,14 @@ class DisplayList : public SkRefCnt {
   const bool can_apply_group_opacity_;
   const bool is_ui_thread_safe_;
   const bool modifies_transparent_black_;
+  const bool has_backdrop_filter_;
 
   const sk_sp<const DlRTree> rtree_;
 
-  void Dispatch(DlOpReceiver& ctx,
-                uint8_t* ptr,
-                uint8_t* end,
-                Culler& culler) const;
+  // Zero until |content_hash| is first called.
+  mutable std::atomic<size_t> content_hash_ = 0;
+
+  void Dispatch(DlOpReceiver& ctx, Culler& culler) const;
 
   friend class DisplayListBuilder;
 };
@@ -3015,6 +3015,83 @@ TEST_F(DisplayListTest, RTreeRenderCulling) {
   }
 }
 
+TEST_F(DisplayListTest, BackdropFilterIsReported) {
+  DlBlurImageFilter backdrop(5.0, 5.0, DlTileMode::kClamp);
+  {
+    DisplayListBuilder builder;
+    builder.DrawRect({10, 10, 20, 20}, DlPaint());
+    EXPECT_FALSE(builder.Build()->has_backdrop_filter());
+  }
+  {
+    DisplayListBuilder builder;
+    builder.SaveLayer(nullptr, nullptr, &backdrop);
+    builder.DrawRect({10, 10, 20, 20}, DlPaint());
+    builder.Restore();
+    EXPECT_TRUE(builder.Build()->has_backdrop_filter());
+    // The flag is reset once the builder has produced a DisplayList.
+    EXPECT_FALSE(builder.Build()->has_backdrop_filter());
+  }
+  {
+    DisplayListBuilder nested_builder;
+    nested_builder.SaveLayer(nullptr, nullptr, &backdrop);
+    nested_builder.DrawRect({10, 10, 20, 20}, DlPaint());
+    nested_builder.Restore();
+
+    DisplayListBuilder builder;
+    builder.DrawDisplayList(nested_builder.Build());
+    EXPECT_TRUE(builder.Build()->has_backdrop_filter());
+  }
+}
+
+TEST_F(DisplayListTest, ContentHashMatchesForEqualDisplayLists) {
+  for (auto& group : CreateAllGroups()) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      auto& invocation = group.variants[i];
+      DisplayListBuilder builder1;
+      invocation.Invoke(ToReceiver(builder1));
+      sk_sp<DisplayList> dl1 = builder1.Build();
+      DisplayListBuilder builder2;
+      invocation.Invoke(ToReceiver(builder2));
+      sk_sp<DisplayList> dl2 = builder2.Build();
+
+      ASSERT_TRUE(dl1->Equals(dl2))
+          << group.op_name << "(variant " << i << ")";
+      EXPECT_EQ(dl1->content_hash(), dl2->content_hash())
+          << group.op_name << "(variant " << i << ")";
+    }
+  }
+}
+
+TEST_F(DisplayListTest, ContentHashSeesThroughRecordedObjects) {
+  auto make_display_list = [](SkScalar radius, DlColor nested_color) {
+    DisplayListBuilder nested_builder;
+    nested_builder.DrawRect({0, 0, 10, 10}, DlPaint(nested_color));
+
+    DisplayListBuilder builder;
+    SkPath path;
+    path.moveTo(50, 50 - radius);
+    path.lineTo(50 + radius, 50 + radius);
+    path.lineTo(50 - radius, 50 + radius);
+    path.close();
+    builder.ClipPath(path, DlCanvas::ClipOp::kIntersect, true);
+    builder.DrawPath(path, DlPaint());
+    builder.DrawDisplayList(nested_builder.Build(), 0.5f);
+    return builder.Build();
+  };
+
+  auto display_list = make_display_list(20, DlColor::kRed());
+  auto same = make_display_list(20, DlColor::kRed());
+  auto different_path = make_display_list(25, DlColor::kRed());
+  auto different_nested = make_display_list(20, DlColor::kBlue());
+
+  ASSERT_TRUE(display_list->Equals(same));
+  EXPECT_EQ(display_list->content_hash(), same->content_hash());
+  EXPECT_NE(display_list->content_hash(), different_path->content_hash());
+  EXPECT_NE(display_list->content_hash(), different_nested->content_hash());
+  // The hash is remembered.
+  EXPECT_EQ(display_list->content_hash(), display_list->content_hash());
+}
+
 TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   DisplayListBuilder builder;
   builder.DrawCircle({10, 10}, 5, DlPaint());
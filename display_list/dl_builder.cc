@@ -6,6 +6,7 @@
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
+#include "flutter/display_list/dl_compact_op_storage.h"
 #include "flutter/display_list/dl_op_flags.h"
 #include "flutter/display_list/dl_op_records.h"
 #include "flutter/display_list/effects/dl_color_source.h"
@@ -75,10 +76,12 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   bool compatible = current_layer_->is_group_opacity_compatible();
   bool is_safe = is_ui_thread_safe_;
   bool affects_transparency = current_layer_->affects_transparent_layer();
+  bool has_backdrop_filter = has_backdrop_filter_;
 
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   is_ui_thread_safe_ = true;
+  has_backdrop_filter_ = false;
   storage_.realloc(bytes);
   layer_stack_.pop_back();
   layer_stack_.emplace_back();
@@ -87,7 +90,14 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
 
   return sk_sp<DisplayList>(new DisplayList(
       std::move(storage_), bytes, count, nested_bytes, nested_count, bounds(),
-      compatible, is_safe, affects_transparency, rtree()));
+      compatible, is_safe, affects_transparency, has_backdrop_filter,
+      rtree()));
+}
+
+sk_sp<DisplayList> DisplayListBuilder::BuildCompact() {
+  sk_sp<DisplayList> display_list = Build();
+  return sk_sp<DisplayList>(new DisplayList(
+      DlCompactOpStorage::Encode(*display_list), *display_list));
 }
 
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
@@ -523,6 +533,7 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
     // when we tested the PaintResult.
     [[maybe_unused]] bool unclipped = AccumulateUnbounded();
     FML_DCHECK(unclipped);
+    has_backdrop_filter_ = true;
     bounds  //
         ? Push<SaveLayerBackdropBoundsOp>(0, 1, options, *bounds, backdrop)
         : Push<SaveLayerBackdropOp>(0, 1, options, backdrop);
@@ -1240,6 +1251,8 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
   Push<DrawDisplayListOp>(0, 1, display_list,
                           opacity < SK_Scalar1 ? opacity : SK_Scalar1);
   is_ui_thread_safe_ = is_ui_thread_safe_ && display_list->isUIThreadSafe();
+  has_backdrop_filter_ =
+      has_backdrop_filter_ || display_list->has_backdrop_filter();
   // Not really necessary if the developer is interacting with us via
   // our attribute-state-less DlCanvas methods, but this avoids surprises
   // for those who may have been using the stateful Dispatcher methods.
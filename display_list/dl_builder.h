@@ -246,6 +246,16 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Builds a |DisplayList| that holds its ops in the byte-compact
+  ///             |DlCompactOpStorage| encoding.
+  ///
+  /// The list renders, culls, and compares like the one returned by |Build|
+  /// but takes less memory at the cost of decoding the operands of each op
+  /// when it is dispatched.
+  ///
+  sk_sp<DisplayList> BuildCompact();
+
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
@@ -496,6 +506,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
   int nested_op_count_ = 0;
 
   bool is_ui_thread_safe_ = true;
+  bool has_backdrop_filter_ = false;
 
   template <typename T, typename... Args>
   void* Push(size_t extra, int op_inc, Args&&... args);
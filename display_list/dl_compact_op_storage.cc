@@ -0,0 +1,1188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_compact_op_storage.h"
+
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#include "flutter/display_list/dl_op_records.h"
+#include "flutter/display_list/utils/dl_comparable.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/typographer/text_frame.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+
+namespace flutter {
+
+namespace {
+
+// The op codes of the compact encoding. These enumerate the calls on
+// |DlOpReceiver| rather than the records of |DisplayListOpType| since a few
+// records map to the same call with different arguments.
+enum class CompactOp : uint8_t {
+  kSetAntiAlias,
+  kSetDrawStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawTextFrame,
+  kDrawShadow,
+};
+
+// Scalars that are a multiple of 1/kScalarFraction and within this range are
+// encoded as varints.
+constexpr float kScalarFraction = 16.0f;
+constexpr float kMaxFixedScalar = (1 << 24) / kScalarFraction;
+
+// The low bit of an encoded scalar distinguishes fixed point values (0) from
+// a raw IEEE value (1) which follows in the next 4 bytes.
+constexpr uint32_t kRawScalarTag = 1;
+
+constexpr uint32_t ZigZag(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^
+         static_cast<uint32_t>(value >> 31);
+}
+
+constexpr int32_t UnZigZag(uint32_t value) {
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+class CompactReader {
+ public:
+  explicit CompactReader(const std::vector<uint8_t>& operands)
+      : ptr_(operands.data()), end_(operands.data() + operands.size()) {}
+
+  uint32_t ReadVarint() {
+    uint32_t value = 0;
+    int shift = 0;
+    while (true) {
+      FML_DCHECK(ptr_ < end_);
+      uint8_t byte = *ptr_++;
+      value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+      shift += 7;
+    }
+  }
+
+  bool ReadBool() { return ReadVarint() != 0; }
+
+  int32_t ReadInt() { return UnZigZag(ReadVarint()); }
+
+  SkScalar ReadScalar() {
+    uint32_t encoded = ReadVarint();
+    if (encoded == kRawScalarTag) {
+      FML_DCHECK(ptr_ + sizeof(SkScalar) <= end_);
+      SkScalar value;
+      memcpy(&value, ptr_, sizeof(value));
+      ptr_ += sizeof(value);
+      return value;
+    }
+    return UnZigZag(encoded >> 1) / kScalarFraction;
+  }
+
+  SkPoint ReadPoint() {
+    SkScalar x = ReadScalar();
+    SkScalar y = ReadScalar();
+    return SkPoint::Make(x, y);
+  }
+
+  SkRect ReadRect() {
+    SkScalar left = ReadScalar();
+    SkScalar top = ReadScalar();
+    SkScalar right = ReadScalar();
+    SkScalar bottom = ReadScalar();
+    return SkRect::MakeLTRB(left, top, right, bottom);
+  }
+
+  SkRRect ReadRRect() {
+    SkRect rect = ReadRect();
+    SkVector radii[4];
+    for (SkVector& radius : radii) {
+      radius = ReadPoint();
+    }
+    SkRRect rrect;
+    rrect.setRectRadii(rect, radii);
+    return rrect;
+  }
+
+  bool is_done() const { return ptr_ >= end_; }
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* const end_;
+};
+
+// Returns the object for an index written by |DlCompactOpEncoder::Index|.
+template <typename T>
+const T* Lookup(const std::vector<std::shared_ptr<T>>& table, uint32_t index) {
+  return index == 0 ? nullptr : table[index - 1].get();
+}
+
+template <typename P>
+P LookupObject(const std::vector<P>& table, uint32_t index) {
+  return index == 0 ? nullptr : table[index - 1];
+}
+
+// The same decisions as |SaveOpBase::save_needed| and |RestoreOp::dispatch|
+// in dl_op_records.h, using the restore index stored alongside the ops.
+bool SaveNeeded(DispatchContext& ctx, int restore_index) {
+  bool needed = ctx.next_render_index <= restore_index;
+  ctx.save_infos.emplace_back(ctx.next_restore_index, needed);
+  ctx.next_restore_index = restore_index;
+  return needed;
+}
+
+void DispatchRestore(DispatchContext& ctx) {
+  DispatchContext::SaveInfo& info = ctx.save_infos.back();
+  if (info.save_was_needed) {
+    ctx.receiver.restore();
+  }
+  ctx.next_restore_index = info.previous_restore_index;
+  ctx.save_infos.pop_back();
+}
+
+void HashPath(size_t& hash, const SkPath& path) {
+  fml::HashCombineSeed(hash, static_cast<int>(path.getFillType()),
+                       path.countVerbs(), path.countPoints());
+}
+
+template <typename T>
+void HashBytes(size_t& hash, const std::vector<T>& data) {
+  std::string_view bytes(reinterpret_cast<const char*>(data.data()),
+                         data.size() * sizeof(T));
+  fml::HashCombineSeed(hash, std::hash<std::string_view>{}(bytes));
+}
+
+template <typename T>
+bool AttributesEqual(const std::vector<std::shared_ptr<const T>>& a,
+                     const std::vector<std::shared_ptr<const T>>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (NotEquals(a[i], b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// A |DlOpReceiver| that writes the calls it receives into the streams and
+/// tables of a |DlCompactOpStorage|, one compact op per call.
+///
+/// The |DisplayListBuilder| already drops setters that do not change the
+/// attribute state, so every call is recorded to keep the compact ops in
+/// step with the op records and the indices of the |DlRTree|.
+class DlCompactOpEncoder final : public virtual DlOpReceiver {
+ public:
+  explicit DlCompactOpEncoder(DlCompactOpStorage* target) : target_(target) {}
+
+  void setAntiAlias(bool aa) override {
+    WriteOp(CompactOp::kSetAntiAlias);
+    WriteBool(aa);
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    WriteOp(CompactOp::kSetDrawStyle);
+    WriteEnum(style);
+  }
+  void setColor(DlColor color) override {
+    WriteOp(CompactOp::kSetColor);
+    WriteColor(color);
+  }
+  void setStrokeWidth(float width) override {
+    WriteOp(CompactOp::kSetStrokeWidth);
+    WriteScalar(width);
+  }
+  void setStrokeMiter(float limit) override {
+    WriteOp(CompactOp::kSetStrokeMiter);
+    WriteScalar(limit);
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    WriteOp(CompactOp::kSetStrokeCap);
+    WriteEnum(cap);
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    WriteOp(CompactOp::kSetStrokeJoin);
+    WriteEnum(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    WriteOp(CompactOp::kSetColorSource);
+    WriteVarint(Index(target_->color_sources_, color_source_indices_, source));
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    WriteOp(CompactOp::kSetColorFilter);
+    WriteVarint(Index(target_->color_filters_, color_filter_indices_, filter));
+  }
+  void setInvertColors(bool invert) override {
+    WriteOp(CompactOp::kSetInvertColors);
+    WriteBool(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    WriteOp(CompactOp::kSetBlendMode);
+    WriteEnum(mode);
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    WriteOp(CompactOp::kSetPathEffect);
+    WriteVarint(Index(target_->path_effects_, path_effect_indices_, effect));
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    WriteOp(CompactOp::kSetMaskFilter);
+    WriteVarint(Index(target_->mask_filters_, mask_filter_indices_, filter));
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    WriteOp(CompactOp::kSetImageFilter);
+    WriteVarint(Index(target_->image_filters_, image_filter_indices_, filter));
+  }
+
+  void save() override {
+    WriteOp(CompactOp::kSave);
+    OpenSave();
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    WriteOp(CompactOp::kSaveLayer);
+    WriteVarint((bounds ? 1 : 0) |                             //
+                (options.renders_with_attributes() ? 2 : 0) |  //
+                (options.can_distribute_opacity() ? 4 : 0));
+    if (bounds) {
+      WriteRect(*bounds);
+    }
+    WriteVarint(Index(target_->image_filters_, image_filter_indices_,
+                      backdrop));
+    OpenSave();
+  }
+  void restore() override {
+    // The op records of a save store the index of their restore op, which
+    // is the index of the compact op about to be written.
+    FML_DCHECK(!open_saves_.empty());
+    target_->restore_indices_[open_saves_.back()] = target_->ops_.size();
+    open_saves_.pop_back();
+    WriteOp(CompactOp::kRestore);
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    WriteOp(CompactOp::kTranslate);
+    WriteScalars({tx, ty});
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    WriteOp(CompactOp::kScale);
+    WriteScalars({sx, sy});
+  }
+  void rotate(SkScalar degrees) override {
+    WriteOp(CompactOp::kRotate);
+    WriteScalar(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    WriteOp(CompactOp::kSkew);
+    WriteScalars({sx, sy});
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    WriteOp(CompactOp::kTransform2DAffine);
+    WriteScalars({mxx, mxy, mxt, myx, myy, myt});
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    WriteOp(CompactOp::kTransformFullPerspective);
+    WriteScalars({mxx, mxy, mxz, mxt,
+                  myx, myy, myz, myt,
+                  mzx, mzy, mzz, mzt,
+                  mwx, mwy, mwz, mwt});
+  }
+  // clang-format on
+  void transformReset() override { WriteOp(CompactOp::kTransformReset); }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    WriteOp(CompactOp::kClipRect);
+    WriteClipFlags(clip_op, is_aa);
+    WriteRect(rect);
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    WriteOp(CompactOp::kClipRRect);
+    WriteClipFlags(clip_op, is_aa);
+    WriteRRect(rrect);
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    WriteOp(CompactOp::kClipPath);
+    WriteClipFlags(clip_op, is_aa);
+    WritePath(path);
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    WriteOp(CompactOp::kDrawColor);
+    WriteColor(color);
+    WriteEnum(mode);
+  }
+  void drawPaint() override { WriteOp(CompactOp::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    WriteOp(CompactOp::kDrawLine);
+    WriteScalars({p0.fX, p0.fY, p1.fX, p1.fY});
+  }
+  void drawRect(const SkRect& rect) override {
+    WriteOp(CompactOp::kDrawRect);
+    WriteRect(rect);
+  }
+  void drawOval(const SkRect& bounds) override {
+    WriteOp(CompactOp::kDrawOval);
+    WriteRect(bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    WriteOp(CompactOp::kDrawCircle);
+    WriteScalars({center.fX, center.fY, radius});
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    WriteOp(CompactOp::kDrawRRect);
+    WriteRRect(rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    WriteOp(CompactOp::kDrawDRRect);
+    WriteRRect(outer);
+    WriteRRect(inner);
+  }
+  void drawPath(const SkPath& path) override {
+    WriteOp(CompactOp::kDrawPath);
+    WritePath(path);
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    WriteOp(CompactOp::kDrawArc);
+    WriteRect(oval_bounds);
+    WriteScalars({start_degrees, sweep_degrees});
+    WriteBool(use_center);
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    WriteOp(CompactOp::kDrawPoints);
+    WriteEnum(mode);
+    WriteVarint(count);
+    for (uint32_t i = 0; i < count; i++) {
+      WriteScalars({points[i].fX, points[i].fY});
+    }
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    WriteOp(CompactOp::kDrawVertices);
+    target_->vertices_.push_back(DlVertices::Make(
+        vertices->mode(), vertices->vertex_count(), vertices->vertices(),
+        vertices->texture_coordinates(), vertices->colors(),
+        vertices->index_count(), vertices->indices()));
+    WriteVarint(target_->vertices_.size());
+    WriteEnum(mode);
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    WriteOp(CompactOp::kDrawImage);
+    WriteVarint(Index(target_->images_, image_indices_, image));
+    WriteScalars({point.fX, point.fY});
+    WriteVarint(static_cast<uint32_t>(sampling) << 1 |
+                (render_with_attributes ? 1 : 0));
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    WriteOp(CompactOp::kDrawImageRect);
+    WriteVarint(Index(target_->images_, image_indices_, image));
+    WriteRect(src);
+    WriteRect(dst);
+    WriteVarint(static_cast<uint32_t>(sampling) << 2 |
+                static_cast<uint32_t>(constraint) << 1 |
+                (render_with_attributes ? 1 : 0));
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    WriteOp(CompactOp::kDrawImageNine);
+    WriteVarint(Index(target_->images_, image_indices_, image));
+    WriteInt(center.fLeft);
+    WriteInt(center.fTop);
+    WriteInt(center.fRight);
+    WriteInt(center.fBottom);
+    WriteRect(dst);
+    WriteVarint(static_cast<uint32_t>(filter) << 1 |
+                (render_with_attributes ? 1 : 0));
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    WriteOp(CompactOp::kDrawAtlas);
+    WriteVarint(Index(target_->images_, image_indices_, atlas));
+    WriteVarint(count);
+    WriteVarint((colors ? 1 : 0) |     //
+                (cull_rect ? 2 : 0) |  //
+                (render_with_attributes ? 4 : 0));
+    WriteEnum(mode);
+    WriteEnum(sampling);
+    for (int i = 0; i < count; i++) {
+      const SkRSXform& x = xform[i];
+      WriteScalars({x.fSCos, x.fSSin, x.fTx, x.fTy});
+      WriteRect(tex[i]);
+      if (colors) {
+        WriteColor(colors[i]);
+      }
+    }
+    if (cull_rect) {
+      WriteRect(*cull_rect);
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    WriteOp(CompactOp::kDrawDisplayList);
+    WriteVarint(Index(target_->display_lists_, display_list_indices_,
+                      display_list));
+    WriteScalar(opacity);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    WriteOp(CompactOp::kDrawTextBlob);
+    WriteVarint(Index(target_->text_blobs_, text_blob_indices_, blob));
+    WriteScalars({x, y});
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    WriteOp(CompactOp::kDrawTextFrame);
+    WriteVarint(Index(target_->text_frames_, text_frame_indices_,
+                      text_frame));
+    WriteScalars({x, y});
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    WriteOp(CompactOp::kDrawShadow);
+    WritePath(path);
+    WriteColor(color);
+    WriteScalars({elevation, dpr});
+    WriteBool(transparent_occluder);
+  }
+
+ private:
+  // Content comparisons of attribute objects are only made against the most
+  // recently added entries of a table so that encoding stays linear in the
+  // number of ops. Equal attributes that are further apart are kept twice.
+  static constexpr size_t kAttributeSearchWindow = 8;
+
+  template <typename T>
+  using IndexMap = std::unordered_map<const T*, uint32_t>;
+
+  DlCompactOpStorage* target_;
+  std::vector<size_t> open_saves_;
+
+  std::unordered_map<uint32_t, uint32_t> palette_indices_;
+  std::unordered_map<uint32_t, uint32_t> path_indices_;
+  IndexMap<DlColorSource> color_source_indices_;
+  IndexMap<DlColorFilter> color_filter_indices_;
+  IndexMap<DlImageFilter> image_filter_indices_;
+  IndexMap<DlPathEffect> path_effect_indices_;
+  IndexMap<DlMaskFilter> mask_filter_indices_;
+  IndexMap<DlImage> image_indices_;
+  IndexMap<DisplayList> display_list_indices_;
+  IndexMap<SkTextBlob> text_blob_indices_;
+  IndexMap<impeller::TextFrame> text_frame_indices_;
+
+  void WriteOp(CompactOp op) {
+    target_->ops_.push_back(static_cast<uint8_t>(op));
+  }
+
+  // Reserves the restore index of the save op that was just written.
+  void OpenSave() {
+    open_saves_.push_back(target_->restore_indices_.size());
+    target_->restore_indices_.push_back(0);
+  }
+
+  void WriteVarint(uint32_t value) {
+    std::vector<uint8_t>& operands = target_->operands_;
+    while (value >= 0x80) {
+      operands.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    operands.push_back(static_cast<uint8_t>(value));
+  }
+
+  void WriteBool(bool value) { WriteVarint(value ? 1 : 0); }
+
+  void WriteInt(int32_t value) { WriteVarint(ZigZag(value)); }
+
+  template <typename T>
+  void WriteEnum(T value) {
+    WriteVarint(static_cast<uint32_t>(value));
+  }
+
+  void WriteScalar(SkScalar value) {
+    // Coordinates in UI content are overwhelmingly whole or simple fractional
+    // pixel values, which fit in 1-3 bytes as a fixed point varint. Anything
+    // else, including -0.0 and non-finite values, is stored as raw bits.
+    SkScalar fixed = value * kScalarFraction;
+    if (std::abs(value) <= kMaxFixedScalar && fixed == std::floor(fixed) &&
+        !(value == 0 && std::signbit(value))) {
+      WriteVarint(ZigZag(static_cast<int32_t>(fixed)) << 1);
+      return;
+    }
+    WriteVarint(kRawScalarTag);
+    uint8_t bytes[sizeof(SkScalar)];
+    memcpy(bytes, &value, sizeof(value));
+    target_->operands_.insert(target_->operands_.end(), bytes,
+                              bytes + sizeof(bytes));
+  }
+
+  void WriteScalars(std::initializer_list<SkScalar> values) {
+    for (SkScalar value : values) {
+      WriteScalar(value);
+    }
+  }
+
+  void WriteRect(const SkRect& rect) {
+    WriteScalars({rect.fLeft, rect.fTop, rect.fRight, rect.fBottom});
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    WriteRect(rrect.rect());
+    for (int i = 0; i < 4; i++) {
+      SkVector radius = rrect.radii(static_cast<SkRRect::Corner>(i));
+      WriteScalars({radius.fX, radius.fY});
+    }
+  }
+
+  void WriteColor(DlColor color) {
+    std::vector<DlColor>& palette = target_->palette_;
+    auto [found, added] =
+        palette_indices_.try_emplace(color.argb(), palette.size());
+    if (added) {
+      palette.push_back(color);
+    }
+    WriteVarint(found->second);
+  }
+
+  void WriteClipFlags(ClipOp clip_op, bool is_aa) {
+    WriteVarint(static_cast<uint32_t>(clip_op) << 1 | (is_aa ? 1 : 0));
+  }
+
+  // Paths that share their point storage, such as the same path drawn
+  // repeatedly, share a generation id and are stored once.
+  void WritePath(const SkPath& path) {
+    std::vector<SkPath>& paths = target_->paths_;
+    auto [found, added] =
+        path_indices_.try_emplace(path.getGenerationID(), paths.size());
+    if (added || paths[found->second] != path) {
+      if (!added) {
+        found->second = paths.size();
+      }
+      paths.push_back(path);
+    }
+    WriteVarint(found->second);
+  }
+
+  // Returns 0 for a null attribute, otherwise 1 + the index of an equal
+  // attribute in the table, adding a shared copy if there is none.
+  template <typename T>
+  uint32_t Index(std::vector<std::shared_ptr<const T>>& table,
+                 IndexMap<T>& indices,
+                 const T* attribute) {
+    if (attribute == nullptr) {
+      return 0;
+    }
+    auto [found, added] = indices.try_emplace(attribute, 0);
+    if (!added) {
+      return found->second;
+    }
+    size_t start = table.size() > kAttributeSearchWindow
+                       ? table.size() - kAttributeSearchWindow
+                       : 0;
+    for (size_t i = table.size(); i > start; i--) {
+      if (Equals(table[i - 1], attribute)) {
+        return found->second = i;
+      }
+    }
+    table.push_back(attribute->shared());
+    return found->second = table.size();
+  }
+
+  // Returns 0 for a null object, otherwise 1 + the index of the same object
+  // in the table, adding it if it is not there yet.
+  template <typename P, typename T>
+  uint32_t Index(std::vector<P>& table, IndexMap<T>& indices, const P& object) {
+    if (!object) {
+      return 0;
+    }
+    auto [found, added] = indices.try_emplace(object.get(), 0);
+    if (added) {
+      table.push_back(object);
+      found->second = table.size();
+    }
+    return found->second;
+  }
+};
+
+DlCompactOpStorage::DlCompactOpStorage() = default;
+
+DlCompactOpStorage::~DlCompactOpStorage() = default;
+
+std::unique_ptr<const DlCompactOpStorage> DlCompactOpStorage::Encode(
+    const DisplayList& display_list) {
+  TRACE_EVENT0("flutter", "DlCompactOpStorage::Encode");
+  std::unique_ptr<DlCompactOpStorage> storage(new DlCompactOpStorage());
+  DlCompactOpEncoder encoder(storage.get());
+  display_list.Dispatch(encoder);
+  storage->ops_.shrink_to_fit();
+  storage->operands_.shrink_to_fit();
+  storage->restore_indices_.shrink_to_fit();
+  return storage;
+}
+
+size_t DlCompactOpStorage::bytes() const {
+  size_t vertex_bytes = 0;
+  for (const std::shared_ptr<DlVertices>& vertices : vertices_) {
+    vertex_bytes += vertices->size();
+  }
+  return sizeof(DlCompactOpStorage) + ops_.size() + operands_.size() +
+         restore_indices_.size() * sizeof(uint32_t) +
+         palette_.size() * sizeof(DlColor) +
+         color_sources_.size() * sizeof(color_sources_[0]) +
+         color_filters_.size() * sizeof(color_filters_[0]) +
+         image_filters_.size() * sizeof(image_filters_[0]) +
+         path_effects_.size() * sizeof(path_effects_[0]) +
+         mask_filters_.size() * sizeof(mask_filters_[0]) +
+         vertices_.size() * sizeof(vertices_[0]) + vertex_bytes +
+         paths_.size() * sizeof(paths_[0]) +
+         images_.size() * sizeof(images_[0]) +
+         display_lists_.size() * sizeof(display_lists_[0]) +
+         text_blobs_.size() * sizeof(text_blobs_[0]) +
+         text_frames_.size() * sizeof(text_frames_[0]);
+}
+
+bool DlCompactOpStorage::Equals(const DlCompactOpStorage& other) const {
+  if (this == &other) {
+    return true;
+  }
+  if (ops_ != other.ops_ || operands_ != other.operands_ ||
+      restore_indices_ != other.restore_indices_ ||
+      palette_ != other.palette_ || paths_ != other.paths_ ||
+      images_ != other.images_ || text_blobs_ != other.text_blobs_ ||
+      text_frames_ != other.text_frames_) {
+    return false;
+  }
+  if (!AttributesEqual(color_sources_, other.color_sources_) ||
+      !AttributesEqual(color_filters_, other.color_filters_) ||
+      !AttributesEqual(image_filters_, other.image_filters_) ||
+      !AttributesEqual(path_effects_, other.path_effects_) ||
+      !AttributesEqual(mask_filters_, other.mask_filters_)) {
+    return false;
+  }
+  if (vertices_.size() != other.vertices_.size() ||
+      display_lists_.size() != other.display_lists_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < vertices_.size(); i++) {
+    if (!(*vertices_[i] == *other.vertices_[i])) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < display_lists_.size(); i++) {
+    if (!display_lists_[i]->Equals(other.display_lists_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t DlCompactOpStorage::Hash() const {
+  size_t hash = fml::HashCombine();
+  HashBytes(hash, ops_);
+  HashBytes(hash, operands_);
+  HashBytes(hash, restore_indices_);
+  HashBytes(hash, palette_);
+  for (const SkPath& path : paths_) {
+    HashPath(hash, path);
+  }
+  // Images, text blobs and text frames are compared by identity.
+  for (const sk_sp<DlImage>& image : images_) {
+    fml::HashCombineSeed(hash, image.get());
+  }
+  for (const sk_sp<SkTextBlob>& blob : text_blobs_) {
+    fml::HashCombineSeed(hash, blob.get());
+  }
+  for (const std::shared_ptr<impeller::TextFrame>& frame : text_frames_) {
+    fml::HashCombineSeed(hash, frame.get());
+  }
+  for (const sk_sp<DisplayList>& display_list : display_lists_) {
+    fml::HashCombineSeed(hash, display_list->content_hash());
+  }
+  for (const std::shared_ptr<DlVertices>& vertices : vertices_) {
+    fml::HashCombineSeed(hash, vertices->vertex_count(),
+                         vertices->index_count());
+  }
+  // Attributes may compare equal with different contents, so only the
+  // sizes of their tables contribute.
+  fml::HashCombineSeed(hash, color_sources_.size(), color_filters_.size(),
+                       image_filters_.size(), path_effects_.size(),
+                       mask_filters_.size());
+  return hash;
+}
+
+void DlCompactOpStorage::Dispatch(DispatchContext& ctx, Culler& culler) const {
+  using ClipOp = DlCanvas::ClipOp;
+  using PointMode = DlCanvas::PointMode;
+  using SrcRectConstraint = DlCanvas::SrcRectConstraint;
+
+  DlOpReceiver& receiver = ctx.receiver;
+  CompactReader reader(operands_);
+  auto restore_index = restore_indices_.begin();
+  std::vector<SkPoint> points;
+  std::vector<SkRSXform> xforms;
+  std::vector<SkRect> rects;
+  std::vector<DlColor> colors;
+
+  // The operands of every op are read even when the op is culled. The
+  // culling decisions mirror the op_needed methods of the op records.
+  for (uint8_t op : ops_) {
+    bool draw_needed = ctx.cur_index >= ctx.next_render_index;
+    bool transform_needed = ctx.next_render_index <= ctx.next_restore_index;
+    switch (static_cast<CompactOp>(op)) {
+      case CompactOp::kSetAntiAlias:
+        receiver.setAntiAlias(reader.ReadBool());
+        break;
+      case CompactOp::kSetDrawStyle:
+        receiver.setDrawStyle(static_cast<DlDrawStyle>(reader.ReadVarint()));
+        break;
+      case CompactOp::kSetColor:
+        receiver.setColor(palette_[reader.ReadVarint()]);
+        break;
+      case CompactOp::kSetStrokeWidth:
+        receiver.setStrokeWidth(reader.ReadScalar());
+        break;
+      case CompactOp::kSetStrokeMiter:
+        receiver.setStrokeMiter(reader.ReadScalar());
+        break;
+      case CompactOp::kSetStrokeCap:
+        receiver.setStrokeCap(static_cast<DlStrokeCap>(reader.ReadVarint()));
+        break;
+      case CompactOp::kSetStrokeJoin:
+        receiver.setStrokeJoin(static_cast<DlStrokeJoin>(reader.ReadVarint()));
+        break;
+      case CompactOp::kSetColorSource:
+        receiver.setColorSource(Lookup(color_sources_, reader.ReadVarint()));
+        break;
+      case CompactOp::kSetColorFilter:
+        receiver.setColorFilter(Lookup(color_filters_, reader.ReadVarint()));
+        break;
+      case CompactOp::kSetInvertColors:
+        receiver.setInvertColors(reader.ReadBool());
+        break;
+      case CompactOp::kSetBlendMode:
+        receiver.setBlendMode(static_cast<DlBlendMode>(reader.ReadVarint()));
+        break;
+      case CompactOp::kSetPathEffect:
+        receiver.setPathEffect(Lookup(path_effects_, reader.ReadVarint()));
+        break;
+      case CompactOp::kSetMaskFilter:
+        receiver.setMaskFilter(Lookup(mask_filters_, reader.ReadVarint()));
+        break;
+      case CompactOp::kSetImageFilter:
+        receiver.setImageFilter(Lookup(image_filters_, reader.ReadVarint()));
+        break;
+
+      case CompactOp::kSave:
+        if (SaveNeeded(ctx, *restore_index++)) {
+          receiver.save();
+        }
+        break;
+      case CompactOp::kSaveLayer: {
+        uint32_t flags = reader.ReadVarint();
+        SaveLayerOptions options = SaveLayerOptions::kNoAttributes;
+        if (flags & 2) {
+          options = options.with_renders_with_attributes();
+        }
+        if (flags & 4) {
+          options = options.with_can_distribute_opacity();
+        }
+        SkRect bounds;
+        if (flags & 1) {
+          bounds = reader.ReadRect();
+        }
+        const DlImageFilter* backdrop =
+            Lookup(image_filters_, reader.ReadVarint());
+        if (SaveNeeded(ctx, *restore_index++)) {
+          receiver.saveLayer((flags & 1) ? &bounds : nullptr, options,
+                             backdrop);
+        }
+        break;
+      }
+      case CompactOp::kRestore:
+        DispatchRestore(ctx);
+        break;
+
+      case CompactOp::kTranslate: {
+        SkPoint t = reader.ReadPoint();
+        if (transform_needed) {
+          receiver.translate(t.fX, t.fY);
+        }
+        break;
+      }
+      case CompactOp::kScale: {
+        SkPoint s = reader.ReadPoint();
+        if (transform_needed) {
+          receiver.scale(s.fX, s.fY);
+        }
+        break;
+      }
+      case CompactOp::kRotate: {
+        SkScalar degrees = reader.ReadScalar();
+        if (transform_needed) {
+          receiver.rotate(degrees);
+        }
+        break;
+      }
+      case CompactOp::kSkew: {
+        SkPoint s = reader.ReadPoint();
+        if (transform_needed) {
+          receiver.skew(s.fX, s.fY);
+        }
+        break;
+      }
+      case CompactOp::kTransform2DAffine: {
+        SkScalar m[6];
+        for (SkScalar& v : m) {
+          v = reader.ReadScalar();
+        }
+        if (transform_needed) {
+          receiver.transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+        }
+        break;
+      }
+      case CompactOp::kTransformFullPerspective: {
+        SkScalar m[16];
+        for (SkScalar& v : m) {
+          v = reader.ReadScalar();
+        }
+        if (transform_needed) {
+          // clang-format off
+          receiver.transformFullPerspective(m[0],  m[1],  m[2],  m[3],
+                                            m[4],  m[5],  m[6],  m[7],
+                                            m[8],  m[9],  m[10], m[11],
+                                            m[12], m[13], m[14], m[15]);
+          // clang-format on
+        }
+        break;
+      }
+      case CompactOp::kTransformReset:
+        if (transform_needed) {
+          receiver.transformReset();
+        }
+        break;
+
+      case CompactOp::kClipRect: {
+        uint32_t flags = reader.ReadVarint();
+        SkRect rect = reader.ReadRect();
+        if (transform_needed) {
+          receiver.clipRect(rect, static_cast<ClipOp>(flags >> 1), flags & 1);
+        }
+        break;
+      }
+      case CompactOp::kClipRRect: {
+        uint32_t flags = reader.ReadVarint();
+        SkRRect rrect = reader.ReadRRect();
+        if (transform_needed) {
+          receiver.clipRRect(rrect, static_cast<ClipOp>(flags >> 1),
+                             flags & 1);
+        }
+        break;
+      }
+      case CompactOp::kClipPath: {
+        uint32_t flags = reader.ReadVarint();
+        const SkPath& path = paths_[reader.ReadVarint()];
+        if (transform_needed) {
+          receiver.clipPath(path, static_cast<ClipOp>(flags >> 1), flags & 1);
+        }
+        break;
+      }
+
+      case CompactOp::kDrawColor: {
+        DlColor color = palette_[reader.ReadVarint()];
+        auto mode = static_cast<DlBlendMode>(reader.ReadVarint());
+        if (draw_needed) {
+          receiver.drawColor(color, mode);
+        }
+        break;
+      }
+      case CompactOp::kDrawPaint:
+        if (draw_needed) {
+          receiver.drawPaint();
+        }
+        break;
+      case CompactOp::kDrawLine: {
+        SkPoint p0 = reader.ReadPoint();
+        SkPoint p1 = reader.ReadPoint();
+        if (draw_needed) {
+          receiver.drawLine(p0, p1);
+        }
+        break;
+      }
+      case CompactOp::kDrawRect: {
+        SkRect rect = reader.ReadRect();
+        if (draw_needed) {
+          receiver.drawRect(rect);
+        }
+        break;
+      }
+      case CompactOp::kDrawOval: {
+        SkRect bounds = reader.ReadRect();
+        if (draw_needed) {
+          receiver.drawOval(bounds);
+        }
+        break;
+      }
+      case CompactOp::kDrawCircle: {
+        SkPoint center = reader.ReadPoint();
+        SkScalar radius = reader.ReadScalar();
+        if (draw_needed) {
+          receiver.drawCircle(center, radius);
+        }
+        break;
+      }
+      case CompactOp::kDrawRRect: {
+        SkRRect rrect = reader.ReadRRect();
+        if (draw_needed) {
+          receiver.drawRRect(rrect);
+        }
+        break;
+      }
+      case CompactOp::kDrawDRRect: {
+        SkRRect outer = reader.ReadRRect();
+        SkRRect inner = reader.ReadRRect();
+        if (draw_needed) {
+          receiver.drawDRRect(outer, inner);
+        }
+        break;
+      }
+      case CompactOp::kDrawPath: {
+        const SkPath& path = paths_[reader.ReadVarint()];
+        if (draw_needed) {
+          receiver.drawPath(path);
+        }
+        break;
+      }
+      case CompactOp::kDrawArc: {
+        SkRect bounds = reader.ReadRect();
+        SkScalar start = reader.ReadScalar();
+        SkScalar sweep = reader.ReadScalar();
+        bool use_center = reader.ReadBool();
+        if (draw_needed) {
+          receiver.drawArc(bounds, start, sweep, use_center);
+        }
+        break;
+      }
+      case CompactOp::kDrawPoints: {
+        auto mode = static_cast<PointMode>(reader.ReadVarint());
+        uint32_t count = reader.ReadVarint();
+        points.resize(count);
+        for (SkPoint& point : points) {
+          point = reader.ReadPoint();
+        }
+        if (draw_needed) {
+          receiver.drawPoints(mode, count, points.data());
+        }
+        break;
+      }
+      case CompactOp::kDrawVertices: {
+        const DlVertices* vertices = Lookup(vertices_, reader.ReadVarint());
+        auto mode = static_cast<DlBlendMode>(reader.ReadVarint());
+        if (draw_needed) {
+          receiver.drawVertices(vertices, mode);
+        }
+        break;
+      }
+      case CompactOp::kDrawImage: {
+        sk_sp<DlImage> image = LookupObject(images_, reader.ReadVarint());
+        SkPoint point = reader.ReadPoint();
+        uint32_t flags = reader.ReadVarint();
+        if (draw_needed) {
+          receiver.drawImage(image, point,
+                             static_cast<DlImageSampling>(flags >> 1),
+                             flags & 1);
+        }
+        break;
+      }
+      case CompactOp::kDrawImageRect: {
+        sk_sp<DlImage> image = LookupObject(images_, reader.ReadVarint());
+        SkRect src = reader.ReadRect();
+        SkRect dst = reader.ReadRect();
+        uint32_t flags = reader.ReadVarint();
+        if (draw_needed) {
+          auto sampling = static_cast<DlImageSampling>(flags >> 2);
+          auto constraint = static_cast<SrcRectConstraint>((flags >> 1) & 1);
+          receiver.drawImageRect(image, src, dst, sampling, flags & 1,
+                                 constraint);
+        }
+        break;
+      }
+      case CompactOp::kDrawImageNine: {
+        sk_sp<DlImage> image = LookupObject(images_, reader.ReadVarint());
+        int32_t left = reader.ReadInt();
+        int32_t top = reader.ReadInt();
+        int32_t right = reader.ReadInt();
+        int32_t bottom = reader.ReadInt();
+        SkRect dst = reader.ReadRect();
+        uint32_t flags = reader.ReadVarint();
+        if (draw_needed) {
+          receiver.drawImageNine(image,
+                                 SkIRect::MakeLTRB(left, top, right, bottom),
+                                 dst, static_cast<DlFilterMode>(flags >> 1),
+                                 flags & 1);
+        }
+        break;
+      }
+      case CompactOp::kDrawAtlas: {
+        sk_sp<DlImage> atlas = LookupObject(images_, reader.ReadVarint());
+        uint32_t count = reader.ReadVarint();
+        uint32_t flags = reader.ReadVarint();
+        auto mode = static_cast<DlBlendMode>(reader.ReadVarint());
+        auto sampling = static_cast<DlImageSampling>(reader.ReadVarint());
+        xforms.resize(count);
+        rects.resize(count);
+        colors.resize((flags & 1) ? count : 0);
+        for (uint32_t i = 0; i < count; i++) {
+          SkScalar scos = reader.ReadScalar();
+          SkScalar ssin = reader.ReadScalar();
+          SkScalar tx = reader.ReadScalar();
+          SkScalar ty = reader.ReadScalar();
+          xforms[i] = SkRSXform::Make(scos, ssin, tx, ty);
+          rects[i] = reader.ReadRect();
+          if (flags & 1) {
+            colors[i] = palette_[reader.ReadVarint()];
+          }
+        }
+        SkRect cull_rect;
+        if (flags & 2) {
+          cull_rect = reader.ReadRect();
+        }
+        if (draw_needed) {
+          receiver.drawAtlas(atlas, xforms.data(), rects.data(),
+                             (flags & 1) ? colors.data() : nullptr, count,
+                             mode, sampling,
+                             (flags & 2) ? &cull_rect : nullptr, flags & 4);
+        }
+        break;
+      }
+      case CompactOp::kDrawDisplayList: {
+        sk_sp<DisplayList> display_list =
+            LookupObject(display_lists_, reader.ReadVarint());
+        SkScalar opacity = reader.ReadScalar();
+        if (draw_needed) {
+          receiver.drawDisplayList(display_list, opacity);
+        }
+        break;
+      }
+      case CompactOp::kDrawTextBlob: {
+        sk_sp<SkTextBlob> blob =
+            LookupObject(text_blobs_, reader.ReadVarint());
+        SkPoint point = reader.ReadPoint();
+        if (draw_needed) {
+          receiver.drawTextBlob(blob, point.fX, point.fY);
+        }
+        break;
+      }
+      case CompactOp::kDrawTextFrame: {
+        std::shared_ptr<impeller::TextFrame> text_frame =
+            LookupObject(text_frames_, reader.ReadVarint());
+        SkPoint point = reader.ReadPoint();
+        if (draw_needed) {
+          receiver.drawTextFrame(text_frame, point.fX, point.fY);
+        }
+        break;
+      }
+      case CompactOp::kDrawShadow: {
+        const SkPath& path = paths_[reader.ReadVarint()];
+        DlColor color = palette_[reader.ReadVarint()];
+        SkScalar elevation = reader.ReadScalar();
+        SkScalar dpr = reader.ReadScalar();
+        bool transparent_occluder = reader.ReadBool();
+        if (draw_needed) {
+          receiver.drawShadow(path, color, elevation, transparent_occluder,
+                              dpr);
+        }
+        break;
+      }
+    }
+    culler.update(ctx);
+  }
+  FML_DCHECK(reader.is_done());
+  FML_DCHECK(restore_index == restore_indices_.end());
+}
+
+}  // namespace flutter
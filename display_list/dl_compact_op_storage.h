@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DL_COMPACT_OP_STORAGE_H_
+#define FLUTTER_DISPLAY_LIST_DL_COMPACT_OP_STORAGE_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_color.h"
+#include "flutter/display_list/dl_vertices.h"
+#include "flutter/display_list/effects/dl_color_filter.h"
+#include "flutter/display_list/effects/dl_color_source.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/effects/dl_mask_filter.h"
+#include "flutter/display_list/effects/dl_path_effect.h"
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace impeller {
+class TextFrame;
+}  // namespace impeller
+
+namespace flutter {
+
+struct DispatchContext;
+class DlCompactOpEncoder;
+
+//------------------------------------------------------------------------------
+/// @brief      A byte-compact encoding of the ops of a |DisplayList| that a
+///             |DisplayList| can hold in place of its op records.
+///
+/// A |DisplayList| normally stores each op as an 8-byte aligned record with
+/// a header. This encoding instead stores the ops as a structure of arrays:
+///
+///   - one byte per op holding the op code
+///   - a byte stream of operands in which coordinates and other scalars
+///     that are multiples of 1/16 are written as zigzag varints and
+///     enums, counts and flags are written as varints
+///   - the restore index of each save and saveLayer op
+///   - a palette of the distinct colors used by the ops
+///   - tables of the distinct attribute objects (color sources, filters,
+///     etc.) and of the paths, images, and other ref-counted objects
+///
+/// There is exactly one compact op for each op record of the original list
+/// so the indices stored in the |DlRTree| of the list remain valid and the
+/// compact form can be culled during dispatch just like the op records.
+/// Scalars that are not multiples of 1/16 are stored losslessly.
+///
+/// The encoding is created by |DisplayListBuilder::BuildCompact| for lists
+/// that are retained for a long time or in large numbers, such as the
+/// pictures of scrolling content, where memory footprint matters more than
+/// the cost of decoding the operands.
+class DlCompactOpStorage {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes all of the ops of the |display_list|.
+  ///
+  static std::unique_ptr<const DlCompactOpStorage> Encode(
+      const DisplayList& display_list);
+
+  ~DlCompactOpStorage();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Plays back the ops, skipping the ones that the |culler|
+  ///             marks as not needed in the same way as the op records.
+  ///
+  void Dispatch(DispatchContext& context, Culler& culler) const;
+
+  /// The size of the encoded streams, palette, and object tables.
+  size_t bytes() const;
+
+  uint32_t op_count() const { return static_cast<uint32_t>(ops_.size()); }
+
+  /// Whether the |other| encoding dispatches the same calls as this one.
+  bool Equals(const DlCompactOpStorage& other) const;
+
+  /// A hash that is the same for any two encodings for which |Equals|
+  /// returns true.
+  size_t Hash() const;
+
+ private:
+  DlCompactOpStorage();
+
+  std::vector<uint8_t> ops_;
+  std::vector<uint8_t> operands_;
+  std::vector<uint32_t> restore_indices_;
+  std::vector<DlColor> palette_;
+
+  std::vector<std::shared_ptr<const DlColorSource>> color_sources_;
+  std::vector<std::shared_ptr<const DlColorFilter>> color_filters_;
+  std::vector<std::shared_ptr<const DlImageFilter>> image_filters_;
+  std::vector<std::shared_ptr<const DlPathEffect>> path_effects_;
+  std::vector<std::shared_ptr<const DlMaskFilter>> mask_filters_;
+  std::vector<std::shared_ptr<DlVertices>> vertices_;
+  std::vector<SkPath> paths_;
+  std::vector<sk_sp<DlImage>> images_;
+  std::vector<sk_sp<DisplayList>> display_lists_;
+  std::vector<sk_sp<SkTextBlob>> text_blobs_;
+  std::vector<std::shared_ptr<impeller::TextFrame>> text_frames_;
+
+  friend class DlCompactOpEncoder;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlCompactOpStorage);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DL_COMPACT_OP_STORAGE_H_
@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/dl_compact_op_storage.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/display_list_testing.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Replays the display list through a builder so that lists with different
+// encodings can be compared op for op.
+sk_sp<DisplayList> Rebuild(const sk_sp<DisplayList>& display_list) {
+  DisplayListBuilder builder;
+  display_list->Dispatch(DisplayListBuilderTestingAccessor(builder));
+  return builder.Build();
+}
+
+sk_sp<DisplayList> Rebuild(const sk_sp<DisplayList>& display_list,
+                           const SkRect& cull_rect) {
+  DisplayListBuilder builder;
+  display_list->Dispatch(DisplayListBuilderTestingAccessor(builder),
+                         cull_rect);
+  return builder.Build();
+}
+
+// Simulates the rows of a scrolling list, each with a background, a
+// divider and an icon in one of a few colors.
+void DrawRows(DisplayListBuilder& builder, int rows) {
+  DlPaint background = DlPaint(DlColor::kWhite());
+  DlPaint divider = DlPaint(DlColor::kLightGrey())
+                        .setDrawStyle(DlDrawStyle::kStroke)
+                        .setStrokeWidth(1.0f);
+  for (int row = 0; row < rows; row++) {
+    SkScalar top = row * 48.0f;
+    builder.Save();
+    builder.Translate(0, top);
+    builder.ClipRect(SkRect::MakeWH(400, 48));
+    builder.DrawRect(SkRect::MakeWH(400, 48), background);
+    builder.DrawLine({16, 47.5f}, {384, 47.5f}, divider);
+    DlPaint icon = DlPaint(row % 3 == 0   ? DlColor::kRed()
+                           : row % 3 == 1 ? DlColor::kGreen()
+                                          : DlColor::kBlue())
+                       .setAntiAlias(true);
+    builder.DrawCircle({40, 24}, 12, icon);
+    builder.Restore();
+  }
+}
+
+}  // namespace
+
+TEST(DlCompactOpStorage, RoundTripsAllOps) {
+  for (DisplayListInvocationGroup& group : CreateAllGroups()) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      DisplayListInvocation& invocation = group.variants[i];
+      DisplayListBuilder builder;
+      invocation.Invoke(DisplayListBuilderTestingAccessor(builder));
+      sk_sp<DisplayList> display_list = builder.Build();
+      DisplayListBuilder compact_builder;
+      invocation.Invoke(DisplayListBuilderTestingAccessor(compact_builder));
+      sk_sp<DisplayList> compact = compact_builder.BuildCompact();
+
+      EXPECT_EQ(compact->op_count(), display_list->op_count())
+          << group.op_name << " variant " << (i + 1);
+      EXPECT_EQ(compact->bounds(), display_list->bounds())
+          << group.op_name << " variant " << (i + 1);
+      EXPECT_TRUE(DisplayListsEQ_Verbose(Rebuild(display_list),
+                                         Rebuild(compact)))
+          << group.op_name << " variant " << (i + 1);
+    }
+  }
+}
+
+TEST(DlCompactOpStorage, RoundTripsScalarsExactly) {
+  const SkScalar values[] = {
+      0.0f,   -0.0f,     1.0f,     -1.0f,  0.5f,        1.0f / 16,
+      0.1f,   1.0f / 3,  1e6f,     -1e6f,  65535.9375f, 1048576.0f,
+      3e-40f, SK_ScalarInfinity,  -SK_ScalarInfinity,
+  };
+  auto record = [&values](DlOpReceiver& receiver) {
+    for (SkScalar value : values) {
+      receiver.drawRect(SkRect::MakeLTRB(value, -value, value + 1, value * 2));
+      receiver.translate(value, 1.0f);
+    }
+  };
+  DisplayListBuilder builder;
+  record(DisplayListBuilderTestingAccessor(builder));
+  DisplayListBuilder compact_builder;
+  record(DisplayListBuilderTestingAccessor(compact_builder));
+
+  EXPECT_TRUE(DisplayListsEQ_Verbose(Rebuild(builder.Build()),
+                                     Rebuild(compact_builder.BuildCompact())));
+}
+
+TEST(DlCompactOpStorage, CullsLikeOpRecords) {
+  DisplayListBuilder builder(/*prepare_rtree=*/true);
+  DrawRows(builder, 50);
+  sk_sp<DisplayList> display_list = builder.Build();
+  DisplayListBuilder compact_builder(/*prepare_rtree=*/true);
+  DrawRows(compact_builder, 50);
+  sk_sp<DisplayList> compact = compact_builder.BuildCompact();
+  ASSERT_TRUE(compact->has_rtree());
+
+  const SkRect cull_rects[] = {
+      SkRect::MakeLTRB(0, 0, 400, 10),
+      SkRect::MakeLTRB(30, 500, 50, 700),
+      SkRect::MakeLTRB(0, 1000, 400, 1100),
+      SkRect::MakeLTRB(500, 0, 600, 100),
+  };
+  for (const SkRect& cull_rect : cull_rects) {
+    sk_sp<DisplayList> expected = Rebuild(display_list, cull_rect);
+    EXPECT_LT(expected->op_count(), display_list->op_count());
+    EXPECT_TRUE(
+        DisplayListsEQ_Verbose(expected, Rebuild(compact, cull_rect)));
+  }
+}
+
+TEST(DlCompactOpStorage, RepeatedContentIsSmallerThanOpRecords) {
+  DisplayListBuilder builder;
+  DrawRows(builder, 200);
+  sk_sp<DisplayList> display_list = builder.Build();
+  DisplayListBuilder compact_builder;
+  DrawRows(compact_builder, 200);
+  sk_sp<DisplayList> compact = compact_builder.BuildCompact();
+
+  EXPECT_LT(compact->bytes(false), display_list->bytes(false) / 2);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(Rebuild(display_list), Rebuild(compact)));
+}
+
+TEST(DlCompactOpStorage, EqualContentHasEqualHash) {
+  DisplayListBuilder builder1;
+  DrawRows(builder1, 10);
+  sk_sp<DisplayList> compact1 = builder1.BuildCompact();
+  DisplayListBuilder builder2;
+  DrawRows(builder2, 10);
+  sk_sp<DisplayList> compact2 = builder2.BuildCompact();
+  DisplayListBuilder builder3;
+  DrawRows(builder3, 11);
+  sk_sp<DisplayList> compact3 = builder3.BuildCompact();
+
+  EXPECT_TRUE(compact1->Equals(compact2));
+  EXPECT_EQ(compact1->content_hash(), compact2->content_hash());
+  EXPECT_FALSE(compact1->Equals(compact3));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -58,6 +58,16 @@ struct DispatchContext {
   std::vector<SaveInfo> save_infos;
 };
 
+// Decides which rendering ops are dispatched by moving the
+// |next_render_index| of a |DispatchContext| forward as the ops are
+// played back. |init| returns false if no op needs to be dispatched.
+class Culler {
+ public:
+  virtual ~Culler() = default;
+  virtual bool init(DispatchContext& context) = 0;
+  virtual void update(DispatchContext& context) = 0;
+};
+
 // Most Ops can be bulk compared using memcmp because they contain
 // only numeric values or constructs that are constructed from numeric
 // values.
@@ -252,12 +252,16 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
   // setRects can only be called on empty regions.
   FML_DCHECK(lines_.empty());
 
-  size_t count = unsorted_rects.size();
-  std::vector<const SkIRect*> rects(count);
-  for (size_t i = 0; i < count; i++) {
-    rects[i] = &unsorted_rects[i];
-    bounds_.join(unsorted_rects[i]);
+  // Empty rects contribute no spans and are dropped up front.
+  std::vector<const SkIRect*> rects;
+  rects.reserve(unsorted_rects.size());
+  for (const SkIRect& rect : unsorted_rects) {
+    if (!rect.isEmpty()) {
+      rects.push_back(&rect);
+      bounds_.join(rect);
+    }
   }
+  size_t count = rects.size();
   std::sort(rects.begin(), rects.end(), [](const SkIRect* a, const SkIRect* b) {
     if (a->top() < b->top()) {
       return true;
@@ -304,9 +308,6 @@ void DlRegion::setRects(const std::vector<SkIRect>& unsorted_rects) {
     // Next, insert any new rects we've reached into the active list
     while (next_rect < count) {
       const SkIRect* r = rects[next_rect];
-      if (r->isEmpty()) {
-        continue;
-      }
       if (r->top() > cur_y) {
         break;
       }
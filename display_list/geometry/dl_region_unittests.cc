@@ -25,6 +25,14 @@ TEST(DisplayListRegion, SingleRectangle) {
   EXPECT_EQ(rects.front(), SkIRect::MakeLTRB(10, 10, 50, 50));
 }
 
+TEST(DisplayListRegion, EmptyRectanglesAreIgnored) {
+  DlRegion region({SkIRect::MakeLTRB(10, 10, 10, 50),
+                   SkIRect::MakeLTRB(10, 10, 50, 50), SkIRect::MakeEmpty()});
+  auto rects = region.getRects();
+  ASSERT_EQ(rects.size(), 1u);
+  EXPECT_EQ(rects.front(), SkIRect::MakeLTRB(10, 10, 50, 50));
+}
+
 TEST(DisplayListRegion, NonOverlappingRectangles1) {
   std::vector<SkIRect> rects_in;
   for (int i = 0; i < 10; ++i) {
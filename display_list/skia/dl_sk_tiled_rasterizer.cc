@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
+
+#include <algorithm>
+
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/fml/parallel_for.h"
+#include "flutter/fml/trace_event.h"
+
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+
+namespace {
+
+void RenderTile(const DisplayList& display_list,
+                const SkPixmap& pixels,
+                const SkIRect& tile) {
+  TRACE_EVENT0("flutter", "DlSkTiledRasterizer::RenderTile");
+  SkPixmap tile_pixels;
+  if (!pixels.extractSubset(&tile_pixels, tile)) {
+    return;
+  }
+  std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+      tile_pixels.info(), tile_pixels.writable_addr(), tile_pixels.rowBytes());
+  if (!canvas) {
+    return;
+  }
+  canvas->translate(-tile.fLeft, -tile.fTop);
+  DlSkCanvasDispatcher dispatcher(canvas.get());
+  display_list.Dispatch(dispatcher, tile);
+}
+
+}  // namespace
+
+DlSkTiledRasterizer::DlSkTiledRasterizer(
+    std::shared_ptr<fml::BasicTaskRunner> worker_runner,
+    size_t worker_count,
+    int tile_size)
+    : worker_runner_(std::move(worker_runner)),
+      worker_count_(worker_runner_ ? worker_count : 0),
+      tile_size_(std::max(tile_size, 1)) {}
+
+DlSkTiledRasterizer::~DlSkTiledRasterizer() = default;
+
+std::vector<SkIRect> DlSkTiledRasterizer::ComputeTiles(const SkISize& size,
+                                                       int tile_size) {
+  std::vector<SkIRect> tiles;
+  if (size.isEmpty() || tile_size <= 0) {
+    return tiles;
+  }
+  for (int top = 0; top < size.height(); top += tile_size) {
+    int bottom = std::min(top + tile_size, size.height());
+    for (int left = 0; left < size.width(); left += tile_size) {
+      int right = std::min(left + tile_size, size.width());
+      tiles.push_back(SkIRect::MakeLTRB(left, top, right, bottom));
+    }
+  }
+  return tiles;
+}
+
+bool DlSkTiledRasterizer::Rasterize(const sk_sp<DisplayList>& display_list,
+                                    const SkPixmap& pixels) const {
+  TRACE_EVENT0("flutter", "DlSkTiledRasterizer::Rasterize");
+  if (!display_list || pixels.addr() == nullptr) {
+    return false;
+  }
+
+  std::vector<SkIRect> tiles = ComputeTiles(pixels.dimensions(), tile_size_);
+  if (worker_count_ == 0 || tiles.size() < 2 ||
+      display_list->has_backdrop_filter()) {
+    std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+        pixels.info(), pixels.writable_addr(), pixels.rowBytes());
+    if (!canvas) {
+      return false;
+    }
+    DlSkCanvasDispatcher dispatcher(canvas.get());
+    display_list->Dispatch(dispatcher);
+    return true;
+  }
+
+  fml::ParallelFor(worker_runner_, worker_count_, tiles.size(),
+                   [&display_list, &pixels, &tiles](size_t index) {
+                     RenderTile(*display_list, pixels, tiles[index]);
+                   });
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_SKIA_DL_SK_TILED_RASTERIZER_H_
+#define FLUTTER_DISPLAY_LIST_SKIA_DL_SK_TILED_RASTERIZER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Rasterizes a |DisplayList| into CPU memory by splitting the
+///             target into a grid of tiles and rendering the tiles in
+///             parallel.
+///
+///             Each tile is rendered through its own |SkCanvas| that wraps
+///             the tile's subset of the destination pixels, so the workers
+///             never write to the same memory. When the |DisplayList| has an
+///             |DlRTree|, each tile only dispatches the ops that intersect
+///             it.
+///
+///             DisplayLists that contain a backdrop filter are always
+///             rendered serially since the filter would sample pixels that
+///             belong to neighboring tiles.
+///
+class DlSkTiledRasterizer {
+ public:
+  static constexpr int kDefaultTileSize = 256;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  worker_runner  The runner on which tiles are rendered in
+  ///                            addition to the calling thread. Typically the
+  ///                            concurrent worker task runner. If null, all
+  ///                            rendering happens on the calling thread.
+  /// @param[in]  worker_count   The maximum number of tasks posted to the
+  ///                            worker runner for a single frame.
+  /// @param[in]  tile_size      The edge length of each tile in pixels.
+  ///
+  DlSkTiledRasterizer(std::shared_ptr<fml::BasicTaskRunner> worker_runner,
+                      size_t worker_count,
+                      int tile_size = kDefaultTileSize);
+
+  ~DlSkTiledRasterizer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the display list into the pixels. Returns once every
+  ///             tile has been rendered.
+  ///
+  /// @return     Whether the pixels could be wrapped by a raster canvas.
+  ///
+  bool Rasterize(const sk_sp<DisplayList>& display_list,
+                 const SkPixmap& pixels) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Splits the bounds of a surface of the given size into a
+  ///             row-major list of tiles no larger than tile_size on each
+  ///             side.
+  ///
+  static std::vector<SkIRect> ComputeTiles(const SkISize& size, int tile_size);
+
+ private:
+  const std::shared_ptr<fml::BasicTaskRunner> worker_runner_;
+  const size_t worker_count_;
+  const int tile_size_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlSkTiledRasterizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_SKIA_DL_SK_TILED_RASTERIZER_H_
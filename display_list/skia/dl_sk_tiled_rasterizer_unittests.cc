@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_paint.h"
+#include "flutter/display_list/effects/dl_image_filter.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "gtest/gtest.h"
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DisplayList> MakeTestDisplayList(bool with_backdrop) {
+  DisplayListBuilder builder(SkRect::MakeWH(300, 200), /*prepare_rtree=*/true);
+  builder.DrawColor(DlColor::kWhite(), DlBlendMode::kSrc);
+  DlPaint paint;
+  for (int i = 0; i < 20; i++) {
+    paint.setColor(DlColor(0xFF000000 | (i * 0x0C0703)));
+    builder.DrawRect(SkRect::MakeXYWH(i * 13.5f, i * 9.25f, 40, 30), paint);
+  }
+  paint.setColor(DlColor::kBlue());
+  paint.setAntiAlias(true);
+  builder.DrawCircle({150, 100}, 70, paint);
+  if (with_backdrop) {
+    DlBlurImageFilter blur(5, 5, DlTileMode::kClamp);
+    builder.SaveLayer(nullptr, nullptr, &blur);
+    builder.Restore();
+  }
+  return builder.Build();
+}
+
+SkBitmap RenderSerially(const sk_sp<DisplayList>& display_list) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(300, 200);
+  SkCanvas canvas(bitmap);
+  DlSkCanvasDispatcher dispatcher(&canvas);
+  display_list->Dispatch(dispatcher);
+  return bitmap;
+}
+
+void ExpectSamePixels(const SkBitmap& a, const SkBitmap& b) {
+  ASSERT_EQ(a.dimensions(), b.dimensions());
+  for (int y = 0; y < a.height(); y++) {
+    for (int x = 0; x < a.width(); x++) {
+      ASSERT_EQ(a.getColor(x, y), b.getColor(x, y)) << "at " << x << ", " << y;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(DlSkTiledRasterizer, ComputeTilesCoversSurface) {
+  auto tiles = DlSkTiledRasterizer::ComputeTiles(SkISize::Make(300, 200), 128);
+  ASSERT_EQ(tiles.size(), 6u);
+  EXPECT_EQ(tiles[0], SkIRect::MakeLTRB(0, 0, 128, 128));
+  EXPECT_EQ(tiles[2], SkIRect::MakeLTRB(256, 0, 300, 128));
+  EXPECT_EQ(tiles[5], SkIRect::MakeLTRB(256, 128, 300, 200));
+
+  EXPECT_TRUE(
+      DlSkTiledRasterizer::ComputeTiles(SkISize::Make(0, 200), 128).empty());
+  EXPECT_TRUE(
+      DlSkTiledRasterizer::ComputeTiles(SkISize::Make(300, 200), 0).empty());
+}
+
+TEST(DlSkTiledRasterizer, TiledOutputMatchesSerialOutput) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  DlSkTiledRasterizer rasterizer(loop->GetTaskRunner(), 4, 64);
+
+  auto display_list = MakeTestDisplayList(false);
+  ASSERT_TRUE(display_list->has_rtree());
+  ASSERT_FALSE(display_list->has_backdrop_filter());
+
+  SkBitmap tiled;
+  tiled.allocN32Pixels(300, 200);
+  ASSERT_TRUE(rasterizer.Rasterize(display_list, tiled.pixmap()));
+
+  ExpectSamePixels(tiled, RenderSerially(display_list));
+}
+
+TEST(DlSkTiledRasterizer, RendersOnCallingThreadWithoutWorkers) {
+  DlSkTiledRasterizer rasterizer(nullptr, 4, 64);
+
+  auto display_list = MakeTestDisplayList(false);
+  SkBitmap tiled;
+  tiled.allocN32Pixels(300, 200);
+  ASSERT_TRUE(rasterizer.Rasterize(display_list, tiled.pixmap()));
+
+  ExpectSamePixels(tiled, RenderSerially(display_list));
+}
+
+TEST(DlSkTiledRasterizer, BackdropFilterRendersUntiled) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  DlSkTiledRasterizer rasterizer(loop->GetTaskRunner(), 4, 64);
+
+  auto display_list = MakeTestDisplayList(true);
+  ASSERT_TRUE(display_list->has_backdrop_filter());
+
+  SkBitmap tiled;
+  tiled.allocN32Pixels(300, 200);
+  ASSERT_TRUE(rasterizer.Rasterize(display_list, tiled.pixmap()));
+
+  ExpectSamePixels(tiled, RenderSerially(display_list));
+}
+
+}  // namespace testing
+}  // namespace flutter
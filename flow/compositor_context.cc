@@ -6,8 +6,10 @@
 
 #include <optional>
 #include <utility>
+#include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPath.h"
 
 namespace flutter {
 
@@ -20,7 +22,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     DiffContext context(layer_tree.frame_size(), layer_tree.paint_region_map(),
                         prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
                                          : empty_paint_region_map,
-                        has_raster_cache, impeller_enabled);
+                        has_raster_cache, impeller_enabled, worker_runner_);
     context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
                                          layer_tree.frame_size().height()));
     {
@@ -39,8 +41,9 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
     }
 
     damage_ =
-        context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
-                              vertical_clip_alignment_);
+        context.ComputeDamage(DlRegion(additional_damage_),
+                              horizontal_clip_alignment_,
+                              vertical_clip_alignment_, max_damage_rects_);
     return SkRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
@@ -122,6 +125,8 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 
   std::optional<SkRect> clip_rect;
   if (frame_damage) {
+    ScopedRasterPhaseTimer diff_timer(frame_timings_recorder_,
+                                      FrameTiming::kDiff);
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
 
@@ -132,8 +137,13 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     }
   }
 
-  bool root_needs_readback = layer_tree.Preroll(
-      *this, ignore_raster_cache, clip_rect ? *clip_rect : kGiantRect);
+  bool root_needs_readback;
+  {
+    ScopedRasterPhaseTimer preroll_timer(frame_timings_recorder_,
+                                         FrameTiming::kPreroll);
+    root_needs_readback = layer_tree.Preroll(
+        *this, ignore_raster_cache, clip_rect ? *clip_rect : kGiantRect);
+  }
   bool needs_save_layer = root_needs_readback && !surface_supports_readback();
   PostPrerollResult post_preroll_result = PostPrerollResult::kSuccess;
   if (view_embedder_ && raster_thread_merger_) {
@@ -151,8 +161,10 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (aiks_context_) {
     PaintLayerTreeImpeller(layer_tree, clip_rect, ignore_raster_cache);
   } else {
-    PaintLayerTreeSkia(layer_tree, clip_rect, needs_save_layer,
-                       ignore_raster_cache);
+    PaintLayerTreeSkia(layer_tree, clip_rect,
+                       clip_rect ? frame_damage->GetBufferDamageRects()
+                                 : std::vector<SkIRect>(),
+                       needs_save_layer, ignore_raster_cache);
   }
   return RasterStatus::kSuccess;
 }
@@ -160,6 +172,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 void CompositorContext::ScopedFrame::PaintLayerTreeSkia(
     flutter::LayerTree& layer_tree,
     std::optional<SkRect> clip_rect,
+    const std::vector<SkIRect>& clip_rects,
     bool needs_save_layer,
     bool ignore_raster_cache) {
   DlAutoCanvasRestore restore(canvas(), clip_rect.has_value());
@@ -168,6 +181,15 @@ void CompositorContext::ScopedFrame::PaintLayerTreeSkia(
     if (clip_rect) {
       canvas()->ClipRect(*clip_rect);
     }
+    if (clip_rects.size() > 1) {
+      // The clip rect culls layers outside of the damage bounds, the rects
+      // avoid repainting the area between them.
+      SkPath path;
+      for (const SkIRect& rect : clip_rects) {
+        path.addRect(SkRect::Make(rect));
+      }
+      canvas()->ClipPath(path);
+    }
 
     if (needs_save_layer) {
       TRACE_EVENT0("flutter", "Canvas::saveLayer");
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/texture.h"
 #include "flutter/flow/diff_context.h"
@@ -21,6 +22,7 @@
 
 namespace flutter {
 
+class FrameTimingsRecorder;
 class LayerTree;
 
 // The result status of CompositorContext::ScopedFrame::Raster.
@@ -58,7 +60,15 @@ class FrameDamage {
   // Adds additional damage (accumulated for double / triple buffering).
   // This is area that will be repainted alongside any changed part.
   void AddAdditionalDamage(const SkIRect& damage) {
-    additional_damage_.join(damage);
+    if (!damage.isEmpty()) {
+      additional_damage_.push_back(damage);
+    }
+  }
+
+  // Sets the most rects that frame and buffer damage may each be split into.
+  // Defaults to a single rect bounding all of the damage.
+  void SetMaxDamageRects(size_t max_damage_rects) {
+    max_damage_rects_ = max_damage_rects;
   }
 
   // Specifies clip rect alignment.
@@ -67,6 +77,12 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Sets the runner on which sibling subtrees may be diffed in parallel. If
+  // not set, the layer tree is diffed on the calling thread.
+  void SetWorkerTaskRunner(std::shared_ptr<fml::BasicTaskRunner> runner) {
+    worker_runner_ = std::move(runner);
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
@@ -88,6 +104,17 @@ class FrameDamage {
                : std::nullopt;
   }
 
+  // See Damage::frame_damage_rects.
+  std::vector<SkIRect> GetFrameDamageRects() const {
+    return damage_ ? damage_->frame_damage_rects : std::vector<SkIRect>();
+  }
+
+  // See Damage::buffer_damage_rects.
+  std::vector<SkIRect> GetBufferDamageRects() const {
+    return (damage_ && !ignore_damage_) ? damage_->buffer_damage_rects
+                                        : std::vector<SkIRect>();
+  }
+
   // Remove reported buffer_damage to inform clients that a partial repaint
   // should not be performed on this frame.
   // frame_damage is required to correctly track accumulated damage for
@@ -95,12 +122,14 @@ class FrameDamage {
   void Reset() { ignore_damage_ = true; }
 
  private:
-  SkIRect additional_damage_ = SkIRect::MakeEmpty();
+  std::vector<SkIRect> additional_damage_;
   std::optional<Damage> damage_;
+  size_t max_damage_rects_ = 1;
   const LayerTree* prev_layer_tree_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
   bool ignore_damage_ = false;
+  std::shared_ptr<fml::BasicTaskRunner> worker_runner_;
 };
 
 class CompositorContext {
@@ -135,6 +164,16 @@ class CompositorContext {
 
     impeller::AiksContext* aiks_context() const { return aiks_context_; }
 
+    /// The recorder that the durations of the raster phases of the frame are
+    /// added to, or null if they are not recorded.
+    FrameTimingsRecorder* frame_timings_recorder() const {
+      return frame_timings_recorder_;
+    }
+
+    void set_frame_timings_recorder(FrameTimingsRecorder* recorder) {
+      frame_timings_recorder_ = recorder;
+    }
+
     virtual RasterStatus Raster(LayerTree& layer_tree,
                                 bool ignore_raster_cache,
                                 FrameDamage* frame_damage);
@@ -142,6 +181,7 @@ class CompositorContext {
    private:
     void PaintLayerTreeSkia(flutter::LayerTree& layer_tree,
                             std::optional<SkRect> clip_rect,
+                            const std::vector<SkIRect>& clip_rects,
                             bool needs_save_layer,
                             bool ignore_raster_cache);
 
@@ -158,6 +198,7 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    FrameTimingsRecorder* frame_timings_recorder_ = nullptr;
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -3,22 +3,118 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/diff_context.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
+#include "flutter/fml/parallel_for.h"
+#include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+PaintRegionMap::PaintRegionMap() : table_(std::make_shared<Table>()) {}
+
+size_t PaintRegionMap::GetRegionCount() const {
+  size_t count = 0;
+  std::set<const Table*> visited;
+  std::vector<const Table*> pending = {table_.get()};
+  while (!pending.empty()) {
+    const Table* table = pending.back();
+    pending.pop_back();
+    if (!visited.insert(table).second) {
+      continue;
+    }
+    count += table->regions.size();
+    for (const auto& [id, subtree] : table->retained_subtrees) {
+      pending.push_back(subtree.get());
+    }
+  }
+  return count;
+}
+
 DiffContext::DiffContext(SkISize frame_size,
                          PaintRegionMap& this_frame_paint_region_map,
                          const PaintRegionMap& last_frame_paint_region_map,
                          bool has_raster_cache,
-                         bool impeller_enabled)
+                         bool impeller_enabled,
+                         std::shared_ptr<fml::BasicTaskRunner> worker_runner)
     : clip_tracker_(DisplayListMatrixClipTracker(kGiantRect, SkMatrix::I())),
       rects_(std::make_shared<std::vector<SkRect>>()),
       frame_size_(frame_size),
-      this_frame_paint_region_map_(this_frame_paint_region_map),
-      last_frame_paint_region_map_(last_frame_paint_region_map),
+      this_frame_paint_regions_(this_frame_paint_region_map.table_),
+      old_paint_regions_({last_frame_paint_region_map.table_}),
       has_raster_cache_(has_raster_cache),
-      impeller_enabled_(impeller_enabled) {}
+      impeller_enabled_(impeller_enabled),
+      worker_runner_(std::move(worker_runner)) {}
+
+DiffContext::DiffContext(const DiffContext* parent)
+    : clip_tracker_(parent->clip_tracker_.device_cull_rect(),
+                    parent->clip_tracker_.matrix_4x4()),
+      rects_(std::make_shared<std::vector<SkRect>>()),
+      state_(parent->state_),
+      frame_size_(parent->frame_size_),
+      filter_bounds_adjustment_stack_(parent->filter_bounds_adjustment_stack_),
+      this_frame_paint_regions_(std::make_shared<PaintRegionMap::Table>()),
+      old_paint_regions_(parent->old_paint_regions_),
+      has_raster_cache_(parent->has_raster_cache_),
+      impeller_enabled_(parent->impeller_enabled_) {
+  // The fork only ever ends the subtrees it begins itself.
+  state_.rect_index = 0;
+  state_.clip_tracker_save_count = clip_tracker_.getSaveCount();
+  state_.has_filter_bounds_adjustment = false;
+  state_.has_texture = false;
+}
+
+void DiffContext::MergeFork(const DiffContext& fork) {
+  FML_DCHECK(fork.state_stack_.empty());
+  size_t offset = rects_->size();
+  rects_->insert(rects_->end(), fork.rects_->begin(), fork.rects_->end());
+  for (Readback readback : fork.readbacks_) {
+    readback.position += offset;
+    readbacks_.push_back(readback);
+  }
+  damage_.join(fork.damage_);
+  damage_rects_.insert(damage_rects_.end(), fork.damage_rects_.begin(),
+                       fork.damage_rects_.end());
+  if (fork.state_.has_texture) {
+    MarkSubtreeHasTextureLayer();
+  }
+  // The paint regions recorded by the fork refer to the rects of the fork,
+  // which they keep alive.
+  for (const auto& [id, region] : fork.this_frame_paint_regions_->regions) {
+    this_frame_paint_regions_->regions[id] = region;
+  }
+  for (const auto& [id, table] :
+       fork.this_frame_paint_regions_->retained_subtrees) {
+    this_frame_paint_regions_->retained_subtrees[id] = table;
+  }
+  statistics_.Merge(fork.statistics_);
+}
+
+void DiffContext::DiffSiblings(size_t count,
+                               size_t diffed_count,
+                               const SiblingDiff& diff) {
+  if (!worker_runner_ || diffed_count < kMinSiblingsForParallelDiff) {
+    for (size_t i = 0; i < count; i++) {
+      diff(this, i);
+    }
+    return;
+  }
+
+  TRACE_EVENT0("flutter", "DiffContext::DiffSiblings");
+  std::vector<std::unique_ptr<DiffContext>> forks(count);
+  fml::ParallelFor(worker_runner_, kMaxSiblingDiffHelpers, count,
+                   [this, &forks, &diff](size_t index) {
+                     forks[index].reset(new DiffContext(this));
+                     diff(forks[index].get(), index);
+                   });
+  for (const auto& fork : forks) {
+    MergeFork(*fork);
+  }
+}
 
 void DiffContext::BeginSubtree() {
   state_stack_.push_back(state_);
@@ -109,9 +205,128 @@ void DiffContext::AlignRect(SkIRect& rect,
   rect = SkIRect::MakeLTRB(left, top, right, bottom);
 }
 
-Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
+namespace {
+
+// Past this many rects, damage is reduced to its bounds rather than merged
+// pair by pair, which is quadratic in the number of rects.
+constexpr size_t kMaxDamageRectsToMerge = 64;
+
+// Merges rects until at most |max_rects| remain and none of them overlap.
+// Overlapping rects are merged first, then the pair whose bounds add the
+// least area over the rects themselves.
+std::vector<SkIRect> MergeDamageRects(std::vector<SkIRect> rects,
+                                      size_t max_rects) {
+  if (rects.size() > kMaxDamageRectsToMerge) {
+    SkIRect bounds = SkIRect::MakeEmpty();
+    for (const SkIRect& rect : rects) {
+      bounds.join(rect);
+    }
+    return {bounds};
+  }
+  while (rects.size() > 1) {
+    size_t best_i = 0;
+    size_t best_j = 0;
+    bool best_overlaps = false;
+    int64_t best_cost = std::numeric_limits<int64_t>::max();
+    for (size_t i = 0; i < rects.size(); i++) {
+      for (size_t j = i + 1; j < rects.size(); j++) {
+        bool overlaps = SkIRect::Intersects(rects[i], rects[j]);
+        if (best_overlaps && !overlaps) {
+          continue;
+        }
+        SkIRect merged = rects[i];
+        merged.join(rects[j]);
+        int64_t cost = merged.height64() * merged.width64() -
+                       rects[i].height64() * rects[i].width64() -
+                       rects[j].height64() * rects[j].width64();
+        if ((overlaps && !best_overlaps) || cost < best_cost) {
+          best_i = i;
+          best_j = j;
+          best_overlaps = overlaps;
+          best_cost = cost;
+        }
+      }
+    }
+    if (rects.size() <= max_rects && !best_overlaps) {
+      break;
+    }
+    rects[best_i].join(rects[best_j]);
+    rects.erase(rects.begin() + best_j);
+  }
+  return rects;
+}
+
+}  // namespace
+
+Damage DiffContext::ComputeDamage(const DlRegion& additional_damage,
                                   int horizontal_clip_alignment,
-                                  int vertical_clip_alignment) const {
+                                  int vertical_clip_alignment,
+                                  size_t max_damage_rects) const {
+  if (max_damage_rects <= 1 || frame_size_.isEmpty()) {
+    return ComputeBoundingDamage(additional_damage.bounds(),
+                                 horizontal_clip_alignment,
+                                 vertical_clip_alignment);
+  }
+
+  SkIRect frame_clip = SkIRect::MakeSize(frame_size_);
+  std::vector<SkIRect> frame_rects;
+  frame_rects.reserve(damage_rects_.size());
+  for (const SkRect& rect : damage_rects_) {
+    SkIRect frame_rect = rect.roundOut();
+    if (frame_rect.intersect(frame_clip)) {
+      frame_rects.push_back(frame_rect);
+    }
+  }
+  DlRegion frame_damage(frame_rects);
+
+  std::vector<SkIRect> readback_rects;
+  for (const auto& r : readbacks_) {
+    // Changes either in readback or paint rect require repainting both readback
+    // and paint rect.
+    if (frame_damage.intersects(r.paint_rect) ||
+        frame_damage.intersects(r.readback_rect)) {
+      std::vector<SkIRect> rects;
+      for (SkIRect rect : {r.readback_rect, r.paint_rect}) {
+        if (rect.intersect(frame_clip)) {
+          rects.push_back(rect);
+        }
+      }
+      frame_damage = DlRegion::MakeUnion(frame_damage, DlRegion(rects));
+    }
+  }
+
+  DlRegion buffer_damage = DlRegion::MakeUnion(
+      frame_damage,
+      DlRegion::MakeIntersection(additional_damage, DlRegion(frame_clip)));
+
+  auto to_rects = [&](const DlRegion& region) {
+    std::vector<SkIRect> rects = region.getRects();
+    if (horizontal_clip_alignment > 1 || vertical_clip_alignment > 1) {
+      for (SkIRect& rect : rects) {
+        AlignRect(rect, horizontal_clip_alignment, vertical_clip_alignment);
+      }
+    }
+    return MergeDamageRects(std::move(rects), max_damage_rects);
+  };
+
+  Damage res;
+  res.frame_damage_rects = to_rects(frame_damage);
+  res.buffer_damage_rects = to_rects(buffer_damage);
+  res.frame_damage = SkIRect::MakeEmpty();
+  for (const SkIRect& rect : res.frame_damage_rects) {
+    res.frame_damage.join(rect);
+  }
+  res.buffer_damage = SkIRect::MakeEmpty();
+  for (const SkIRect& rect : res.buffer_damage_rects) {
+    res.buffer_damage.join(rect);
+  }
+  return res;
+}
+
+Damage DiffContext::ComputeBoundingDamage(
+    const SkIRect& accumulated_buffer_damage,
+    int horizontal_clip_alignment,
+    int vertical_clip_alignment) const {
   SkRect buffer_damage = SkRect::Make(accumulated_buffer_damage);
   buffer_damage.join(damage_);
   SkRect frame_damage(damage_);
@@ -144,6 +359,12 @@ Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
     AlignRect(res.frame_damage, horizontal_clip_alignment,
               vertical_clip_alignment);
   }
+  if (!res.frame_damage.isEmpty()) {
+    res.frame_damage_rects.push_back(res.frame_damage);
+  }
+  if (!res.buffer_damage.isEmpty()) {
+    res.buffer_damage_rects.push_back(res.buffer_damage);
+  }
   return res;
 }
 
@@ -240,30 +461,124 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    AddDamage(r);
   }
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
   damage_.join(rect);
+  if (!rect.isEmpty()) {
+    damage_rects_.push_back(rect);
+  }
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
                                       const PaintRegion& region) {
-  this_frame_paint_region_map_[layer->unique_id()] = region;
+  this_frame_paint_regions_->regions[layer->unique_id()] = region;
+}
+
+PaintRegion DiffContext::FindOldLayerPaintRegion(
+    const Layer* layer,
+    std::shared_ptr<const PaintRegionMap::Table>* table) const {
+  for (auto i = old_paint_regions_.rbegin(); i != old_paint_regions_.rend();
+       ++i) {
+    auto region = (*i)->regions.find(layer->unique_id());
+    if (region != (*i)->regions.end()) {
+      *table = *i;
+      return region->second;
+    }
+  }
+  // This is valid when Layer::PreservePaintRegion is called for retained
+  // layer with zero sized parent clip (these layers are not diffed)
+  return PaintRegion();
 }
 
 PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
-  auto i = last_frame_paint_region_map_.find(layer->unique_id());
-  if (i != last_frame_paint_region_map_.end()) {
-    return i->second;
-  } else {
-    // This is valid when Layer::PreservePaintRegion is called for retained
-    // layer with zero sized parent clip (these layers are not diffed)
-    return PaintRegion();
+  std::shared_ptr<const PaintRegionMap::Table> table;
+  return FindOldLayerPaintRegion(layer, &table);
+}
+
+void DiffContext::PreserveSubtreePaintRegion(const Layer* layer) {
+  std::shared_ptr<const PaintRegionMap::Table> table;
+  this_frame_paint_regions_->regions[layer->unique_id()] =
+      FindOldLayerPaintRegion(layer, &table);
+  if (!table) {
+    return;
+  }
+  // If the layer was already retained in that frame, its descendants have a
+  // table of their own.
+  auto retained = table->retained_subtrees.find(layer->unique_id());
+  if (retained != table->retained_subtrees.end()) {
+    this_frame_paint_regions_->retained_subtrees[layer->unique_id()] =
+        retained->second;
+    return;
+  }
+  // Otherwise they are in the table of the whole frame that diffed them.
+  // Copying them out lets that table be released along with its frame.
+  auto subtree = std::make_shared<PaintRegionMap::Table>();
+  CopySubtreePaintRegions(layer, *table, subtree.get());
+  this_frame_paint_regions_->retained_subtrees[layer->unique_id()] =
+      std::move(subtree);
+}
+
+void DiffContext::CopySubtreePaintRegions(const Layer* layer,
+                                          const PaintRegionMap::Table& source,
+                                          PaintRegionMap::Table* subtree) {
+  const ContainerLayer* container = layer->as_container_layer();
+  if (!container) {
+    return;
+  }
+  for (const auto& child : container->layers()) {
+    const uint64_t id = child->unique_id();
+    auto region = source.regions.find(id);
+    if (region != source.regions.end()) {
+      subtree->regions[id] = region->second;
+    }
+    auto retained = source.retained_subtrees.find(id);
+    if (retained != source.retained_subtrees.end()) {
+      subtree->retained_subtrees[id] = retained->second;
+    } else {
+      CopySubtreePaintRegions(child.get(), source, subtree);
+    }
+  }
+}
+
+bool DiffContext::PushOldSubtree(const Layer* old_layer) {
+  if (!old_layer) {
+    return false;
+  }
+  std::shared_ptr<const PaintRegionMap::Table> table;
+  FindOldLayerPaintRegion(old_layer, &table);
+  if (!table) {
+    return false;
+  }
+  auto retained = table->retained_subtrees.find(old_layer->unique_id());
+  if (retained == table->retained_subtrees.end()) {
+    return false;
+  }
+  old_paint_regions_.push_back(retained->second);
+  return true;
+}
+
+DiffContext::AutoOldSubtree::AutoOldSubtree(DiffContext* context,
+                                            const Layer* old_layer)
+    : context_(context), pushed_(context->PushOldSubtree(old_layer)) {}
+
+DiffContext::AutoOldSubtree::~AutoOldSubtree() {
+  if (pushed_) {
+    context_->old_paint_regions_.pop_back();
   }
 }
 
+void DiffContext::Statistics::Merge(const Statistics& other) {
+  new_pictures_ += other.new_pictures_;
+  pictures_too_complex_to_compare_ += other.pictures_too_complex_to_compare_;
+  same_instance_pictures_ += other.same_instance_pictures_;
+  deep_compare_pictures_ += other.deep_compare_pictures_;
+  different_instance_but_equal_pictures_ +=
+      other.different_instance_but_equal_pictures_;
+}
+
 void DiffContext::Statistics::LogStatistics() {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "DiffContext", reinterpret_cast<int64_t>(this),
@@ -7,11 +7,14 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
+#include "display_list/geometry/dl_region.h"
 #include "display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/paint_region.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkM44.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -35,19 +38,67 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // Non-overlapping rects that cover the changed area more tightly than
+  // frame_damage, which is their bounds. Empty if there is no frame damage.
+  std::vector<SkIRect> frame_damage_rects;
+
+  // Non-overlapping rects that cover the changed area more tightly than
+  // buffer_damage, which is their bounds. Empty if there is no buffer damage.
+  std::vector<SkIRect> buffer_damage_rects;
 };
 
-// Layer Unique Id to PaintRegion
-using PaintRegionMap = std::map<uint64_t, PaintRegion>;
+// Layer Unique Id to PaintRegion, for the layers of one layer tree.
+//
+// The descendants of a retained layer are not diffed. The first frame that
+// retains the layer copies their paint regions out of the map of the frame
+// that last diffed them into a table of their own, which later frames that
+// keep retaining the layer share without visiting the descendants again.
+// DiffContext looks them up there if the retained layer is diffed again.
+class PaintRegionMap {
+ public:
+  PaintRegionMap();
+
+  // The number of paint regions that this map holds, including those of the
+  // descendants of retained layers.
+  size_t GetRegionCount() const;
+
+ private:
+  friend class DiffContext;
+
+  struct Table {
+    std::map<uint64_t, PaintRegion> regions;
+
+    // Unique id of a retained layer to the table holding the paint regions of
+    // its descendants, and of no other layers.
+    std::map<uint64_t, std::shared_ptr<const Table>> retained_subtrees;
+  };
+
+  std::shared_ptr<Table> table_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PaintRegionMap);
+};
 
 // Tracks state during tree diffing process and computes resulting damage
 class DiffContext {
  public:
-  explicit DiffContext(SkISize frame_size,
-                       PaintRegionMap& this_frame_paint_region_map,
-                       const PaintRegionMap& last_frame_paint_region_map,
-                       bool has_raster_cache,
-                       bool impeller_enabled);
+  // Siblings are only diffed in parallel if at least this many of them are
+  // diffed rather than retained.
+  static constexpr size_t kMinSiblingsForParallelDiff = 4;
+
+  // The maximum number of tasks posted to the worker runner to diff siblings
+  // alongside the calling thread.
+  static constexpr size_t kMaxSiblingDiffHelpers = 3;
+
+  // If |worker_runner| is provided, sibling subtrees may be diffed in
+  // parallel on it. See |DiffSiblings|.
+  explicit DiffContext(
+      SkISize frame_size,
+      PaintRegionMap& this_frame_paint_region_map,
+      const PaintRegionMap& last_frame_paint_region_map,
+      bool has_raster_cache,
+      bool impeller_enabled,
+      std::shared_ptr<fml::BasicTaskRunner> worker_runner = nullptr);
 
   // Starts a new subtree.
   void BeginSubtree();
@@ -143,9 +194,15 @@ class DiffContext {
   //
   // clip_alignment controls the alignment of resulting frame and surface
   // damage.
-  Damage ComputeDamage(const SkIRect& additional_damage,
+  //
+  // max_damage_rects is the most rects that frame and buffer damage may each
+  // be split into. Damaged areas are merged until they fit, picking the pair
+  // whose merged bounds add the least area first. With a single rect, the
+  // damage is the bounds of all changes.
+  Damage ComputeDamage(const DlRegion& additional_damage,
                        int horizontal_clip_alignment = 0,
-                       int vertical_clip_alignment = 0) const;
+                       int vertical_clip_alignment = 0,
+                       size_t max_damage_rects = 1) const;
 
   // Adds the region to current damage. Used for removed layers, where instead
   // of diffing the layer its paint region is direcly added to damage.
@@ -161,6 +218,40 @@ class DiffContext {
   // frame layer tree.
   PaintRegion GetOldLayerPaintRegion(const Layer* layer) const;
 
+  // Associates the previous paint region of a retained layer and of all of
+  // its descendants with the current layer tree. The descendants are only
+  // visited if the layer was diffed, rather than retained, in the previous
+  // frame.
+  void PreserveSubtreePaintRegion(const Layer* layer);
+
+  // Makes the previous paint regions of the children of |old_layer| available
+  // to GetOldLayerPaintRegion while its subtree is diffed. Must be called
+  // before diffing the children of a layer against those of |old_layer|.
+  class AutoOldSubtree {
+    FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AutoOldSubtree);
+
+   public:
+    AutoOldSubtree(DiffContext* context, const Layer* old_layer);
+    ~AutoOldSubtree();
+
+   private:
+    DiffContext* context_;
+    bool pushed_;
+  };
+
+  using SiblingDiff = std::function<void(DiffContext* context, size_t index)>;
+
+  // Calls |diff| with the index of each of |count| sibling subtrees, in order.
+  //
+  // If the context has a worker runner and at least
+  // kMinSiblingsForParallelDiff of the siblings are diffed rather than
+  // retained (|diffed_count|), each sibling is instead diffed in a fork of
+  // this context on the calling thread or the worker runner. The forks are
+  // merged back in order, which produces the same damage and paint regions as
+  // diffing the siblings one after another. The forks diff the subtrees of
+  // the siblings serially.
+  void DiffSiblings(size_t count, size_t diffed_count, const SiblingDiff& diff);
+
   // Whether or not a raster cache is being used. If so, we must snap
   // all transformations to physical pixels if the layer may be raster
   // cached.
@@ -189,6 +280,9 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Adds the counts of statistics collected by a forked context.
+    void Merge(const Statistics& other);
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -205,6 +299,14 @@ class DiffContext {
   SkRect MapRect(const SkRect& rect);
 
  private:
+  // Creates a context for diffing a sibling subtree in parallel with others.
+  // The fork starts in the current state of |parent|, but collects rects,
+  // damage, readbacks and paint regions on its own.
+  explicit DiffContext(const DiffContext* parent);
+
+  // Appends the results of a fork to this context.
+  void MergeFork(const DiffContext& fork);
+
   struct State {
     State();
 
@@ -249,13 +351,44 @@ class DiffContext {
 
   SkRect damage_ = SkRect::MakeEmpty();
 
-  PaintRegionMap& this_frame_paint_region_map_;
-  const PaintRegionMap& last_frame_paint_region_map_;
+  // The individual rects joined into damage_.
+  std::vector<SkRect> damage_rects_;
+
+  // The paint regions of the current layer tree.
+  std::shared_ptr<PaintRegionMap::Table> this_frame_paint_regions_;
+
+  // Where the paint regions of the previous layer tree are looked up, most
+  // specific last. The first table is that of the previous frame, the others
+  // hold the descendants of retained layers that are being diffed.
+  std::vector<std::shared_ptr<const PaintRegionMap::Table>> old_paint_regions_;
+
+  // Returns the previous paint region of the layer, and the table that it was
+  // found in, if any.
+  PaintRegion FindOldLayerPaintRegion(
+      const Layer* layer,
+      std::shared_ptr<const PaintRegionMap::Table>* table) const;
+
+  // Pushes the table holding the descendants of |old_layer| if it was
+  // retained. Returns whether a table was pushed.
+  bool PushOldSubtree(const Layer* old_layer);
+
+  // Copies the paint regions of the descendants of |layer| from |source| into
+  // |subtree|, along with the tables of descendants that were retained.
+  static void CopySubtreePaintRegions(const Layer* layer,
+                                      const PaintRegionMap::Table& source,
+                                      PaintRegionMap::Table* subtree);
+
   bool has_raster_cache_;
   bool impeller_enabled_;
+  std::shared_ptr<fml::BasicTaskRunner> worker_runner_;
 
   void AddDamage(const SkRect& rect);
 
+  // Computes damage as single rects, bounding all changes.
+  Damage ComputeBoundingDamage(const SkIRect& accumulated_buffer_damage,
+                               int horizontal_clip_alignment,
+                               int vertical_clip_alignment) const;
+
   void AlignRect(SkIRect& rect,
                  int horizontal_alignment,
                  int vertical_clip_alignment) const;
@@ -32,5 +32,67 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, DamageRects) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(10, 10, 30, 30))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 10, 990, 30))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 950, 990, 990))));
+
+  // By default the damage is a single rect bounding all changes.
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 990, 990));
+  EXPECT_EQ(damage.frame_damage_rects,
+            std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 990, 990)});
+
+  SetMaxDamageRects(3);
+  damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 990, 990));
+  EXPECT_EQ(damage.frame_damage_rects,
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 30, 30),
+                                  SkIRect::MakeLTRB(900, 10, 990, 30),
+                                  SkIRect::MakeLTRB(900, 950, 990, 990)}));
+  EXPECT_EQ(damage.buffer_damage_rects, damage.frame_damage_rects);
+
+  // The additional damage takes the budget of the buffer damage, so the two
+  // rects that are cheapest to merge are merged.
+  damage = DiffLayerTree(t1, MockLayerTree(),
+                         SkIRect::MakeLTRB(500, 500, 510, 510));
+  EXPECT_EQ(damage.frame_damage_rects.size(), 3u);
+  EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(10, 10, 990, 990));
+  EXPECT_EQ(damage.buffer_damage_rects,
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 990, 30),
+                                  SkIRect::MakeLTRB(500, 500, 510, 510),
+                                  SkIRect::MakeLTRB(900, 950, 990, 990)}));
+
+  SetMaxDamageRects(2);
+  damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage_rects,
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 990, 30),
+                                  SkIRect::MakeLTRB(900, 950, 990, 990)}));
+}
+
+TEST_F(DiffContextTest, DamageRectsClipAlignment) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(30, 30, 50, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(54, 60, 70, 90))));
+  SetMaxDamageRects(4);
+
+  // Aligned to 16, the rects overlap and are merged.
+  auto damage =
+      DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 16, 16);
+  EXPECT_EQ(damage.frame_damage_rects,
+            std::vector<SkIRect>{SkIRect::MakeLTRB(16, 16, 80, 96)});
+
+  damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 8, 8);
+  EXPECT_EQ(damage.frame_damage_rects,
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(24, 24, 56, 56),
+                                  SkIRect::MakeLTRB(48, 56, 72, 96)}));
+}
+
 }  // namespace testing
 }  // namespace flutter
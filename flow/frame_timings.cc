@@ -126,6 +126,21 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   (void)status;
 }
 
+void FrameTimingsRecorder::AddRasterPhaseDuration(
+    FrameTiming::RasterPhase phase,
+    fml::TimeDelta duration) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  raster_phase_durations_[phase] = raster_phase_durations_[phase] + duration;
+}
+
+fml::TimeDelta FrameTimingsRecorder::GetRasterPhaseDuration(
+    FrameTiming::RasterPhase phase) const {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kRasterStart);
+  return raster_phase_durations_[phase];
+}
+
 fml::Status FrameTimingsRecorder::RecordVsyncImpl(fml::TimePoint vsync_start,
                                                   fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -197,6 +212,9 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.Set(FrameTiming::kRasterStart, raster_start_);
   timing_.Set(FrameTiming::kRasterFinish, raster_end_);
   timing_.Set(FrameTiming::kRasterFinishWallTime, raster_end_wall_time_);
+  for (auto phase : FrameTiming::kRasterPhases) {
+    timing_.SetRasterPhaseDuration(phase, raster_phase_durations_[phase]);
+  }
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
@@ -232,6 +250,10 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kRasterStart) {
     recorder->raster_start_ = raster_start_;
+    for (auto phase : FrameTiming::kRasterPhases) {
+      recorder->raster_phase_durations_[phase] =
+          raster_phase_durations_[phase];
+    }
   }
 
   if (state >= State::kRasterEnd) {
@@ -258,4 +280,17 @@ void FrameTimingsRecorder::AssertInState(State state) const {
   FML_DCHECK(state_ == state);
 }
 
+ScopedRasterPhaseTimer::ScopedRasterPhaseTimer(
+    FrameTimingsRecorder* recorder,
+    FrameTiming::RasterPhase phase)
+    : recorder_(recorder),
+      phase_(phase),
+      start_(recorder ? fml::TimePoint::Now() : fml::TimePoint()) {}
+
+ScopedRasterPhaseTimer::~ScopedRasterPhaseTimer() {
+  if (recorder_) {
+    recorder_->AddRasterPhaseDuration(phase_, fml::TimePoint::Now() - start_);
+  }
+}
+
 }  // namespace flutter
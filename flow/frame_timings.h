@@ -98,6 +98,15 @@ class FrameTimingsRecorder {
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Adds to the duration of a part of the rasterization of the frame. May
+  /// be called any number of times between the raster start and raster end
+  /// events, and the durations of each phase are summed.
+  void AddRasterPhaseDuration(FrameTiming::RasterPhase phase,
+                              fml::TimeDelta duration);
+
+  /// The summed duration of a part of the rasterization of the frame.
+  fml::TimeDelta GetRasterPhaseDuration(FrameTiming::RasterPhase phase) const;
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -155,12 +164,31 @@ class FrameTimingsRecorder {
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
 
+  fml::TimeDelta raster_phase_durations_[FrameTiming::kRasterPhaseCount];
+
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(FrameTimingsRecorder);
 };
 
+/// Adds the time spent in its scope to a raster phase of a recorder. Does
+/// nothing if the recorder is null.
+class ScopedRasterPhaseTimer {
+ public:
+  ScopedRasterPhaseTimer(FrameTimingsRecorder* recorder,
+                         FrameTiming::RasterPhase phase);
+
+  ~ScopedRasterPhaseTimer();
+
+ private:
+  FrameTimingsRecorder* recorder_;
+  const FrameTiming::RasterPhase phase_;
+  const fml::TimePoint start_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(ScopedRasterPhaseTimer);
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_FRAME_TIMINGS_H_
@@ -285,6 +285,63 @@ TEST(FrameTimingsRecorderTest, ClonedHasSameRasterEndWithCache) {
   ASSERT_EQ(recorder->GetPictureCacheBytes(), cloned->GetPictureCacheBytes());
 }
 
+TEST(FrameTimingsRecorderTest, RecordRasterPhaseDurations) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+
+  recorder->AddRasterPhaseDuration(FrameTiming::kPreroll,
+                                   fml::TimeDelta::FromMilliseconds(1));
+  recorder->AddRasterPhaseDuration(FrameTiming::kPreroll,
+                                   fml::TimeDelta::FromMilliseconds(2));
+  recorder->AddRasterPhaseDuration(FrameTiming::kGpu,
+                                   fml::TimeDelta::FromMilliseconds(5));
+  {
+    using namespace std::chrono_literals;
+    ScopedRasterPhaseTimer timer(recorder.get(), FrameTiming::kDiff);
+    std::this_thread::sleep_for(1ms);
+  }
+  const auto timing = recorder->RecordRasterEnd();
+
+  ASSERT_EQ(recorder->GetRasterPhaseDuration(FrameTiming::kPreroll),
+            fml::TimeDelta::FromMilliseconds(3));
+  ASSERT_GE(recorder->GetRasterPhaseDuration(FrameTiming::kDiff),
+            fml::TimeDelta::FromMilliseconds(1));
+  ASSERT_EQ(recorder->GetRasterPhaseDuration(FrameTiming::kEncode),
+            fml::TimeDelta::Zero());
+  for (auto phase : FrameTiming::kRasterPhases) {
+    ASSERT_EQ(timing.GetRasterPhaseDuration(phase),
+              recorder->GetRasterPhaseDuration(phase));
+  }
+}
+
+TEST(FrameTimingsRecorderTest, ClonedHasSameRasterPhaseDurations) {
+  auto recorder = std::make_unique<FrameTimingsRecorder>();
+
+  const auto st = fml::TimePoint::Now();
+  const auto en = st + fml::TimeDelta::FromMillisecondsF(16);
+  recorder->RecordVsync(st, en);
+  recorder->RecordBuildStart(fml::TimePoint::Now());
+  recorder->RecordBuildEnd(fml::TimePoint::Now());
+  recorder->RecordRasterStart(fml::TimePoint::Now());
+  recorder->AddRasterPhaseDuration(FrameTiming::kDispatch,
+                                   fml::TimeDelta::FromMilliseconds(4));
+
+  auto cloned =
+      recorder->CloneUntil(FrameTimingsRecorder::State::kRasterStart);
+  ASSERT_EQ(cloned->GetRasterPhaseDuration(FrameTiming::kDispatch),
+            fml::TimeDelta::FromMilliseconds(4));
+}
+
+TEST(FrameTimingsRecorderTest, ScopedRasterPhaseTimerAllowsNullRecorder) {
+  ScopedRasterPhaseTimer timer(nullptr, FrameTiming::kDiff);
+}
+
 TEST(FrameTimingsRecorderTest, FrameNumberTraceArgIsValid) {
   auto recorder = std::make_unique<FrameTimingsRecorder>();
 
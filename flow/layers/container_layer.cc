@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/container_layer.h"
 
 #include <optional>
+#include <vector>
 
 namespace flutter {
 
@@ -18,22 +19,26 @@ void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
 }
 
 void ContainerLayer::PreservePaintRegion(DiffContext* context) {
-  Layer::PreservePaintRegion(context);
-  for (auto& layer : layers_) {
-    layer->PreservePaintRegion(context);
-  }
+  // The context carries over the paint regions of the children. It only
+  // visits the subtree when it was diffed in the previous frame.
+  context->PreserveSubtreePaintRegion(this);
 }
 
 void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
   if (context->IsSubtreeDirty()) {
-    for (auto& layer : layers_) {
-      layer->Diff(context, nullptr);
-    }
+    context->DiffSiblings(layers_.size(), layers_.size(),
+                          [this](DiffContext* sibling_context, size_t index) {
+                            layers_[index]->Diff(sibling_context, nullptr);
+                          });
     return;
   }
   FML_DCHECK(old_layer);
 
+  // The children of a layer that was retained in the previous frame have
+  // their paint regions recorded in an earlier frame.
+  DiffContext::AutoOldSubtree old_subtree(context, old_layer);
+
   const auto& prev_layers = old_layer->layers_;
 
   // first mismatched element
@@ -70,14 +75,19 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
   }
 
+  // For each child, the matching previous layer if the child is diffed
+  // against it, or nullptr if it is retained or new.
+  std::vector<const Layer*> diff_against(layers_.size(), nullptr);
+  std::vector<bool> retained(layers_.size(), false);
+  std::vector<PaintRegion> retained_regions(layers_.size());
+  size_t diffed_count = 0;
   for (int i = 0; i < static_cast<int>(layers_.size()); ++i) {
     if (i < new_children_top || i > new_children_bottom) {
       int i_prev =
           i < new_children_top ? i : prev_layers.size() - (layers_.size() - i);
-      auto layer = layers_[i];
-      auto prev_layer = prev_layers[i_prev];
-      auto paint_region = context->GetOldLayerPaintRegion(prev_layer.get());
-      if (layer == prev_layer && !paint_region.has_readback() &&
+      auto prev_layer = prev_layers[i_prev].get();
+      auto paint_region = context->GetOldLayerPaintRegion(prev_layer);
+      if (layers_[i].get() == prev_layer && !paint_region.has_readback() &&
           !paint_region.has_texture()) {
         // for retained layers, stop processing the subtree and add existing
         // region; We know current subtree is not dirty (every ancestor up to
@@ -85,22 +95,34 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // previous frame; We can only do this if there is no readback in the
         // subtree. Layers that do readback must be able to register readback
         // inside Diff
-        context->AddExistingPaintRegion(paint_region);
-
-        // While we don't need to diff retained layers, we still need to
-        // associate their paint region with current layer tree so that we can
-        // retrieve it in next frame diff
-        layer->PreservePaintRegion(context);
-      } else {
-        layer->Diff(context, prev_layer.get());
+        retained[i] = true;
+        retained_regions[i] = paint_region;
+        continue;
       }
-    } else {
-      DiffContext::AutoSubtreeRestore subtree(context);
-      context->MarkSubtreeDirty();
-      auto layer = layers_[i];
-      layer->Diff(context, nullptr);
+      diff_against[i] = prev_layer;
     }
+    ++diffed_count;
   }
+
+  context->DiffSiblings(
+      layers_.size(), diffed_count,
+      [&](DiffContext* sibling_context, size_t index) {
+        const auto& layer = layers_[index];
+        if (retained[index]) {
+          sibling_context->AddExistingPaintRegion(retained_regions[index]);
+
+          // While we don't need to diff retained layers, we still need to
+          // associate their paint region with current layer tree so that we
+          // can retrieve it in next frame diff
+          layer->PreservePaintRegion(sibling_context);
+        } else if (diff_against[index]) {
+          layer->Diff(sibling_context, diff_against[index]);
+        } else {
+          DiffContext::AutoSubtreeRestore subtree(sibling_context);
+          sibling_context->MarkSubtreeDirty();
+          layer->Diff(sibling_context, nullptr);
+        }
+      });
 }
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
@@ -9,6 +9,7 @@
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -763,6 +764,149 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+TEST_F(ContainerLayerDiffTest, DiffAgainstLayerRetainedInPreviousFrame) {
+  auto path1 = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto path2 = SkPath().addRect(SkRect::MakeLTRB(100, 0, 150, 50));
+  auto path2a = SkPath().addRect(SkRect::MakeLTRB(100, 100, 150, 150));
+
+  auto m1 = std::make_shared<MockLayer>(path1);
+  auto c1 = CreateContainerLayer({m1, std::make_shared<MockLayer>(path2)});
+
+  MockLayerTree t1;
+  t1.root()->Add(c1);
+
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 150, 50));
+
+  // The container is retained without visiting its children.
+  MockLayerTree t2;
+  t2.root()->Add(c1);
+
+  damage = DiffLayerTree(t2, t1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  // The children of the replacing container are diffed against the paint
+  // regions recorded by the first frame.
+  auto c2 = CreateContainerLayer({m1, std::make_shared<MockLayer>(path2a)});
+  c2->AssignOldLayer(c1.get());
+  MockLayerTree t3;
+  t3.root()->Add(c2);
+
+  damage = DiffLayerTree(t3, t2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 0, 150, 150));
+
+  // The paint region of the retained child is carried over to the next frame.
+  auto c3 = CreateContainerLayer(std::make_shared<MockLayer>(path2a));
+  c3->AssignOldLayer(c2.get());
+  MockLayerTree t4;
+  t4.root()->Add(c3);
+
+  damage = DiffLayerTree(t4, t3);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 50, 50));
+}
+
+TEST_F(ContainerLayerDiffTest, RetainedLayerDoesNotKeepOldFrameAlive) {
+  auto rect = [](int i) {
+    return SkPath().addRect(SkRect::MakeXYWH(i * 100, 0, 50, 50));
+  };
+  auto m0 = std::make_shared<MockLayer>(rect(0));
+  auto c1 = CreateContainerLayer({m0, std::make_shared<MockLayer>(rect(1))});
+
+  auto t1 = std::make_unique<MockLayerTree>();
+  t1->root()->Add(c1);
+  for (int i = 2; i < 10; i++) {
+    t1->root()->Add(std::make_shared<MockLayer>(rect(i)));
+  }
+  DiffLayerTree(*t1, MockLayerTree());
+
+  // Only the retained container and its two children are carried over from
+  // the first frame, in addition to the root and the new layer.
+  auto t2 = std::make_unique<MockLayerTree>();
+  t2->root()->Add(c1);
+  t2->root()->Add(std::make_shared<MockLayer>(rect(2)));
+  auto damage = DiffLayerTree(*t2, *t1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 950, 50));
+  EXPECT_EQ(t2->paint_region_map().GetRegionCount(), 5u);
+  t1.reset();
+
+  // Retaining the container again shares the table of its children.
+  MockLayerTree t3;
+  t3.root()->Add(c1);
+  damage = DiffLayerTree(t3, *t2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 50));
+  EXPECT_EQ(t3.paint_region_map().GetRegionCount(), 4u);
+  t2.reset();
+
+  // The children are diffed against the regions that were carried over.
+  auto c2 = CreateContainerLayer({m0, std::make_shared<MockLayer>(rect(3))});
+  c2->AssignOldLayer(c1.get());
+  MockLayerTree t4;
+  t4.root()->Add(c2);
+  damage = DiffLayerTree(t4, t3);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 0, 350, 50));
+}
+
+TEST_F(ContainerLayerDiffTest, ParallelDiffMatchesSerialDiff) {
+  constexpr int kChildCount = 8;
+  auto rect = [](int i, int y) {
+    return SkPath().addRect(SkRect::MakeXYWH(i * 100, y, 50, 50));
+  };
+
+  MockLayerTree t1;
+  std::vector<std::shared_ptr<ContainerLayer>> t1_children;
+  for (int i = 0; i < kChildCount; i++) {
+    t1_children.push_back(
+        CreateContainerLayer({std::make_shared<MockLayer>(rect(i, 0)),
+                              std::make_shared<MockLayer>(rect(i, 100))}));
+    t1.root()->Add(t1_children.back());
+  }
+
+  // Every fourth child is retained, the others move their second layer.
+  MockLayerTree t2;
+  std::vector<std::shared_ptr<ContainerLayer>> t2_children;
+  for (int i = 0; i < kChildCount; i++) {
+    if (i % 4 == 3) {
+      t2_children.push_back(t1_children[i]);
+    } else {
+      t2_children.push_back(
+          CreateContainerLayer({std::make_shared<MockLayer>(rect(i, 0)),
+                                std::make_shared<MockLayer>(rect(i, 200))}));
+      t2_children.back()->AssignOldLayer(t1_children[i].get());
+    }
+    t2.root()->Add(t2_children.back());
+  }
+
+  // Only the first child changes, the others are retained.
+  MockLayerTree t3;
+  t3.root()->Add(CreateContainerLayer(std::make_shared<MockLayer>(rect(0, 0))));
+  for (int i = 1; i < kChildCount; i++) {
+    t3.root()->Add(t2_children[i]);
+  }
+
+  Damage serial_damage[3];
+  serial_damage[0] = DiffLayerTree(t1, MockLayerTree());
+  serial_damage[1] = DiffLayerTree(t2, t1);
+  serial_damage[2] = DiffLayerTree(t3, t2);
+  EXPECT_FALSE(serial_damage[1].frame_damage.isEmpty());
+  EXPECT_FALSE(serial_damage[2].frame_damage.isEmpty());
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  SetWorkerTaskRunner(loop->GetTaskRunner());
+
+  Damage parallel_damage[3];
+  parallel_damage[0] = DiffLayerTree(t1, MockLayerTree());
+  parallel_damage[1] = DiffLayerTree(t2, t1);
+  parallel_damage[2] = DiffLayerTree(t3, t2);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(parallel_damage[i].frame_damage, serial_damage[i].frame_damage)
+        << "frame " << (i + 1);
+    EXPECT_EQ(parallel_damage[i].buffer_damage, serial_damage[i].buffer_damage)
+        << "frame " << (i + 1);
+  }
+
+  SetWorkerTaskRunner(nullptr);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -90,6 +90,16 @@ void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
     return;
   }
 
+  if (context->raster_cache &&
+      context->raster_cache->display_list_content_keys()) {
+    if (!content_key_id_.has_value()) {
+      content_key_id_.emplace(
+          RasterCacheKeyID::ForDisplayListContent(display_list_));
+    }
+  } else {
+    content_key_id_.reset();
+  }
+
   if (context->raster_cached_entries && context->raster_cache) {
     context->raster_cached_entries->push_back(this);
     cache_state_ = CacheState::kCurrent;
@@ -107,7 +117,7 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   bool visible = !context->state_stack.content_culled(bounds);
   RasterCache::CacheInfo cache_info =
-      raster_cache->MarkSeen(key_id_, matrix, visible);
+      raster_cache->MarkSeen(cache_key_id(), matrix, visible);
   if (!visible ||
       cache_info.accesses_since_visible <= raster_cache->access_threshold()) {
     cache_state_ = kNone;
@@ -121,6 +131,10 @@ void DisplayListRasterCacheItem::PrerollFinalize(PrerollContext* context,
   return;
 }
 
+std::optional<RasterCacheKeyID> DisplayListRasterCacheItem::GetId() const {
+  return cache_key_id();
+}
+
 bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
                                       const DlPaint* paint) const {
   return Draw(context, context.canvas, paint);
@@ -133,7 +147,7 @@ bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
     return false;
   }
   if (cache_state_ == CacheState::kCurrent) {
-    return context.raster_cache->Draw(key_id_, *canvas, paint,
+    return context.raster_cache->Draw(cache_key_id(), *canvas, paint,
                                       context.rendering_above_platform_view);
   }
   return false;
@@ -43,6 +43,8 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   bool TryToPrepareRasterCache(const PaintContext& context,
                                bool parent_cached = false) const override;
 
+  std::optional<RasterCacheKeyID> GetId() const override;
+
   void ModifyMatrix(SkPoint offset) const {
     matrix_ = matrix_.preTranslate(offset.x(), offset.y());
   }
@@ -50,6 +52,13 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   const DisplayList* display_list() const { return display_list_.get(); }
 
  private:
+  // The id under which the display list is cached, which is derived from
+  // its content if the raster cache uses content keys.
+  const RasterCacheKeyID& cache_key_id() const {
+    return content_key_id_.has_value() ? content_key_id_.value() : key_id_;
+  }
+
+  std::optional<RasterCacheKeyID> content_key_id_;
   SkMatrix transformation_matrix_;
   sk_sp<DisplayList> display_list_;
   SkPoint offset_;
@@ -146,6 +146,8 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
   };
 
   if (cache) {
+    ScopedRasterPhaseTimer raster_cache_timer(frame.frame_timings_recorder(),
+                                              FrameTiming::kRasterCache);
     cache->EvictUnusedCacheEntries();
     TryToRasterCache(raster_cache_items_, &context, ignore_raster_cache);
   }
@@ -126,7 +126,8 @@ bool RasterCache::UpdateCacheEntry(
                             render_function, func);
     if (entry.image != nullptr) {
       switch (id.type()) {
-        case RasterCacheKeyType::kDisplayList: {
+        case RasterCacheKeyType::kDisplayList:
+        case RasterCacheKeyType::kDisplayListContent: {
           display_list_cached_this_frame_++;
           break;
         }
@@ -276,6 +277,10 @@ void RasterCache::SetCheckboardCacheImages(bool checkerboard) {
   Clear();
 }
 
+void RasterCache::SetDisplayListContentKeys(bool content_keys) {
+  display_list_content_keys_ = content_keys;
+}
+
 void RasterCache::TraceStatsToTimeline() const {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER(
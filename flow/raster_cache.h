@@ -168,6 +168,20 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  /**
+   * @brief Whether display lists are cached under a key derived from their
+   * content instead of their unique id.
+   *
+   * With content keys, a display list that is recorded again with the same
+   * operations, for example by a widget that was rebuilt without changes,
+   * reuses the image cached for the previous recording. Computing the key
+   * costs one pass over the operations of each display list considered for
+   * caching.
+   */
+  void SetDisplayListContentKeys(bool content_keys);
+
+  bool display_list_content_keys() const { return display_list_content_keys_; }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -265,6 +279,7 @@ class RasterCache {
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
+  bool display_list_content_keys_ = false;
 
   void TraceStatsToTimeline() const;
 
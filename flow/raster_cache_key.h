@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "flutter/display_list/display_list.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -18,7 +19,13 @@ namespace flutter {
 
 class Layer;
 
-enum class RasterCacheKeyType { kLayer, kDisplayList, kLayerChildren };
+enum class RasterCacheKeyType {
+  kLayer,
+  kDisplayList,
+  kLayerChildren,
+  // A DisplayList identified by its content rather than by its unique id.
+  kDisplayListContent,
+};
 
 class RasterCacheKeyID {
  public:
@@ -33,6 +40,14 @@ class RasterCacheKeyID {
         type_(type),
         child_ids_(std::move(child_ids)) {}
 
+  /// Creates an id that matches the id of any DisplayList with the same
+  /// rendering operations as |display_list|, so that the cached rendering
+  /// of a DisplayList can be reused when the same content is recorded again.
+  static RasterCacheKeyID ForDisplayListContent(
+      sk_sp<const DisplayList> display_list) {
+    return RasterCacheKeyID(std::move(display_list));
+  }
+
   uint64_t unique_id() const { return unique_id_; }
 
   RasterCacheKeyType type() const { return type_; }
@@ -58,7 +73,8 @@ class RasterCacheKeyID {
 
   bool operator==(const RasterCacheKeyID& other) const {
     return unique_id_ == other.unique_id_ && type_ == other.type_ &&
-           GetHash() == other.GetHash() && child_ids_ == other.child_ids_;
+           GetHash() == other.GetHash() && child_ids_ == other.child_ids_ &&
+           SameDisplayListContent(other);
   }
 
   bool operator!=(const RasterCacheKeyID& other) const {
@@ -66,9 +82,25 @@ class RasterCacheKeyID {
   }
 
  private:
+  explicit RasterCacheKeyID(sk_sp<const DisplayList> display_list)
+      : unique_id_(display_list->content_hash()),
+        type_(RasterCacheKeyType::kDisplayListContent),
+        display_list_(std::move(display_list)) {}
+
+  // Content hashes can collide, so ids with equal hashes compare the
+  // DisplayLists themselves.
+  bool SameDisplayListContent(const RasterCacheKeyID& other) const {
+    if (display_list_ == other.display_list_) {
+      return true;
+    }
+    return display_list_ && other.display_list_ &&
+           display_list_->Equals(other.display_list_);
+  }
+
   const uint64_t unique_id_;
   const RasterCacheKeyType type_;
   const std::vector<RasterCacheKeyID> child_ids_;
+  const sk_sp<const DisplayList> display_list_;
   mutable std::optional<std::size_t> cached_hash_;
 };
 
@@ -93,6 +125,7 @@ class RasterCacheKey {
   RasterCacheKeyKind kind() const {
     switch (id_.type()) {
       case RasterCacheKeyType::kDisplayList:
+      case RasterCacheKeyType::kDisplayListContent:
         return RasterCacheKeyKind::kDisplayListMetrics;
       case RasterCacheKeyType::kLayer:
       case RasterCacheKeyType::kLayerChildren:
@@ -784,6 +784,120 @@ TEST(RasterCache, RasterCacheKeyIDHashCode) {
   ASSERT_EQ(fourth_hash, fourth.GetHash());
 }
 
+TEST(RasterCache, RasterCacheKeyIDForDisplayListContent) {
+  auto display_list = GetSampleDisplayList();
+  auto same_content = GetSampleDisplayList();
+  auto other_content = GetSampleDisplayList(2);
+  ASSERT_NE(display_list->unique_id(), same_content->unique_id());
+
+  RasterCacheKeyID first =
+      RasterCacheKeyID::ForDisplayListContent(display_list);
+  RasterCacheKeyID second =
+      RasterCacheKeyID::ForDisplayListContent(same_content);
+  RasterCacheKeyID third =
+      RasterCacheKeyID::ForDisplayListContent(other_content);
+
+  ASSERT_EQ(first.type(), RasterCacheKeyType::kDisplayListContent);
+  ASSERT_EQ(first.GetHash(), second.GetHash());
+  ASSERT_EQ(first, second);
+  ASSERT_NE(first, third);
+  ASSERT_NE(first, RasterCacheKeyID(display_list->content_hash(),
+                                    RasterCacheKeyType::kDisplayListContent));
+  ASSERT_EQ(RasterCacheKey(first, SkMatrix::I()).kind(),
+            RasterCacheKeyKind::kDisplayListMetrics);
+}
+
+TEST(RasterCache, ContentKeysShareEntriesBetweenEqualDisplayLists) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetDisplayListContentKeys(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  // Each frame records the same content into a new display list.
+  cache.BeginFrame();
+  DisplayListRasterCacheItem first_item(GetSampleDisplayList(), SkPoint(),
+                                        true, false);
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      first_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  DisplayListRasterCacheItem second_item(GetSampleDisplayList(), SkPoint(),
+                                         true, false);
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      second_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(second_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  DisplayListRasterCacheItem third_item(GetSampleDisplayList(), SkPoint(),
+                                        true, false);
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      third_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(third_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.GetPictureCachedEntriesCount(), 1u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+}
+
+TEST(RasterCache, UniqueIdKeysDoNotShareEntriesBetweenEqualDisplayLists) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  cache.BeginFrame();
+  DisplayListRasterCacheItem first_item(GetSampleDisplayList(), SkPoint(),
+                                        true, false);
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      first_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  DisplayListRasterCacheItem second_item(GetSampleDisplayList(), SkPoint(),
+                                         true, false);
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      second_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(second_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+}
+
 using RasterCacheTest = LayerTest;
 
 TEST_F(RasterCacheTest, RasterCacheKeyIDLayerChildrenIds) {
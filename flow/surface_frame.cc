@@ -20,7 +20,8 @@ SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
                            const SubmitCallback& submit_callback,
                            SkISize frame_size,
                            std::unique_ptr<GLContextResult> context_result,
-                           bool display_list_fallback)
+                           bool display_list_fallback,
+                           bool display_list_rtree)
     : surface_(std::move(surface)),
       framebuffer_info_(framebuffer_info),
       submit_callback_(submit_callback),
@@ -36,8 +37,10 @@ SurfaceFrame::SurfaceFrame(sk_sp<SkSurface> surface,
     // further culling during `DisplayList::Dispatch`. Further, this canvas
     // will live underneath any platform views so we do not need to compute
     // exact coverage to describe "pixel ownership" to the platform.
+    // Surfaces that render the DisplayList in tiles can still request an
+    // rtree so that each tile only dispatches the ops that intersect it.
     dl_builder_ = sk_make_sp<DisplayListBuilder>(SkRect::Make(frame_size),
-                                                 /*prepare_rtree=*/false);
+                                                 display_list_rtree);
     canvas_ = dl_builder_.get();
   }
 }
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/display_list/dl_builder.h"
@@ -54,6 +55,14 @@ class SurfaceFrame {
     // rasterized (no partial redraw). To signal that there is no existing
     // damage use an empty SkIRect.
     std::optional<SkIRect> existing_damage = std::nullopt;
+
+    // The rects that make up existing_damage, if the surface tracks them
+    // separately. Their bounds must be existing_damage.
+    std::vector<SkIRect> existing_damage_rects;
+
+    // The most rects that the surface accepts as frame and buffer damage
+    // when presenting. With a single rect, the damage bounds all changes.
+    size_t max_damage_rects = 1;
   };
 
   SurfaceFrame(sk_sp<SkSurface> surface,
@@ -61,7 +70,8 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                SkISize frame_size,
                std::unique_ptr<GLContextResult> context_result = nullptr,
-               bool display_list_fallback = false);
+               bool display_list_fallback = false,
+               bool display_list_rtree = false);
 
   struct SubmitInfo {
     // The frame damage for frame n is the difference between frame n and
@@ -77,6 +87,13 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_partial_update
     std::optional<SkIRect> buffer_damage;
 
+    // Non-overlapping rects that cover the frame and buffer damage more
+    // tightly, at most FramebufferInfo::max_damage_rects of each. Their
+    // bounds are frame_damage and buffer_damage. Empty if the damage is empty
+    // or unspecified.
+    std::vector<SkIRect> frame_damage_rects;
+    std::vector<SkIRect> buffer_damage_rects;
+
     // Time at which this frame is scheduled to be presented. This is a hint
     // that can be passed to the platform to drop queued frames.
     std::optional<fml::TimePoint> presentation_time;
@@ -23,12 +23,16 @@ Damage DiffContextTest::DiffLayerTree(MockLayerTree& layer_tree,
 
   DiffContext dc(layer_tree.size(), layer_tree.paint_region_map(),
                  old_layer_tree.paint_region_map(), use_raster_cache,
-                 impeller_enabled);
+                 impeller_enabled, worker_runner_);
   dc.PushCullRect(
       SkRect::MakeIWH(layer_tree.size().width(), layer_tree.size().height()));
   layer_tree.root()->Diff(&dc, old_layer_tree.root());
-  return dc.ComputeDamage(additional_damage, horizontal_clip_alignment,
-                          vertical_clip_alignment);
+  std::vector<SkIRect> additional_rects;
+  if (!additional_damage.isEmpty()) {
+    additional_rects.push_back(additional_damage);
+  }
+  return dc.ComputeDamage(DlRegion(additional_rects), horizontal_clip_alignment,
+                          vertical_clip_alignment, max_damage_rects_);
 }
 
 sk_sp<DisplayList> DiffContextTest::CreateDisplayList(const SkRect& bounds,
@@ -38,6 +38,16 @@ class DiffContextTest : public LayerTest {
  public:
   DiffContextTest();
 
+  // Sets the runner passed to the DiffContext of subsequent diffs.
+  void SetWorkerTaskRunner(std::shared_ptr<fml::BasicTaskRunner> runner) {
+    worker_runner_ = std::move(runner);
+  }
+
+  // Sets the rect budget of the damage computed by subsequent diffs.
+  void SetMaxDamageRects(size_t max_damage_rects) {
+    max_damage_rects_ = max_damage_rects;
+  }
+
   Damage DiffLayerTree(MockLayerTree& layer_tree,
                        const MockLayerTree& old_layer_tree,
                        const SkIRect& additional_damage = SkIRect::MakeEmpty(),
@@ -67,6 +77,10 @@ class DiffContextTest : public LayerTest {
       std::initializer_list<std::shared_ptr<Layer>> layers,
       SkAlpha alpha,
       const SkPoint& offset = SkPoint::Make(0, 0));
+
+ private:
+  std::shared_ptr<fml::BasicTaskRunner> worker_runner_;
+  size_t max_damage_rects_ = 1;
 };
 
 }  // namespace testing
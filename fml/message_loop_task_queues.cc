@@ -35,11 +35,46 @@ class TaskSourceGradeHolder {
 FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
+TaskQueueInbox::TaskQueueInbox() = default;
+
+TaskQueueInbox::~TaskQueueInbox() {
+  Node* node = head_.exchange(nullptr);
+  while (node) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+bool TaskQueueInbox::Push(const DelayedTask& task) {
+  Node* node = new Node{task, head_.load()};
+  while (!head_.compare_exchange_weak(node->next, node)) {
+  }
+  return node->next == nullptr;
+}
+
+void TaskQueueInbox::DrainInto(TaskSource& task_source) {
+  // The nodes are in reverse order of pushing, which does not matter since
+  // the task source orders tasks by their target time and order.
+  Node* node = head_.exchange(nullptr);
+  while (node) {
+    task_source.RegisterTask(node->task);
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+bool TaskQueueInbox::IsEmpty() const {
+  return head_.load() == nullptr;
+}
+
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
     : subsumed_by(kUnmerged), created_for(created_for_arg) {
   wakeable = NULL;
   task_observers = TaskObservers();
   task_source = std::make_unique<TaskSource>(created_for);
+  inbox = std::make_unique<TaskQueueInbox>();
 }
 
 MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
@@ -52,10 +87,13 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
+  UniqueLock inboxes_lock(*inboxes_mutex_);
+  inboxes_[loop_id] = queue_entries_[loop_id]->inbox.get();
   return loop_id;
 }
 
-MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
+MessageLoopTaskQueues::MessageLoopTaskQueues()
+    : inboxes_mutex_(fml::SharedMutex::Create()), order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
 }
@@ -67,9 +105,12 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
+  UniqueLock inboxes_lock(*inboxes_mutex_);
   for (auto& subsumed : subsumed_set) {
+    inboxes_.erase(subsumed);
     queue_entries_.erase(subsumed);
   }
+  inboxes_.erase(queue_id);
   // Erase owner queue_id at last to avoid &subsumed_set from being invalid
   queue_entries_.erase(queue_id);
 }
@@ -79,6 +120,7 @@ void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
+  DrainInboxesUnlocked(queue_id);
   queue_entry->task_source->ShutDown();
   for (auto& subsumed : subsumed_set) {
     queue_entries_.at(subsumed)->task_source->ShutDown();
@@ -94,30 +136,67 @@ void MessageLoopTaskQueues::RegisterTask(
     const fml::closure& task,
     fml::TimePoint target_time,
     fml::TaskSourceGrade task_source_grade) {
+  // Tasks that are already due are added to the inbox of the queue without
+  // taking |queue_mutex_|, so that threads posting to different queues, or
+  // to the same queue, do not serialize on it. Tasks in the future are kept
+  // in order of their target time under the lock, as they may change the
+  // time at which the message loop needs to wake up.
+  //
+  // Secondary tasks can be paused, in which case posting one must not wake
+  // the loop, so they also take the locked path.
+  DelayedTask delayed_task(order_++, task, target_time, task_source_grade);
+  if (task_source_grade != TaskSourceGrade::kDartMicroTasks &&
+      target_time <= fml::TimePoint::Now() &&
+      TryRegisterTaskLockFree(queue_id, delayed_task)) {
+    return;
+  }
+
   std::lock_guard guard(queue_mutex_);
-  size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+  queue_entry->task_source->RegisterTask(delayed_task);
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
 
+  DrainInboxesUnlocked(loop_to_wake);
   // This can happen when the secondary tasks are paused.
   if (HasPendingTasksUnlocked(loop_to_wake)) {
     WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
   }
 }
 
+bool MessageLoopTaskQueues::TryRegisterTaskLockFree(TaskQueueId queue_id,
+                                                    const DelayedTask& task) {
+  SharedLock inboxes_lock(*inboxes_mutex_);
+  auto found = inboxes_.find(queue_id);
+  if (found == inboxes_.end()) {
+    return false;
+  }
+  TaskQueueInbox* inbox = found->second;
+  // Only the push that makes the inbox non-empty needs to wake the loop.
+  // Later pushes are drained together with it, and until then every wake up
+  // made under |queue_mutex_| sees the non-empty inbox, see |WakeUpUnlocked|.
+  if (inbox->Push(task)) {
+    std::lock_guard wakeup_guard(wakeup_mutex_);
+    Wakeable* wakeable = inbox->wakeable.load();
+    if (wakeable) {
+      wakeable->WakeUp(task.GetTargetTime());
+    }
+  }
+  return true;
+}
+
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
   std::lock_guard guard(queue_mutex_);
+  DrainInboxesUnlocked(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
 fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
                                                      fml::TimePoint from_time) {
   std::lock_guard guard(queue_mutex_);
+  DrainInboxesUnlocked(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
@@ -142,9 +221,19 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
 
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+  Wakeable* wakeable = queue_entries_.at(queue_id)->wakeable;
+  if (!wakeable) {
+    return;
+  }
+  // A task pushed to an inbox after it was drained has already woken the
+  // loop, or is about to. Replacing that wake up with a later |time| would
+  // leave the task waiting, so the loop is woken now instead. Holding
+  // |wakeup_mutex_| orders this check against the wake up of the pusher.
+  std::lock_guard wakeup_guard(wakeup_mutex_);
+  if (!InboxesEmptyUnlocked(queue_id)) {
+    time = std::min(time, fml::TimePoint::Now());
   }
+  wakeable->WakeUp(time);
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
@@ -154,6 +243,7 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
     return 0;
   }
 
+  DrainInboxesUnlocked(queue_id);
   size_t total_tasks = 0;
   total_tasks += queue_entry->task_source->GetNumPendingTasks();
 
@@ -205,9 +295,15 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
   std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  const auto& queue_entry = queue_entries_.at(queue_id);
+  FML_CHECK(!queue_entry->wakeable) << "Wakeable can only be set once.";
+  queue_entry->wakeable = wakeable;
+  if (queue_entry->subsumed_by == kUnmerged) {
+    queue_entry->inbox->wakeable.store(wakeable);
+    for (auto& subsumed : queue_entry->owner_of) {
+      queue_entries_.at(subsumed)->inbox->wakeable.store(wakeable);
+    }
+  }
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
@@ -253,7 +349,9 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   // All checking is OK, set merged state.
   owner_entry->owner_of.insert(subsumed);
   subsumed_entry->subsumed_by = owner;
+  subsumed_entry->inbox->wakeable.store(owner_entry->wakeable);
 
+  DrainInboxesUnlocked(owner);
   if (HasPendingTasksUnlocked(owner)) {
     WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
   }
@@ -290,9 +388,13 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
     return false;
   }
 
-  queue_entries_.at(subsumed)->subsumed_by = kUnmerged;
+  const auto& subsumed_entry = queue_entries_.at(subsumed);
+  subsumed_entry->subsumed_by = kUnmerged;
+  subsumed_entry->inbox->wakeable.store(subsumed_entry->wakeable);
   owner_entry->owner_of.erase(subsumed);
 
+  DrainInboxesUnlocked(owner);
+  DrainInboxesUnlocked(subsumed);
   if (HasPendingTasksUnlocked(owner)) {
     WakeUpUnlocked(owner, GetNextWakeTimeUnlocked(owner));
   }
@@ -329,6 +431,7 @@ void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
   std::lock_guard guard(queue_mutex_);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
+  DrainInboxesUnlocked(queue_id);
   if (HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
   }
@@ -355,6 +458,26 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
       });
 }
 
+void MessageLoopTaskQueues::DrainInboxesUnlocked(TaskQueueId queue_id) const {
+  const auto& entry = queue_entries_.at(queue_id);
+  entry->inbox->DrainInto(*entry->task_source);
+  for (TaskQueueId subsumed : entry->owner_of) {
+    const auto& subsumed_entry = queue_entries_.at(subsumed);
+    subsumed_entry->inbox->DrainInto(*subsumed_entry->task_source);
+  }
+}
+
+bool MessageLoopTaskQueues::InboxesEmptyUnlocked(TaskQueueId queue_id) const {
+  const auto& entry = queue_entries_.at(queue_id);
+  if (!entry->inbox->IsEmpty()) {
+    return false;
+  }
+  return std::all_of(entry->owner_of.begin(), entry->owner_of.end(),
+                     [&](const auto& subsumed) {
+                       return queue_entries_.at(subsumed)->inbox->IsEmpty();
+                     });
+}
+
 fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
     TaskQueueId queue_id) const {
   return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -24,6 +25,43 @@ namespace fml {
 
 static const TaskQueueId kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 
+/// A list of tasks that are due to run immediately, which any thread can add
+/// to without locking.
+///
+/// Tasks in the inbox are moved into the |TaskSource| of their TaskQueue by
+/// the thread that holds the lock of the \p fml::MessageLoopTaskQueues,
+/// before that lock holder looks at the pending tasks.
+class TaskQueueInbox {
+ public:
+  TaskQueueInbox();
+
+  ~TaskQueueInbox();
+
+  /// Adds a task. Can be called from any thread. Returns true if the inbox
+  /// was empty before.
+  bool Push(const DelayedTask& task);
+
+  /// Moves all tasks into the |task_source|. Must not be called by more than
+  /// one thread at a time.
+  void DrainInto(TaskSource& task_source);
+
+  bool IsEmpty() const;
+
+  /// The wakeable of the message loop that runs the tasks of this inbox,
+  /// which is the wakeable of the owning TaskQueue while merged.
+  std::atomic<Wakeable*> wakeable = nullptr;
+
+ private:
+  struct Node {
+    DelayedTask task;
+    Node* next;
+  };
+
+  std::atomic<Node*> head_ = nullptr;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskQueueInbox);
+};
+
 /// A collection of tasks and observers associated with one TaskQueue.
 ///
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
@@ -35,6 +73,7 @@ class TaskQueueEntry {
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
+  std::unique_ptr<TaskQueueInbox> inbox;
 
   /// Set of the TaskQueueIds which is owned by this TaskQueue. If the set is
   /// empty, this TaskQueue does not own any other TaskQueues.
@@ -150,11 +189,30 @@ class MessageLoopTaskQueues {
 
   TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
 
+  // Moves the tasks in the inboxes of the queue and of the queues it owns
+  // into their task sources. The tasks remain pending, so this does not
+  // change the observable state of the queues.
+  void DrainInboxesUnlocked(TaskQueueId queue_id) const;
+
+  bool InboxesEmptyUnlocked(TaskQueueId queue_id) const;
+
+  bool TryRegisterTaskLockFree(TaskQueueId queue_id, const DelayedTask& task);
+
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
   mutable std::mutex queue_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
+  // The inboxes of |queue_entries_|, which can be looked up without holding
+  // |queue_mutex_|. Entries are only added or removed while holding both
+  // |queue_mutex_| and a unique lock on |inboxes_mutex_|.
+  std::unique_ptr<fml::SharedMutex> inboxes_mutex_;
+  std::map<TaskQueueId, TaskQueueInbox*> inboxes_;
+
+  // Serializes all calls to |Wakeable::WakeUp|, which are made both with and
+  // without |queue_mutex_| held. Acquired after |queue_mutex_|.
+  mutable std::mutex wakeup_mutex_;
+
   size_t task_queue_id_counter_ = 0;
 
   std::atomic_int order_;
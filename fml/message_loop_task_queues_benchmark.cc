@@ -66,5 +66,51 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Many threads post immediate tasks to one queue while its owner thread runs
+// them, as the platform, IO and raster threads do when posting to the UI
+// task runner.
+static void BM_MultiProducerSingleConsumer(
+    benchmark::State& state) {  // NOLINT
+  const int num_producers = state.range(0);
+  const int num_tasks_per_producer = 1000;
+  const int num_tasks = num_producers * num_tasks_per_producer;
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  const TaskQueueId queue_id = task_queue->CreateTaskQueue();
+
+  while (state.KeepRunning()) {
+    CountDownLatch producers_ready(num_producers + 1);
+    std::vector<std::thread> producers;
+    producers.reserve(num_producers);
+    for (int i = 0; i < num_producers; i++) {
+      producers.emplace_back([&]() {
+        producers_ready.CountDown();
+        producers_ready.Wait();
+        for (int j = 0; j < num_tasks_per_producer; j++) {
+          task_queue->RegisterTask(queue_id, [] {}, fml::TimePoint::Now());
+        }
+      });
+    }
+
+    producers_ready.CountDown();
+    producers_ready.Wait();
+    int num_invocations = 0;
+    while (num_invocations < num_tasks) {
+      fml::closure invocation =
+          task_queue->GetNextTaskToRun(queue_id, fml::TimePoint::Now());
+      if (invocation) {
+        num_invocations++;
+      }
+    }
+
+    for (auto& producer : producers) {
+      producer.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_tasks);
+  task_queue->Dispose(queue_id);
+}
+
+BENCHMARK(BM_MultiProducerSingleConsumer)->Arg(1)->Arg(4)->Arg(8);
+
 }  // namespace benchmarking
 }  // namespace fml
@@ -7,9 +7,12 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -451,5 +454,128 @@ TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   ASSERT_EQ(time1, wakes[2]);
 }
 
+TEST(MessageLoopTaskQueue, ImmediateTasksFromManyThreadsAllRunInOrder) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+
+  std::atomic_int num_wakes = 0;
+  auto wakeable = std::make_unique<TestWakeable>(
+      [&num_wakes](fml::TimePoint wake_time) { ++num_wakes; });
+  task_queue->SetWakeable(queue_id, wakeable.get());
+
+  constexpr int kThreadCount = 8;
+  constexpr int kThreadTaskCount = 500;
+  std::vector<std::vector<int>> ran(kThreadCount);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([&task_queue, &ran, queue_id, t]() {
+      for (int i = 0; i < kThreadTaskCount; i++) {
+        task_queue->RegisterTask(
+            queue_id, [&ran, t, i]() { ran[t].push_back(i); },
+            fml::TimePoint::Now());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(task_queue->GetNumPendingTasks(queue_id),
+            static_cast<size_t>(kThreadCount * kThreadTaskCount));
+  ASSERT_GE(num_wakes, 1);
+
+  const auto now = fml::TimePoint::Now();
+  while (fml::closure invocation =
+             task_queue->GetNextTaskToRun(queue_id, now)) {
+    invocation();
+  }
+  for (int t = 0; t < kThreadCount; t++) {
+    ASSERT_EQ(ran[t].size(), static_cast<size_t>(kThreadTaskCount));
+    // Tasks posted from one thread run in the order they were posted.
+    ASSERT_TRUE(std::is_sorted(ran[t].begin(), ran[t].end()));
+  }
+}
+
+TEST(MessageLoopTaskQueue, ImmediateTaskOnSubsumedQueueWakesUpOwnerQueue) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queue->CreateTaskQueue();
+  auto raster_queue = task_queue->CreateTaskQueue();
+
+  int platform_wakes = 0;
+  auto wakeable1 = std::make_unique<TestWakeable>(
+      [&platform_wakes](fml::TimePoint wake_time) { ++platform_wakes; });
+  auto wakeable2 = std::make_unique<TestWakeable>([](fml::TimePoint wake_time) {
+    // The raster queue is owned by the platform queue.
+    ASSERT_FALSE(true);
+  });
+  task_queue->SetWakeable(platform_queue, wakeable1.get());
+  task_queue->SetWakeable(raster_queue, wakeable2.get());
+  task_queue->Merge(platform_queue, raster_queue);
+
+  int value = 0;
+  task_queue->RegisterTask(
+      raster_queue, [&value]() { value = 1; }, fml::TimePoint::Now());
+  ASSERT_GE(platform_wakes, 1);
+  ASSERT_FALSE(task_queue->HasPendingTasks(raster_queue));
+  ASSERT_TRUE(task_queue->HasPendingTasks(platform_queue));
+
+  fml::closure invocation =
+      task_queue->GetNextTaskToRun(platform_queue, fml::TimePoint::Now());
+  ASSERT_TRUE(invocation);
+  invocation();
+  ASSERT_EQ(value, 1);
+  ASSERT_TRUE(task_queue->Unmerge(platform_queue, raster_queue));
+}
+
+TEST(MessageLoopTaskQueue, ImmediateTaskRacingDelayedTaskWakesUpNow) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  constexpr int kIterationCount = 200;
+  constexpr int kTaskCount = 50;
+  for (int i = 0; i < kIterationCount; i++) {
+    auto queue_id = task_queue->CreateTaskQueue();
+
+    std::mutex wake_mutex;
+    fml::TimePoint wake_time = fml::TimePoint::Max();
+    std::atomic_int concurrent_wakes = 0;
+    auto wakeable = std::make_unique<TestWakeable>(
+        [&](fml::TimePoint time_point) {
+          ASSERT_EQ(concurrent_wakes.fetch_add(1), 0);
+          {
+            std::scoped_lock lock(wake_mutex);
+            wake_time = time_point;
+          }
+          concurrent_wakes.fetch_sub(1);
+        });
+    task_queue->SetWakeable(queue_id, wakeable.get());
+
+    fml::CountDownLatch start(2);
+    std::thread immediate([&]() {
+      start.CountDown();
+      start.Wait();
+      for (int j = 0; j < kTaskCount; j++) {
+        task_queue->RegisterTask(queue_id, [] {}, fml::TimePoint::Now());
+      }
+    });
+    std::thread delayed([&]() {
+      start.CountDown();
+      start.Wait();
+      for (int j = 0; j < kTaskCount; j++) {
+        task_queue->RegisterTask(
+            queue_id, [] {},
+            fml::TimePoint::Now() + fml::TimeDelta::FromSeconds(10));
+      }
+    });
+    immediate.join();
+    delayed.join();
+
+    // The immediate task must not wait for the wake up of the delayed one.
+    {
+      std::scoped_lock lock(wake_mutex);
+      ASSERT_LE(wake_time, fml::TimePoint::Now()) << "iteration " << i;
+    }
+    task_queue->Dispose(queue_id);
+  }
+}
+
 }  // namespace testing
 }  // namespace fml
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+
+namespace {
+
+// The state of a single |ParallelFor|. It is shared with the tasks posted to
+// the runner because those tasks may only get to run after all indices have
+// been claimed and |ParallelFor| has returned. Such late tasks find no index
+// left to claim, so they never call |fn|.
+struct ParallelForJob {
+  ParallelForJob(size_t p_count, const std::function<void(size_t)>& p_fn)
+      : count(p_count), fn(p_fn), latch(p_count) {}
+
+  const size_t count;
+  const std::function<void(size_t)> fn;
+  std::atomic_size_t next_index = 0;
+  CountDownLatch latch;
+
+  // Claims and runs indices until none are left.
+  void Run() {
+    size_t index;
+    while ((index = next_index.fetch_add(1)) < count) {
+      fn(index);
+      latch.CountDown();
+    }
+  }
+};
+
+}  // namespace
+
+void ParallelFor(const std::shared_ptr<BasicTaskRunner>& runner,
+                 size_t max_helpers,
+                 size_t count,
+                 const std::function<void(size_t index)>& fn) {
+  if (!runner || max_helpers == 0u || count < 2u) {
+    for (size_t i = 0; i < count; i++) {
+      fn(i);
+    }
+    return;
+  }
+
+  auto job = std::make_shared<ParallelForJob>(count, fn);
+  // The calling thread runs indices too, so one fewer helper is needed.
+  size_t helpers = std::min(max_helpers, count - 1);
+  for (size_t i = 0; i < helpers; i++) {
+    runner->PostTask([job]() { job->Run(); });
+  }
+  job->Run();
+  job->latch.Wait();
+}
+
+}  // namespace fml
@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_PARALLEL_FOR_H_
+#define FLUTTER_FML_PARALLEL_FOR_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/task_runner.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Calls |fn| once for every index in [0, |count|) and returns
+///             once all of the calls have returned.
+///
+///             The calling thread claims and runs indices itself, helped by up
+///             to |max_helpers| tasks posted to |runner|. Indices are claimed
+///             one at a time, so the calls are balanced across threads even if
+///             they take different amounts of time. The calls run on the
+///             calling thread alone if there is no |runner|, no helpers are
+///             allowed, or there are fewer than two indices.
+///
+///             |fn| must be safe to call concurrently for different indices.
+///             It is never called after |ParallelFor| returns, even if some
+///             of the posted tasks only get to run later.
+///
+void ParallelFor(const std::shared_ptr<BasicTaskRunner>& runner,
+                 size_t max_helpers,
+                 size_t count,
+                 const std::function<void(size_t index)>& fn);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_PARALLEL_FOR_H_
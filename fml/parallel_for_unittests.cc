@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/parallel_for.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+namespace {
+
+// Runs each task on a thread of its own.
+class ThreadTaskRunner : public BasicTaskRunner {
+ public:
+  ~ThreadTaskRunner() {
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void PostTask(const fml::closure& task) override {
+    std::scoped_lock lock(mutex_);
+    threads_.emplace_back(task);
+  }
+
+  size_t task_count() {
+    std::scoped_lock lock(mutex_);
+    return threads_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::thread> threads_;
+};
+
+// Keeps the tasks until they are run explicitly.
+class DeferredTaskRunner : public BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  void RunTasks() {
+    for (const auto& task : tasks_) {
+      task();
+    }
+    tasks_.clear();
+  }
+
+  size_t task_count() const { return tasks_.size(); }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+}  // namespace
+
+TEST(ParallelForTest, RunsOnCallingThreadWithoutHelpers) {
+  auto runner = std::make_shared<DeferredTaskRunner>();
+  const auto calling_thread = std::this_thread::get_id();
+  std::vector<int> calls(10);
+  ParallelFor(runner, 0u, calls.size(), [&](size_t index) {
+    EXPECT_EQ(std::this_thread::get_id(), calling_thread);
+    calls[index]++;
+  });
+  EXPECT_EQ(runner->task_count(), 0u);
+  EXPECT_EQ(calls, std::vector<int>(10, 1));
+
+  ParallelFor(nullptr, 4u, calls.size(), [&](size_t index) { calls[index]++; });
+  EXPECT_EQ(calls, std::vector<int>(10, 2));
+}
+
+TEST(ParallelForTest, CallsEveryIndexOnceAcrossHelpers) {
+  auto runner = std::make_shared<ThreadTaskRunner>();
+  std::vector<std::atomic_int> calls(1000);
+  ParallelFor(runner, 3u, calls.size(),
+              [&](size_t index) { calls[index].fetch_add(1); });
+  EXPECT_EQ(runner->task_count(), 3u);
+  for (const auto& call : calls) {
+    EXPECT_EQ(call.load(), 1);
+  }
+}
+
+TEST(ParallelForTest, PostsNoMoreHelpersThanNeeded) {
+  auto runner = std::make_shared<ThreadTaskRunner>();
+  std::atomic_int calls = 0;
+  ParallelFor(runner, 8u, 3u, [&](size_t index) { calls.fetch_add(1); });
+  EXPECT_EQ(runner->task_count(), 2u);
+  EXPECT_EQ(calls.load(), 3);
+}
+
+TEST(ParallelForTest, LateHelpersDoNotCallAfterReturning) {
+  auto runner = std::make_shared<DeferredTaskRunner>();
+  int calls = 0;
+  ParallelFor(runner, 2u, 5u, [&](size_t index) { calls++; });
+  EXPECT_EQ(calls, 5);
+  EXPECT_EQ(runner->task_count(), 2u);
+  runner->RunTasks();
+  EXPECT_EQ(calls, 5);
+}
+
+}  // namespace testing
+}  // namespace fml
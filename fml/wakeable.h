@@ -15,6 +15,9 @@ class Wakeable {
  public:
   virtual ~Wakeable() {}
 
+  /// Schedules the message loop to wake up at |time_point|, replacing any
+  /// previously scheduled time. Can be called from any thread, but not from
+  /// several threads at once.
   virtual void WakeUp(fml::TimePoint time_point) = 0;
 };
 
@@ -31,14 +31,20 @@ bool PaintPassDelegate::CanCollapseIntoParentPass(EntityPass* entity_pass) {
   return false;
 }
 
+// |EntityPassDelgate|
+bool PaintPassDelegate::CanRenderIntoLargerTarget() const {
+  return !paint_.image_filter && !paint_.HasColorFilter();
+}
+
 // |EntityPassDelgate|
 std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
     std::shared_ptr<Texture> target,
+    ISize size,
     const Matrix& effect_transform) {
-  auto contents = TextureContents::MakeRect(Rect::MakeSize(target->GetSize()));
+  auto contents = TextureContents::MakeRect(Rect::MakeSize(size));
   contents->SetTexture(target);
   contents->SetLabel("Subpass");
-  contents->SetSourceRect(Rect::MakeSize(target->GetSize()));
+  contents->SetSourceRect(Rect::MakeSize(size));
   contents->SetOpacity(paint_.color.alpha);
   contents->SetDeferApplyingOpacity(true);
 
@@ -131,15 +137,21 @@ bool OpacityPeepholePassDelegate::CanCollapseIntoParentPass(
   return true;
 }
 
+// |EntityPassDelgate|
+bool OpacityPeepholePassDelegate::CanRenderIntoLargerTarget() const {
+  return !paint_.image_filter && !paint_.HasColorFilter();
+}
+
 // |EntityPassDelgate|
 std::shared_ptr<Contents>
 OpacityPeepholePassDelegate::CreateContentsForSubpassTarget(
     std::shared_ptr<Texture> target,
+    ISize size,
     const Matrix& effect_transform) {
-  auto contents = TextureContents::MakeRect(Rect::MakeSize(target->GetSize()));
+  auto contents = TextureContents::MakeRect(Rect::MakeSize(size));
   contents->SetLabel("Subpass");
   contents->SetTexture(target);
-  contents->SetSourceRect(Rect::MakeSize(target->GetSize()));
+  contents->SetSourceRect(Rect::MakeSize(size));
   contents->SetOpacity(paint_.color.alpha);
   contents->SetDeferApplyingOpacity(true);
 
@@ -26,9 +26,13 @@ class PaintPassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   bool CanCollapseIntoParentPass(EntityPass* entity_pass) override;
 
+  // |EntityPassDelgate|
+  bool CanRenderIntoLargerTarget() const override;
+
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) override;
 
   // |EntityPassDelgate|
@@ -62,9 +66,13 @@ class OpacityPeepholePassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   bool CanCollapseIntoParentPass(EntityPass* entity_pass) override;
 
+  // |EntityPassDelgate|
+  bool CanRenderIntoLargerTarget() const override;
+
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) override;
 
   // |EntityPassDelgate|
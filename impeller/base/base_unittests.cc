@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/testing/testing.h"
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/thread.h"
 
@@ -233,5 +234,50 @@ TEST(ConditionVariableTest, TestsCriticalSectionAfterWait) {
   ASSERT_EQ(sum, kThreadCount);
 }
 
+TEST(FramePhaseTimingsTest, AccumulatesAndResetsPhases) {
+  FramePhaseTimings timings;
+  timings.Add(FramePhase::kEncode, fml::TimeDelta::FromMicroseconds(10));
+  timings.Add(FramePhase::kEncode, fml::TimeDelta::FromMicroseconds(5));
+  timings.SetGPUDuration(fml::TimeDelta::FromMicroseconds(100));
+  {
+    ScopedFramePhase phase(nullptr, FramePhase::kSubmit);
+  }
+
+  EXPECT_EQ(timings.Get(FramePhase::kEncode),
+            fml::TimeDelta::FromMicroseconds(15));
+  EXPECT_EQ(timings.Get(FramePhase::kSubmit), fml::TimeDelta::Zero());
+
+  timings.Reset();
+  EXPECT_EQ(timings.Get(FramePhase::kEncode), fml::TimeDelta::Zero());
+  // The GPU duration belongs to an earlier frame and survives resets.
+  EXPECT_EQ(timings.GetGPUDuration(), fml::TimeDelta::FromMicroseconds(100));
+}
+
+TEST(FramePhaseTimingsTest, ReportsWorkerPhasesOfCompletedFrames) {
+  FramePhaseTimings timings;
+  {
+    ScopedWorkerFramePhases worker_phases;
+    timings.AddWorker(FramePhase::kEncode, fml::TimeDelta::FromMicroseconds(7));
+    ScopedFramePhase phase(&timings, FramePhase::kSubmit);
+  }
+  // The worker tasks of the frame have not completed yet.
+  EXPECT_EQ(timings.GetWorker(FramePhase::kEncode), fml::TimeDelta::Zero());
+  EXPECT_EQ(timings.Get(FramePhase::kSubmit), fml::TimeDelta::Zero());
+
+  timings.CompleteWorkerFrame();
+  timings.Reset();
+  EXPECT_EQ(timings.GetWorker(FramePhase::kEncode),
+            fml::TimeDelta::FromMicroseconds(7));
+  EXPECT_GE(timings.GetWorker(FramePhase::kSubmit), fml::TimeDelta::Zero());
+
+  // Phases recorded outside of the scope are not worker time.
+  {
+    ScopedFramePhase phase(&timings, FramePhase::kSubmit);
+  }
+  timings.CompleteWorkerFrame();
+  EXPECT_EQ(timings.GetWorker(FramePhase::kEncode), fml::TimeDelta::Zero());
+  EXPECT_EQ(timings.GetWorker(FramePhase::kSubmit), fml::TimeDelta::Zero());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/base/frame_phase_timings.h"
+
+#include <utility>
+
+namespace impeller {
+
+// Whether the current thread is inside a |ScopedWorkerFramePhases|.
+static thread_local bool tRecordsWorkerPhases = false;
+
+FramePhaseTimings::FramePhaseTimings() = default;
+
+FramePhaseTimings::~FramePhaseTimings() = default;
+
+void FramePhaseTimings::Add(FramePhase phase, fml::TimeDelta duration) {
+  phase_nanoseconds_[static_cast<size_t>(phase)].fetch_add(
+      duration.ToNanoseconds(), std::memory_order_relaxed);
+}
+
+fml::TimeDelta FramePhaseTimings::Get(FramePhase phase) const {
+  return fml::TimeDelta::FromNanoseconds(
+      phase_nanoseconds_[static_cast<size_t>(phase)].load(
+          std::memory_order_relaxed));
+}
+
+void FramePhaseTimings::Reset() {
+  for (auto& nanoseconds : phase_nanoseconds_) {
+    nanoseconds.store(0, std::memory_order_relaxed);
+  }
+}
+
+void FramePhaseTimings::SetGPUDuration(fml::TimeDelta duration) {
+  gpu_nanoseconds_.store(duration.ToNanoseconds(), std::memory_order_relaxed);
+}
+
+fml::TimeDelta FramePhaseTimings::GetGPUDuration() const {
+  return fml::TimeDelta::FromNanoseconds(
+      gpu_nanoseconds_.load(std::memory_order_relaxed));
+}
+
+void FramePhaseTimings::AddWorker(FramePhase phase, fml::TimeDelta duration) {
+  worker_nanoseconds_[static_cast<size_t>(phase)].fetch_add(
+      duration.ToNanoseconds(), std::memory_order_relaxed);
+}
+
+void FramePhaseTimings::CompleteWorkerFrame() {
+  for (size_t i = 0; i < kFramePhaseCount; i++) {
+    completed_worker_nanoseconds_[i].store(
+        worker_nanoseconds_[i].exchange(0, std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  }
+}
+
+fml::TimeDelta FramePhaseTimings::GetWorker(FramePhase phase) const {
+  return fml::TimeDelta::FromNanoseconds(
+      completed_worker_nanoseconds_[static_cast<size_t>(phase)].load(
+          std::memory_order_relaxed));
+}
+
+ScopedFramePhase::ScopedFramePhase(FramePhaseTimings* timings,
+                                   FramePhase phase)
+    : timings_(timings),
+      phase_(phase),
+      start_(timings ? fml::TimePoint::Now() : fml::TimePoint()) {}
+
+ScopedFramePhase::~ScopedFramePhase() {
+  if (!timings_) {
+    return;
+  }
+  fml::TimeDelta duration = fml::TimePoint::Now() - start_;
+  if (tRecordsWorkerPhases) {
+    timings_->AddWorker(phase_, duration);
+  } else {
+    timings_->Add(phase_, duration);
+  }
+}
+
+ScopedWorkerFramePhases::ScopedWorkerFramePhases()
+    : was_worker_(std::exchange(tRecordsWorkerPhases, true)) {}
+
+ScopedWorkerFramePhases::~ScopedWorkerFramePhases() {
+  tRecordsWorkerPhases = was_worker_;
+}
+
+}  // namespace impeller
@@ -0,0 +1,132 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_BASE_FRAME_PHASE_TIMINGS_H_
+#define FLUTTER_IMPELLER_BASE_FRAME_PHASE_TIMINGS_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The parts of rendering a frame whose CPU time is accumulated
+///             by |FramePhaseTimings|.
+///
+enum class FramePhase : size_t {
+  /// Dispatching display lists into Aiks.
+  kDispatch,
+  /// Tessellating paths.
+  kTessellation,
+  /// Creating or updating glyph atlases.
+  kGlyphAtlas,
+  /// Encoding render and compute passes into command buffers.
+  kEncode,
+  /// Submitting command buffers.
+  kSubmit,
+};
+
+static constexpr size_t kFramePhaseCount =
+    static_cast<size_t>(FramePhase::kSubmit) + 1u;
+
+//------------------------------------------------------------------------------
+/// @brief      Accumulates the time spent in each |FramePhase| since the last
+///             |Reset|, along with the GPU execution time of the most recent
+///             frame whose GPU work completed.
+///
+///             Embedders reset the timings when they start rendering a frame
+///             and read them once the frame has been submitted. Work that
+///             runs on worker threads on behalf of a frame, see
+///             |ScopedWorkerFramePhases|, may still be running at that point.
+///             Like the GPU duration, it is reported separately for the most
+///             recent frame whose worker tasks completed.
+///
+/// @note       This class is thread-safe.
+///
+class FramePhaseTimings {
+ public:
+  FramePhaseTimings();
+
+  ~FramePhaseTimings();
+
+  void Add(FramePhase phase, fml::TimeDelta duration);
+
+  fml::TimeDelta Get(FramePhase phase) const;
+
+  /// @brief      Resets the time of every phase to zero. The GPU duration is
+  ///             kept as it is reported after the frame that it belongs to.
+  void Reset();
+
+  void SetGPUDuration(fml::TimeDelta duration);
+
+  fml::TimeDelta GetGPUDuration() const;
+
+  /// @brief      Adds time spent in a phase on a worker thread. It is reported
+  ///             by |GetWorker| after the next |CompleteWorkerFrame|.
+  void AddWorker(FramePhase phase, fml::TimeDelta duration);
+
+  /// @brief      Called on the worker thread once the tasks of a frame have
+  ///             run, to report the worker time added since the last call.
+  void CompleteWorkerFrame();
+
+  /// @brief      The time spent in a phase on worker threads by the most
+  ///             recent frame whose worker tasks completed.
+  fml::TimeDelta GetWorker(FramePhase phase) const;
+
+ private:
+  std::atomic<int64_t> phase_nanoseconds_[kFramePhaseCount] = {};
+  std::atomic<int64_t> worker_nanoseconds_[kFramePhaseCount] = {};
+  std::atomic<int64_t> completed_worker_nanoseconds_[kFramePhaseCount] = {};
+  std::atomic<int64_t> gpu_nanoseconds_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramePhaseTimings);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Adds the time spent in its scope to a phase. Does nothing if
+///             the timings are null.
+///
+///             Inside a |ScopedWorkerFramePhases| the time is added with
+///             |FramePhaseTimings::AddWorker|.
+///
+class ScopedFramePhase {
+ public:
+  ScopedFramePhase(FramePhaseTimings* timings, FramePhase phase);
+
+  ~ScopedFramePhase();
+
+ private:
+  FramePhaseTimings* timings_;
+  const FramePhase phase_;
+  const fml::TimePoint start_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedFramePhase);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Marks the current thread as running a task on behalf of a frame
+///             that is rendered on another thread, so that the phases
+///             recorded by |ScopedFramePhase| in its scope are reported as
+///             worker time.
+///
+class ScopedWorkerFramePhases {
+ public:
+  ScopedWorkerFramePhases();
+
+  ~ScopedWorkerFramePhases();
+
+ private:
+  const bool was_worker_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedWorkerFramePhases);
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_BASE_FRAME_PHASE_TIMINGS_H_
@@ -19,17 +19,41 @@ std::shared_ptr<HostBuffer> HostBuffer::Create() {
   return std::shared_ptr<HostBuffer>(new HostBuffer());
 }
 
+std::shared_ptr<HostBuffer> HostBuffer::CreateArena(size_t chunk_size) {
+  return std::shared_ptr<HostBuffer>(
+      new HostBuffer(std::max<size_t>(chunk_size, 1u)));
+}
+
 HostBuffer::HostBuffer() = default;
 
+HostBuffer::HostBuffer(size_t arena_chunk_size)
+    : arena_chunk_size_(arena_chunk_size) {}
+
 HostBuffer::~HostBuffer() = default;
 
 void HostBuffer::SetLabel(std::string label) {
+  for (const auto& chunk : arena_chunks_) {
+    chunk->label = label;
+  }
+  for (const auto& chunk : arena_oversized_chunks_) {
+    chunk->label = label;
+  }
   state_->label = std::move(label);
 }
 
 BufferView HostBuffer::Emplace(const void* buffer,
                                size_t length,
                                size_t align) {
+  if (arena_chunk_size_ > 0u) {
+    auto [chunk, offset] = ArenaAllocate(length, align);
+    if (!chunk) {
+      return {};
+    }
+    if (buffer) {
+      ::memmove(chunk->GetBuffer() + offset, buffer, length);
+    }
+    return BufferView{chunk, chunk->GetBuffer(), Range{offset, length}};
+  }
   auto [device_buffer, range] = state_->Emplace(buffer, length, align);
   if (!device_buffer) {
     return {};
@@ -38,6 +62,9 @@ BufferView HostBuffer::Emplace(const void* buffer,
 }
 
 BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
+  if (arena_chunk_size_ > 0u) {
+    return Emplace(buffer, length, 0u);
+  }
   auto [device_buffer, range] = state_->Emplace(buffer, length);
   if (!device_buffer) {
     return {};
@@ -48,6 +75,17 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
 BufferView HostBuffer::Emplace(size_t length,
                                size_t align,
                                const EmplaceProc& cb) {
+  if (arena_chunk_size_ > 0u) {
+    if (!cb) {
+      return {};
+    }
+    auto [chunk, offset] = ArenaAllocate(length, align);
+    if (!chunk) {
+      return {};
+    }
+    cb(chunk->GetBuffer() + offset);
+    return BufferView{chunk, chunk->GetBuffer(), Range{offset, length}};
+  }
   auto [buffer, range] = state_->Emplace(length, align, cb);
   if (!buffer) {
     return {};
@@ -62,14 +100,118 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
 
 void HostBuffer::Reset() {
   state_->Reset();
+  for (const auto& chunk : arena_chunks_) {
+    chunk->Reset();
+  }
+  arena_oversized_chunks_.clear();
+  arena_current_chunk_.reset();
+  arena_statistics_.bytes_used = 0u;
+  arena_statistics_.bytes_wasted = 0u;
+}
+
+void HostBuffer::Trim(size_t max_size) {
+  FML_DCHECK(!arena_current_chunk_.has_value());
+  size_t size = GetSize();
+  while (size > max_size && !arena_chunks_.empty()) {
+    size -= arena_chunks_.back()->GetReservedLength();
+    arena_chunks_.pop_back();
+  }
 }
 
 size_t HostBuffer::GetSize() const {
-  return state_->GetReservedLength();
+  size_t size = state_->GetReservedLength();
+  for (const auto& chunk : arena_chunks_) {
+    size += chunk->GetReservedLength();
+  }
+  for (const auto& chunk : arena_oversized_chunks_) {
+    size += chunk->GetReservedLength();
+  }
+  return size;
 }
 
 size_t HostBuffer::GetLength() const {
-  return state_->GetLength();
+  size_t length = state_->GetLength();
+  for (const auto& chunk : arena_chunks_) {
+    length += chunk->GetLength();
+  }
+  for (const auto& chunk : arena_oversized_chunks_) {
+    length += chunk->GetLength();
+  }
+  return length;
+}
+
+std::shared_ptr<HostBuffer::HostBufferState> HostBuffer::CreateArenaChunk(
+    size_t size) const {
+  auto chunk = std::make_shared<HostBufferState>();
+  chunk->is_arena_chunk = true;
+  // Reserve the whole chunk up front. Later truncations within the reserved
+  // size never reallocate.
+  if (!chunk->Truncate(size, /*npot=*/false) ||
+      !chunk->Truncate(0u, /*npot=*/false)) {
+    return nullptr;
+  }
+  chunk->label = state_->label;
+  return chunk;
+}
+
+std::pair<std::shared_ptr<HostBuffer::HostBufferState>, size_t>
+HostBuffer::ArenaAllocate(size_t length, size_t align) {
+  if (length > arena_chunk_size_) {
+    auto chunk = CreateArenaChunk(length);
+    if (!chunk || !chunk->Truncate(length, /*npot=*/false)) {
+      return {};
+    }
+    chunk->generation++;
+    arena_oversized_chunks_.push_back(chunk);
+    arena_statistics_.oversized_allocations++;
+    arena_statistics_.bytes_used += length;
+    return std::make_pair(std::move(chunk), 0u);
+  }
+
+  auto align_offset = [align](size_t offset) {
+    if (align == 0u || (offset % align) == 0u) {
+      return offset;
+    }
+    return offset + align - (offset % align);
+  };
+
+  size_t index = 0u;
+  size_t offset = 0u;
+  bool starts_chunk = true;
+  if (arena_current_chunk_.has_value()) {
+    index = arena_current_chunk_.value();
+    offset = align_offset(arena_chunks_[index]->GetLength());
+    if (offset + length > arena_chunk_size_) {
+      // Move on to the next chunk, leaving the rest of this one unused.
+      arena_statistics_.bytes_wasted +=
+          arena_chunk_size_ - arena_chunks_[index]->GetLength();
+      index++;
+      offset = 0u;
+    } else {
+      starts_chunk = false;
+    }
+  }
+
+  if (index == arena_chunks_.size()) {
+    auto chunk = CreateArenaChunk(arena_chunk_size_);
+    if (!chunk) {
+      return {};
+    }
+    arena_chunks_.push_back(std::move(chunk));
+    arena_statistics_.chunks_allocated++;
+  } else if (starts_chunk) {
+    arena_statistics_.chunks_reused++;
+  }
+  arena_current_chunk_ = index;
+
+  const auto& chunk = arena_chunks_[index];
+  arena_statistics_.bytes_wasted += offset - chunk->GetLength();
+  if (!chunk->Truncate(offset + length, /*npot=*/false)) {
+    return {};
+  }
+  chunk->generation++;
+  arena_statistics_.bytes_used += length;
+  return std::make_pair(chunk, offset);
 }
 
 std::pair<uint8_t*, Range> HostBuffer::HostBufferState::Emplace(
@@ -139,7 +281,9 @@ std::pair<uint8_t*, Range> HostBuffer::HostBufferState::Emplace(
 void HostBuffer::HostBufferState::Reset() {
   generation += 1;
   device_buffer = nullptr;
-  bool did_truncate = Truncate(0);
+  // Arena chunks are reserved at their exact size, which may be less than
+  // the page that is reserved for an empty buffer otherwise.
+  bool did_truncate = Truncate(0, /*npot=*/!is_arena_chunk);
   FML_CHECK(did_truncate);
 }
 
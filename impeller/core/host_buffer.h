@@ -7,8 +7,10 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "impeller/base/allocation.h"
 #include "impeller/core/buffer.h"
@@ -19,8 +21,56 @@ namespace impeller {
 
 class HostBuffer final : public Buffer {
  public:
+  static constexpr size_t kDefaultArenaChunkSize = 64u * 1024u;
+
   static std::shared_ptr<HostBuffer> Create();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a host buffer that stores its contents in chunks of a
+  ///             fixed size instead of in a single growable allocation.
+  ///
+  ///             Data is emplaced by bumping an offset into the current chunk
+  ///             and moves on to the next chunk when it does not fit, so
+  ///             emplacing never reallocates or copies data that was emplaced
+  ///             before. Data that is larger than a chunk gets an allocation
+  ///             of its own. |Reset| keeps the chunks so that they are reused
+  ///             when the buffer is filled again, such as when it is recycled
+  ///             for the next frame.
+  ///
+  ///             Each chunk is a separate |Buffer|, so the views returned by
+  ///             an arena refer to the chunk that holds their data.
+  ///
+  /// @param[in]  chunk_size  The size in bytes of each chunk.
+  ///
+  static std::shared_ptr<HostBuffer> CreateArena(
+      size_t chunk_size = kDefaultArenaChunkSize);
+
+  /// Counters describing the memory use of a host buffer created with
+  /// |CreateArena|.
+  struct ArenaStatistics {
+    /// The number of bytes emplaced since the last reset.
+    size_t bytes_used = 0u;
+    /// The number of bytes skipped since the last reset, either to align
+    /// emplaced data or at the end of a chunk that the next emplacement did
+    /// not fit in.
+    size_t bytes_wasted = 0u;
+    /// The number of chunks allocated over the lifetime of the buffer.
+    size_t chunks_allocated = 0u;
+    /// The number of times a chunk allocated before a reset was filled again.
+    size_t chunks_reused = 0u;
+    /// The number of emplacements over the lifetime of the buffer that were
+    /// larger than a chunk.
+    size_t oversized_allocations = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The arena counters of this buffer. All counters are zero if
+  ///             the buffer was not created with |CreateArena|.
+  ///
+  const ArenaStatistics& GetArenaStatistics() const {
+    return arena_statistics_;
+  }
+
   // |Buffer|
   virtual ~HostBuffer();
 
@@ -114,6 +164,18 @@ class HostBuffer final : public Buffer {
   ///        reused.
   void Reset();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the chunks of a reset arena, starting with the last
+  ///             one, until the capacity is at most |max_size| bytes or no
+  ///             chunks are left.
+  ///
+  ///             This must only be called right after |Reset|, while no
+  ///             chunk holds emplaced data.
+  ///
+  /// @param[in]  max_size  The capacity in bytes to trim the buffer to.
+  ///
+  void Trim(size_t max_size);
+
   //----------------------------------------------------------------------------
   /// @brief Returns the capacity of the HostBuffer in memory in bytes.
   size_t GetSize() const;
@@ -145,10 +207,29 @@ class HostBuffer final : public Buffer {
     mutable size_t device_buffer_generation = 0u;
     size_t generation = 1u;
     std::string label;
+    bool is_arena_chunk = false;
   };
 
   std::shared_ptr<HostBufferState> state_ = std::make_shared<HostBufferState>();
 
+  // The chunk size of an arena, or zero if all data is emplaced into
+  // |state_|.
+  const size_t arena_chunk_size_ = 0u;
+  std::vector<std::shared_ptr<HostBufferState>> arena_chunks_;
+  std::vector<std::shared_ptr<HostBufferState>> arena_oversized_chunks_;
+  // The index of the chunk being filled, if any chunk has been filled since
+  // the last reset.
+  std::optional<size_t> arena_current_chunk_;
+  ArenaStatistics arena_statistics_;
+
+  std::shared_ptr<HostBufferState> CreateArenaChunk(size_t size) const;
+
+  // Reserves |length| bytes at an offset aligned to |align| in a chunk and
+  // returns the chunk and the offset.
+  std::pair<std::shared_ptr<HostBufferState>, size_t> ArenaAllocate(
+      size_t length,
+      size_t align);
+
   // |Buffer|
   std::shared_ptr<const DeviceBuffer> GetDeviceBuffer(
       Allocator& allocator) const override;
@@ -157,6 +238,8 @@ class HostBuffer final : public Buffer {
 
   HostBuffer();
 
+  explicit HostBuffer(size_t arena_chunk_size);
+
   HostBuffer(const HostBuffer&) = delete;
 
   HostBuffer& operator=(const HostBuffer&) = delete;
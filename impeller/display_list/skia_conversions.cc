@@ -124,6 +124,11 @@ Path ToPath(const SkPath& path, Point shift) {
   builder.SetConvexity(path.isConvex() ? Convexity::kConvex
                                        : Convexity::kUnknown);
   builder.Shift(shift);
+  if (shift.IsZero()) {
+    // Display lists share the same immutable SkPath every time a picture is
+    // drawn, which lets the tessellator recognize the path again.
+    builder.SetSourceId(path.getGenerationID());
+  }
   auto sk_bounds = path.getBounds().makeOutset(shift.x, shift.y);
   builder.SetBounds(ToRect(sk_bounds));
   return builder.TakePath(fill_type);
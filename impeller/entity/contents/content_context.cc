@@ -5,7 +5,10 @@
 #include "impeller/entity/contents/content_context.h"
 
 #include <memory>
+#include <sstream>
+#include <unordered_map>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/formats.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
@@ -20,6 +23,37 @@
 
 namespace impeller {
 
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  auto byte = [key](int shift) {
+    return static_cast<uint8_t>((key >> shift) & 0xFFu);
+  };
+  ContentContextOptions options{
+      .sample_count = static_cast<SampleCount>(byte(56)),
+      .blend_mode = static_cast<BlendMode>(byte(48)),
+      .stencil_compare = static_cast<CompareFunction>(byte(40)),
+      .stencil_operation = static_cast<StencilOperation>(byte(32)),
+      .primitive_type = static_cast<PrimitiveType>(byte(24)),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(byte(16)),
+      .has_stencil_attachment = ((key >> 2) & 1u) != 0u,
+      .wireframe = ((key >> 1) & 1u) != 0u,
+      .is_for_rrect_blur_clear = (key & 1u) != 0u,
+  };
+  // Keys with unused bits set or out of range enums weren't written by this
+  // build.
+  if (options.ToKey() != key ||
+      (options.sample_count != SampleCount::kCount1 &&
+       options.sample_count != SampleCount::kCount4) ||
+      options.blend_mode > BlendMode::kLast ||
+      options.stencil_compare > CompareFunction::kGreaterEqual ||
+      options.stencil_operation > StencilOperation::kDecrementWrap ||
+      options.primitive_type > PrimitiveType::kPoint ||
+      options.color_attachment_pixel_format > PixelFormat::kD32FloatS8UInt) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 void ContentContextOptions::ApplyToPipelineDescriptor(
     PipelineDescriptor& desc) const {
   auto pipeline_blend = blend_mode;
@@ -188,6 +222,7 @@ ContentContext::ContentContext(
   if (!context_ || !context_->IsValid()) {
     return;
   }
+  tessellator_->SetFramePhaseTimings(&context_->GetFramePhaseTimings());
   auto options = ContentContextOptions{
       .sample_count = SampleCount::kCount4,
       .color_attachment_pixel_format =
@@ -488,4 +523,123 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetPipelineWarmupLog(
+    std::shared_ptr<PipelineWarmupLog> log) {
+  pipeline_warmup_log_ = std::move(log);
+}
+
+size_t ContentContext::WarmUpPipelines(const PipelineWarmupLog& log) {
+  if (!IsValid()) {
+    return 0u;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::WarmUpPipelines");
+
+  std::unordered_map<std::string, VariantsBase*> variants_by_name;
+  for (VariantsBase* variants : GetAllVariants()) {
+    // Pipelines that aren't supported by the device have no prototype.
+    if (!variants->GetName().empty()) {
+      variants_by_name.emplace(variants->GetName(), variants);
+    }
+  }
+
+  size_t started = 0u;
+  for (const auto& entry : log.GetEntries()) {
+    auto found = variants_by_name.find(entry.pipeline_name);
+    if (found == variants_by_name.end()) {
+      continue;
+    }
+    std::optional<ContentContextOptions> options =
+        ContentContextOptions::FromKey(entry.options_key);
+    if (!options.has_value()) {
+      continue;
+    }
+    if (found->second->WarmUp(*context_, options.value())) {
+      started++;
+    }
+  }
+  return started;
+}
+
+std::string ContentContext::GetPipelineWarmupName(
+    const PipelineDescriptor& desc) {
+  std::stringstream stream;
+  stream << desc.GetLabel();
+  for (Scalar constant : desc.GetSpecializationConstants()) {
+    stream << " " << constant;
+  }
+  return stream.str();
+}
+
+std::vector<ContentContext::VariantsBase*> ContentContext::GetAllVariants()
+    const {
+  return {
+#ifdef IMPELLER_DEBUG
+      &checkerboard_pipelines_,
+#endif  // IMPELLER_DEBUG
+      &solid_fill_pipelines_,
+      &linear_gradient_fill_pipelines_,
+      &radial_gradient_fill_pipelines_,
+      &conical_gradient_fill_pipelines_,
+      &sweep_gradient_fill_pipelines_,
+      &linear_gradient_ssbo_fill_pipelines_,
+      &radial_gradient_ssbo_fill_pipelines_,
+      &conical_gradient_ssbo_fill_pipelines_,
+      &sweep_gradient_ssbo_fill_pipelines_,
+      &rrect_blur_pipelines_,
+      &texture_blend_pipelines_,
+      &texture_pipelines_,
+#ifdef IMPELLER_ENABLE_OPENGLES
+      &texture_external_pipelines_,
+      &tiled_texture_external_pipelines_,
+#endif  // IMPELLER_ENABLE_OPENGLES
+      &position_uv_pipelines_,
+      &tiled_texture_pipelines_,
+      &gaussian_blur_noalpha_decal_pipelines_,
+      &gaussian_blur_noalpha_nodecal_pipelines_,
+      &kernel_decal_pipelines_,
+      &kernel_nodecal_pipelines_,
+      &border_mask_blur_pipelines_,
+      &morphology_filter_pipelines_,
+      &color_matrix_color_filter_pipelines_,
+      &linear_to_srgb_filter_pipelines_,
+      &srgb_to_linear_filter_pipelines_,
+      &clip_pipelines_,
+      &glyph_atlas_pipelines_,
+      &glyph_atlas_color_pipelines_,
+      &geometry_color_pipelines_,
+      &yuv_to_rgb_filter_pipelines_,
+      &porter_duff_blend_pipelines_,
+      &blend_color_pipelines_,
+      &blend_colorburn_pipelines_,
+      &blend_colordodge_pipelines_,
+      &blend_darken_pipelines_,
+      &blend_difference_pipelines_,
+      &blend_exclusion_pipelines_,
+      &blend_hardlight_pipelines_,
+      &blend_hue_pipelines_,
+      &blend_lighten_pipelines_,
+      &blend_luminosity_pipelines_,
+      &blend_multiply_pipelines_,
+      &blend_overlay_pipelines_,
+      &blend_saturation_pipelines_,
+      &blend_screen_pipelines_,
+      &blend_softlight_pipelines_,
+      &framebuffer_blend_color_pipelines_,
+      &framebuffer_blend_colorburn_pipelines_,
+      &framebuffer_blend_colordodge_pipelines_,
+      &framebuffer_blend_darken_pipelines_,
+      &framebuffer_blend_difference_pipelines_,
+      &framebuffer_blend_exclusion_pipelines_,
+      &framebuffer_blend_hardlight_pipelines_,
+      &framebuffer_blend_hue_pipelines_,
+      &framebuffer_blend_lighten_pipelines_,
+      &framebuffer_blend_luminosity_pipelines_,
+      &framebuffer_blend_multiply_pipelines_,
+      &framebuffer_blend_overlay_pipelines_,
+      &framebuffer_blend_saturation_pipelines_,
+      &framebuffer_blend_screen_pipelines_,
+      &framebuffer_blend_softlight_pipelines_,
+  };
+}
+
 }  // namespace impeller
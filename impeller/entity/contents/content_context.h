@@ -15,6 +15,7 @@
 #include "flutter/fml/status_or.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/pipeline_warmup_log.h"
 #include "impeller/entity/entity.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
@@ -284,26 +285,36 @@ struct ContentContextOptions {
   bool wireframe = false;
   bool is_for_rrect_blur_clear = false;
 
+  /// @brief A packed representation of the options that is stable across
+  ///        launches of the same engine build.
+  constexpr uint64_t ToKey() const {
+    static_assert(sizeof(sample_count) == 1);
+    static_assert(sizeof(blend_mode) == 1);
+    static_assert(sizeof(stencil_compare) == 1);
+    static_assert(sizeof(stencil_operation) == 1);
+    static_assert(sizeof(primitive_type) == 1);
+    static_assert(sizeof(color_attachment_pixel_format) == 1);
+
+    return (is_for_rrect_blur_clear ? 1llu : 0llu) << 0 |
+           (wireframe ? 1llu : 0llu) << 1 |
+           (has_stencil_attachment ? 1llu : 0llu) << 2 |
+           // enums
+           static_cast<uint64_t>(color_attachment_pixel_format) << 16 |
+           static_cast<uint64_t>(primitive_type) << 24 |
+           static_cast<uint64_t>(stencil_operation) << 32 |
+           static_cast<uint64_t>(stencil_compare) << 40 |
+           static_cast<uint64_t>(blend_mode) << 48 |
+           static_cast<uint64_t>(sample_count) << 56;
+  }
+
+  /// @brief Unpacks options packed by |ToKey|, or returns std::nullopt if
+  ///        the key does not describe valid options, such as a key that was
+  ///        written by a different engine build.
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
+
   struct Hash {
     constexpr uint64_t operator()(const ContentContextOptions& o) const {
-      static_assert(sizeof(o.sample_count) == 1);
-      static_assert(sizeof(o.blend_mode) == 1);
-      static_assert(sizeof(o.sample_count) == 1);
-      static_assert(sizeof(o.stencil_compare) == 1);
-      static_assert(sizeof(o.stencil_operation) == 1);
-      static_assert(sizeof(o.primitive_type) == 1);
-      static_assert(sizeof(o.color_attachment_pixel_format) == 1);
-
-      return (o.is_for_rrect_blur_clear ? 1llu : 0llu) << 0 |
-             (o.wireframe ? 1llu : 0llu) << 1 |
-             (o.has_stencil_attachment ? 1llu : 0llu) << 2 |
-             // enums
-             static_cast<uint64_t>(o.color_attachment_pixel_format) << 16 |
-             static_cast<uint64_t>(o.primitive_type) << 24 |
-             static_cast<uint64_t>(o.stencil_operation) << 32 |
-             static_cast<uint64_t>(o.stencil_compare) << 40 |
-             static_cast<uint64_t>(o.blend_mode) << 48 |
-             static_cast<uint64_t>(o.sample_count) << 56;
+      return o.ToKey();
     }
   };
 
@@ -729,12 +740,46 @@ class ContentContext {
     return render_target_cache_;
   }
 
+  /// @brief Records every pipeline variant created from now on to `log`, or
+  ///        stops recording if `log` is nullptr.
+  void SetPipelineWarmupLog(std::shared_ptr<PipelineWarmupLog> log);
+
+  /// @brief Starts creating the pipeline variants in `log` that don't exist
+  ///        yet, without waiting for them. Backends that compile pipelines on
+  ///        worker threads do so in the background, and the first draw that
+  ///        needs a variant only waits for the compile if it is still
+  ///        running. Entries that don't match a pipeline of this build are
+  ///        skipped.
+  ///
+  ///        Like the other pipeline accessors, this must be called on the
+  ///        thread that renders with this context.
+  ///
+  /// @return The number of variants that were started.
+  size_t WarmUpPipelines(const PipelineWarmupLog& log);
+
  private:
   std::shared_ptr<Context> context_;
   std::shared_ptr<LazyGlyphAtlas> lazy_glyph_atlas_;
 
+  class VariantsBase {
+   public:
+    virtual ~VariantsBase() = default;
+
+    /// The name of the pipeline in warm-up logs, which is the label and
+    /// specialization constants of the prototype.
+    const std::string& GetName() const { return name_; }
+
+    /// Starts creating the variant for `options` from the prototype unless it
+    /// already exists. Returns whether it was started.
+    virtual bool WarmUp(const Context& context,
+                        const ContentContextOptions& options) = 0;
+
+   protected:
+    std::string name_;
+  };
+
   template <class PipelineT>
-  class Variants {
+  class Variants final : public VariantsBase {
    public:
     Variants() = default;
 
@@ -745,6 +790,9 @@ class ContentContext {
 
     void SetDefault(const ContentContextOptions& options,
                     std::unique_ptr<PipelineT> pipeline) {
+      if (auto desc = pipeline->GetDescriptor(); desc.has_value()) {
+        name_ = GetPipelineWarmupName(desc.value());
+      }
       default_options_ = options;
       Set(options, std::move(pipeline));
     }
@@ -780,6 +828,28 @@ class ContentContext {
 
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
+    // |VariantsBase|
+    bool WarmUp(const Context& context,
+                const ContentContextOptions& options) override {
+      if (Get(options)) {
+        return false;
+      }
+      auto prototype = GetDefault();
+      if (!prototype) {
+        return false;
+      }
+      // The same descriptor that |GetPipeline| derives from the prototype.
+      auto desc = prototype->GetDescriptor();
+      if (!desc.has_value()) {
+        return false;
+      }
+      options.ApplyToPipelineDescriptor(desc.value());
+      desc->SetLabel(
+          SPrintF("%s V#%zu", desc->GetLabel().c_str(), GetPipelineCount()));
+      Set(options, std::make_unique<PipelineT>(context, desc));
+      return true;
+    }
+
    private:
     std::optional<ContentContextOptions> default_options_;
     std::unordered_map<ContentContextOptions,
@@ -931,15 +1001,24 @@ class ContentContext {
     auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
     auto variant_pipeline = variant->WaitAndGet();
     container.Set(opts, std::move(variant));
+    if (pipeline_warmup_log_) {
+      pipeline_warmup_log_->Record(container.GetName(), opts.ToKey());
+    }
     return variant_pipeline;
   }
 
+  static std::string GetPipelineWarmupName(const PipelineDescriptor& desc);
+
+  /// Every set of variants, for replaying warm-up logs.
+  std::vector<VariantsBase*> GetAllVariants() const;
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
+  std::shared_ptr<PipelineWarmupLog> pipeline_warmup_log_;
   bool wireframe_ = false;
 
   ContentContext(const ContentContext&) = delete;
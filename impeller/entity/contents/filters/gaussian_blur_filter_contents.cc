@@ -5,7 +5,10 @@
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 
 #include <cmath>
+#include <unordered_map>
 
+#include "flutter/fml/hash_combine.h"
+#include "impeller/base/thread.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
@@ -171,7 +174,7 @@ fml::StatusOr<RenderTarget> MakeBlurSubpass(
         GaussianBlurVertexShader::BindFrameInfo(
             cmd, host_buffer.EmplaceUniform(frame_info));
         GaussianBlurFragmentShader::BindKernelSamples(
-            cmd, host_buffer.EmplaceUniform(GenerateBlurInfo(blur_info)));
+            cmd, host_buffer.EmplaceUniform(GetCachedBlurInfo(blur_info)));
         pass.AddCommand(std::move(cmd));
 
         return true;
@@ -185,6 +188,42 @@ fml::StatusOr<RenderTarget> MakeBlurSubpass(
   }
 }
 
+/// Downsamples the input through the intermediate steps of the downsample
+/// chain before the final downsample to `subpass_size`. Only the first pass
+/// samples outside of the input to add the gutter.
+fml::StatusOr<RenderTarget> MakeDownsampleChain(
+    const ContentContext& renderer,
+    std::shared_ptr<Texture> input_texture,
+    const SamplerDescriptor& sampler_descriptor,
+    const Quad& uvs,
+    const Size& padded_size,
+    Scalar downsample_scalar,
+    const ISize& subpass_size,
+    Entity::TileMode tile_mode) {
+  std::shared_ptr<Texture> texture = std::move(input_texture);
+  Quad level_uvs = uvs;
+  Entity::TileMode level_tile_mode = tile_mode;
+  std::vector<Scalar> steps =
+      GaussianBlurFilterContents::CalculateDownsampleSteps(downsample_scalar);
+  for (Scalar step : steps) {
+    Size level_size = padded_size * step;
+    fml::StatusOr<RenderTarget> level = MakeDownsampleSubpass(
+        renderer, texture, sampler_descriptor, level_uvs,
+        renderer.GetRenderTargetCache()->GetAllocationSize(
+            ISize(std::max(1.0f, std::round(level_size.width)),
+                  std::max(1.0f, std::round(level_size.height)))),
+        level_tile_mode);
+    if (!level.ok()) {
+      return level;
+    }
+    texture = level.value().GetRenderTargetTexture();
+    level_uvs = {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)};
+    level_tile_mode = Entity::TileMode::kClamp;
+  }
+  return MakeDownsampleSubpass(renderer, texture, sampler_descriptor,
+                               level_uvs, subpass_size, level_tile_mode);
+}
+
 /// Returns `rect` relative to `reference`, where Rect::MakeXYWH(0,0,1,1) will
 /// be returned when `rect` == `reference`.
 Rect MakeReferenceUVs(const Rect& reference, const Rect& rect) {
@@ -211,6 +250,17 @@ Scalar GaussianBlurFilterContents::CalculateScale(Scalar sigma) {
   return 4.0 / sigma;
 };
 
+std::vector<Scalar> GaussianBlurFilterContents::CalculateDownsampleSteps(
+    Scalar scalar) {
+  std::vector<Scalar> steps;
+  Scalar step = 0.5;
+  while (step > scalar) {
+    steps.push_back(step);
+    step *= 0.5;
+  }
+  return steps;
+}
+
 std::optional<Rect> GaussianBlurFilterContents::GetFilterSourceCoverage(
     const Matrix& effect_transform,
     const Rect& output_limit) const {
@@ -302,17 +352,22 @@ std::optional<Entity> GaussianBlurFilterContents::RenderFilter(
   //   !input_snapshot->GetCoverage()->Expand(-local_padding)
   //     .Contains(coverage_hint.value()))
   Vector2 downsampled_size = source_rect_padded.GetSize() * downsample_scalar;
-  ISize subpass_size =
-      ISize(round(downsampled_size.x), round(downsampled_size.y));
+  // Every pass samples the whole texture of the previous one, so the passes
+  // can be allocated at the rounded up size that the render target cache
+  // reuses while the blurred size changes from frame to frame. The effective
+  // scalar accounts for the rounding.
+  ISize subpass_size = renderer.GetRenderTargetCache()->GetAllocationSize(
+      ISize(round(downsampled_size.x), round(downsampled_size.y)));
   Vector2 effective_scalar =
       Vector2(subpass_size) / source_rect_padded.GetSize();
 
   Quad uvs = CalculateUVs(inputs[0], entity, source_rect_padded,
                           input_snapshot->texture->GetSize());
 
-  fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleSubpass(
+  fml::StatusOr<RenderTarget> pass1_out = MakeDownsampleChain(
       renderer, input_snapshot->texture, input_snapshot->sampler_descriptor,
-      uvs, subpass_size, tile_mode_);
+      uvs, source_rect_padded.GetSize(), desired_scalar, subpass_size,
+      tile_mode_);
 
   if (!pass1_out.ok()) {
     return std::nullopt;
@@ -459,4 +514,123 @@ KernelPipeline::FragmentShader::KernelSamples GenerateBlurInfo(
   return result;
 }
 
+KernelPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
+    KernelPipeline::FragmentShader::KernelSamples samples) {
+  using KernelSample = KernelPipeline::FragmentShader::KernelSample;
+  KernelPipeline::FragmentShader::KernelSamples result;
+  result.sample_count = 0;
+
+  // Sampling between two texels at a position weighted by their coefficients
+  // yields their weighted sum when the texture is linearly filtered.
+  auto merge = [&result](const KernelSample& a, const KernelSample& b) {
+    Scalar coefficient = a.coefficient + b.coefficient;
+    result.samples[result.sample_count++] = KernelSample{
+        .uv_offset = (a.uv_offset * a.coefficient +
+                      b.uv_offset * b.coefficient) /
+                     coefficient,
+        .coefficient = coefficient,
+    };
+  };
+
+  // The center sample is kept as is, and the samples on either side of it are
+  // merged in pairs, starting next to the center so that a leftover sample is
+  // the outermost one, which has the smallest coefficient. The order of the
+  // samples doesn't matter to the shader.
+  int center = samples.sample_count / 2;
+  for (int i = center - 1; i >= 1; i -= 2) {
+    merge(samples.samples[i], samples.samples[i - 1]);
+  }
+  if (center % 2 == 1) {
+    result.samples[result.sample_count++] = samples.samples[0];
+  }
+
+  result.samples[result.sample_count++] = samples.samples[center];
+
+  int right_count = samples.sample_count - center - 1;
+  for (int i = center + 1; i + 1 < samples.sample_count; i += 2) {
+    merge(samples.samples[i], samples.samples[i + 1]);
+  }
+  if (right_count % 2 == 1) {
+    result.samples[result.sample_count++] =
+        samples.samples[samples.sample_count - 1];
+  }
+  return result;
+}
+
+namespace {
+
+// The number of sigma buckets per pixel of the blur kernel cache.
+constexpr Scalar kSigmaBucketsPerPixel = 16.0f;
+
+// Caches the merged kernels for a unit offset of one pixel, keyed by the blur
+// radius and sigma bucket.
+struct BlurKernelKey {
+  int blur_radius;
+  int sigma_bucket;
+
+  bool operator==(const BlurKernelKey& other) const {
+    return blur_radius == other.blur_radius &&
+           sigma_bucket == other.sigma_bucket;
+  }
+};
+
+struct BlurKernelKeyHash {
+  std::size_t operator()(const BlurKernelKey& key) const {
+    return fml::HashCombine(key.blur_radius, key.sigma_bucket);
+  }
+};
+
+// Blurs that animate their sigma only ever visit a limited number of buckets,
+// but the cache is reset if it grows past this many kernels regardless.
+constexpr size_t kMaxCachedBlurKernels = 128u;
+
+Mutex g_blur_kernel_cache_mutex;
+std::unordered_map<BlurKernelKey,
+                   KernelPipeline::FragmentShader::KernelSamples,
+                   BlurKernelKeyHash>
+    g_blur_kernel_cache IPLR_GUARDED_BY(g_blur_kernel_cache_mutex);
+
+}  // namespace
+
+KernelPipeline::FragmentShader::KernelSamples GetCachedBlurInfo(
+    BlurParameters parameters) {
+  if (parameters.step_size != 1) {
+    return GenerateBlurInfo(parameters);
+  }
+
+  BlurKernelKey key = {
+      .blur_radius = parameters.blur_radius,
+      .sigma_bucket = std::max(
+          1, static_cast<int>(std::round(parameters.blur_sigma *
+                                         kSigmaBucketsPerPixel))),
+  };
+
+  KernelPipeline::FragmentShader::KernelSamples result;
+  {
+    Lock lock(g_blur_kernel_cache_mutex);
+    auto found = g_blur_kernel_cache.find(key);
+    if (found != g_blur_kernel_cache.end()) {
+      result = found->second;
+    } else {
+      result = LerpHackKernelSamples(GenerateBlurInfo(BlurParameters{
+          .blur_uv_offset = Point(1, 0),
+          .blur_sigma = key.sigma_bucket / kSigmaBucketsPerPixel,
+          .blur_radius = key.blur_radius,
+          .step_size = 1,
+      }));
+      if (g_blur_kernel_cache.size() >= kMaxCachedBlurKernels) {
+        g_blur_kernel_cache.clear();
+      }
+      g_blur_kernel_cache[key] = result;
+    }
+  }
+
+  // The cached kernel is along the x axis in pixels.
+  for (int i = 0; i < result.sample_count; ++i) {
+    result.samples[i].uv_offset =
+        parameters.blur_uv_offset * result.samples[i].uv_offset.x;
+  }
+  return result;
+}
+
 }  // namespace impeller
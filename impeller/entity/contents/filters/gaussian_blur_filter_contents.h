@@ -6,6 +6,8 @@
 #define FLUTTER_IMPELLER_ENTITY_CONTENTS_FILTERS_GAUSSIAN_BLUR_FILTER_CONTENTS_H_
 
 #include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 
@@ -21,6 +23,19 @@ struct BlurParameters {
 KernelPipeline::FragmentShader::KernelSamples GenerateBlurInfo(
     BlurParameters parameters);
 
+/// This will shrink the size of a kernel by roughly half by sampling between
+/// adjacent samples and relying on linear filtering of the texture to blend
+/// them with the right weights. Only valid for kernels with a step size of 1.
+KernelPipeline::FragmentShader::KernelSamples LerpHackKernelSamples(
+    KernelPipeline::FragmentShader::KernelSamples samples);
+
+/// Returns the kernel for `parameters` with adjacent samples merged, reusing
+/// the kernel generated for the same radius and sigma bucket. Sigmas are
+/// rounded to the nearest 1/16th of a pixel, which isn't noticeable, so that
+/// animated blurs don't generate a new kernel every frame.
+KernelPipeline::FragmentShader::KernelSamples GetCachedBlurInfo(
+    BlurParameters parameters);
+
 /// Performs a bidirectional Gaussian blur.
 ///
 /// This is accomplished by rendering multiple passes in multiple directions.
@@ -64,6 +79,14 @@ class GaussianBlurFilterContents final : public FilterContents {
   /// Visible for testing.
   static Scalar CalculateScale(Scalar sigma);
 
+  /// The scales of the intermediate downsample passes for a downsample by
+  /// `scalar`. Large downsamples halve the size one step at a time, like a
+  /// mip chain, so that every input pixel contributes to the result instead
+  /// of being skipped by a single linearly filtered pass.
+  ///
+  /// Visible for testing.
+  static std::vector<Scalar> CalculateDownsampleSteps(Scalar scalar);
+
   /// Scales down the sigma value to match Skia's behavior.
   ///
   /// effective_blur_radius = CalculateBlurRadius(ScaleSigma(sigma_));
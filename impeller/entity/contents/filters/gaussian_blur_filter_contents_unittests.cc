@@ -6,6 +6,7 @@
 #include "fml/status_or.h"
 #include "gmock/gmock.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
+#include "impeller/entity/contents/test/gaussian_blur_reference.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity_playground.h"
 #include "impeller/geometry/geometry_asserts.h"
@@ -48,6 +49,21 @@ Scalar CalculateSigmaForBlurRadius(Scalar radius) {
   return LowerBoundNewtonianMethod(f, radius, 2.f, 0.001f);
 }
 
+// A deterministic image with detail at every pixel.
+ReferenceImage MakeNoiseImage(ISize size) {
+  ReferenceImage image = ReferenceImage::Make(size);
+  uint32_t state = 12345u;
+  auto next = [&state]() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<Scalar>(state >> 8) / static_cast<Scalar>(1 << 24);
+  };
+  for (auto& pixel : image.pixels) {
+    Scalar alpha = next();
+    pixel = Color(next() * alpha, next() * alpha, next() * alpha, alpha);
+  }
+  return image;
+}
+
 }  // namespace
 
 class GaussianBlurFilterContentsTest : public EntityPlayground {
@@ -406,5 +422,93 @@ TEST(GaussianBlurFilterContentsTest, Coefficients) {
   }
 }
 
+TEST(GaussianBlurFilterContentsTest, LerpHackKernelSamplesHalvesSampleCount) {
+  BlurParameters parameters = {.blur_uv_offset = Point(1, 0),
+                               .blur_sigma = 2,
+                               .blur_radius = 5,
+                               .step_size = 1};
+  KernelPipeline::FragmentShader::KernelSamples samples =
+      GenerateBlurInfo(parameters);
+  KernelPipeline::FragmentShader::KernelSamples fast_samples =
+      LerpHackKernelSamples(samples);
+  EXPECT_EQ(samples.sample_count, 11);
+  EXPECT_EQ(fast_samples.sample_count, 7);
+
+  Scalar tally = 0;
+  for (int i = 0; i < fast_samples.sample_count; ++i) {
+    tally += fast_samples.samples[i].coefficient;
+  }
+  EXPECT_NEAR(tally, 1.0f, 1e-6);
+}
+
+TEST(GaussianBlurFilterContentsTest, LerpHackKernelSamplesMatchReference) {
+  ReferenceImage image = MakeNoiseImage(ISize(32, 8));
+  for (int radius : {1, 4, 5, 11}) {
+    Scalar sigma = radius / 3.0f;
+    BlurParameters parameters = {.blur_uv_offset = Point(1.0f / 32.0f, 0),
+                                 .blur_sigma = sigma,
+                                 .blur_radius = radius,
+                                 .step_size = 1};
+    KernelPipeline::FragmentShader::KernelSamples samples =
+        GenerateBlurInfo(parameters);
+    ReferenceImage expected = ReferenceGaussianBlur(
+        image, sigma, 0, radius, 0, Entity::TileMode::kClamp);
+
+    ReferenceImage full =
+        ApplyReferenceKernel(image, samples, Entity::TileMode::kClamp);
+    EXPECT_LT(GetMaxChannelDifference(full, expected), 1e-4) << radius;
+
+    ReferenceImage fast = ApplyReferenceKernel(
+        image, LerpHackKernelSamples(samples), Entity::TileMode::kClamp);
+    EXPECT_LT(GetMaxChannelDifference(fast, expected), 1e-4) << radius;
+  }
+}
+
+TEST(GaussianBlurFilterContentsTest, CachedBlurInfoMatchesGenerated) {
+  BlurParameters parameters = {.blur_uv_offset = Point(0, 0.25),
+                               .blur_sigma = 2,
+                               .blur_radius = 6,
+                               .step_size = 1};
+  KernelPipeline::FragmentShader::KernelSamples expected =
+      LerpHackKernelSamples(GenerateBlurInfo(parameters));
+
+  // Once to fill the cache and once to read from it.
+  for (int i = 0; i < 2; ++i) {
+    KernelPipeline::FragmentShader::KernelSamples samples =
+        GetCachedBlurInfo(parameters);
+    ASSERT_EQ(samples.sample_count, expected.sample_count);
+    for (int j = 0; j < samples.sample_count; ++j) {
+      EXPECT_NEAR(samples.samples[j].coefficient,
+                  expected.samples[j].coefficient, 1e-6);
+      EXPECT_POINT_NEAR(samples.samples[j].uv_offset,
+                        expected.samples[j].uv_offset);
+    }
+  }
+}
+
+TEST(GaussianBlurFilterContentsTest, CalculateDownsampleSteps) {
+  EXPECT_TRUE(GaussianBlurFilterContents::CalculateDownsampleSteps(1.0)
+                  .empty());
+  EXPECT_TRUE(GaussianBlurFilterContents::CalculateDownsampleSteps(0.5)
+                  .empty());
+  EXPECT_THAT(GaussianBlurFilterContents::CalculateDownsampleSteps(0.08),
+              ::testing::ElementsAre(0.5f, 0.25f, 0.125f));
+}
+
+TEST(GaussianBlurFilterContentsTest, ReferenceBlurPreservesEnergy) {
+  ReferenceImage image = ReferenceImage::Make(ISize(33, 33));
+  image.SetPixel(16, 16, Color::White());
+  ReferenceImage blurred = ReferenceGaussianBlur(image, 3, 3, 9, 9,
+                                                 Entity::TileMode::kDecal);
+  Scalar tally = 0;
+  for (const Color& pixel : blurred.pixels) {
+    tally += pixel.alpha;
+  }
+  EXPECT_NEAR(tally, 1.0f, 1e-5);
+  EXPECT_GT(blurred.GetPixel(16, 16).alpha, blurred.GetPixel(17, 16).alpha);
+  EXPECT_FLOAT_EQ(blurred.GetPixel(15, 16).alpha,
+                  blurred.GetPixel(17, 16).alpha);
+}
+
 }  // namespace testing
 }  // namespace impeller
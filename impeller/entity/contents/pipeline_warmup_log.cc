@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/pipeline_warmup_log.h"
+
+#include <cstring>
+
+namespace impeller {
+
+namespace {
+
+// "IPWL" in little endian.
+constexpr uint32_t kMagic = 0x4C575049u;
+
+// Pipeline labels are short. Anything longer is a corrupt log.
+constexpr uint32_t kMaxPipelineNameLength = 1024u;
+
+class Writer {
+ public:
+  template <class T>
+  void Write(const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    data_.insert(data_.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteString(const std::string& value) {
+    Write(static_cast<uint32_t>(value.size()));
+    data_.insert(data_.end(), value.begin(), value.end());
+  }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+class Reader {
+ public:
+  explicit Reader(const fml::Mapping& mapping)
+      : data_(mapping.GetMapping()), size_(mapping.GetSize()) {}
+
+  template <class T>
+  bool Read(T& value) {
+    if (!data_ || size_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    ::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    uint32_t length = 0u;
+    if (!Read(length) || length > kMaxPipelineNameLength ||
+        size_ - offset_ < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0u;
+};
+
+}  // namespace
+
+PipelineWarmupLog::PipelineWarmupLog() = default;
+
+PipelineWarmupLog::~PipelineWarmupLog() = default;
+
+std::shared_ptr<PipelineWarmupLog> PipelineWarmupLog::Deserialize(
+    const fml::Mapping& mapping) {
+  Reader reader(mapping);
+  uint32_t magic = 0u;
+  uint32_t version = 0u;
+  uint32_t count = 0u;
+  if (!reader.Read(magic) || magic != kMagic || !reader.Read(version) ||
+      version != kVersion || !reader.Read(count)) {
+    return nullptr;
+  }
+
+  auto log = std::make_shared<PipelineWarmupLog>();
+  for (uint32_t i = 0; i < count; i++) {
+    Entry entry;
+    if (!reader.ReadString(entry.pipeline_name) ||
+        !reader.Read(entry.options_key)) {
+      return nullptr;
+    }
+    log->Record(std::move(entry.pipeline_name), entry.options_key);
+  }
+
+  Lock lock(log->mutex_);
+  log->has_unsaved_entries_ = false;
+  return log;
+}
+
+bool PipelineWarmupLog::Record(std::string pipeline_name,
+                               uint64_t options_key) {
+  Entry entry{.pipeline_name = std::move(pipeline_name),
+              .options_key = options_key};
+  Lock lock(mutex_);
+  if (!recorded_.insert(entry).second) {
+    return false;
+  }
+  entries_.push_back(std::move(entry));
+  has_unsaved_entries_ = true;
+  return true;
+}
+
+std::vector<PipelineWarmupLog::Entry> PipelineWarmupLog::GetEntries() const {
+  Lock lock(mutex_);
+  return entries_;
+}
+
+size_t PipelineWarmupLog::GetEntryCount() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+bool PipelineWarmupLog::HasUnsavedEntries() const {
+  Lock lock(mutex_);
+  return has_unsaved_entries_;
+}
+
+std::unique_ptr<fml::Mapping> PipelineWarmupLog::Serialize() {
+  Writer writer;
+  {
+    Lock lock(mutex_);
+    writer.Write(kMagic);
+    writer.Write(kVersion);
+    writer.Write(static_cast<uint32_t>(entries_.size()));
+    for (const auto& entry : entries_) {
+      writer.WriteString(entry.pipeline_name);
+      writer.Write(entry.options_key);
+    }
+    has_unsaved_entries_ = false;
+  }
+  return std::make_unique<fml::DataMapping>(writer.TakeData());
+}
+
+}  // namespace impeller
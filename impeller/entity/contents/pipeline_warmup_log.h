@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_WARMUP_LOG_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_WARMUP_LOG_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+/// @brief A log of the pipeline variants that were created during a session,
+///        which can be saved and replayed on the next launch so that the
+///        variants are compiled before the first frame that needs them.
+///
+///        Each entry names the pipeline by the label and specialization
+///        constants of its prototype, and the variant by its packed
+///        |ContentContextOptions|. The log may be recorded to and serialized
+///        from any thread.
+class PipelineWarmupLog {
+ public:
+  struct Entry {
+    std::string pipeline_name;
+    uint64_t options_key = 0u;
+
+    bool operator<(const Entry& other) const {
+      return std::tie(pipeline_name, options_key) <
+             std::tie(other.pipeline_name, other.options_key);
+    }
+  };
+
+  /// The version of the serialized format. Logs of other versions are
+  /// ignored.
+  static constexpr uint32_t kVersion = 1u;
+
+  PipelineWarmupLog();
+
+  ~PipelineWarmupLog();
+
+  /// @brief Reads a log written by |Serialize|. Returns nullptr if the data
+  ///        is not a log of the current version or is truncated.
+  static std::shared_ptr<PipelineWarmupLog> Deserialize(
+      const fml::Mapping& mapping);
+
+  /// @brief Adds an entry to the log. Returns false if the entry had already
+  ///        been recorded.
+  bool Record(std::string pipeline_name, uint64_t options_key);
+
+  /// @brief The entries in the order that they were first recorded.
+  std::vector<Entry> GetEntries() const;
+
+  size_t GetEntryCount() const;
+
+  /// @brief Whether entries were recorded since the log was deserialized or
+  ///        last serialized.
+  bool HasUnsavedEntries() const;
+
+  /// @brief Writes the log in a compact binary format.
+  std::unique_ptr<fml::Mapping> Serialize();
+
+ private:
+  mutable Mutex mutex_;
+  std::vector<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  std::set<Entry> recorded_ IPLR_GUARDED_BY(mutex_);
+  bool has_unsaved_entries_ IPLR_GUARDED_BY(mutex_) = false;
+
+  PipelineWarmupLog(const PipelineWarmupLog&) = delete;
+
+  PipelineWarmupLog& operator=(const PipelineWarmupLog&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_PIPELINE_WARMUP_LOG_H_
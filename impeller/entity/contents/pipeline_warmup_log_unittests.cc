@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/pipeline_warmup_log.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(PipelineWarmupLogTest, RecordsEachEntryOnce) {
+  PipelineWarmupLog log;
+  EXPECT_FALSE(log.HasUnsavedEntries());
+  EXPECT_TRUE(log.Record("SolidFill Pipeline", 1u));
+  EXPECT_TRUE(log.Record("SolidFill Pipeline", 2u));
+  EXPECT_TRUE(log.Record("Texture Pipeline", 1u));
+  EXPECT_FALSE(log.Record("SolidFill Pipeline", 1u));
+  EXPECT_EQ(log.GetEntryCount(), 3u);
+  EXPECT_TRUE(log.HasUnsavedEntries());
+}
+
+TEST(PipelineWarmupLogTest, SerializationRoundTrips) {
+  PipelineWarmupLog log;
+  log.Record("SolidFill Pipeline", 0x0401000300000004u);
+  log.Record("Blend Pipeline 5 1", 42u);
+  auto mapping = log.Serialize();
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_FALSE(log.HasUnsavedEntries());
+
+  auto restored = PipelineWarmupLog::Deserialize(*mapping);
+  ASSERT_NE(restored, nullptr);
+  EXPECT_FALSE(restored->HasUnsavedEntries());
+  auto entries = restored->GetEntries();
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[0].pipeline_name, "SolidFill Pipeline");
+  EXPECT_EQ(entries[0].options_key, 0x0401000300000004u);
+  EXPECT_EQ(entries[1].pipeline_name, "Blend Pipeline 5 1");
+  EXPECT_EQ(entries[1].options_key, 42u);
+}
+
+TEST(PipelineWarmupLogTest, RejectsInvalidData) {
+  EXPECT_EQ(PipelineWarmupLog::Deserialize(fml::DataMapping("")), nullptr);
+  EXPECT_EQ(PipelineWarmupLog::Deserialize(
+                fml::DataMapping("not a pipeline warm-up log")),
+            nullptr);
+
+  PipelineWarmupLog log;
+  log.Record("SolidFill Pipeline", 1u);
+  auto mapping = log.Serialize();
+  std::vector<uint8_t> truncated(
+      mapping->GetMapping(), mapping->GetMapping() + mapping->GetSize() - 1);
+  EXPECT_EQ(PipelineWarmupLog::Deserialize(fml::DataMapping(truncated)),
+            nullptr);
+}
+
+TEST(PipelineWarmupLogTest, ContentContextOptionsKeyRoundTrips) {
+  ContentContextOptions options{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kPlus,
+      .stencil_compare = CompareFunction::kGreaterEqual,
+      .stencil_operation = StencilOperation::kIncrementClamp,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      .has_stencil_attachment = false,
+      .wireframe = true,
+  };
+  std::optional<ContentContextOptions> restored =
+      ContentContextOptions::FromKey(options.ToKey());
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_TRUE(ContentContextOptions::Equal{}(options, restored.value()));
+
+  // Unused bits, and enums out of range.
+  EXPECT_FALSE(ContentContextOptions::FromKey(options.ToKey() | 1u << 8));
+  ContentContextOptions bad_blend = options;
+  bad_blend.blend_mode = static_cast<BlendMode>(0xFF);
+  EXPECT_FALSE(ContentContextOptions::FromKey(bad_blend.ToKey()));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,126 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
+
+#include <iterator>
+
+#include "flutter/fml/logging.h"
+#include "impeller/base/strings.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+static const SolidColorContents* AsSolidColorContents(const Entity& entity) {
+  const auto& contents = entity.GetContents();
+  return contents ? contents->AsSolidColor() : nullptr;
+}
+
+bool SolidRectBatchContents::CanBatch(const Entity& entity) {
+  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      entity.GetTransform().HasPerspective()) {
+    return false;
+  }
+  const auto* contents = AsSolidColorContents(entity);
+  if (!contents || !contents->GetGeometry()) {
+    return false;
+  }
+  return contents->GetGeometry()->AsRect().has_value();
+}
+
+bool SolidRectBatchContents::CanBatchTogether(const Entity& a,
+                                              const Entity& b) {
+  return a.GetBlendMode() == b.GetBlendMode() &&
+         a.GetClipDepth() == b.GetClipDepth();
+}
+
+SolidRectBatchContents::SolidRectBatchContents() = default;
+
+SolidRectBatchContents::~SolidRectBatchContents() = default;
+
+void SolidRectBatchContents::AddEntity(const Entity& entity) {
+  FML_DCHECK(CanBatch(entity));
+  const auto* contents = AsSolidColorContents(entity);
+  Rect rect = contents->GetGeometry()->AsRect().value();
+  for (const Point& corner : rect.GetTransformedPoints(entity.GetTransform())) {
+    corners_.push_back(corner);
+  }
+  colors_.push_back(contents->GetColor().Premultiply());
+
+  Rect bounds = rect.TransformBounds(entity.GetTransform());
+  coverage_ = coverage_.has_value() ? coverage_->Union(bounds) : bounds;
+}
+
+size_t SolidRectBatchContents::GetRectCount() const {
+  return colors_.size();
+}
+
+std::optional<Rect> SolidRectBatchContents::GetCoverage(
+    const Entity& entity) const {
+  if (!coverage_.has_value()) {
+    return std::nullopt;
+  }
+  return coverage_->TransformBounds(entity.GetTransform());
+}
+
+bool SolidRectBatchContents::Render(const ContentContext& renderer,
+                                    const Entity& entity,
+                                    RenderPass& pass) const {
+  if (colors_.empty()) {
+    return true;
+  }
+
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  // Two triangles per rectangle. The corners are top left, top right, bottom
+  // left and bottom right.
+  static constexpr size_t kCornerIndices[] = {0, 1, 2, 1, 2, 3};
+  const size_t vertex_count = colors_.size() * std::size(kCornerIndices);
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  auto vertex_buffer_view = host_buffer.Emplace(
+      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+      [&](uint8_t* buffer) {
+        auto* vertices = reinterpret_cast<VS::PerVertexData*>(buffer);
+        for (size_t i = 0; i < colors_.size(); i++) {
+          for (size_t corner : kCornerIndices) {
+            *vertices++ = {
+                .position = corners_[i * 4 + corner],
+                .color = colors_[i],
+            };
+          }
+        }
+      });
+
+  Command cmd;
+  DEBUG_COMMAND_INFO(cmd, SPrintF("Solid Rect Batch (%zu rects)",
+                                  colors_.size()));
+  cmd.stencil_reference = entity.GetClipDepth();
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer.GetGeometryColorPipeline(options);
+  cmd.BindVertices(VertexBuffer{
+      .vertex_buffer = vertex_buffer_view,
+      .vertex_count = vertex_count,
+      .index_type = IndexType::kNone,
+  });
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = pass.GetOrthographicTransform() * entity.GetTransform();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_RECT_BATCH_CONTENTS_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_RECT_BATCH_CONTENTS_H_
+
+#include <optional>
+#include <vector>
+
+#include "impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Draws the rectangles of several solid color entities with a
+///             single command, using per-vertex colors.
+///
+///             The rectangles are drawn in the order they were added, so
+///             overlapping rectangles blend exactly as they would if each
+///             entity were drawn with its own command. Every entity in a
+///             batch must share its blend mode and clip depth, which become
+///             those of the entity that renders the batch.
+///
+class SolidRectBatchContents final : public Contents {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the entity draws a single solid color rectangle with
+  ///             a blend mode that the pipeline can perform, and so can be
+  ///             added to a batch.
+  ///
+  static bool CanBatch(const Entity& entity);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the two batchable entities can be drawn by the same
+  ///             batch.
+  ///
+  static bool CanBatchTogether(const Entity& a, const Entity& b);
+
+  SolidRectBatchContents();
+
+  ~SolidRectBatchContents() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the rectangle of a batchable entity, transformed into
+  ///             the space of the entity that renders the batch.
+  ///
+  void AddEntity(const Entity& entity);
+
+  size_t GetRectCount() const;
+
+  // |Contents|
+  std::optional<Rect> GetCoverage(const Entity& entity) const override;
+
+  // |Contents|
+  bool Render(const ContentContext& renderer,
+              const Entity& entity,
+              RenderPass& pass) const override;
+
+ private:
+  // The four corners of each rectangle, in the order of |Rect::GetPoints|.
+  std::vector<Point> corners_;
+  // The premultiplied color of each rectangle.
+  std::vector<Color> colors_;
+  std::optional<Rect> coverage_;
+
+  SolidRectBatchContents(const SolidRectBatchContents&) = delete;
+
+  SolidRectBatchContents& operator=(const SolidRectBatchContents&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_SOLID_RECT_BATCH_CONTENTS_H_
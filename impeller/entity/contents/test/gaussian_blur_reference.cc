@@ -0,0 +1,185 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/test/gaussian_blur_reference.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+namespace {
+
+// Maps a coordinate outside of [0, size) into it, or returns -1 if the pixel
+// is transparent.
+int64_t TileCoordinate(int64_t coordinate,
+                       int64_t size,
+                       Entity::TileMode tile_mode) {
+  if (coordinate >= 0 && coordinate < size) {
+    return coordinate;
+  }
+  switch (tile_mode) {
+    case Entity::TileMode::kClamp:
+      return std::clamp<int64_t>(coordinate, 0, size - 1);
+    case Entity::TileMode::kRepeat:
+      return ((coordinate % size) + size) % size;
+    case Entity::TileMode::kMirror: {
+      int64_t period = ((coordinate % (2 * size)) + 2 * size) % (2 * size);
+      return period < size ? period : 2 * size - 1 - period;
+    }
+    case Entity::TileMode::kDecal:
+      return -1;
+  }
+  FML_UNREACHABLE();
+}
+
+Color ReadPixel(const ReferenceImage& image,
+                int64_t x,
+                int64_t y,
+                Entity::TileMode tile_mode) {
+  x = TileCoordinate(x, image.size.width, tile_mode);
+  y = TileCoordinate(y, image.size.height, tile_mode);
+  if (x < 0 || y < 0) {
+    return Color::BlackTransparent();
+  }
+  return image.GetPixel(x, y);
+}
+
+// Sums in double precision so that the result doesn't depend on the order
+// of the taps.
+struct Accumulator {
+  double red = 0.0;
+  double green = 0.0;
+  double blue = 0.0;
+  double alpha = 0.0;
+
+  void Add(Color color, double weight) {
+    red += color.red * weight;
+    green += color.green * weight;
+    blue += color.blue * weight;
+    alpha += color.alpha * weight;
+  }
+
+  Color ToColor() const {
+    return Color(static_cast<Scalar>(red), static_cast<Scalar>(green),
+                 static_cast<Scalar>(blue), static_cast<Scalar>(alpha));
+  }
+};
+
+ReferenceImage BlurDirection(const ReferenceImage& image,
+                             Scalar sigma,
+                             int radius,
+                             int64_t dx,
+                             int64_t dy,
+                             Entity::TileMode tile_mode) {
+  if (sigma <= 0.0f || radius <= 0) {
+    return image;
+  }
+
+  std::vector<double> weights;
+  double tally = 0.0;
+  for (int i = -radius; i <= radius; i++) {
+    double weight = std::exp(-0.5 * i * i / (static_cast<double>(sigma) *
+                                             static_cast<double>(sigma)));
+    weights.push_back(weight);
+    tally += weight;
+  }
+
+  ReferenceImage result = ReferenceImage::Make(image.size);
+  for (int64_t y = 0; y < image.size.height; y++) {
+    for (int64_t x = 0; x < image.size.width; x++) {
+      Accumulator accumulator;
+      for (int i = -radius; i <= radius; i++) {
+        accumulator.Add(ReadPixel(image, x + i * dx, y + i * dy, tile_mode),
+                        weights[i + radius] / tally);
+      }
+      result.SetPixel(x, y, accumulator.ToColor());
+    }
+  }
+  return result;
+}
+
+// Samples the image at a position in pixels with linear filtering, where
+// pixel centers are at half pixel positions.
+Color SampleLinear(const ReferenceImage& image,
+                   Point position,
+                   Entity::TileMode tile_mode) {
+  double u = position.x - 0.5;
+  double v = position.y - 0.5;
+  double x0 = std::floor(u);
+  double y0 = std::floor(v);
+  double fx = u - x0;
+  double fy = v - y0;
+  auto x = static_cast<int64_t>(x0);
+  auto y = static_cast<int64_t>(y0);
+
+  Accumulator accumulator;
+  accumulator.Add(ReadPixel(image, x, y, tile_mode), (1 - fx) * (1 - fy));
+  accumulator.Add(ReadPixel(image, x + 1, y, tile_mode), fx * (1 - fy));
+  accumulator.Add(ReadPixel(image, x, y + 1, tile_mode), (1 - fx) * fy);
+  accumulator.Add(ReadPixel(image, x + 1, y + 1, tile_mode), fx * fy);
+  return accumulator.ToColor();
+}
+
+}  // namespace
+
+ReferenceImage ReferenceImage::Make(ISize size, Color color) {
+  return ReferenceImage{
+      .size = size,
+      .pixels = std::vector<Color>(size.Area(), color),
+  };
+}
+
+ReferenceImage ReferenceGaussianBlur(const ReferenceImage& image,
+                                     Scalar sigma_x,
+                                     Scalar sigma_y,
+                                     int radius_x,
+                                     int radius_y,
+                                     Entity::TileMode tile_mode) {
+  // Same order as the filter: vertical first, then horizontal.
+  ReferenceImage vertical =
+      BlurDirection(image, sigma_y, radius_y, 0, 1, tile_mode);
+  return BlurDirection(vertical, sigma_x, radius_x, 1, 0, tile_mode);
+}
+
+ReferenceImage ApplyReferenceKernel(
+    const ReferenceImage& image,
+    const KernelPipeline::FragmentShader::KernelSamples& samples,
+    Entity::TileMode tile_mode) {
+  ReferenceImage result = ReferenceImage::Make(image.size);
+  Point size(image.size.width, image.size.height);
+  for (int64_t y = 0; y < image.size.height; y++) {
+    for (int64_t x = 0; x < image.size.width; x++) {
+      Point center(x + 0.5f, y + 0.5f);
+      Accumulator accumulator;
+      for (int i = 0; i < samples.sample_count; i++) {
+        const auto& sample = samples.samples[i];
+        accumulator.Add(
+            SampleLinear(image, center + sample.uv_offset * size, tile_mode),
+            sample.coefficient);
+      }
+      result.SetPixel(x, y, accumulator.ToColor());
+    }
+  }
+  return result;
+}
+
+Scalar GetMaxChannelDifference(const ReferenceImage& a,
+                               const ReferenceImage& b) {
+  FML_CHECK(a.size == b.size);
+  Scalar difference = 0.0f;
+  for (size_t i = 0; i < a.pixels.size(); i++) {
+    const Color& ca = a.pixels[i];
+    const Color& cb = b.pixels[i];
+    difference = std::max({difference, std::abs(ca.red - cb.red),
+                           std::abs(ca.green - cb.green),
+                           std::abs(ca.blue - cb.blue),
+                           std::abs(ca.alpha - cb.alpha)});
+  }
+  return difference;
+}
+
+}  // namespace impeller
@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_CONTENTS_TEST_GAUSSIAN_BLUR_REFERENCE_H_
+#define FLUTTER_IMPELLER_ENTITY_CONTENTS_TEST_GAUSSIAN_BLUR_REFERENCE_H_
+
+#include <vector>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/entity.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/size.h"
+
+namespace impeller {
+
+/// @brief An image of premultiplied colors, stored in rows from the top.
+struct ReferenceImage {
+  ISize size;
+  std::vector<Color> pixels;
+
+  static ReferenceImage Make(ISize size, Color color = Color());
+
+  Color GetPixel(int64_t x, int64_t y) const {
+    return pixels[y * size.width + x];
+  }
+
+  void SetPixel(int64_t x, int64_t y, Color color) {
+    pixels[y * size.width + x] = color;
+  }
+};
+
+/// @brief A deterministic CPU implementation of the separable Gaussian blur.
+///
+///        Each direction is blurred with `2 * radius + 1` taps at whole pixel
+///        offsets, weighted by the normalized Gaussian for `sigma`. A sigma of
+///        0 leaves that direction unblurred. Pixels outside of the image are
+///        read according to `tile_mode`.
+ReferenceImage ReferenceGaussianBlur(const ReferenceImage& image,
+                                     Scalar sigma_x,
+                                     Scalar sigma_y,
+                                     int radius_x,
+                                     int radius_y,
+                                     Entity::TileMode tile_mode);
+
+/// @brief Applies kernel samples to the image the way the blur kernel shader
+///        does, with linear filtering for offsets between pixels.
+///
+///        The uv offsets of the samples are relative to the image size.
+ReferenceImage ApplyReferenceKernel(
+    const ReferenceImage& image,
+    const KernelPipeline::FragmentShader::KernelSamples& samples,
+    Entity::TileMode tile_mode);
+
+/// @brief The largest difference between any two channels of the images.
+Scalar GetMaxChannelDifference(const ReferenceImage& a,
+                               const ReferenceImage& b);
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_CONTENTS_TEST_GAUSSIAN_BLUR_REFERENCE_H_
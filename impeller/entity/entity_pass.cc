@@ -19,6 +19,7 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
@@ -599,10 +600,21 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
+    // Subpasses that are only ever sampled by the delegate's contents may be
+    // rendered into a target that the render target cache rounds up to a
+    // size bucket, so that the target is reused while the subpass size
+    // changes from frame to frame. Passes that read their own texture back
+    // need it to be the exact size.
+    auto subpass_target_size =
+        subpass->delegate_->CanRenderIntoLargerTarget() &&
+                subpass->GetTotalPassReads(renderer) == 0
+            ? renderer.GetRenderTargetCache()->GetAllocationSize(subpass_size)
+            : subpass_size;
+
     auto subpass_target = CreateRenderTarget(
-        renderer,                                        // renderer
-        subpass_size,                                    // size
-        subpass->GetClearColorOrDefault(subpass_size));  // clear_color
+        renderer,             // renderer
+        subpass_target_size,  // size
+        subpass->GetClearColorOrDefault(subpass_target_size));  // clear_color
 
     if (!subpass_target.IsValid()) {
       VALIDATION_LOG << "Subpass render target is invalid.";
@@ -646,7 +658,7 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
 
     auto offscreen_texture_contents =
         subpass->delegate_->CreateContentsForSubpassTarget(
-            subpass_texture,
+            subpass_texture, subpass_size,
             Matrix::MakeTranslation(Vector3{-global_pass_position}) *
                 subpass->transform_);
 
@@ -823,6 +835,58 @@ bool EntityPass::RenderElement(Entity& element_entity,
   return true;
 }
 
+bool EntityPass::RenderBatch(std::vector<Entity>& batch,
+                             size_t clip_depth_floor,
+                             InlinePassContext& pass_context,
+                             int32_t pass_depth,
+                             ContentContext& renderer,
+                             ClipCoverageStack& clip_coverage_stack,
+                             Point global_pass_position) const {
+  if (batch.empty()) {
+    return true;
+  }
+  std::vector<Entity> entities = std::move(batch);
+  batch.clear();
+
+  // Batched entities don't change the clip, so the clip coverage is the same
+  // for all of them. Cull them individually rather than by the batch's
+  // overall coverage.
+  auto current_clip_coverage = clip_coverage_stack.back().coverage;
+  if (current_clip_coverage.has_value()) {
+    current_clip_coverage = current_clip_coverage->Shift(-global_pass_position);
+  }
+
+  auto contents = std::make_shared<SolidRectBatchContents>();
+  const Entity* first_entity = nullptr;
+  for (const auto& entity : entities) {
+    if (!entity.ShouldRender(current_clip_coverage)) {
+      continue;
+    }
+    contents->AddEntity(entity);
+    if (!first_entity) {
+      first_entity = &entity;
+    }
+  }
+
+  if (contents->GetRectCount() <= 1) {
+    // Nothing to gain from batching a single entity. If all of them were
+    // culled, one is still passed on so that the render pass is set up as it
+    // would have been without batching.
+    Entity entity = (first_entity ? *first_entity : entities.front()).Clone();
+    return RenderElement(entity, clip_depth_floor, pass_context, pass_depth,
+                         renderer, clip_coverage_stack, global_pass_position);
+  }
+
+  Entity batch_entity;
+  batch_entity.SetCapture(first_entity->GetCapture());
+  batch_entity.SetContents(std::move(contents));
+  batch_entity.SetBlendMode(first_entity->GetBlendMode());
+  batch_entity.SetClipDepth(first_entity->GetClipDepth());
+  return RenderElement(batch_entity, clip_depth_floor, pass_context,
+                       pass_depth, renderer, clip_coverage_stack,
+                       global_pass_position);
+}
+
 bool EntityPass::OnRender(
     ContentContext& renderer,
     Capture& capture,
@@ -878,6 +942,9 @@ bool EntityPass::OnRender(
                                     // Backdrop filters act as a entity before
                                     // everything and disrupt the optimization.
                                     !backdrop_filter_proc_;
+  // Consecutive solid color rectangles that are waiting to be drawn with a
+  // single command.
+  std::vector<Entity> batch;
   for (const auto& element : elements_) {
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
@@ -889,6 +956,14 @@ bool EntityPass::OnRender(
       is_collapsing_clear_colors = false;
     }
 
+    // Subpasses may render into this pass or end it, so anything batched
+    // before them has to be drawn first.
+    if (!std::holds_alternative<Entity>(element) &&
+        !RenderBatch(batch, clip_depth_floor, pass_context, pass_depth,
+                     renderer, clip_coverage_stack, global_pass_position)) {
+      return false;
+    }
+
     EntityResult result =
         GetEntityForElement(element,               // element
                             renderer,              // renderer
@@ -911,6 +986,27 @@ bool EntityPass::OnRender(
         continue;
     };
 
+    //--------------------------------------------------------------------------
+    /// Batch solid color rectangles.
+    ///
+
+    if (SolidRectBatchContents::CanBatch(result.entity)) {
+      if (!batch.empty() && !SolidRectBatchContents::CanBatchTogether(
+                                batch.back(), result.entity)) {
+        if (!RenderBatch(batch, clip_depth_floor, pass_context, pass_depth,
+                         renderer, clip_coverage_stack,
+                         global_pass_position)) {
+          return false;
+        }
+      }
+      batch.push_back(std::move(result.entity));
+      continue;
+    }
+    if (!RenderBatch(batch, clip_depth_floor, pass_context, pass_depth,
+                     renderer, clip_coverage_stack, global_pass_position)) {
+      return false;
+    }
+
     //--------------------------------------------------------------------------
     /// Setup advanced blends.
     ///
@@ -971,6 +1067,10 @@ bool EntityPass::OnRender(
       return false;
     }
   }
+  if (!RenderBatch(batch, clip_depth_floor, pass_context, pass_depth, renderer,
+                   clip_coverage_stack, global_pass_position)) {
+    return false;
+  }
 
 #ifdef IMPELLER_DEBUG
   //--------------------------------------------------------------------------
@@ -204,6 +204,17 @@ class EntityPass {
                      ClipCoverageStack& clip_coverage_stack,
                      Point global_pass_position) const;
 
+  /// @brief  Renders consecutive solid color rectangles that share a blend
+  ///         mode and clip depth with a single command. The batch is left
+  ///         empty.
+  bool RenderBatch(std::vector<Entity>& batch,
+                   size_t clip_depth_floor,
+                   InlinePassContext& pass_context,
+                   int32_t pass_depth,
+                   ContentContext& renderer,
+                   ClipCoverageStack& clip_coverage_stack,
+                   Point global_pass_position) const;
+
   EntityResult GetEntityForElement(const EntityPass::Element& element,
                                    ContentContext& renderer,
                                    Capture& capture,
@@ -11,6 +11,10 @@ EntityPassDelegate::EntityPassDelegate() = default;
 
 EntityPassDelegate::~EntityPassDelegate() = default;
 
+bool EntityPassDelegate::CanRenderIntoLargerTarget() const {
+  return false;
+}
+
 class DefaultEntityPassDelegate final : public EntityPassDelegate {
  public:
   DefaultEntityPassDelegate() = default;
@@ -29,6 +33,7 @@ class DefaultEntityPassDelegate final : public EntityPassDelegate {
   // |EntityPassDelegate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) override {
     // Not possible since this pass always collapses into its parent.
     FML_UNREACHABLE();
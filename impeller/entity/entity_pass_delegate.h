@@ -31,8 +31,18 @@ class EntityPassDelegate {
   ///         If true, this method may modify the entities for the current pass.
   virtual bool CanCollapseIntoParentPass(EntityPass* entity_pass) = 0;
 
+  /// @brief  Whether the subpass may be rendered into a target that is
+  ///         larger than the subpass. The contents created for such a target
+  ///         only sample the region of the subpass size, which is only free
+  ///         if no filter has to snapshot the target first.
+  virtual bool CanRenderIntoLargerTarget() const;
+
+  /// @brief  Creates the contents that draw the subpass into its parent.
+  ///         Only the region of |size| at the origin of |target| holds the
+  ///         subpass.
   virtual std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& effect_transform) = 0;
 
   virtual std::shared_ptr<FilterContents> WithImageFilter(
@@ -23,9 +23,11 @@
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
+#include "impeller/entity/contents/pipeline_warmup_log.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
+#include "impeller/entity/contents/solid_rect_batch_contents.h"
 #include "impeller/entity/contents/solid_rrect_blur_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
@@ -37,6 +39,7 @@
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -86,6 +89,7 @@ class TestPassDelegate final : public EntityPassDelegate {
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
+      ISize size,
       const Matrix& transform) override {
     return nullptr;
   }
@@ -2349,6 +2353,82 @@ TEST_P(EntityTest, SolidColorContentsIsOpaque) {
   ASSERT_FALSE(contents.IsOpaque());
 }
 
+static Entity MakeSolidRectEntity(Rect rect,
+                                  Color color,
+                                  const Matrix& transform = {}) {
+  auto contents = std::make_unique<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(rect));
+  contents->SetColor(color);
+  Entity entity;
+  entity.SetTransform(transform);
+  entity.SetContents(std::move(contents));
+  return entity;
+}
+
+TEST_P(EntityTest, SolidRectBatchContentsOnlyBatchesSolidRects) {
+  auto rect = Rect::MakeXYWH(10, 10, 20, 20);
+  EXPECT_TRUE(SolidRectBatchContents::CanBatch(
+      MakeSolidRectEntity(rect, Color::Red())));
+
+  Entity path_entity;
+  path_entity.SetContents(SolidColorContents::Make(
+      PathBuilder{}.AddCircle({20, 20}, 10).TakePath(), Color::Red()));
+  EXPECT_FALSE(SolidRectBatchContents::CanBatch(path_entity));
+
+  auto advanced_blend = MakeSolidRectEntity(rect, Color::Red());
+  advanced_blend.SetBlendMode(BlendMode::kColorBurn);
+  EXPECT_FALSE(SolidRectBatchContents::CanBatch(advanced_blend));
+
+  Matrix perspective;
+  perspective.m[3] = 0.001;
+  EXPECT_FALSE(SolidRectBatchContents::CanBatch(
+      MakeSolidRectEntity(rect, Color::Red(), perspective)));
+
+  auto a = MakeSolidRectEntity(rect, Color::Red());
+  auto b = MakeSolidRectEntity(rect, Color::Blue());
+  EXPECT_TRUE(SolidRectBatchContents::CanBatchTogether(a, b));
+  b.SetClipDepth(1);
+  EXPECT_FALSE(SolidRectBatchContents::CanBatchTogether(a, b));
+  b.SetClipDepth(0);
+  b.SetBlendMode(BlendMode::kSource);
+  EXPECT_FALSE(SolidRectBatchContents::CanBatchTogether(a, b));
+}
+
+TEST_P(EntityTest, SolidRectBatchContentsCoversAllRects) {
+  SolidRectBatchContents contents;
+  EXPECT_FALSE(contents.GetCoverage({}).has_value());
+
+  contents.AddEntity(
+      MakeSolidRectEntity(Rect::MakeLTRB(0, 0, 10, 10), Color::Red()));
+  contents.AddEntity(MakeSolidRectEntity(Rect::MakeLTRB(0, 0, 10, 10),
+                                         Color::Blue(),
+                                         Matrix::MakeTranslation({50, 20})));
+  EXPECT_EQ(contents.GetRectCount(), 2u);
+
+  auto coverage = contents.GetCoverage({});
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(0, 0, 60, 30));
+}
+
+TEST_P(EntityTest, EntityPassBatchesSolidRects) {
+  // A grid of overlapping, translucent rects. Every other row is drawn with a
+  // different blend mode, which splits the batches.
+  EntityPass pass;
+  for (int row = 0; row < 20; row++) {
+    for (int column = 0; column < 20; column++) {
+      auto color = Color(column / 20.0, row / 20.0, 0.5, 0.75);
+      auto entity = MakeSolidRectEntity(
+          Rect::MakeXYWH(column * 30, row * 30, 40, 40), color,
+          Matrix::MakeScale(GetContentScale()));
+      if (row % 2 == 1) {
+        entity.SetBlendMode(BlendMode::kPlus);
+      }
+      pass.AddEntity(std::move(entity));
+    }
+  }
+  ASSERT_TRUE(OpenPlaygroundHere(pass));
+}
+
 TEST_P(EntityTest, ConicalGradientContentsIsOpaque) {
   ConicalGradientContents contents;
   contents.SetColors({Color::CornflowerBlue()});
@@ -2541,6 +2621,95 @@ TEST_P(EntityTest, AdvancedBlendCoverageHintIsNotResetByEntityPass) {
   }
 }
 
+/// Draws the subpass texture as is, and records the target it was given.
+class RecordingPassDelegate final : public EntityPassDelegate {
+ public:
+  // |EntityPassDelegate|
+  bool CanElide() override { return false; }
+
+  // |EntityPassDelegate|
+  bool CanCollapseIntoParentPass(EntityPass* entity_pass) override {
+    return false;
+  }
+
+  // |EntityPassDelegate|
+  bool CanRenderIntoLargerTarget() const override { return true; }
+
+  // |EntityPassDelegate|
+  std::shared_ptr<Contents> CreateContentsForSubpassTarget(
+      std::shared_ptr<Texture> target,
+      ISize size,
+      const Matrix& effect_transform) override {
+    target_ = target;
+    size_ = size;
+    auto contents = TextureContents::MakeRect(Rect::MakeSize(size));
+    contents->SetTexture(std::move(target));
+    contents->SetSourceRect(Rect::MakeSize(size));
+    return contents;
+  }
+
+  // |EntityPassDelegate|
+  std::shared_ptr<FilterContents> WithImageFilter(
+      const FilterInput::Variant& input,
+      const Matrix& effect_transform) const override {
+    return nullptr;
+  }
+
+  const std::shared_ptr<Texture>& GetTarget() const { return target_; }
+
+  ISize GetSize() const { return size_; }
+
+ private:
+  std::shared_ptr<Texture> target_;
+  ISize size_;
+};
+
+TEST_P(EntityTest, SubpassTargetIsReusedWhileItsSizeChanges) {
+  auto render_target_cache = std::make_shared<RenderTargetCache>(
+      GetContext()->GetResourceAllocator());
+  auto stencil_config = RenderTarget::AttachmentConfig{
+      .storage_mode = StorageMode::kDevicePrivate,
+      .load_action = LoadAction::kClear,
+      .store_action = StoreAction::kDontCare,
+      .clear_color = Color::BlackTransparent()};
+  auto rt = RenderTarget::CreateOffscreen(
+      *GetContext(), *render_target_cache, ISize::MakeWH(1000, 1000),
+      "Offscreen", RenderTarget::kDefaultColorAttachmentConfig,
+      stencil_config);
+  auto content_context = ContentContext(
+      GetContext(), TypographerContextSkia::Make(), render_target_cache);
+
+  std::shared_ptr<Texture> first_target;
+  for (int frame = 0; frame < 4; frame++) {
+    // The subpass grows every frame, but stays within one size bucket.
+    int64_t size = 100 + frame * 3;
+    auto delegate = std::make_shared<RecordingPassDelegate>();
+    auto subpass = std::make_unique<EntityPass>();
+    Entity entity;
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, size, size)).TakePath(),
+        Color::Red()));
+    subpass->AddEntity(std::move(entity));
+    subpass->SetDelegate(delegate);
+    EntityPass pass;
+    pass.AddSubpass(std::move(subpass));
+
+    render_target_cache->Start();
+    EXPECT_TRUE(pass.Render(content_context, rt));
+    render_target_cache->End();
+
+    ASSERT_NE(delegate->GetTarget(), nullptr);
+    EXPECT_EQ(delegate->GetSize(), ISize(size, size));
+    EXPECT_EQ(delegate->GetTarget()->GetSize(),
+              RenderTargetCache::GetBucketSize(ISize(size, size)));
+    if (frame == 0) {
+      first_target = delegate->GetTarget();
+    } else {
+      EXPECT_EQ(delegate->GetTarget(), first_target);
+    }
+  }
+}
+
 TEST_P(EntityTest, SpecializationConstantsAreAppliedToVariants) {
   auto content_context =
       ContentContext(GetContext(), TypographerContextSkia::Make());
@@ -2561,6 +2730,30 @@ TEST_P(EntityTest, SpecializationConstantsAreAppliedToVariants) {
             expected_constants);
 }
 
+TEST_P(EntityTest, PipelineWarmupLogReplaysRecordedVariants) {
+  auto log = std::make_shared<PipelineWarmupLog>();
+  ContentContextOptions options{
+      .blend_mode = BlendMode::kPlus,
+      .color_attachment_pixel_format = PixelFormat::kR8G8B8A8UNormInt};
+  {
+    auto content_context =
+        ContentContext(GetContext(), TypographerContextSkia::Make());
+    content_context.SetPipelineWarmupLog(log);
+    ASSERT_NE(content_context.GetSolidFillPipeline(options), nullptr);
+    ASSERT_NE(content_context.GetBlendColorBurnPipeline(options), nullptr);
+  }
+  EXPECT_EQ(log->GetEntryCount(), 2u);
+
+  auto restored = PipelineWarmupLog::Deserialize(*log->Serialize());
+  ASSERT_NE(restored, nullptr);
+  auto content_context =
+      ContentContext(GetContext(), TypographerContextSkia::Make());
+  EXPECT_EQ(content_context.WarmUpPipelines(*restored), 2u);
+  // The variants exist, so replaying again doesn't start anything.
+  EXPECT_EQ(content_context.WarmUpPipelines(*restored), 0u);
+  EXPECT_NE(content_context.GetSolidFillPipeline(options), nullptr);
+}
+
 TEST_P(EntityTest, DecalSpecializationAppliedToMorphologyFilter) {
   auto content_context =
       ContentContext(GetContext(), TypographerContextSkia::Make());
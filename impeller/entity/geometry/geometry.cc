@@ -215,4 +215,8 @@ bool Geometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<Rect> Geometry::AsRect() const {
+  return std::nullopt;
+}
+
 }  // namespace impeller
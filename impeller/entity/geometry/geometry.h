@@ -121,6 +121,10 @@ class Geometry {
 
   virtual bool IsAxisAlignedRect() const;
 
+  /// @brief    The rectangle filled by this geometry in local coordinates, if
+  ///           it fills exactly one rectangle.
+  virtual std::optional<Rect> AsRect() const;
+
  protected:
   static GeometryResult ComputePositionGeometry(
       const Tessellator::VertexGenerator& generator,
@@ -3,12 +3,44 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
-    : RenderTargetAllocator(std::move(allocator)) {}
+namespace {
+
+// The smallest power of two that is split into buckets. Its buckets are
+// one texel apart, so smaller sizes are not rounded up at all.
+constexpr int64_t kMinBucketPowerOfTwo = 8;
+
+size_t GetTextureByteSize(const TextureDescriptor& desc) {
+  return desc.GetByteSizeOfBaseMipLevel() *
+         static_cast<size_t>(desc.sample_count);
+}
+
+int64_t RoundUpToBucket(int64_t dimension) {
+  int64_t power_of_two = kMinBucketPowerOfTwo;
+  while (power_of_two < dimension) {
+    power_of_two *= 2;
+  }
+  // Four buckets between the previous power of two and this one.
+  const int64_t step = power_of_two / 8;
+  return (dimension + step - 1) / step * step;
+}
+
+}  // namespace
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t keep_alive_frame_count,
+                                     size_t byte_budget)
+    : RenderTargetAllocator(allocator),
+      keep_alive_frame_count_(std::max<size_t>(keep_alive_frame_count, 1u)),
+      byte_budget_(byte_budget),
+      max_texture_size_(allocator ? allocator->GetMaxTextureSizeSupported()
+                                  : ISize()) {}
 
 void RenderTargetCache::Start() {
   for (auto& td : texture_data_) {
@@ -18,19 +50,47 @@ void RenderTargetCache::Start() {
 
 void RenderTargetCache::End() {
   std::vector<TextureData> retain;
-
   for (const auto& td : texture_data_) {
-    if (td.used_this_frame) {
+    if (td.used_this_frame ||
+        frame_ - td.last_used_frame < keep_alive_frame_count_) {
       retain.push_back(td);
     }
   }
+
+  // Discard the least recently used textures until the rest fit the budget.
+  std::stable_sort(retain.begin(), retain.end(),
+                   [](const TextureData& a, const TextureData& b) {
+                     return a.last_used_frame > b.last_used_frame;
+                   });
+  size_t byte_size = 0u;
+  size_t retain_count = 0u;
+  for (const auto& td : retain) {
+    size_t texture_byte_size =
+        GetTextureByteSize(td.texture->GetTextureDescriptor());
+    if (byte_size + texture_byte_size > byte_budget_) {
+      break;
+    }
+    byte_size += texture_byte_size;
+    retain_count++;
+  }
+  retain.resize(retain_count);
+
   texture_data_.swap(retain);
+  frame_++;
 }
 
 size_t RenderTargetCache::CachedTextureCount() const {
   return texture_data_.size();
 }
 
+size_t RenderTargetCache::CachedByteSize() const {
+  size_t byte_size = 0u;
+  for (const auto& td : texture_data_) {
+    byte_size += GetTextureByteSize(td.texture->GetTextureDescriptor());
+  }
+  return byte_size;
+}
+
 std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
     const TextureDescriptor& desc) {
   FML_DCHECK(desc.storage_mode != StorageMode::kHostVisible);
@@ -42,15 +102,39 @@ std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
     FML_DCHECK(td.texture != nullptr);
     if (!td.used_this_frame && desc == other_desc) {
       td.used_this_frame = true;
+      td.last_used_frame = frame_;
       return td.texture;
     }
   }
+  return AllocateTexture(desc);
+}
+
+ISize RenderTargetCache::GetAllocationSize(ISize size) const {
+  ISize bucket_size = GetBucketSize(size);
+  if (max_texture_size_.IsEmpty()) {
+    return bucket_size;
+  }
+  // Don't round up past the maximum texture size, but leave sizes that are
+  // already too large as they are so that the allocation fails as before.
+  return ISize(
+      std::max(std::min(bucket_size.width, max_texture_size_.width),
+               size.width),
+      std::max(std::min(bucket_size.height, max_texture_size_.height),
+               size.height));
+}
+
+ISize RenderTargetCache::GetBucketSize(ISize size) {
+  return ISize(RoundUpToBucket(size.width), RoundUpToBucket(size.height));
+}
+
+std::shared_ptr<Texture> RenderTargetCache::AllocateTexture(
+    const TextureDescriptor& desc) {
   auto result = RenderTargetAllocator::CreateTexture(desc);
   if (result == nullptr) {
     return result;
   }
-  texture_data_.push_back(
-      TextureData{.used_this_frame = true, .texture = result});
+  texture_data_.push_back(TextureData{
+      .used_this_frame = true, .last_used_frame = frame_, .texture = result});
   return result;
 }
 
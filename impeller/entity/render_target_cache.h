@@ -5,17 +5,38 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 #define FLUTTER_IMPELLER_ENTITY_RENDER_TARGET_CACHE_H_
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
-/// @brief An implementation of the [RenderTargetAllocator] that caches all
-///        allocated texture data for one frame.
+/// @brief An implementation of the [RenderTargetAllocator] that pools
+///        allocated texture data across frames.
+///
+///        Textures are kept until they have gone unused for a number of
+///        frames, or until the pool exceeds its byte budget, in which case
+///        the least recently used textures are discarded first.
 ///
-///        Any textures unused after a frame are immediately discarded.
+///        Requests are matched exactly. Callers that only sample the top left
+///        of a render target may allocate it at |GetAllocationSize|, which
+///        rounds sizes up to a size bucket so that targets whose size changes
+///        slightly every frame are still reused.
 class RenderTargetCache : public RenderTargetAllocator {
  public:
-  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+  /// The number of frames that a texture may go unused before it is
+  /// discarded.
+  static constexpr size_t kDefaultKeepAliveFrameCount = 3u;
+
+  /// The number of bytes of textures kept by the pool.
+  static constexpr size_t kDefaultByteBudget = 64u * 1024u * 1024u;
+
+  explicit RenderTargetCache(
+      std::shared_ptr<Allocator> allocator,
+      size_t keep_alive_frame_count = kDefaultKeepAliveFrameCount,
+      size_t byte_budget = kDefaultByteBudget);
 
   ~RenderTargetCache() = default;
 
@@ -29,17 +50,35 @@ class RenderTargetCache : public RenderTargetAllocator {
   std::shared_ptr<Texture> CreateTexture(
       const TextureDescriptor& desc) override;
 
+  // |RenderTargetAllocator|
+  ISize GetAllocationSize(ISize size) const override;
+
+  /// @brief The size bucket of the given size. Each dimension is rounded up
+  ///        to one of four buckets per power of two, so at most a quarter of
+  ///        each dimension is wasted.
+  static ISize GetBucketSize(ISize size);
+
   // visible for testing.
   size_t CachedTextureCount() const;
 
+  // visible for testing.
+  size_t CachedByteSize() const;
+
  private:
   struct TextureData {
     bool used_this_frame;
+    uint64_t last_used_frame;
     std::shared_ptr<Texture> texture;
   };
 
+  const size_t keep_alive_frame_count_;
+  const size_t byte_budget_;
+  const ISize max_texture_size_;
+  uint64_t frame_ = 0u;
   std::vector<TextureData> texture_data_;
 
+  std::shared_ptr<Texture> AllocateTexture(const TextureDescriptor& desc);
+
   RenderTargetCache(const RenderTargetCache&) = delete;
 
   RenderTargetCache& operator=(const RenderTargetCache&) = delete;
@@ -44,7 +44,8 @@ class TestAllocator : public Allocator {
 
 TEST(RenderTargetCacheTest, CachesUsedTexturesAcrossFrames) {
   auto allocator = std::make_shared<TestAllocator>();
-  auto render_target_cache = RenderTargetCache(allocator);
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/1);
   auto desc = TextureDescriptor{
       .format = PixelFormat::kR8G8B8A8UNormInt,
       .size = ISize(100, 100),
@@ -85,5 +86,110 @@ TEST(RenderTargetCacheTest, DoesNotPersistFailedAllocations) {
   ASSERT_EQ(render_target_cache.CachedTextureCount(), 0u);
 }
 
+TEST(RenderTargetCacheTest, KeepsUnusedTexturesForSeveralFrames) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache =
+      RenderTargetCache(allocator, /*keep_alive_frame_count=*/3);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  render_target_cache.Start();
+  auto texture = render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+
+  // Unused for the next two frames.
+  for (int i = 0; i < 2; i++) {
+    render_target_cache.Start();
+    render_target_cache.End();
+    ASSERT_EQ(render_target_cache.CachedTextureCount(), 1u);
+  }
+
+  render_target_cache.Start();
+  EXPECT_EQ(render_target_cache.CreateTexture(desc), texture);
+  render_target_cache.End();
+
+  for (int i = 0; i < 3; i++) {
+    render_target_cache.Start();
+    render_target_cache.End();
+  }
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 0u);
+}
+
+TEST(RenderTargetCacheTest, DiscardsLeastRecentlyUsedTexturesOverBudget) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .size = ISize(100, 100),
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+  const size_t texture_size = desc.GetByteSizeOfBaseMipLevel();
+  auto render_target_cache = RenderTargetCache(
+      allocator, /*keep_alive_frame_count=*/10, /*byte_budget=*/
+      texture_size * 2);
+
+  render_target_cache.Start();
+  auto old_texture = render_target_cache.CreateTexture(desc);
+  render_target_cache.End();
+
+  render_target_cache.Start();
+  auto texture_a = render_target_cache.CreateTexture(desc);
+  EXPECT_EQ(texture_a, old_texture);
+  auto texture_b = render_target_cache.CreateTexture(desc);
+  auto texture_c = render_target_cache.CreateTexture(desc);
+  ASSERT_EQ(render_target_cache.CachedTextureCount(), 3u);
+  render_target_cache.End();
+
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 2u);
+  EXPECT_LE(render_target_cache.CachedByteSize(), texture_size * 2);
+}
+
+TEST(RenderTargetCacheTest, BucketSizesRoundUpByAtMostAQuarter) {
+  EXPECT_EQ(RenderTargetCache::GetBucketSize(ISize(1, 8)), ISize(1, 8));
+  EXPECT_EQ(RenderTargetCache::GetBucketSize(ISize(9, 15)), ISize(10, 16));
+  EXPECT_EQ(RenderTargetCache::GetBucketSize(ISize(65, 100)), ISize(80, 112));
+  EXPECT_EQ(RenderTargetCache::GetBucketSize(ISize(256, 257)),
+            ISize(256, 320));
+  EXPECT_EQ(RenderTargetCache::GetBucketSize(ISize(1000, 1025)),
+            ISize(1024, 1280));
+}
+
+TEST(RenderTargetCacheTest, AllocationSizesStayWithinTheMaxTextureSize) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+
+  EXPECT_EQ(render_target_cache.GetAllocationSize(ISize(100, 90)),
+            ISize(112, 96));
+  // Sizes round up to no more than the maximum, 1024.
+  EXPECT_EQ(render_target_cache.GetAllocationSize(ISize(1000, 700)),
+            ISize(1024, 768));
+  EXPECT_EQ(render_target_cache.GetAllocationSize(ISize(1020, 1030)),
+            ISize(1024, 1030));
+}
+
+TEST(RenderTargetCacheTest, ReusesTexturesWhileTheRequestedSizeChanges) {
+  auto allocator = std::make_shared<TestAllocator>();
+  auto render_target_cache = RenderTargetCache(allocator);
+  auto desc = TextureDescriptor{
+      .format = PixelFormat::kR8G8B8A8UNormInt,
+      .usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)};
+
+  std::shared_ptr<Texture> first_texture;
+  for (int64_t size = 100; size < 112; size += 3) {
+    render_target_cache.Start();
+    desc.size = render_target_cache.GetAllocationSize(ISize(size, size));
+    auto texture = render_target_cache.CreateTexture(desc);
+    ASSERT_NE(texture, nullptr);
+    EXPECT_EQ(texture->GetSize(), ISize(112, 112));
+    if (!first_texture) {
+      first_texture = texture;
+    } else {
+      EXPECT_EQ(texture, first_texture);
+    }
+    render_target_cache.End();
+  }
+  EXPECT_EQ(render_target_cache.CachedTextureCount(), 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -32,6 +32,7 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   size_t single_point_count = 0u;
   auto points = std::make_unique<std::vector<Point>>();
   points->reserve(2048);
+  tess.SetCacheLimit(0);
   while (state.KeepRunning()) {
     if (tessellate) {
       tess.Tessellate(path, 1.0f,
@@ -73,6 +74,7 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   size_t single_point_count = 0u;
   auto points = std::make_unique<std::vector<Point>>();
   points->reserve(2048);
+  tess.SetCacheLimit(0);
   while (state.KeepRunning()) {
     auto points = tess.TessellateConvex(path, 1.0f);
     single_point_count = points.size();
@@ -82,11 +84,76 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+/// Tessellates the same path repeatedly with the tessellation cache enabled.
+template <class... Args>
+static void BM_CachedTessellate(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = PathBuilder{}
+                  .AddPath(std::get<Path>(args_tuple))
+                  .SetSourceId(1u)
+                  .TakePath();
+
+  Tessellator cached_tess;
+  size_t point_count = 0u;
+  while (state.KeepRunning()) {
+    cached_tess.Tessellate(
+        path, 1.0f,
+        [&point_count](const float* vertices, size_t vertices_count,
+                       const uint16_t* indices, size_t indices_count) {
+          point_count += indices_count > 0 ? indices_count : vertices_count;
+          return true;
+        });
+  }
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["HitRate"] = cached_tess.GetCacheStatistics().GetHitRate();
+}
+
+/// Flattens just the curves of the path, without building contours, and
+/// reports the throughput of the flattening in points per second.
+template <class... Args>
+static void BM_Flatten(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple).Clone();
+
+  std::vector<QuadraticPathComponent> quads;
+  std::vector<CubicPathComponent> cubics;
+  path.EnumerateComponents(
+      [](size_t, const LinearPathComponent&) {},
+      [&quads](size_t, const QuadraticPathComponent& quad) {
+        quads.push_back(quad);
+      },
+      [&cubics](size_t, const CubicPathComponent& cubic) {
+        cubics.push_back(cubic);
+      },
+      [](size_t, const ContourComponent&) {});
+
+  size_t point_count = 0u;
+  std::vector<Point> points;
+  points.reserve(2048);
+  while (state.KeepRunning()) {
+    points.clear();
+    for (const auto& quad : quads) {
+      quad.AppendPolylinePoints(1.0f, points);
+    }
+    for (const auto& cubic : cubics) {
+      cubic.AppendPolylinePoints(1.0f, points);
+    }
+    benchmark::DoNotOptimize(points.data());
+    point_count += points.size();
+  }
+  state.counters["SinglePointCount"] = points.size();
+  state.counters["PointsPerSecond"] =
+      benchmark::Counter(point_count, benchmark::Counter::kIsRate);
+}
+
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline, CreateCubic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
+BENCHMARK_CAPTURE(BM_CachedTessellate, cubic_tess_cached, CreateCubic());
+BENCHMARK_CAPTURE(BM_Flatten, cubic_flatten, CreateCubic());
+BENCHMARK_CAPTURE(BM_Flatten, quad_flatten, CreateQuadratic());
 
 namespace {
 
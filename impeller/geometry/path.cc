@@ -64,6 +64,14 @@ void Path::SetConvexity(Convexity value) {
   convexity_ = value;
 }
 
+uint32_t Path::GetSourceId() const {
+  return source_id_;
+}
+
+void Path::SetSourceId(uint32_t source_id) {
+  source_id_ = source_id;
+}
+
 void Path::Shift(Point shift) {
   for (auto i = 0u; i < points_.size(); i++) {
     points_[i] += shift;
@@ -144,6 +144,12 @@ class Path {
 
   bool IsConvex() const;
 
+  /// @brief An identifier of the immutable source the path was converted
+  ///        from, such as the generation id of an `SkPath`, or 0 if it has
+  ///        none. Paths with the same non-zero id and fill type have the same
+  ///        components.
+  uint32_t GetSourceId() const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -192,6 +198,8 @@ class Path {
 
   void SetBounds(Rect rect);
 
+  void SetSourceId(uint32_t source_id);
+
   Path& AddLinearComponent(const Point& p1, const Point& p2);
 
   Path& AddQuadraticComponent(const Point& p1,
@@ -227,6 +235,7 @@ class Path {
 
   FillType fill_ = FillType::kNonZero;
   Convexity convexity_ = Convexity::kUnknown;
+  uint32_t source_id_ = 0;
   std::vector<ComponentIndexPair> components_;
   std::vector<Point> points_;
   std::vector<ContourComponent> contours_;
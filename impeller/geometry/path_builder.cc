@@ -22,6 +22,8 @@ Path PathBuilder::TakePath(FillType fill) {
   auto path = std::move(prototype_);
   path.SetFillType(fill);
   path.SetConvexity(convexity_);
+  path.SetSourceId(source_id_);
+  source_id_ = 0;
   if (!did_compute_bounds_) {
     path.ComputeBounds();
   }
@@ -405,4 +407,9 @@ PathBuilder& PathBuilder::SetBounds(Rect bounds) {
   return *this;
 }
 
+PathBuilder& PathBuilder::SetSourceId(uint32_t source_id) {
+  source_id_ = source_id;
+  return *this;
+}
+
 }  // namespace impeller
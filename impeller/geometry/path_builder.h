@@ -104,6 +104,13 @@ class PathBuilder {
   ///        recomputing these bounds.
   PathBuilder& SetBounds(Rect bounds);
 
+  /// @brief Set the id returned by `Path::GetSourceId` for the next path
+  ///        taken from this builder.
+  ///
+  ///        The id must only be set when the path is a faithful conversion
+  ///        of an immutable source, such as an untransformed SkPath.
+  PathBuilder& SetSourceId(uint32_t source_id);
+
   struct RoundingRadii {
     Point top_left;
     Point bottom_left;
@@ -161,6 +168,7 @@ class PathBuilder {
   Path prototype_;
   Convexity convexity_;
   bool did_compute_bounds_ = false;
+  uint32_t source_id_ = 0;
 
   PathBuilder& AddRoundedRectTopLeft(Rect rect, RoundingRadii radii);
 
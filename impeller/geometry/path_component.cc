@@ -4,10 +4,76 @@
 
 #include "path_component.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <functional>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMPELLER_PATH_COMPONENT_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IMPELLER_PATH_COMPONENT_SSE 1
+#endif
 
 namespace impeller {
 
+namespace {
+
+// Four scalars that are operated on together, one lane per curve parameter.
+// Maps to a single SSE or NEON register where available and to plain
+// arrays elsewhere.
+struct Scalar4 {
+#if defined(IMPELLER_PATH_COMPONENT_NEON)
+  float32x4_t v;
+
+  static Scalar4 Splat(Scalar s) { return {vdupq_n_f32(s)}; }
+  static Scalar4 Load(const Scalar* s) { return {vld1q_f32(s)}; }
+  void Store(Scalar* s) const { vst1q_f32(s, v); }
+
+  Scalar4 operator+(Scalar4 o) const { return {vaddq_f32(v, o.v)}; }
+  Scalar4 operator-(Scalar4 o) const { return {vsubq_f32(v, o.v)}; }
+  Scalar4 operator*(Scalar4 o) const { return {vmulq_f32(v, o.v)}; }
+  Scalar4 operator/(Scalar4 o) const { return {vdivq_f32(v, o.v)}; }
+  Scalar4 Sqrt() const { return {vsqrtq_f32(v)}; }
+#elif defined(IMPELLER_PATH_COMPONENT_SSE)
+  __m128 v;
+
+  static Scalar4 Splat(Scalar s) { return {_mm_set1_ps(s)}; }
+  static Scalar4 Load(const Scalar* s) { return {_mm_loadu_ps(s)}; }
+  void Store(Scalar* s) const { _mm_storeu_ps(s, v); }
+
+  Scalar4 operator+(Scalar4 o) const { return {_mm_add_ps(v, o.v)}; }
+  Scalar4 operator-(Scalar4 o) const { return {_mm_sub_ps(v, o.v)}; }
+  Scalar4 operator*(Scalar4 o) const { return {_mm_mul_ps(v, o.v)}; }
+  Scalar4 operator/(Scalar4 o) const { return {_mm_div_ps(v, o.v)}; }
+  Scalar4 Sqrt() const { return {_mm_sqrt_ps(v)}; }
+#else
+  std::array<Scalar, 4> v;
+
+  static Scalar4 Splat(Scalar s) { return {{s, s, s, s}}; }
+  static Scalar4 Load(const Scalar* s) { return {{s[0], s[1], s[2], s[3]}}; }
+  void Store(Scalar* s) const { std::copy(v.begin(), v.end(), s); }
+
+  template <class Op>
+  Scalar4 Apply(Scalar4 o, Op op) const {
+    return {{op(v[0], o.v[0]), op(v[1], o.v[1]),  //
+             op(v[2], o.v[2]), op(v[3], o.v[3])}};
+  }
+  Scalar4 operator+(Scalar4 o) const { return Apply(o, std::plus<>()); }
+  Scalar4 operator-(Scalar4 o) const { return Apply(o, std::minus<>()); }
+  Scalar4 operator*(Scalar4 o) const { return Apply(o, std::multiplies<>()); }
+  Scalar4 operator/(Scalar4 o) const { return Apply(o, std::divides<>()); }
+  Scalar4 Sqrt() const {
+    return {{std::sqrt(v[0]), std::sqrt(v[1]), std::sqrt(v[2]),
+             std::sqrt(v[3])}};
+  }
+#endif  // IMPELLER_PATH_COMPONENT_NEON
+};
+
+}  // namespace
+
 /*
  *  Based on: https://en.wikipedia.org/wiki/B%C3%A9zier_curve#Specific_cases
  */
@@ -98,11 +164,20 @@ Point QuadraticPathComponent::SolveDerivative(Scalar time) const {
   };
 }
 
+static constexpr Scalar kParabolaIntegralD = 0.67;
+
 static Scalar ApproximateParabolaIntegral(Scalar x) {
-  constexpr Scalar d = 0.67;
+  constexpr Scalar d = kParabolaIntegralD;
   return x / (1.0 - d + sqrt(sqrt(pow(d, 4) + 0.25 * x * x)));
 }
 
+static Scalar4 ApproximateParabolaIntegral(Scalar4 x) {
+  constexpr Scalar d = kParabolaIntegralD;
+  const Scalar4 d4 = Scalar4::Splat(d * d * d * d);
+  const Scalar4 quarter = Scalar4::Splat(0.25f);
+  return x / (Scalar4::Splat(1.0f - d) + (d4 + quarter * x * x).Sqrt().Sqrt());
+}
+
 void QuadraticPathComponent::AppendPolylinePoints(
     Scalar scale_factor,
     std::vector<Point>& points) const {
@@ -137,11 +212,45 @@ void QuadraticPathComponent::AppendPolylinePoints(
 
   auto line_count = std::max(1., ceil(0.5 * val / sqrt_tolerance));
   auto step = 1 / line_count;
-  for (size_t i = 1; i < line_count; i += 1) {
-    auto u = i * step;
-    auto a = a0 + (a2 - a0) * u;
-    auto t = (ApproximateParabolaIntegral(a) - u0) * uscale;
-    points.emplace_back(Solve(t));
+
+  // Each interior point only depends on its own index, so the points are
+  // evaluated four at a time. The last group may compute lanes past the end
+  // of the curve; those are simply not written out.
+  const size_t interior_count = static_cast<size_t>(line_count) - 1;
+  const size_t first = points.size();
+  points.resize(first + interior_count);
+
+  const Scalar4 lane_offsets = Scalar4::Load(
+      std::array<Scalar, 4>{1, 2, 3, 4}.data());
+  const Scalar4 step4 = Scalar4::Splat(step);
+  const Scalar4 a0_4 = Scalar4::Splat(a0);
+  const Scalar4 da4 = Scalar4::Splat(a2 - a0);
+  const Scalar4 u0_4 = Scalar4::Splat(u0);
+  const Scalar4 uscale4 = Scalar4::Splat(uscale);
+  const Scalar4 one = Scalar4::Splat(1);
+  const Scalar4 two = Scalar4::Splat(2);
+  std::array<Scalar, 4> xs;
+  std::array<Scalar, 4> ys;
+  for (size_t i = 0; i < interior_count; i += 4) {
+    Scalar4 u = (Scalar4::Splat(static_cast<Scalar>(i)) + lane_offsets) * step4;
+    Scalar4 a = a0_4 + da4 * u;
+    Scalar4 t = (ApproximateParabolaIntegral(a) - u0_4) * uscale4;
+
+    Scalar4 mt = one - t;
+    Scalar4 w0 = mt * mt;
+    Scalar4 w1 = two * mt * t;
+    Scalar4 w2 = t * t;
+    (w0 * Scalar4::Splat(p1.x) + w1 * Scalar4::Splat(cp.x) +
+     w2 * Scalar4::Splat(p2.x))
+        .Store(xs.data());
+    (w0 * Scalar4::Splat(p1.y) + w1 * Scalar4::Splat(cp.y) +
+     w2 * Scalar4::Splat(p2.y))
+        .Store(ys.data());
+
+    const size_t lanes = std::min<size_t>(4, interior_count - i);
+    for (size_t lane = 0; lane < lanes; lane++) {
+      points[first + i + lane] = Point(xs[lane], ys[lane]);
+    }
   }
   points.emplace_back(p2);
 }
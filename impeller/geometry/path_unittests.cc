@@ -22,6 +22,78 @@ TEST(PathTest, CubicPathComponentPolylineDoesNotIncludePointOne) {
   ASSERT_EQ(polyline.back().y, 40);
 }
 
+namespace {
+
+Scalar ReferenceParabolaIntegral(Scalar x) {
+  constexpr Scalar d = 0.67;
+  return x / (1.0 - d + sqrt(sqrt(pow(d, 4) + 0.25 * x * x)));
+}
+
+// A point at a time version of QuadraticPathComponent::AppendPolylinePoints.
+std::vector<Point> ReferenceQuadraticPolyline(
+    const QuadraticPathComponent& quad,
+    Scalar scale_factor) {
+  auto sqrt_tolerance = sqrt(kDefaultCurveTolerance / scale_factor);
+  auto d01 = quad.cp - quad.p1;
+  auto d12 = quad.p2 - quad.cp;
+  auto dd = d01 - d12;
+  auto cross = (quad.p2 - quad.p1).Cross(dd);
+  auto x0 = d01.Dot(dd) * 1 / cross;
+  auto x2 = d12.Dot(dd) * 1 / cross;
+  auto scale = std::abs(cross / (hypot(dd.x, dd.y) * (x2 - x0)));
+  auto a0 = ReferenceParabolaIntegral(x0);
+  auto a2 = ReferenceParabolaIntegral(x2);
+  Scalar val = 0.f;
+  if (std::isfinite(scale)) {
+    auto da = std::abs(a2 - a0);
+    auto sqrt_scale = sqrt(scale);
+    if ((x0 < 0 && x2 < 0) || (x0 >= 0 && x2 >= 0)) {
+      val = da * sqrt_scale;
+    } else {
+      auto xmin = sqrt_tolerance / sqrt_scale;
+      val = sqrt_tolerance * da / ReferenceParabolaIntegral(xmin);
+    }
+  }
+  auto u0 = ReferenceParabolaIntegral(a0);
+  auto u2 = ReferenceParabolaIntegral(a2);
+  auto uscale = 1 / (u2 - u0);
+  auto line_count = std::max(1., ceil(0.5 * val / sqrt_tolerance));
+  auto step = 1 / line_count;
+  std::vector<Point> points;
+  for (size_t i = 1; i < line_count; i += 1) {
+    auto a = a0 + (a2 - a0) * (i * step);
+    points.emplace_back(
+        quad.Solve((ReferenceParabolaIntegral(a) - u0) * uscale));
+  }
+  points.emplace_back(quad.p2);
+  return points;
+}
+
+}  // namespace
+
+TEST(PathTest, QuadraticPathComponentPolylineMatchesPointwiseEvaluation) {
+  QuadraticPathComponent components[] = {
+      {{10, 10}, {100, 200}, {300, 20}},
+      {{0, 0}, {50, 0}, {100, 0}},
+      {{0, 0}, {200, 200}, {0, 10}},
+      {{359.934, 96.6335}, {358.189, 96.7055}, {354.673, 96.8895}},
+  };
+  // Enough scales that the interior point counts cover every remainder of
+  // the groups of four points that are evaluated together.
+  for (const auto& component : components) {
+    for (Scalar scale = 0.25; scale <= 16; scale *= 1.5) {
+      std::vector<Point> polyline = {{-1, -1}};
+      component.AppendPolylinePoints(scale, polyline);
+      auto expected = ReferenceQuadraticPolyline(component, scale);
+      ASSERT_EQ(polyline.size(), expected.size() + 1);
+      ASSERT_EQ(polyline.front(), Point(-1, -1));
+      for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_POINT_NEAR(polyline[i + 1], expected[i]);
+      }
+    }
+  }
+}
+
 TEST(PathTest, PathCreatePolyLineDoesNotDuplicatePoints) {
   PathBuilder builder;
   builder.MoveTo({10, 10});
@@ -485,5 +557,18 @@ TEST(PathTest, CanBeCloned) {
   }
 }
 
+TEST(PathTest, SourceIdOnlyAppliesToTheNextPath) {
+  PathBuilder builder;
+  builder.AddRect(Rect::MakeLTRB(0, 0, 10, 10));
+  builder.SetSourceId(42u);
+  auto path_a = builder.TakePath();
+  EXPECT_EQ(path_a.GetSourceId(), 42u);
+  EXPECT_EQ(path_a.Clone().GetSourceId(), 42u);
+
+  builder.AddRect(Rect::MakeLTRB(0, 0, 20, 20));
+  auto path_b = builder.TakePath();
+  EXPECT_EQ(path_b.GetSourceId(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
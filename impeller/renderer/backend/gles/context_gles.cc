@@ -67,6 +67,7 @@ ContextGLES::ContextGLES(
   }
   gpu_tracer_ = std::make_shared<GPUTracerGLES>(GetReactor()->GetProcTable(),
                                                 enable_gpu_tracing);
+  gpu_tracer_->SetFramePhaseTimings(GetSharedFramePhaseTimings());
   is_valid_ = true;
 }
 
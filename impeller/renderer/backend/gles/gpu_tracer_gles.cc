@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include <thread>
+#include <utility>
 #include "fml/trace_event.h"
 
 namespace impeller {
@@ -63,6 +64,10 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
     uint64_t duration = 0;
     gl.GetQueryObjectui64vEXT(query, GL_QUERY_RESULT_EXT, &duration);
     auto gpu_ms = duration / 1000000.0;
+    if (frame_phase_timings_) {
+      frame_phase_timings_->SetGPUDuration(fml::TimeDelta::FromNanoseconds(
+          static_cast<int64_t>(duration)));
+    }
 
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
@@ -72,6 +77,11 @@ void GPUTracerGLES::ProcessQueries(const ProcTableGLES& gl) {
   }
 }
 
+void GPUTracerGLES::SetFramePhaseTimings(
+    std::shared_ptr<FramePhaseTimings> timings) {
+  frame_phase_timings_ = std::move(timings);
+}
+
 void GPUTracerGLES::MarkFrameEnd(const ProcTableGLES& gl) {
   if (!enabled_ || std::this_thread::get_id() != raster_thread_ ||
       !active_frame_.has_value()) {
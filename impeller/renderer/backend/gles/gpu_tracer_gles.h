@@ -7,8 +7,10 @@
 
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <thread>
 
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
 
 namespace impeller {
@@ -40,12 +42,17 @@ class GPUTracerGLES {
   /// @brief Record the end of a frame workload.
   void MarkFrameEnd(const ProcTableGLES& gl);
 
+  /// @brief Sets the timings that the GPU time of each completed frame is
+  ///        reported to.
+  void SetFramePhaseTimings(std::shared_ptr<FramePhaseTimings> timings);
+
  private:
   void ProcessQueries(const ProcTableGLES& gl);
 
   std::deque<uint32_t> pending_traces_;
   std::optional<uint32_t> active_frame_ = std::nullopt;
   std::thread::id raster_thread_;
+  std::shared_ptr<FramePhaseTimings> frame_phase_timings_;
 
   bool enabled_ = false;
 };
@@ -149,6 +149,7 @@ ContextMTL::ContextMTL(
       InferMetalCapabilities(device_, PixelFormat::kB8G8R8A8UNormInt);
 #ifdef IMPELLER_DEBUG
   gpu_tracer_ = std::make_shared<GPUTracerMTL>();
+  gpu_tracer_->SetFramePhaseTimings(GetSharedFramePhaseTimings());
 #endif  // IMPELLER_DEBUG
   is_valid_ = true;
 }
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <optional>
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/base/thread.h"
 #include "impeller/base/thread_safety.h"
 #include "impeller/geometry/scalar.h"
@@ -34,6 +35,10 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   ///        aggregate frame workload metric.
   void RecordCmdBuffer(id<MTLCommandBuffer> buffer);
 
+  /// @brief Sets the timings that the GPU time of each completed frame is
+  ///        reported to. Must be called before any cmd buffer is recorded.
+  void SetFramePhaseTimings(std::shared_ptr<FramePhaseTimings> timings);
+
  private:
   struct GPUTraceState {
     Scalar smallest_timestamp = std::numeric_limits<float>::max();
@@ -44,6 +49,7 @@ class GPUTracerMTL : public std::enable_shared_from_this<GPUTracerMTL> {
   mutable Mutex trace_state_mutex_;
   GPUTraceState trace_states_[16] IPLR_GUARDED_BY(trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
+  std::shared_ptr<FramePhaseTimings> frame_phase_timings_;
 };
 
 }  // namespace impeller
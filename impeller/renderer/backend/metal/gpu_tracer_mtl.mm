@@ -8,6 +8,7 @@
 #include "impeller/renderer/backend/metal/formats_mtl.h"
 
 #include <memory>
+#include <utility>
 
 #include "impeller/renderer/backend/metal/gpu_tracer_mtl.h"
 
@@ -20,6 +21,11 @@ void GPUTracerMTL::MarkFrameEnd() {
   }
 }
 
+void GPUTracerMTL::SetFramePhaseTimings(
+    std::shared_ptr<FramePhaseTimings> timings) {
+  frame_phase_timings_ = std::move(timings);
+}
+
 void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
   if (@available(ios 10.3, tvos 10.2, macos 10.15, macCatalyst 13.0, *)) {
     Lock lock(trace_state_mutex_);
@@ -43,6 +49,10 @@ void GPUTracerMTL::RecordCmdBuffer(id<MTLCommandBuffer> buffer) {
       if (state.pending_buffers == 0) {
         auto gpu_ms =
             (state.largest_timestamp - state.smallest_timestamp) * 1000;
+        if (self->frame_phase_timings_) {
+          self->frame_phase_timings_->SetGPUDuration(
+              fml::TimeDelta::FromMillisecondsF(gpu_ms));
+        }
         state.smallest_timestamp = std::numeric_limits<float>::max();
         state.largest_timestamp = 0;
         FML_TRACE_COUNTER("flutter", "GPUTracer",
@@ -3,6 +3,13 @@
 // found in the LICENSE file.
 
 #include "impeller/renderer/backend/vulkan/binding_helpers_vk.h"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
 #include "fml/status.h"
 #include "impeller/core/shader_types.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
@@ -23,12 +30,224 @@ namespace impeller {
 // manually changed.
 static constexpr size_t kMagicSubpassInputBinding = 64;
 
+template <class HandleType>
+static uint64_t HandleToKeyValue(HandleType handle) {
+  return reinterpret_cast<uint64_t>(
+      static_cast<typename HandleType::CType>(handle));
+}
+
+DescriptorSetKeyVK::DescriptorSetKeyVK(vk::DescriptorSetLayout layout) {
+  values_.push_back(HandleToKeyValue(layout));
+}
+
+void DescriptorSetKeyVK::AddBuffer(uint32_t binding,
+                                   vk::DescriptorType type,
+                                   const vk::DescriptorBufferInfo& info) {
+  values_.push_back(binding);
+  values_.push_back(static_cast<uint64_t>(type));
+  values_.push_back(HandleToKeyValue(info.buffer));
+  values_.push_back(info.offset);
+  values_.push_back(info.range);
+}
+
+void DescriptorSetKeyVK::AddImage(uint32_t binding,
+                                  vk::DescriptorType type,
+                                  const vk::DescriptorImageInfo& info) {
+  values_.push_back(binding);
+  values_.push_back(static_cast<uint64_t>(type));
+  values_.push_back(HandleToKeyValue(info.sampler));
+  values_.push_back(HandleToKeyValue(info.imageView));
+  values_.push_back(static_cast<uint64_t>(info.imageLayout));
+}
+
+std::size_t DescriptorSetKeyVK::Hash::operator()(
+    const DescriptorSetKeyVK& key) const {
+  std::size_t hash = 0u;
+  for (uint64_t value : key.values_) {
+    hash = fml::HashCombine(hash, value);
+  }
+  return hash;
+}
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Collects the descriptors of each command of a pass before any descriptor
+/// sets are allocated, so that commands with the same descriptors are given
+/// the same set and the set is only written once.
+///
+class DescriptorSetBuilder {
+ public:
+  DescriptorSetBuilder(size_t command_count,
+                       size_t buffer_count,
+                       size_t image_count) {
+    // The descriptor writes point into these, so they must not reallocate.
+    buffers_.reserve(buffer_count);
+    images_.reserve(image_count);
+    writes_.reserve(buffer_count + image_count);
+    write_set_indices_.reserve(buffer_count + image_count);
+    command_set_indices_.reserve(command_count);
+    result_.dynamic_offset_starts.reserve(command_count + 1);
+    result_.dynamic_offset_starts.push_back(0u);
+  }
+
+  void BeginCommand(vk::DescriptorSetLayout layout) {
+    layout_ = layout;
+    key_.emplace(layout);
+    command_buffer_start_ = buffers_.size();
+    command_image_start_ = images_.size();
+    command_write_start_ = writes_.size();
+    command_dynamic_offsets_.clear();
+  }
+
+  void AddBuffer(uint32_t binding,
+                 vk::DescriptorType type,
+                 vk::Buffer buffer,
+                 uint64_t offset,
+                 uint64_t range) {
+    // Uniform buffers are bound with a dynamic offset instead of writing the
+    // offset into the descriptor.
+    if (type == vk::DescriptorType::eUniformBufferDynamic) {
+      command_dynamic_offsets_.emplace_back(binding,
+                                            static_cast<uint32_t>(offset));
+      offset = 0u;
+    }
+
+    vk::DescriptorBufferInfo buffer_info;
+    buffer_info.buffer = buffer;
+    buffer_info.offset = offset;
+    buffer_info.range = range;
+    buffers_.push_back(buffer_info);
+    key_->AddBuffer(binding, type, buffer_info);
+
+    vk::WriteDescriptorSet write_set;
+    write_set.dstBinding = binding;
+    write_set.descriptorCount = 1u;
+    write_set.descriptorType = type;
+    write_set.pBufferInfo = &buffers_.back();
+    writes_.push_back(write_set);
+  }
+
+  void AddImage(uint32_t binding,
+                vk::DescriptorType type,
+                vk::ImageView image_view,
+                vk::Sampler sampler,
+                vk::ImageLayout image_layout) {
+    vk::DescriptorImageInfo image_info;
+    image_info.imageLayout = image_layout;
+    image_info.sampler = sampler;
+    image_info.imageView = image_view;
+    images_.push_back(image_info);
+    key_->AddImage(binding, type, image_info);
+
+    vk::WriteDescriptorSet write_set;
+    write_set.dstBinding = binding;
+    write_set.descriptorCount = 1u;
+    write_set.descriptorType = type;
+    write_set.pImageInfo = &images_.back();
+    writes_.push_back(write_set);
+  }
+
+  void EndCommand() {
+    auto [it, inserted] =
+        set_indices_.try_emplace(std::move(*key_), layouts_.size());
+    key_.reset();
+    if (inserted) {
+      layouts_.push_back(layout_);
+      write_set_indices_.resize(writes_.size(), it->second);
+    } else {
+      // An earlier command already writes the same descriptors.
+      buffers_.resize(command_buffer_start_);
+      images_.resize(command_image_start_);
+      writes_.resize(command_write_start_);
+    }
+    command_set_indices_.push_back(it->second);
+
+    // Dynamic offsets are consumed in binding order.
+    std::sort(command_dynamic_offsets_.begin(),
+              command_dynamic_offsets_.end());
+    for (const auto& [binding, offset] : command_dynamic_offsets_) {
+      result_.dynamic_offsets.push_back(offset);
+    }
+    result_.dynamic_offset_starts.push_back(result_.dynamic_offsets.size());
+  }
+
+  fml::StatusOr<DescriptorSetsVK> Finish(
+      const ContextVK& context,
+      const std::shared_ptr<CommandEncoderVK>& encoder) {
+    size_t buffer_count = 0;
+    size_t samplers_count = 0;
+    size_t subpass_count = 0;
+    for (const auto& write : writes_) {
+      switch (write.descriptorType) {
+        case vk::DescriptorType::eCombinedImageSampler:
+          samplers_count++;
+          break;
+        case vk::DescriptorType::eInputAttachment:
+          subpass_count++;
+          break;
+        default:
+          buffer_count++;
+          break;
+      }
+    }
+
+    auto descriptor_result = encoder->AllocateDescriptorSets(
+        buffer_count, samplers_count, subpass_count, layouts_);
+    if (!descriptor_result.ok()) {
+      return descriptor_result.status();
+    }
+    auto descriptor_sets = descriptor_result.value();
+    if (descriptor_sets.size() != layouts_.size()) {
+      return fml::Status(fml::StatusCode::kUnknown,
+                         "Failed to allocate descriptor sets.");
+    }
+
+    for (size_t i = 0; i < writes_.size(); i++) {
+      writes_[i].dstSet = descriptor_sets[write_set_indices_[i]];
+    }
+    context.GetDevice().updateDescriptorSets(writes_, {});
+
+    result_.sets.reserve(command_set_indices_.size());
+    for (size_t set_index : command_set_indices_) {
+      result_.sets.push_back(descriptor_sets[set_index]);
+    }
+    result_.unique_set_count = descriptor_sets.size();
+    return result_;
+  }
+
+ private:
+  std::vector<vk::DescriptorBufferInfo> buffers_;
+  std::vector<vk::DescriptorImageInfo> images_;
+  std::vector<vk::WriteDescriptorSet> writes_;
+  // The index of the unique set that each write is for.
+  std::vector<size_t> write_set_indices_;
+  // The layout of each unique set.
+  std::vector<vk::DescriptorSetLayout> layouts_;
+  std::unordered_map<DescriptorSetKeyVK, size_t, DescriptorSetKeyVK::Hash>
+      set_indices_;
+  // The index of the unique set that each command binds.
+  std::vector<size_t> command_set_indices_;
+  DescriptorSetsVK result_;
+
+  // The state of the command being collected.
+  vk::DescriptorSetLayout layout_;
+  std::optional<DescriptorSetKeyVK> key_;
+  size_t command_buffer_start_ = 0;
+  size_t command_image_start_ = 0;
+  size_t command_write_start_ = 0;
+  std::vector<std::pair<uint32_t, uint32_t>> command_dynamic_offsets_;
+
+  DescriptorSetBuilder(const DescriptorSetBuilder&) = delete;
+
+  DescriptorSetBuilder& operator=(const DescriptorSetBuilder&) = delete;
+};
+
+}  // namespace
+
 static bool BindImages(const Bindings& bindings,
-                       Allocator& allocator,
                        const std::shared_ptr<CommandEncoderVK>& encoder,
-                       vk::DescriptorSet& vk_desc_set,
-                       std::vector<vk::DescriptorImageInfo>& images,
-                       std::vector<vk::WriteDescriptorSet>& writes) {
+                       DescriptorSetBuilder& builder) {
   for (const TextureAndSampler& data : bindings.sampled_images) {
     auto texture = data.texture.resource;
     const auto& texture_vk = TextureVK::Cast(*texture);
@@ -41,20 +260,9 @@ static bool BindImages(const Bindings& bindings,
 
     const SampledImageSlot& slot = data.slot;
 
-    vk::DescriptorImageInfo image_info;
-    image_info.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-    image_info.sampler = sampler.GetSampler();
-    image_info.imageView = texture_vk.GetImageView();
-    images.push_back(image_info);
-
-    vk::WriteDescriptorSet write_set;
-    write_set.dstSet = vk_desc_set;
-    write_set.dstBinding = slot.binding;
-    write_set.descriptorCount = 1u;
-    write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
-    write_set.pImageInfo = &images.back();
-
-    writes.push_back(write_set);
+    builder.AddImage(slot.binding, vk::DescriptorType::eCombinedImageSampler,
+                     texture_vk.GetImageView(), sampler.GetSampler(),
+                     vk::ImageLayout::eShaderReadOnlyOptimal);
   }
 
   return true;
@@ -63,10 +271,8 @@ static bool BindImages(const Bindings& bindings,
 static bool BindBuffers(const Bindings& bindings,
                         Allocator& allocator,
                         const std::shared_ptr<CommandEncoderVK>& encoder,
-                        vk::DescriptorSet& vk_desc_set,
                         const std::vector<DescriptorSetLayout>& desc_set,
-                        std::vector<vk::DescriptorBufferInfo>& buffers,
-                        std::vector<vk::WriteDescriptorSet>& writes) {
+                        DescriptorSetBuilder& builder) {
   for (const BufferAndUniformSlot& data : bindings.buffers) {
     const auto& buffer_view = data.view.resource.buffer;
 
@@ -85,14 +291,6 @@ static bool BindBuffers(const Bindings& bindings,
       return false;
     }
 
-    uint32_t offset = data.view.resource.range.offset;
-
-    vk::DescriptorBufferInfo buffer_info;
-    buffer_info.buffer = buffer;
-    buffer_info.offset = offset;
-    buffer_info.range = data.view.resource.range.length;
-    buffers.push_back(buffer_info);
-
     // TODO(jonahwilliams): remove this part by storing more data in
     // ShaderUniformSlot.
     const ShaderUniformSlot& uniform = data.slot;
@@ -108,162 +306,104 @@ static bool BindBuffers(const Bindings& bindings,
     }
     auto layout = *layout_it;
 
-    vk::WriteDescriptorSet write_set;
-    write_set.dstSet = vk_desc_set;
-    write_set.dstBinding = uniform.binding;
-    write_set.descriptorCount = 1u;
-    write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
-    write_set.pBufferInfo = &buffers.back();
-
-    writes.push_back(write_set);
+    builder.AddBuffer(uniform.binding,
+                      ToVKDescriptorType(layout.descriptor_type), buffer,
+                      data.view.resource.range.offset,
+                      data.view.resource.range.length);
   }
   return true;
 }
 
-fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
+fml::StatusOr<DescriptorSetsVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     const std::vector<Command>& commands,
     const TextureVK& input_attachment) {
   if (commands.empty()) {
-    return std::vector<vk::DescriptorSet>{};
+    return DescriptorSetsVK{};
   }
 
-  // Step 1: Determine the total number of buffer and sampler descriptor
-  // sets required. Collect this information along with the layout information
-  // to allocate a correctly sized descriptor pool.
+  // Step 1: Determine the maximum number of buffer and image descriptors
+  // required.
   size_t buffer_count = 0;
-  size_t samplers_count = 0;
-  size_t subpass_count = 0;
-  std::vector<vk::DescriptorSetLayout> layouts;
-  layouts.reserve(commands.size());
-
+  size_t image_count = 0;
   for (const auto& command : commands) {
     buffer_count += command.vertex_bindings.buffers.size();
     buffer_count += command.fragment_bindings.buffers.size();
-    samplers_count += command.fragment_bindings.sampled_images.size();
-    subpass_count +=
-        command.pipeline->GetDescriptor().UsesSubpassInput() ? 1 : 0;
-
-    layouts.emplace_back(
-        PipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout());
-  }
-  auto descriptor_result = encoder->AllocateDescriptorSets(
-      buffer_count, samplers_count, subpass_count, layouts);
-  if (!descriptor_result.ok()) {
-    return descriptor_result.status();
-  }
-  auto descriptor_sets = descriptor_result.value();
-  if (descriptor_sets.empty()) {
-    return fml::Status();
+    image_count += command.fragment_bindings.sampled_images.size();
+    image_count += command.pipeline->GetDescriptor().UsesSubpassInput() ? 1 : 0;
   }
 
-  // Step 2: Update the descriptors for all image and buffer descriptors used
-  // in the render pass.
-  std::vector<vk::DescriptorImageInfo> images;
-  std::vector<vk::DescriptorBufferInfo> buffers;
-  std::vector<vk::WriteDescriptorSet> writes;
-  images.reserve(samplers_count + subpass_count);
-  buffers.reserve(buffer_count);
-  writes.reserve(samplers_count + buffer_count + subpass_count);
-
+  // Step 2: Collect the descriptors of every command. Commands with the same
+  // descriptors share a set.
+  DescriptorSetBuilder builder(commands.size(), buffer_count, image_count);
   auto& allocator = *context.GetResourceAllocator();
-  auto desc_index = 0u;
   for (const auto& command : commands) {
     auto desc_set = command.pipeline->GetDescriptor()
                         .GetVertexDescriptor()
                         ->GetDescriptorSetLayouts();
 
-    if (!BindBuffers(command.vertex_bindings, allocator, encoder,
-                     descriptor_sets[desc_index], desc_set, buffers, writes) ||
-        !BindBuffers(command.fragment_bindings, allocator, encoder,
-                     descriptor_sets[desc_index], desc_set, buffers, writes) ||
-        !BindImages(command.fragment_bindings, allocator, encoder,
-                    descriptor_sets[desc_index], images, writes)) {
+    builder.BeginCommand(
+        PipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout());
+    if (!BindBuffers(command.vertex_bindings, allocator, encoder, desc_set,
+                     builder) ||
+        !BindBuffers(command.fragment_bindings, allocator, encoder, desc_set,
+                     builder) ||
+        !BindImages(command.fragment_bindings, encoder, builder)) {
       return fml::Status(fml::StatusCode::kUnknown,
                          "Failed to bind texture or buffer.");
     }
 
     if (command.pipeline->GetDescriptor().UsesSubpassInput()) {
-      vk::DescriptorImageInfo image_info;
-      image_info.imageLayout = vk::ImageLayout::eGeneral;
-      image_info.sampler = VK_NULL_HANDLE;
-      image_info.imageView = input_attachment.GetImageView();
-      images.push_back(image_info);
-
-      vk::WriteDescriptorSet write_set;
-      write_set.dstSet = descriptor_sets[desc_index];
-      write_set.dstBinding = kMagicSubpassInputBinding;
-      write_set.descriptorCount = 1u;
-      write_set.descriptorType = vk::DescriptorType::eInputAttachment;
-      write_set.pImageInfo = &images.back();
-
-      writes.push_back(write_set);
+      builder.AddImage(kMagicSubpassInputBinding,
+                       vk::DescriptorType::eInputAttachment,
+                       input_attachment.GetImageView(), vk::Sampler{},
+                       vk::ImageLayout::eGeneral);
     }
-    desc_index += 1;
+    builder.EndCommand();
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
-  return descriptor_sets;
+  // Step 3: Allocate and write the distinct descriptor sets.
+  return builder.Finish(context, encoder);
 }
 
-fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
+fml::StatusOr<DescriptorSetsVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     const std::vector<ComputeCommand>& commands) {
   if (commands.empty()) {
-    return std::vector<vk::DescriptorSet>{};
+    return DescriptorSetsVK{};
   }
-  // Step 1: Determine the total number of buffer and sampler descriptor
-  // sets required. Collect this information along with the layout information
-  // to allocate a correctly sized descriptor pool.
-  size_t buffer_count = 0;
-  size_t samplers_count = 0;
-  std::vector<vk::DescriptorSetLayout> layouts;
-  layouts.reserve(commands.size());
 
+  // Step 1: Determine the maximum number of buffer and image descriptors
+  // required.
+  size_t buffer_count = 0;
+  size_t image_count = 0;
   for (const auto& command : commands) {
     buffer_count += command.bindings.buffers.size();
-    samplers_count += command.bindings.sampled_images.size();
-
-    layouts.emplace_back(
-        ComputePipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout());
-  }
-  auto descriptor_result =
-      encoder->AllocateDescriptorSets(buffer_count, samplers_count, 0, layouts);
-  if (!descriptor_result.ok()) {
-    return descriptor_result.status();
+    image_count += command.bindings.sampled_images.size();
   }
-  auto descriptor_sets = descriptor_result.value();
-  if (descriptor_sets.empty()) {
-    return fml::Status();
-  }
-  // Step 2: Update the descriptors for all image and buffer descriptors used
-  // in the render pass.
-  std::vector<vk::DescriptorImageInfo> images;
-  std::vector<vk::DescriptorBufferInfo> buffers;
-  std::vector<vk::WriteDescriptorSet> writes;
-  images.reserve(samplers_count);
-  buffers.reserve(buffer_count);
-  writes.reserve(samplers_count + buffer_count);
 
+  // Step 2: Collect the descriptors of every command. Commands with the same
+  // descriptors share a set.
+  DescriptorSetBuilder builder(commands.size(), buffer_count, image_count);
   auto& allocator = *context.GetResourceAllocator();
-  auto desc_index = 0u;
   for (const auto& command : commands) {
     auto desc_set = command.pipeline->GetDescriptor().GetDescriptorSetLayouts();
 
-    if (!BindBuffers(command.bindings, allocator, encoder,
-                     descriptor_sets[desc_index], desc_set, buffers, writes) ||
-        !BindImages(command.bindings, allocator, encoder,
-                    descriptor_sets[desc_index], images, writes)) {
+    builder.BeginCommand(
+        ComputePipelineVK::Cast(*command.pipeline).GetDescriptorSetLayout());
+    if (!BindBuffers(command.bindings, allocator, encoder, desc_set,
+                     builder) ||
+        !BindImages(command.bindings, encoder, builder)) {
       return fml::Status(fml::StatusCode::kUnknown,
                          "Failed to bind texture or buffer.");
     }
-    desc_index += 1;
+    builder.EndCommand();
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
-  return descriptor_sets;
+  // Step 3: Allocate and write the distinct descriptor sets.
+  return builder.Finish(context, encoder);
 }
 
 }  // namespace impeller
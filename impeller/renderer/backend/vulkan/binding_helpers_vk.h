@@ -5,6 +5,7 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BINDING_HELPERS_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BINDING_HELPERS_VK_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "fml/status_or.h"
@@ -15,13 +16,77 @@
 
 namespace impeller {
 
-fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
+//------------------------------------------------------------------------------
+/// @brief      Identifies the contents of a descriptor set: its layout and
+///             the buffers, image views, and samplers written to each of its
+///             bindings.
+///
+///             Uniform buffers are bound with dynamic offsets, so their
+///             offsets are not part of the descriptor and commands that
+///             only differ in where their uniforms were emplaced have equal
+///             keys.
+///
+class DescriptorSetKeyVK {
+ public:
+  explicit DescriptorSetKeyVK(vk::DescriptorSetLayout layout);
+
+  void AddBuffer(uint32_t binding,
+                 vk::DescriptorType type,
+                 const vk::DescriptorBufferInfo& info);
+
+  void AddImage(uint32_t binding,
+                vk::DescriptorType type,
+                const vk::DescriptorImageInfo& info);
+
+  bool operator==(const DescriptorSetKeyVK& other) const {
+    return values_ == other.values_;
+  }
+
+  struct Hash {
+    std::size_t operator()(const DescriptorSetKeyVK& key) const;
+  };
+
+ private:
+  std::vector<uint64_t> values_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The descriptor sets allocated for the commands of a pass.
+///
+struct DescriptorSetsVK {
+  /// The descriptor set of each command, in command order. Commands with
+  /// equal |DescriptorSetKeyVK|s share a set.
+  std::vector<vk::DescriptorSet> sets;
+
+  /// The dynamic uniform buffer offsets of all commands, in command order
+  /// and in binding order within each command.
+  std::vector<uint32_t> dynamic_offsets;
+
+  /// The index of the first dynamic offset of each command, followed by the
+  /// total number of dynamic offsets.
+  std::vector<size_t> dynamic_offset_starts;
+
+  /// The number of distinct descriptor sets that were allocated and
+  /// written.
+  size_t unique_set_count = 0u;
+
+  /// The dynamic offsets to bind along with the set of the command at
+  /// |index|.
+  vk::ArrayProxy<const uint32_t> GetDynamicOffsets(size_t index) const {
+    const size_t start = dynamic_offset_starts[index];
+    const size_t count = dynamic_offset_starts[index + 1] - start;
+    return vk::ArrayProxy<const uint32_t>(static_cast<uint32_t>(count),
+                                          dynamic_offsets.data() + start);
+  }
+};
+
+fml::StatusOr<DescriptorSetsVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     const std::vector<Command>& commands,
     const TextureVK& input_attachment);
 
-fml::StatusOr<std::vector<vk::DescriptorSet>> AllocateAndBindDescriptorSets(
+fml::StatusOr<DescriptorSetsVK> AllocateAndBindDescriptorSets(
     const ContextVK& context,
     const std::shared_ptr<CommandEncoderVK>& encoder,
     const std::vector<ComputeCommand>& commands);
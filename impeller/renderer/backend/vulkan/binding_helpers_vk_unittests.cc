@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/binding_helpers_vk.h"
+#include "impeller/renderer/backend/vulkan/formats_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+vk::DescriptorSetLayout MakeLayout(uint64_t value) {
+  return vk::DescriptorSetLayout(
+      reinterpret_cast<VkDescriptorSetLayout>(value));
+}
+
+vk::DescriptorBufferInfo MakeBufferInfo(uint64_t buffer,
+                                        uint64_t offset,
+                                        uint64_t range) {
+  return vk::DescriptorBufferInfo(
+      vk::Buffer(reinterpret_cast<VkBuffer>(buffer)), offset, range);
+}
+
+vk::DescriptorImageInfo MakeImageInfo(uint64_t sampler, uint64_t image_view) {
+  return vk::DescriptorImageInfo(
+      vk::Sampler(reinterpret_cast<VkSampler>(sampler)),
+      vk::ImageView(reinterpret_cast<VkImageView>(image_view)),
+      vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+}  // namespace
+
+TEST(DescriptorSetKeyVKTest, UniformBuffersAreBoundWithDynamicOffsets) {
+  EXPECT_EQ(ToVKDescriptorType(DescriptorType::kUniformBuffer),
+            vk::DescriptorType::eUniformBufferDynamic);
+  EXPECT_EQ(ToVKDescriptorType(DescriptorType::kStorageBuffer),
+            vk::DescriptorType::eStorageBuffer);
+}
+
+TEST(DescriptorSetKeyVKTest, EqualDescriptorsHaveEqualKeys) {
+  DescriptorSetKeyVK a(MakeLayout(0x1));
+  a.AddBuffer(0, vk::DescriptorType::eUniformBufferDynamic,
+              MakeBufferInfo(0x10, 0, 64));
+  a.AddImage(1, vk::DescriptorType::eCombinedImageSampler,
+             MakeImageInfo(0x20, 0x30));
+
+  DescriptorSetKeyVK b(MakeLayout(0x1));
+  b.AddBuffer(0, vk::DescriptorType::eUniformBufferDynamic,
+              MakeBufferInfo(0x10, 0, 64));
+  b.AddImage(1, vk::DescriptorType::eCombinedImageSampler,
+             MakeImageInfo(0x20, 0x30));
+
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(DescriptorSetKeyVK::Hash{}(a), DescriptorSetKeyVK::Hash{}(b));
+}
+
+TEST(DescriptorSetKeyVKTest, DifferentDescriptorsHaveDifferentKeys) {
+  DescriptorSetKeyVK base(MakeLayout(0x1));
+  base.AddBuffer(0, vk::DescriptorType::eStorageBuffer,
+                 MakeBufferInfo(0x10, 0, 64));
+
+  DescriptorSetKeyVK other_layout(MakeLayout(0x2));
+  other_layout.AddBuffer(0, vk::DescriptorType::eStorageBuffer,
+                         MakeBufferInfo(0x10, 0, 64));
+  EXPECT_FALSE(base == other_layout);
+
+  DescriptorSetKeyVK other_buffer(MakeLayout(0x1));
+  other_buffer.AddBuffer(0, vk::DescriptorType::eStorageBuffer,
+                         MakeBufferInfo(0x11, 0, 64));
+  EXPECT_FALSE(base == other_buffer);
+
+  DescriptorSetKeyVK other_offset(MakeLayout(0x1));
+  other_offset.AddBuffer(0, vk::DescriptorType::eStorageBuffer,
+                         MakeBufferInfo(0x10, 256, 64));
+  EXPECT_FALSE(base == other_offset);
+
+  DescriptorSetKeyVK other_binding(MakeLayout(0x1));
+  other_binding.AddBuffer(1, vk::DescriptorType::eStorageBuffer,
+                          MakeBufferInfo(0x10, 0, 64));
+  EXPECT_FALSE(base == other_binding);
+
+  DescriptorSetKeyVK image_a(MakeLayout(0x1));
+  image_a.AddImage(1, vk::DescriptorType::eCombinedImageSampler,
+                   MakeImageInfo(0x20, 0x30));
+  DescriptorSetKeyVK image_b(MakeLayout(0x1));
+  image_b.AddImage(1, vk::DescriptorType::eCombinedImageSampler,
+                   MakeImageInfo(0x21, 0x30));
+  EXPECT_FALSE(image_a == image_b);
+}
+
+}  // namespace testing
+}  // namespace impeller
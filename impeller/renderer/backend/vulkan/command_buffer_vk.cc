@@ -8,12 +8,15 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/blit_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/compute_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/encode_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/gpu_tracer_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_target.h"
@@ -46,12 +49,84 @@ bool CommandBufferVK::IsValid() const {
 
 const std::shared_ptr<CommandEncoderVK>& CommandBufferVK::GetEncoder() {
   if (!encoder_) {
+    WaitForPendingEncodes();
     encoder_ = encoder_factory_->Create();
   }
   return encoder_;
 }
 
+void CommandBufferVK::WaitForPendingEncodes() {
+  auto context = context_.lock();
+  if (!context) {
+    return;
+  }
+  const auto& encode_queue = ContextVK::Cast(*context).GetEncodeQueue();
+  if (encode_queue && !encode_queue->WaitUntilIdle()) {
+    VALIDATION_LOG << "A render pass encoded on the encode thread failed.";
+    pending_encodes_failed_ = true;
+  }
+}
+
+bool CommandBufferVK::EncodeAndSubmit(
+    const std::shared_ptr<RenderPass>& render_pass) {
+  TRACE_EVENT0("impeller", "CommandBufferVK::EncodeAndSubmit");
+  if (!IsValid() || !render_pass->IsValid()) {
+    return false;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  const auto& context_vk = ContextVK::Cast(*context);
+  const auto& encode_queue = context_vk.GetEncodeQueue();
+  // GPU traces only cover command buffers recorded on the raster thread. An
+  // encoder that already exists belongs to the current thread's pool.
+  if (!encode_queue || encoder_ || context_vk.GetGPUTracer()->IsEnabled()) {
+    return CommandBuffer::EncodeAndSubmit(render_pass);
+  }
+
+  encode_queue->Enqueue([command_buffer = shared_from_this(), render_pass]() {
+    TRACE_EVENT0("impeller", "CommandBufferVK::EncodeAndSubmitOnWorker");
+    ScopedWorkerFramePhases worker_phases;
+    // This is the only task touching the command buffer, and it runs on the
+    // thread that the encoder's command pool belongs to.
+    command_buffer->encoder_ = command_buffer->encoder_factory_->Create();
+    if (!command_buffer->encoder_) {
+      VALIDATION_LOG << "Could not create command encoder.";
+      return false;
+    }
+    if (!render_pass->EncodeCommands()) {
+      VALIDATION_LOG << "Failed to encode render pass.";
+      command_buffer->encoder_.reset();
+      return false;
+    }
+    auto context = command_buffer->context_.lock();
+    ScopedFramePhase phase(
+        context ? &context->GetFramePhaseTimings() : nullptr,
+        FramePhase::kSubmit);
+    if (!command_buffer->encoder_->Submit()) {
+      VALIDATION_LOG << "Failed to submit command buffer.";
+      return false;
+    }
+    return true;
+  });
+  // Failures are reported by the next submission or presentation that waits
+  // for this one. See |WaitForPendingEncodes|.
+  return true;
+}
+
+bool CommandBufferVK::PendingEncodesFailed() const {
+  return pending_encodes_failed_;
+}
+
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
+  WaitForPendingEncodes();
+  if (pending_encodes_failed_) {
+    if (callback) {
+      callback(CommandBuffer::Status::kError);
+    }
+    return false;
+  }
   if (!encoder_) {
     encoder_ = encoder_factory_->Create();
   }
@@ -24,13 +24,45 @@ class CommandBufferVK final
   // |CommandBuffer|
   ~CommandBufferVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the encoder of this command buffer, creating it on
+  ///             first use. Creating it waits for the render passes that are
+  ///             being encoded on the encode thread, so that it is submitted
+  ///             after them.
+  ///
   const std::shared_ptr<CommandEncoderVK>& GetEncoder();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a render pass that was being encoded on the encode
+  ///             thread when this command buffer waited for it failed to be
+  ///             encoded or submitted. Submitting this command buffer then
+  ///             fails as well, and so should presenting its results.
+  ///
+  bool PendingEncodesFailed() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encodes the render pass and submits this command buffer on
+  ///             the context's encode thread, after the render passes
+  ///             previously submitted this way. The command buffer is
+  ///             allocated from the encode thread's command pool. Returns
+  ///             before the pass is encoded, so a failure is reported by the
+  ///             next command buffer that waits for it instead.
+  ///
+  /// |CommandBuffer|
+  bool EncodeAndSubmit(const std::shared_ptr<RenderPass>& render_pass) override;
+
+  using CommandBuffer::EncodeAndSubmit;
+
  private:
   friend class ContextVK;
 
   std::shared_ptr<CommandEncoderVK> encoder_;
   std::shared_ptr<CommandEncoderFactoryVK> encoder_factory_;
+  bool pending_encodes_failed_ = false;
+
+  // Waits until the render passes being encoded on the encode thread have
+  // been submitted, and records whether any of them failed.
+  void WaitForPendingEncodes();
 
   CommandBufferVK(std::weak_ptr<const Context> context,
                   std::shared_ptr<CommandEncoderFactoryVK> encoder_factory);
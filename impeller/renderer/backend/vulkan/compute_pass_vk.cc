@@ -106,7 +106,7 @@ bool ComputePassVK::OnEncodeCommands(const Context& context,
   if (!desc_sets_result.ok()) {
     return false;
   }
-  auto desc_sets = desc_sets_result.value();
+  const auto& desc_sets = desc_sets_result.value();
 
   TRACE_EVENT0("impeller", "EncodeComputePassCommands");
   size_t desc_index = 0;
@@ -119,8 +119,8 @@ bool ComputePassVK::OnEncodeCommands(const Context& context,
         vk::PipelineBindPoint::eCompute,             // bind point
         pipeline_vk.GetPipelineLayout(),             // layout
         0,                                           // first set
-        {vk::DescriptorSet{desc_sets[desc_index]}},  // sets
-        nullptr                                      // offsets
+        {vk::DescriptorSet{desc_sets.sets[desc_index]}},  // sets
+        desc_sets.GetDynamicOffsets(desc_index)           // offsets
     );
 
     // TOOD(dnfield): This should be moved to caps. But for now keeping this
@@ -412,6 +412,12 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  // Render passes are encoded on a thread of their own rather than on the
+  // worker pool, so that they do not wait behind pipeline compiles and always
+  // use the same thread's command pools.
+  encode_thread_ = std::make_unique<fml::Thread>("ImpellerEncodeThread");
+  auto encode_queue = EncodeQueueVK::Create(encode_thread_->GetTaskRunner());
+
   //----------------------------------------------------------------------------
   /// Fetch the queues.
   ///
@@ -444,12 +450,14 @@ void ContextVK::Setup(Settings settings) {
   resource_manager_ = std::move(resource_manager);
   command_pool_recycler_ = std::move(command_pool_recycler);
   descriptor_pool_recycler_ = std::move(descriptor_pool_recycler);
+  encode_queue_ = std::move(encode_queue);
   device_name_ = std::string(physical_device_properties.deviceName);
   is_valid_ = true;
 
   // Create the GPU Tracer later because it depends on state from
   // the ContextVK.
   gpu_tracer_ = std::make_shared<GPUTracerVK>(GetDeviceHolder());
+  gpu_tracer_->SetFramePhaseTimings(GetSharedFramePhaseTimings());
 
   //----------------------------------------------------------------------------
   /// Label all the relevant objects. This happens after setup so that the
@@ -506,20 +514,49 @@ const fml::RefPtr<fml::TaskRunner> ContextVK::GetQueueSubmitRunner() const {
   return queue_submit_thread_->GetTaskRunner();
 }
 
+void ContextVK::DisposeEncodeThreadCommandPools() const {
+  if (!encode_queue_) {
+    return;
+  }
+  // Runs after the passes of the previous frame, on the thread whose pools
+  // they were allocated from.
+  encode_queue_->Enqueue([recycler = command_pool_recycler_]() {
+    recycler->Dispose();
+    return true;
+  });
+}
+
 const std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextVK::GetConcurrentWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
+void ContextVK::EndFrameWork() const {
+  // Command buffers are encoded and submitted in order on the encode thread,
+  // so the frame's work has run once a task enqueued after it runs.
+  if (encode_queue_) {
+    encode_queue_->Enqueue([timings = GetSharedFramePhaseTimings()]() {
+      timings->CompleteWorkerFrame();
+      return true;
+    });
+  }
+}
+
 void ContextVK::Shutdown() {
   // There are multiple objects, for example |CommandPoolVK|, that in their
   // destructors make a strong reference to |ContextVK|. Resetting these shared
   // pointers ensures that cleanup happens in a correct order.
   //
   // tl;dr: Without it, we get thread::join failures on shutdown.
+  if (encode_queue_) {
+    encode_queue_->WaitUntilIdle();
+  }
   fence_waiter_.reset();
   resource_manager_.reset();
 
+  if (encode_thread_) {
+    encode_thread_->Join();
+  }
   queue_submit_thread_->Join();
   raster_message_loop_->Terminate();
 }
@@ -16,6 +16,7 @@
 #include "impeller/core/formats.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
+#include "impeller/renderer/backend/vulkan/encode_queue_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
 #include "impeller/renderer/backend/vulkan/queue_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
@@ -92,6 +93,9 @@ class ContextVK final : public Context,
   // |Context|
   void SetSyncPresentation(bool value) override { sync_presentation_ = value; }
 
+  // |Context|
+  void EndFrameWork() const override;
+
   bool GetSyncPresentation() const { return sync_presentation_; }
 
   void SetOffscreenFormat(PixelFormat pixel_format);
@@ -166,6 +170,22 @@ class ContextVK final : public Context,
 
   std::shared_ptr<GPUTracerVK> GetGPUTracer() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The queue that render passes are encoded and submitted on
+  ///             when |CommandBufferVK::EncodeAndSubmit| is used.
+  ///
+  const std::shared_ptr<EncodeQueueVK>& GetEncodeQueue() const {
+    return encode_queue_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the command pools of the encode thread once the
+  ///             render passes enqueued so far have been submitted. Called at
+  ///             the end of each frame, like the raster thread's pools are
+  ///             released.
+  ///
+  void DisposeEncodeThreadCommandPools() const;
+
   void RecordFrameEndTime() const;
 
  private:
@@ -196,8 +216,10 @@ class ContextVK final : public Context,
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
   std::unique_ptr<fml::Thread> queue_submit_thread_;
+  std::unique_ptr<fml::Thread> encode_thread_;
   std::shared_ptr<GPUTracerVK> gpu_tracer_;
   std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<EncodeQueueVK> encode_queue_;
 
   bool sync_presentation_ = false;
   const uint64_t hash_;
@@ -183,6 +183,8 @@ DescriptorPoolAndSize DescriptorPoolRecyclerVK::Create(
                              minimum_capacity},
       vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer,
                              minimum_capacity},
+      vk::DescriptorPoolSize{vk::DescriptorType::eUniformBufferDynamic,
+                             minimum_capacity},
       vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer,
                              minimum_capacity},
       vk::DescriptorPoolSize{vk::DescriptorType::eInputAttachment,
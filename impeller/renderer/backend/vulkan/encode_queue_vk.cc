@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/encode_queue_vk.h"
+
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+std::shared_ptr<EncodeQueueVK> EncodeQueueVK::Create(
+    fml::RefPtr<fml::TaskRunner> runner) {
+  return std::shared_ptr<EncodeQueueVK>(new EncodeQueueVK(std::move(runner)));
+}
+
+EncodeQueueVK::EncodeQueueVK(fml::RefPtr<fml::TaskRunner> runner)
+    : runner_(std::move(runner)) {}
+
+EncodeQueueVK::~EncodeQueueVK() = default;
+
+void EncodeQueueVK::Enqueue(Task task) {
+  if (!task) {
+    return;
+  }
+  {
+    Lock lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (running_) {
+      // The runner is already running tasks and picks this one up.
+      return;
+    }
+    running_ = true;
+  }
+  if (!runner_) {
+    RunTasks();
+    return;
+  }
+  runner_->PostTask([queue = shared_from_this()]() { queue->RunTasks(); });
+}
+
+void EncodeQueueVK::RunTasks() {
+  TRACE_EVENT0("impeller", "EncodeQueueVK::RunTasks");
+  while (true) {
+    Task task;
+    {
+      Lock lock(mutex_);
+      if (tasks_.empty()) {
+        running_ = false;
+        idle_cv_.NotifyAll();
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    if (!task()) {
+      Lock lock(mutex_);
+      failed_ = true;
+    }
+  }
+}
+
+bool EncodeQueueVK::WaitUntilIdle() {
+  Lock lock(mutex_);
+  idle_cv_.Wait(mutex_, [&]() IPLR_REQUIRES(mutex_) { return !running_; });
+  return !std::exchange(failed_, false);
+}
+
+}  // namespace impeller
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ENCODE_QUEUE_VK_H_
+#define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ENCODE_QUEUE_VK_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/task_runner.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Runs the encoding and submission of command buffers on a
+///             dedicated thread, one at a time and in the order they were
+///             enqueued.
+///
+///             Image layouts are tracked as commands are encoded, and
+///             command buffers are executed in the order they are submitted,
+///             so both have to happen in the order the passes were recorded.
+///             Running them off the raster thread still lets a pass be
+///             encoded while the next one is being recorded.
+///
+///             All tasks run on the thread of the queue's runner, and so
+///             allocate their command buffers from that thread's command
+///             pool.
+///
+/// @note       This class is thread-safe.
+///
+class EncodeQueueVK final
+    : public std::enable_shared_from_this<EncodeQueueVK> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      A task that encodes and submits a command buffer. Returns
+  ///             false if that failed.
+  ///
+  using Task = std::function<bool()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a queue that runs its tasks on |runner|, or on the
+  ///             enqueuing thread if it is null. The runner must run tasks
+  ///             serially on a single thread that does nothing else that
+  ///             uses the context's command pools.
+  ///
+  static std::shared_ptr<EncodeQueueVK> Create(
+      fml::RefPtr<fml::TaskRunner> runner);
+
+  ~EncodeQueueVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Runs |task| after all previously enqueued tasks.
+  ///
+  void Enqueue(Task task);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks until all enqueued tasks have run. Must be called
+  ///             before a command buffer is encoded or submitted outside of
+  ///             the queue, and must not be called from a task.
+  ///
+  /// @return     Whether all of the tasks that ran since the last time this
+  ///             returned false succeeded. A failure is only reported to one
+  ///             caller.
+  ///
+  bool WaitUntilIdle();
+
+ private:
+  const fml::RefPtr<fml::TaskRunner> runner_;
+  Mutex mutex_;
+  ConditionVariable idle_cv_;
+  std::deque<Task> tasks_ IPLR_GUARDED_BY(mutex_);
+  bool running_ IPLR_GUARDED_BY(mutex_) = false;
+  bool failed_ IPLR_GUARDED_BY(mutex_) = false;
+
+  explicit EncodeQueueVK(fml::RefPtr<fml::TaskRunner> runner);
+
+  void RunTasks();
+
+  EncodeQueueVK(const EncodeQueueVK&) = delete;
+
+  EncodeQueueVK& operator=(const EncodeQueueVK&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_ENCODE_QUEUE_VK_H_
@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"  // IWYU pragma: keep
+#include "impeller/renderer/backend/vulkan/encode_queue_vk.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(EncodeQueueVKTest, RunsTasksInOrderOnRunner) {
+  fml::Thread thread("EncodeQueueVKTest");
+  auto queue = EncodeQueueVK::Create(thread.GetTaskRunner());
+
+  std::vector<int> order;
+  std::atomic_bool ran_on_caller = false;
+  const auto caller = std::this_thread::get_id();
+  for (int i = 0; i < 100; i++) {
+    queue->Enqueue([&order, &ran_on_caller, caller, i]() {
+      if (std::this_thread::get_id() == caller) {
+        ran_on_caller = true;
+      }
+      order.push_back(i);
+      return true;
+    });
+  }
+  EXPECT_TRUE(queue->WaitUntilIdle());
+
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(order[i], i);
+  }
+  EXPECT_FALSE(ran_on_caller);
+}
+
+TEST(EncodeQueueVKTest, RunsTasksInlineWithoutRunner) {
+  auto queue = EncodeQueueVK::Create(nullptr);
+
+  bool ran = false;
+  queue->Enqueue([&ran]() {
+    ran = true;
+    return true;
+  });
+  EXPECT_TRUE(ran);
+  EXPECT_TRUE(queue->WaitUntilIdle());
+}
+
+TEST(EncodeQueueVKTest, WaitUntilIdleReturnsWhenEmpty) {
+  fml::Thread thread("EncodeQueueVKTest");
+  auto queue = EncodeQueueVK::Create(thread.GetTaskRunner());
+  EXPECT_TRUE(queue->WaitUntilIdle());
+}
+
+TEST(EncodeQueueVKTest, ReportsFailedTaskToOneWaiter) {
+  fml::Thread thread("EncodeQueueVKTest");
+  auto queue = EncodeQueueVK::Create(thread.GetTaskRunner());
+
+  bool ran_after_failure = false;
+  queue->Enqueue([]() { return false; });
+  queue->Enqueue([&ran_after_failure]() {
+    ran_after_failure = true;
+    return true;
+  });
+  EXPECT_FALSE(queue->WaitUntilIdle());
+  EXPECT_TRUE(ran_after_failure);
+
+  // The failure has been reported.
+  EXPECT_TRUE(queue->WaitUntilIdle());
+  queue->Enqueue([]() { return true; });
+  EXPECT_TRUE(queue->WaitUntilIdle());
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -272,7 +272,9 @@ constexpr vk::DescriptorType ToVKDescriptorType(DescriptorType type) {
       return vk::DescriptorType::eCombinedImageSampler;
       break;
     case DescriptorType::kUniformBuffer:
-      return vk::DescriptorType::eUniformBuffer;
+      // Uniforms are bound with dynamic offsets so that descriptor sets can
+      // be shared by commands whose uniforms are in the same buffer.
+      return vk::DescriptorType::eUniformBufferDynamic;
       break;
     case DescriptorType::kStorageBuffer:
       return vk::DescriptorType::eStorageBuffer;
@@ -134,6 +134,11 @@ void GPUTracerVK::RecordCmdBufferEnd(const vk::CommandBuffer& buffer,
   }
 }
 
+void GPUTracerVK::SetFramePhaseTimings(
+    std::shared_ptr<FramePhaseTimings> timings) {
+  frame_phase_timings_ = std::move(timings);
+}
+
 void GPUTracerVK::OnFenceComplete(size_t frame_index) {
   if (!enabled_) {
     return;
@@ -170,9 +175,12 @@ void GPUTracerVK::OnFenceComplete(size_t frame_index) {
       smallest_timestamp = std::min(smallest_timestamp, bits[i]);
       largest_timestamp = std::max(largest_timestamp, bits[i]);
     }
-    auto gpu_ms =
-        (((largest_timestamp - smallest_timestamp) * timestamp_period_) /
-         1000000);
+    auto gpu_ns = (largest_timestamp - smallest_timestamp) * timestamp_period_;
+    auto gpu_ms = gpu_ns / 1000000;
+    if (frame_phase_timings_) {
+      frame_phase_timings_->SetGPUDuration(
+          fml::TimeDelta::FromNanoseconds(static_cast<int64_t>(gpu_ns)));
+    }
     FML_TRACE_COUNTER("flutter", "GPUTracer",
                       reinterpret_cast<int64_t>(this),  // Trace Counter ID
                       "FrameTimeMS", gpu_ms);
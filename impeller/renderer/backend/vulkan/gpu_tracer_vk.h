@@ -5,6 +5,7 @@
 #include <memory>
 #include <thread>
 
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "vulkan/vulkan_handles.hpp"
@@ -34,6 +35,10 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
   /// @brief Signal the end of a frame workload.
   void MarkFrameEnd();
 
+  /// @brief Sets the timings that the GPU time of each completed frame is
+  ///        reported to. Must be called before any frame is traced.
+  void SetFramePhaseTimings(std::shared_ptr<FramePhaseTimings> timings);
+
   // visible for testing.
   bool IsEnabled() const;
 
@@ -68,6 +73,8 @@ class GPUTracerVK : public std::enable_shared_from_this<GPUTracerVK> {
       trace_state_mutex_);
   size_t current_state_ IPLR_GUARDED_BY(trace_state_mutex_) = 0u;
 
+  std::shared_ptr<FramePhaseTimings> frame_phase_timings_;
+
   // The number of nanoseconds for each timestamp unit.
   float timestamp_period_ = 1;
 
@@ -6,9 +6,13 @@
 
 #include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
 
+#include <cstring>
+#include <iomanip>
 #include <sstream>
+#include <vector>
 
-#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/timing.h"
 #include "impeller/base/validation.h"
 
 namespace impeller {
@@ -16,41 +20,174 @@ namespace impeller {
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
 
-static bool VerifyExistingCache(const fml::Mapping& mapping,
-                                const CapabilitiesVK& caps) {
-  return true;
+namespace {
+
+// The header written in front of the pipeline cache data. The driver checks
+// the header of its own data too, but drivers have been known to crash on
+// caches written by other driver versions instead of rejecting them, and
+// nothing in the driver's header catches a file that was damaged on disk.
+struct PipelineCacheHeaderVK {
+  // "IPCV" in little endian.
+  static constexpr uint32_t kMagic = 0x56435049u;
+  // Bumped when the header or the way Impeller creates pipelines changes in
+  // a way that makes old caches useless.
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint32_t api_version = 0u;
+  uint8_t pipeline_cache_uuid[VK_UUID_SIZE] = {};
+  uint64_t data_size = 0u;
+  uint64_t data_hash = 0u;
+
+  PipelineCacheHeaderVK() = default;
+
+  PipelineCacheHeaderVK(const vk::PhysicalDeviceProperties& props,
+                        const fml::Mapping& data)
+      : vendor_id(props.vendorID),
+        device_id(props.deviceID),
+        driver_version(props.driverVersion),
+        api_version(props.apiVersion),
+        data_size(data.GetSize()),
+        data_hash(HashData(data)) {
+    ::memcpy(pipeline_cache_uuid, props.pipelineCacheUUID.data(),
+             VK_UUID_SIZE);
+  }
+
+  bool Matches(const PipelineCacheHeaderVK& other) const {
+    return magic == other.magic && version == other.version &&
+           vendor_id == other.vendor_id && device_id == other.device_id &&
+           driver_version == other.driver_version &&
+           api_version == other.api_version &&
+           ::memcmp(pipeline_cache_uuid, other.pipeline_cache_uuid,
+                    VK_UUID_SIZE) == 0 &&
+           data_size == other.data_size && data_hash == other.data_hash;
+  }
+
+  // FNV-1a.
+  static uint64_t HashData(const fml::Mapping& data) {
+    uint64_t hash = 0xcbf29ce484222325u;
+    const uint8_t* bytes = data.GetMapping();
+    for (size_t i = 0, size = data.GetSize(); i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3u;
+    }
+    return hash;
+  }
+};
+
+}  // namespace
+
+std::string GetPipelineCacheFileName(
+    const vk::PhysicalDeviceProperties& props) {
+  std::stringstream stream;
+  stream << kPipelineCacheFileName << "." << std::hex << std::setfill('0')
+         << std::setw(4) << props.vendorID << "." << std::setw(4)
+         << props.deviceID;
+  return stream.str();
 }
 
-static std::shared_ptr<fml::Mapping> DecorateCacheWithMetadata(
-    std::shared_ptr<fml::Mapping> data) {
-  return data;
+std::unique_ptr<fml::Mapping> DecoratePipelineCacheData(
+    const vk::PhysicalDeviceProperties& props,
+    const fml::Mapping& data) {
+  PipelineCacheHeaderVK header(props, data);
+  std::vector<uint8_t> decorated(sizeof(header) + data.GetSize());
+  ::memcpy(decorated.data(), &header, sizeof(header));
+  if (data.GetSize() > 0) {
+    ::memcpy(decorated.data() + sizeof(header), data.GetMapping(),
+             data.GetSize());
+  }
+  return std::make_unique<fml::DataMapping>(std::move(decorated));
 }
 
-static std::unique_ptr<fml::Mapping> RemoveMetadataFromCache(
-    std::unique_ptr<fml::Mapping> data) {
-  return data;
+std::unique_ptr<fml::Mapping> ReadPipelineCacheData(
+    const vk::PhysicalDeviceProperties& props,
+    std::shared_ptr<fml::Mapping> file) {
+  if (!file || file->GetMapping() == nullptr ||
+      file->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+  PipelineCacheHeaderVK header;
+  ::memcpy(&header, file->GetMapping(), sizeof(header));
+
+  const uint8_t* data = file->GetMapping() + sizeof(header);
+  const size_t data_size = file->GetSize() - sizeof(header);
+  auto mapping = std::make_unique<fml::NonOwnedMapping>(
+      data, data_size, [file](auto, auto) {});
+  if (!header.Matches(PipelineCacheHeaderVK(props, *mapping))) {
+    return nullptr;
+  }
+  return mapping;
 }
 
-static std::unique_ptr<fml::Mapping> OpenCacheFile(
+static std::shared_ptr<fml::Mapping> OpenCacheFile(
     const fml::UniqueFD& base_directory,
-    const std::string& cache_file_name,
     const CapabilitiesVK& caps) {
   if (!base_directory.is_valid()) {
     return nullptr;
   }
-  std::unique_ptr<fml::Mapping> mapping =
-      fml::FileMapping::CreateReadOnly(base_directory, cache_file_name);
-  if (!mapping) {
+  const auto& props = caps.GetPhysicalDeviceProperties();
+  std::shared_ptr<fml::Mapping> file = fml::FileMapping::CreateReadOnly(
+      base_directory, GetPipelineCacheFileName(props));
+  if (!file) {
     return nullptr;
   }
-  if (!VerifyExistingCache(*mapping, caps)) {
+  std::shared_ptr<fml::Mapping> data = ReadPipelineCacheData(props, file);
+  if (!data) {
+    FML_LOG(INFO) << "Existing pipeline cache was written by a different "
+                     "device or driver, or was damaged. Starting with a fresh "
+                     "cache.";
     return nullptr;
   }
-  mapping = RemoveMetadataFromCache(std::move(mapping));
-  if (!mapping) {
+  return data;
+}
+
+static vk::UniquePipelineCache CreatePipelineCache(
+    const vk::Device& device,
+    const std::shared_ptr<fml::Mapping>& initial_data) {
+  vk::PipelineCacheCreateInfo cache_info;
+  if (initial_data) {
+    cache_info.initialDataSize = initial_data->GetSize();
+    cache_info.pInitialData = initial_data->GetMapping();
+  }
+
+  auto [result, existing_cache] = device.createPipelineCacheUnique(cache_info);
+  if (result == vk::Result::eSuccess) {
+    return std::move(existing_cache);
+  }
+
+  // Even though we perform consistency checks because we don't trust the
+  // driver, the driver may have additional information that may cause it to
+  // reject the cache too.
+  FML_LOG(INFO) << "Existing pipeline cache was invalid: "
+                << vk::to_string(result) << ". Starting with a fresh cache.";
+  cache_info.pInitialData = nullptr;
+  cache_info.initialDataSize = 0u;
+  auto [result2, new_cache] = device.createPipelineCacheUnique(cache_info);
+  if (result2 != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create new pipeline cache: "
+                   << vk::to_string(result2);
+    return {};
+  }
+  return std::move(new_cache);
+}
+
+static std::shared_ptr<fml::Mapping> GetPipelineCacheData(
+    const vk::Device& device,
+    const vk::PipelineCache& cache) {
+  auto [result, data] = device.getPipelineCacheData(cache);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get pipeline cache data: "
+                   << vk::to_string(result);
     return nullptr;
   }
-  return mapping;
+  auto shared_data = std::make_shared<std::vector<uint8_t>>();
+  std::swap(*shared_data, data);
+  return std::make_shared<fml::NonOwnedMapping>(
+      shared_data->data(), shared_data->size(), [shared_data](auto, auto) {});
 }
 
 PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
@@ -65,46 +202,27 @@ PipelineCacheVK::PipelineCacheVK(std::shared_ptr<const Capabilities> caps,
 
   const auto& vk_caps = CapabilitiesVK::Cast(*caps_);
 
-  auto existing_cache_data =
-      OpenCacheFile(cache_directory_, kPipelineCacheFileName, vk_caps);
-
-  vk::PipelineCacheCreateInfo cache_info;
-  if (existing_cache_data) {
-    cache_info.initialDataSize = existing_cache_data->GetSize();
-    cache_info.pInitialData = existing_cache_data->GetMapping();
+  // Caches written before they were keyed by device are never read again.
+  if (cache_directory_.is_valid()) {
+    fml::UnlinkFile(cache_directory_, kPipelineCacheFileName);
   }
 
-  auto [result, existing_cache] =
-      device_holder->GetDevice().createPipelineCacheUnique(cache_info);
-
-  if (result == vk::Result::eSuccess) {
-    cache_ = std::move(existing_cache);
-  } else {
-    // Even though we perform consistency checks because we don't trust the
-    // driver, the driver may have additional information that may cause it to
-    // reject the cache too.
-    FML_LOG(INFO) << "Existing pipeline cache was invalid: "
-                  << vk::to_string(result) << ". Starting with a fresh cache.";
-    cache_info.pInitialData = nullptr;
-    cache_info.initialDataSize = 0u;
-    auto [result2, new_cache] =
-        device_holder->GetDevice().createPipelineCacheUnique(cache_info);
-    if (result2 == vk::Result::eSuccess) {
-      cache_ = std::move(new_cache);
-    } else {
-      VALIDATION_LOG << "Could not create new pipeline cache: "
-                     << vk::to_string(result2);
-    }
-  }
+  cache_ = CreatePipelineCache(device_holder->GetDevice(),
+                               OpenCacheFile(cache_directory_, vk_caps));
 
   is_valid_ = !!cache_;
 }
 
 PipelineCacheVK::~PipelineCacheVK() {
   std::shared_ptr<DeviceHolder> device_holder = device_holder_.lock();
+  Lock lock(thread_caches_mutex_);
   if (device_holder) {
+    thread_caches_.clear();
     cache_.reset();
   } else {
+    for (auto& [thread_id, cache] : thread_caches_) {
+      cache.release();
+    }
     cache_.release();
   }
 }
@@ -113,6 +231,69 @@ bool PipelineCacheVK::IsValid() const {
   return is_valid_;
 }
 
+vk::PipelineCache PipelineCacheVK::GetThreadCache(const vk::Device& device) {
+  Lock lock(thread_caches_mutex_);
+  auto& cache = thread_caches_[std::this_thread::get_id()];
+  if (!cache && cache_) {
+    // Seed the cache with the pipelines loaded from disk and those merged in
+    // from other threads so far. Merges only write to the main cache with
+    // the lock held, so it can be read here.
+    cache = CreatePipelineCache(device, GetPipelineCacheData(device, *cache_));
+  }
+  // The main cache is never handed out, because merges write to it while
+  // other threads create pipelines. Without a cache of its own, the thread
+  // creates pipelines without one.
+  return cache ? *cache : vk::PipelineCache{};
+}
+
+void PipelineCacheVK::RecordPipelineCreation(
+    const void* create_info_next,
+    std::chrono::nanoseconds duration) {
+  pipeline_count_++;
+  total_create_time_ns_ += duration.count();
+
+  // Find the creation feedback in the chain, if the caller asked for it.
+  for (auto next = static_cast<const vk::BaseInStructure*>(create_info_next);
+       next != nullptr; next = next->pNext) {
+    if (next->sType !=
+        vk::PipelineCreationFeedbackCreateInfoEXT::structureType) {
+      continue;
+    }
+    const auto& feedback =
+        *reinterpret_cast<const vk::PipelineCreationFeedbackCreateInfoEXT*>(
+            next);
+    const auto flags = feedback.pPipelineCreationFeedback->flags;
+    if (!(flags & vk::PipelineCreationFeedbackFlagBits::eValid)) {
+      break;
+    }
+    if (flags &
+        vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit) {
+      cache_hit_count_++;
+    } else {
+      cache_miss_count_++;
+    }
+    break;
+  }
+
+  const Statistics stats = GetStatistics();
+  const int64_t hits = stats.cache_hit_count;
+  const int64_t misses = stats.cache_miss_count;
+  const int64_t pipelines = stats.pipeline_count;
+  const int64_t create_time_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          stats.total_create_time)
+          .count();
+  static constexpr int64_t kImpellerPipelineTraceID = 1988;
+  FML_TRACE_COUNTER("impeller",                         //
+                    "PipelineCache",                    // series name
+                    kImpellerPipelineTraceID,           // series ID
+                    "PipelineCacheHits", hits,          //
+                    "PipelineCacheMisses", misses,      //
+                    "TotalPipelines", pipelines,        //
+                    "TotalCreateTimeMS", create_time_ms  //
+  );
+}
+
 vk::UniquePipeline PipelineCacheVK::CreatePipeline(
     const vk::GraphicsPipelineCreateInfo& info) {
   std::shared_ptr<DeviceHolder> strong_device = device_holder_.lock();
@@ -120,12 +301,16 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
     return {};
   }
 
-  auto [result, pipeline] =
-      strong_device->GetDevice().createGraphicsPipelineUnique(*cache_, info);
+  const auto& device = strong_device->GetDevice();
+  auto cache = GetThreadCache(device);
+  auto start = Clock::now();
+  auto [result, pipeline] = device.createGraphicsPipelineUnique(cache, info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create graphics pipeline: "
                    << vk::to_string(result);
+    return std::move(pipeline);
   }
+  RecordPipelineCreation(info.pNext, Clock::now() - start);
   return std::move(pipeline);
 }
 
@@ -136,12 +321,16 @@ vk::UniquePipeline PipelineCacheVK::CreatePipeline(
     return {};
   }
 
-  auto [result, pipeline] =
-      strong_device->GetDevice().createComputePipelineUnique(*cache_, info);
+  const auto& device = strong_device->GetDevice();
+  auto cache = GetThreadCache(device);
+  auto start = Clock::now();
+  auto [result, pipeline] = device.createComputePipelineUnique(cache, info);
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create compute pipeline: "
                    << vk::to_string(result);
+    return std::move(pipeline);
   }
+  RecordPipelineCreation(info.pNext, Clock::now() - start);
   return std::move(pipeline);
 }
 
@@ -154,19 +343,29 @@ std::shared_ptr<fml::Mapping> PipelineCacheVK::CopyPipelineCacheData() const {
   if (!IsValid()) {
     return nullptr;
   }
-  auto [result, data] =
-      strong_device->GetDevice().getPipelineCacheData(*cache_);
-  if (result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Could not get pipeline cache data to persist.";
-    return nullptr;
+  const auto& device = strong_device->GetDevice();
+
+  Lock lock(thread_caches_mutex_);
+  std::vector<vk::PipelineCache> sources;
+  for (const auto& [thread_id, cache] : thread_caches_) {
+    if (cache) {
+      sources.push_back(*cache);
+    }
   }
-  auto shared_data = std::make_shared<std::vector<uint8_t>>();
-  std::swap(*shared_data, data);
-  return std::make_shared<fml::NonOwnedMapping>(
-      shared_data->data(), shared_data->size(), [shared_data](auto, auto) {});
+  if (!sources.empty()) {
+    // The source caches are internally synchronized, so threads may keep
+    // creating pipelines with them while they are merged.
+    auto result = device.mergePipelineCaches(*cache_, sources);
+    if (result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not merge pipeline caches: "
+                     << vk::to_string(result);
+    }
+  }
+  return GetPipelineCacheData(device, *cache_);
 }
 
 void PipelineCacheVK::PersistCacheToDisk() const {
+  TRACE_EVENT0("impeller", "PipelineCacheVK::PersistCacheToDisk");
   if (!cache_directory_.is_valid()) {
     return;
   }
@@ -175,18 +374,29 @@ void PipelineCacheVK::PersistCacheToDisk() const {
     VALIDATION_LOG << "Could not copy pipeline cache data.";
     return;
   }
-  data = DecorateCacheWithMetadata(std::move(data));
-  if (!data) {
+  const auto& props = GetCapabilities()->GetPhysicalDeviceProperties();
+  auto decorated = DecoratePipelineCacheData(props, *data);
+  if (!decorated) {
     VALIDATION_LOG
         << "Could not decorate pipeline cache with additional metadata.";
     return;
   }
-  if (!fml::WriteAtomically(cache_directory_, kPipelineCacheFileName, *data)) {
+  const auto file_name = GetPipelineCacheFileName(props);
+  if (!fml::WriteAtomically(cache_directory_, file_name.c_str(), *decorated)) {
     VALIDATION_LOG << "Could not persist pipeline cache to disk.";
     return;
   }
 }
 
+PipelineCacheVK::Statistics PipelineCacheVK::GetStatistics() const {
+  return Statistics{
+      .pipeline_count = pipeline_count_,
+      .cache_hit_count = cache_hit_count_,
+      .cache_miss_count = cache_miss_count_,
+      .total_create_time = std::chrono::nanoseconds(total_create_time_ns_),
+  };
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
@@ -5,15 +5,63 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_VK_H_
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Returns the name of the file that the pipeline cache of the
+///             device is persisted to. Each device has its own file so that
+///             devices sharing a cache directory don't discard each other's
+///             caches.
+///
+std::string GetPipelineCacheFileName(const vk::PhysicalDeviceProperties& props);
+
+//------------------------------------------------------------------------------
+/// @brief      Prepends a header identifying the device, driver, and the
+///             pipeline cache UUID to pipeline cache data, along with a
+///             checksum of the data.
+///
+std::unique_ptr<fml::Mapping> DecoratePipelineCacheData(
+    const vk::PhysicalDeviceProperties& props,
+    const fml::Mapping& data);
+
+//------------------------------------------------------------------------------
+/// @brief      Validates the header added by |DecoratePipelineCacheData|
+///             against the device and returns the pipeline cache data that
+///             follows it, or nullptr if the data was written by a different
+///             device, driver, or engine, or is damaged.
+///
+std::unique_ptr<fml::Mapping> ReadPipelineCacheData(
+    const vk::PhysicalDeviceProperties& props,
+    std::shared_ptr<fml::Mapping> file);
+
 class PipelineCacheVK {
  public:
+  struct Statistics {
+    /// The number of pipelines created through the cache.
+    size_t pipeline_count = 0u;
+    /// The number of pipelines that the driver reported as found in the
+    /// cache. Hits and misses are only counted on devices that support
+    /// VK_EXT_pipeline_creation_feedback.
+    size_t cache_hit_count = 0u;
+    size_t cache_miss_count = 0u;
+    /// The wall time spent creating pipelines, summed over all threads.
+    std::chrono::nanoseconds total_create_time{0};
+  };
+
   // The [device] is passed in directly so that it can be used in the
   // constructor directly. The [device_holder] isn't guaranteed to be valid
   // at the time of executing `PipelineCacheVK` because of how `ContextVK` does
@@ -32,15 +80,40 @@ class PipelineCacheVK {
 
   const CapabilitiesVK* GetCapabilities() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Merges the caches of the threads that created pipelines into
+  ///             the main cache and writes it to a temporary file that is
+  ///             then renamed over the existing cache file. Call this on a
+  ///             worker thread.
+  ///
   void PersistCacheToDisk() const;
 
+  Statistics GetStatistics() const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolder> device_holder_;
   const fml::UniqueFD cache_directory_;
+  // The cache loaded from disk, into which the thread caches are merged.
+  // Threads that create pipelines are given their own cache, seeded from
+  // this one, so that concurrent pipeline creation doesn't contend on a
+  // single cache in the driver. This cache is only accessed with the mutex
+  // held, as merges write to it.
   vk::UniquePipelineCache cache_;
+  mutable Mutex thread_caches_mutex_;
+  std::unordered_map<std::thread::id, vk::UniquePipelineCache> thread_caches_
+      IPLR_GUARDED_BY(thread_caches_mutex_);
+  std::atomic_size_t pipeline_count_ = 0u;
+  std::atomic_size_t cache_hit_count_ = 0u;
+  std::atomic_size_t cache_miss_count_ = 0u;
+  std::atomic_int64_t total_create_time_ns_ = 0;
   bool is_valid_ = false;
 
+  vk::PipelineCache GetThreadCache(const vk::Device& device);
+
+  void RecordPipelineCreation(const void* create_info_next,
+                              std::chrono::nanoseconds duration);
+
   std::shared_ptr<fml::Mapping> CopyPipelineCacheData() const;
 
   PipelineCacheVK(const PipelineCacheVK&) = delete;
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+vk::PhysicalDeviceProperties MakeProperties() {
+  vk::PhysicalDeviceProperties props;
+  props.vendorID = 0x13B5;
+  props.deviceID = 0x92020010;
+  props.driverVersion = 42;
+  props.apiVersion = VK_API_VERSION_1_1;
+  for (size_t i = 0; i < VK_UUID_SIZE; i++) {
+    props.pipelineCacheUUID[i] = static_cast<uint8_t>(i);
+  }
+  return props;
+}
+
+std::shared_ptr<fml::Mapping> Copy(const fml::Mapping& mapping) {
+  return std::make_shared<fml::DataMapping>(std::vector<uint8_t>(
+      mapping.GetMapping(), mapping.GetMapping() + mapping.GetSize()));
+}
+
+}  // namespace
+
+TEST(PipelineCacheVKTest, CacheDataRoundTrips) {
+  auto props = MakeProperties();
+  fml::DataMapping data(std::string("pipeline cache data"));
+
+  auto decorated = DecoratePipelineCacheData(props, data);
+  ASSERT_NE(decorated, nullptr);
+  EXPECT_GT(decorated->GetSize(), data.GetSize());
+
+  auto read = ReadPipelineCacheData(props, Copy(*decorated));
+  ASSERT_NE(read, nullptr);
+  ASSERT_EQ(read->GetSize(), data.GetSize());
+  EXPECT_EQ(::memcmp(read->GetMapping(), data.GetMapping(), data.GetSize()),
+            0);
+}
+
+TEST(PipelineCacheVKTest, RejectsCacheFromDifferentDriver) {
+  auto props = MakeProperties();
+  fml::DataMapping data(std::string("pipeline cache data"));
+  auto decorated = DecoratePipelineCacheData(props, data);
+
+  auto other_driver = props;
+  other_driver.driverVersion++;
+  EXPECT_EQ(ReadPipelineCacheData(other_driver, Copy(*decorated)), nullptr);
+
+  auto other_uuid = props;
+  other_uuid.pipelineCacheUUID[3]++;
+  EXPECT_EQ(ReadPipelineCacheData(other_uuid, Copy(*decorated)), nullptr);
+
+  auto other_device = props;
+  other_device.deviceID++;
+  EXPECT_EQ(ReadPipelineCacheData(other_device, Copy(*decorated)), nullptr);
+}
+
+TEST(PipelineCacheVKTest, RejectsDamagedCache) {
+  auto props = MakeProperties();
+  fml::DataMapping data(std::string("pipeline cache data"));
+  auto decorated = DecoratePipelineCacheData(props, data);
+  std::vector<uint8_t> bytes(decorated->GetMapping(),
+                             decorated->GetMapping() + decorated->GetSize());
+
+  auto flipped = bytes;
+  flipped.back() ^= 0xFF;
+  EXPECT_EQ(ReadPipelineCacheData(
+                props, std::make_shared<fml::DataMapping>(flipped)),
+            nullptr);
+
+  auto truncated = bytes;
+  truncated.pop_back();
+  EXPECT_EQ(ReadPipelineCacheData(
+                props, std::make_shared<fml::DataMapping>(truncated)),
+            nullptr);
+
+  EXPECT_EQ(ReadPipelineCacheData(
+                props, std::make_shared<fml::DataMapping>(std::string())),
+            nullptr);
+  EXPECT_EQ(ReadPipelineCacheData(props, nullptr), nullptr);
+}
+
+TEST(PipelineCacheVKTest, CacheFileNameIsKeyedByDevice) {
+  auto props = MakeProperties();
+  auto other_device = props;
+  other_device.deviceID++;
+  EXPECT_NE(GetPipelineCacheFileName(props),
+            GetPipelineCacheFileName(other_device));
+
+  // Driver updates replace the cache of the same device.
+  auto other_driver = props;
+  other_driver.driverVersion++;
+  EXPECT_EQ(GetPipelineCacheFileName(props),
+            GetPipelineCacheFileName(other_driver));
+}
+
+TEST(PipelineCacheVKTest, SeedsThreadCachesFromTheMainCache) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  PipelineCacheVK cache(context->GetCapabilities(), context->GetDeviceHolder(),
+                        fml::UniqueFD());
+  ASSERT_TRUE(cache.IsValid());
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+
+  // The first pipeline of the thread creates its cache from the data of the
+  // main cache.
+  size_t start = functions->size();
+  auto pipeline = cache.CreatePipeline(vk::GraphicsPipelineCreateInfo{});
+  EXPECT_EQ(std::vector<std::string>(functions->begin() + start,
+                                     functions->end()),
+            std::vector<std::string>({"vkGetPipelineCacheData",
+                                      "vkCreatePipelineCache",
+                                      "vkCreateGraphicsPipelines"}));
+
+  // Later pipelines reuse it.
+  start = functions->size();
+  auto other_pipeline = cache.CreatePipeline(vk::GraphicsPipelineCreateInfo{});
+  EXPECT_EQ(std::vector<std::string>(functions->begin() + start,
+                                     functions->end()),
+            std::vector<std::string>({"vkCreateGraphicsPipelines"}));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -221,40 +221,14 @@ static void ReportPipelineCreationFeedbackToLog(
   FML_LOG(ERROR) << stream.str();
 }
 
-static void ReportPipelineCreationFeedbackToTrace(
-    const PipelineDescriptor& desc,
-    const vk::PipelineCreationFeedbackCreateInfoEXT& feedback) {
-  static int64_t gPipelineCacheHits = 0;
-  static int64_t gPipelineCacheMisses = 0;
-  static int64_t gPipelines = 0;
-  if (feedback.pPipelineCreationFeedback->flags &
-      vk::PipelineCreationFeedbackFlagBits::eApplicationPipelineCacheHit) {
-    gPipelineCacheHits++;
-  } else {
-    gPipelineCacheMisses++;
-  }
-  gPipelines++;
-  static constexpr int64_t kImpellerPipelineTraceID = 1988;
-  FML_TRACE_COUNTER("impeller",                                   //
-                    "PipelineCache",                              // series name
-                    kImpellerPipelineTraceID,                     // series ID
-                    "PipelineCacheHits", gPipelineCacheHits,      //
-                    "PipelineCacheMisses", gPipelineCacheMisses,  //
-                    "TotalPipelines", gPipelines                  //
-  );
-}
-
 static void ReportPipelineCreationFeedback(
     const PipelineDescriptor& desc,
     const vk::PipelineCreationFeedbackCreateInfoEXT& feedback) {
+  // Cache hits and misses are counted and traced by the pipeline cache.
   constexpr bool kReportPipelineCreationFeedbackToLogs = false;
-  constexpr bool kReportPipelineCreationFeedbackToTraces = true;
   if (kReportPipelineCreationFeedbackToLogs) {
     ReportPipelineCreationFeedbackToLog(desc, feedback);
   }
-  if (kReportPipelineCreationFeedbackToTraces) {
-    ReportPipelineCreationFeedbackToTrace(desc, feedback);
-  }
 }
 
 std::unique_ptr<PipelineVK> PipelineLibraryVK::CreatePipeline(
@@ -369,7 +369,8 @@ static bool EncodeCommand(const Context& context,
                           CommandEncoderVK& encoder,
                           PassBindingsCache& command_buffer_cache,
                           const ISize& target_size,
-                          const vk::DescriptorSet vk_desc_set) {
+                          const vk::DescriptorSet vk_desc_set,
+                          vk::ArrayProxy<const uint32_t> dynamic_offsets) {
 #ifdef IMPELLER_DEBUG
   fml::ScopedCleanupClosure pop_marker(
       [&encoder]() { encoder.PopDebugGroup(); });
@@ -388,7 +389,7 @@ static bool EncodeCommand(const Context& context,
       pipeline_vk.GetPipelineLayout(),   // layout
       0,                                 // first set
       {vk::DescriptorSet{vk_desc_set}},  // sets
-      nullptr                            // offsets
+      dynamic_offsets                    // offsets
   );
 
   command_buffer_cache.BindPipeline(
@@ -544,7 +545,7 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
   if (!desc_sets_result.ok()) {
     return false;
   }
-  auto desc_sets = desc_sets_result.value();
+  const auto& desc_sets = desc_sets_result.value();
 
   {
     TRACE_EVENT0("impeller", "EncodeRenderPassCommands");
@@ -556,7 +557,8 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
     auto desc_index = 0u;
     for (const auto& command : commands_) {
       if (!EncodeCommand(context, command, *encoder, pass_bindings_cache_,
-                         target_size, desc_sets[desc_index])) {
+                         target_size, desc_sets.sets[desc_index],
+                         desc_sets.GetDynamicOffsets(desc_index))) {
         return false;
       }
       desc_index += 1;
@@ -12,7 +12,7 @@
 namespace impeller {
 
 SurfaceContextVK::SurfaceContextVK(const std::shared_ptr<ContextVK>& parent)
-    : parent_(parent) {}
+    : Context(parent->GetSharedFramePhaseTimings()), parent_(parent) {}
 
 SurfaceContextVK::~SurfaceContextVK() = default;
 
@@ -28,6 +28,10 @@ bool SurfaceContextVK::IsValid() const {
   return parent_->IsValid();
 }
 
+const std::shared_ptr<ContextVK>& SurfaceContextVK::GetParent() const {
+  return parent_;
+}
+
 std::shared_ptr<Allocator> SurfaceContextVK::GetResourceAllocator() const {
   return parent_->GetResourceAllocator();
 }
@@ -85,6 +89,7 @@ std::unique_ptr<Surface> SurfaceContextVK::AcquireNextSurface() {
     allocator->DidAcquireSurfaceFrame();
   }
   parent_->GetCommandPoolRecycler()->Dispose();
+  parent_->DisposeEncodeThreadCommandPools();
   return surface;
 }
 
@@ -92,6 +97,10 @@ void SurfaceContextVK::SetSyncPresentation(bool value) {
   parent_->SetSyncPresentation(value);
 }
 
+void SurfaceContextVK::EndFrameWork() const {
+  parent_->EndFrameWork();
+}
+
 #ifdef FML_OS_ANDROID
 
 vk::UniqueSurfaceKHR SurfaceContextVK::CreateAndroidSurface(
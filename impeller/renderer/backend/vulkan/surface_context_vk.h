@@ -20,6 +20,8 @@ class SwapchainVK;
 class SurfaceContextVK : public Context,
                          public BackendCast<SurfaceContextVK, Context> {
  public:
+  /// Creates a context that renders with |parent| and reports into its frame
+  /// phase timings.
   explicit SurfaceContextVK(const std::shared_ptr<ContextVK>& parent);
 
   // |Context|
@@ -58,10 +60,15 @@ class SurfaceContextVK : public Context,
   // |Context|
   void SetSyncPresentation(bool value) override;
 
+  // |Context|
+  void EndFrameWork() const override;
+
   [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
 
   std::unique_ptr<Surface> AcquireNextSurface();
 
+  const std::shared_ptr<ContextVK>& GetParent() const;
+
 #ifdef FML_OS_ANDROID
   vk::UniqueSurfaceKHR CreateAndroidSurface(ANativeWindow* window) const;
 #endif  // FML_OS_ANDROID
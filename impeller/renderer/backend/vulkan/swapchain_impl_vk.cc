@@ -446,6 +446,10 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   auto vk_final_cmd_buffer = CommandBufferVK::Cast(*sync->final_cmd_buffer)
                                  .GetEncoder()
                                  ->GetCommandBuffer();
+  if (CommandBufferVK::Cast(*sync->final_cmd_buffer).PendingEncodesFailed()) {
+    // The frame's render passes did not all make it to the GPU.
+    return false;
+  }
   {
     BarrierVK barrier;
     barrier.new_layout = vk::ImageLayout::ePresentSrcKHR;
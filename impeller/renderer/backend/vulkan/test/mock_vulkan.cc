@@ -232,6 +232,25 @@ VkResult vkCreatePipelineCache(VkDevice device,
   return VK_SUCCESS;
 }
 
+VkResult vkMergePipelineCaches(VkDevice device,
+                               VkPipelineCache dstCache,
+                               uint32_t srcCacheCount,
+                               const VkPipelineCache* pSrcCaches) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkMergePipelineCaches");
+  return VK_SUCCESS;
+}
+
+VkResult vkGetPipelineCacheData(VkDevice device,
+                                VkPipelineCache pipelineCache,
+                                size_t* pDataSize,
+                                void* pData) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkGetPipelineCacheData");
+  *pDataSize = 0u;
+  return VK_SUCCESS;
+}
+
 VkResult vkCreateCommandPool(VkDevice device,
                              const VkCommandPoolCreateInfo* pCreateInfo,
                              const VkAllocationCallbacks* pAllocator,
@@ -593,6 +612,10 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetPhysicalDeviceMemoryProperties;
   } else if (strcmp("vkCreatePipelineCache", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreatePipelineCache;
+  } else if (strcmp("vkMergePipelineCaches", pName) == 0) {
+    return (PFN_vkVoidFunction)vkMergePipelineCaches;
+  } else if (strcmp("vkGetPipelineCacheData", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetPipelineCacheData;
   } else if (strcmp("vkCreateCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateCommandPool;
   } else if (strcmp("vkResetCommandPool", pName) == 0) {
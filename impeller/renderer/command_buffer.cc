@@ -6,6 +6,7 @@
 
 #include "flutter/fml/trace_event.h"
 #include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
 
@@ -25,6 +26,9 @@ bool CommandBuffer::SubmitCommands(const CompletionCallback& callback) {
     }
     return false;
   }
+  auto context = context_.lock();
+  ScopedFramePhase phase(context ? &context->GetFramePhaseTimings() : nullptr,
+                         FramePhase::kSubmit);
   return OnSubmitCommands(callback);
 }
 
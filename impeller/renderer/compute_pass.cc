@@ -58,6 +58,8 @@ bool ComputePass::EncodeCommands() const {
   if (!context) {
     return false;
   }
+  ScopedFramePhase phase(&context->GetFramePhaseTimings(),
+                         FramePhase::kEncode);
   return OnEncodeCommands(*context, grid_size_, thread_group_size_);
 }
 
@@ -12,6 +12,10 @@ Context::~Context() = default;
 
 Context::Context() : capture(CaptureContext::MakeInactive()) {}
 
+Context::Context(std::shared_ptr<FramePhaseTimings> frame_phase_timings)
+    : capture(CaptureContext::MakeInactive()),
+      frame_phase_timings_(std::move(frame_phase_timings)) {}
+
 bool Context::UpdateOffscreenLayerPixelFormat(PixelFormat format) {
   return false;
 }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/core/allocator.h"
 #include "impeller/core/capture.h"
 #include "impeller/core/formats.h"
@@ -184,6 +185,27 @@ class Context {
   /// @brief Accessor for a pool of HostBuffers.
   Pool<HostBuffer>& GetHostBufferPool() const { return host_buffer_pool_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief Accumulates the time spent in the phases of rendering frames with
+  ///        this context, for reporting by the embedder.
+  FramePhaseTimings& GetFramePhaseTimings() const {
+    return *frame_phase_timings_;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief Marks the end of the work of the frame being rendered. Contexts
+  ///        that hand part of that work to other threads call
+  ///        |FramePhaseTimings::CompleteWorkerFrame| once it has run, without
+  ///        blocking the caller.
+  virtual void EndFrameWork() const {}
+
+  /// The frame phase timings, for objects such as GPU tracers and wrapping
+  /// contexts that report into them and may outlive the context.
+  const std::shared_ptr<FramePhaseTimings>& GetSharedFramePhaseTimings()
+      const {
+    return frame_phase_timings_;
+  }
+
   CaptureContext capture;
 
   /// Stores a task on the `ContextMTL` that is awaiting access for the GPU.
@@ -202,8 +224,19 @@ class Context {
  protected:
   Context();
 
+  /// Creates a context that reports into the given timings, for contexts
+  /// that render on behalf of another context.
+  explicit Context(std::shared_ptr<FramePhaseTimings> frame_phase_timings);
+
  private:
-  mutable Pool<HostBuffer> host_buffer_pool_ = Pool<HostBuffer>(1'000'000);
+  // Render passes emplace their transient data into arenas so that it never
+  // gets reallocated, and the arenas keep their chunks while pooled so that
+  // later passes reuse them.
+  mutable Pool<HostBuffer> host_buffer_pool_ =
+      Pool<HostBuffer>(1'000'000, [] { return HostBuffer::CreateArena(); });
+
+  const std::shared_ptr<FramePhaseTimings> frame_phase_timings_ =
+      std::make_shared<FramePhaseTimings>();
 
   Context(const Context&) = delete;
 
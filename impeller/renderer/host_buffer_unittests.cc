@@ -75,5 +75,148 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, ArenaDoesNotMoveEmplacedData) {
+  struct Length64 {
+    uint8_t pad[64];
+  };
+  auto buffer = HostBuffer::CreateArena(256u);
+  ASSERT_TRUE(buffer);
+  ASSERT_EQ(buffer->GetSize(), 0u);
+
+  auto first = buffer->Emplace(Length64{{1}});
+  ASSERT_TRUE(first);
+  const uint8_t* first_contents = first.contents;
+  for (size_t i = 0; i < 20; i++) {
+    ASSERT_TRUE(buffer->Emplace(Length64{}));
+  }
+  // The first chunk was never reallocated.
+  EXPECT_EQ(first.contents, first_contents);
+  EXPECT_EQ(first.contents[first.range.offset], 1u);
+
+  const auto& statistics = buffer->GetArenaStatistics();
+  EXPECT_EQ(statistics.bytes_used, 21u * 64u);
+  // Four 64 byte emplacements fill a 256 byte chunk.
+  EXPECT_EQ(statistics.chunks_allocated, 6u);
+  EXPECT_EQ(statistics.bytes_wasted, 0u);
+  EXPECT_EQ(buffer->GetSize(), 6u * 256u);
+  EXPECT_EQ(buffer->GetLength(), 21u * 64u);
+}
+
+TEST(HostBufferTest, ArenaViewsReferToTheirChunk) {
+  struct Length100 {
+    uint8_t pad[100];
+  };
+  auto buffer = HostBuffer::CreateArena(256u);
+
+  auto first = buffer->Emplace(Length100{});
+  auto second = buffer->Emplace(Length100{});
+  auto third = buffer->Emplace(Length100{});
+  EXPECT_EQ(first.buffer, second.buffer);
+  EXPECT_NE(second.buffer, third.buffer);
+  EXPECT_EQ(second.range, Range(100u, 100u));
+  EXPECT_EQ(third.range, Range(0u, 100u));
+
+  const auto& statistics = buffer->GetArenaStatistics();
+  EXPECT_EQ(statistics.chunks_allocated, 2u);
+  // The end of the first chunk is left unused.
+  EXPECT_EQ(statistics.bytes_wasted, 56u);
+}
+
+TEST(HostBufferTest, ArenaAlignsWithinChunks) {
+  struct Length2 {
+    uint8_t pad[2];
+  };
+  struct alignas(16) Align16 {
+    uint8_t pad[2];
+  };
+  auto buffer = HostBuffer::CreateArena(64u);
+
+  ASSERT_EQ(buffer->Emplace(Length2{}).range, Range(0u, 2u));
+  ASSERT_EQ(buffer->Emplace(Align16{}).range, Range(16u, 16u));
+  ASSERT_EQ(buffer->Emplace(Length2{}).range, Range(32u, 2u));
+  ASSERT_EQ(buffer->Emplace(Align16{}).range, Range(48u, 16u));
+  // The next aligned emplacement starts a new chunk.
+  ASSERT_EQ(buffer->Emplace(Align16{}).range, Range(0u, 16u));
+
+  const auto& statistics = buffer->GetArenaStatistics();
+  EXPECT_EQ(statistics.bytes_wasted, 14u + 14u);
+  EXPECT_EQ(statistics.chunks_allocated, 2u);
+}
+
+TEST(HostBufferTest, ArenaReusesChunksAfterReset) {
+  struct Length128 {
+    uint8_t pad[128];
+  };
+  auto buffer = HostBuffer::CreateArena(256u);
+  const auto& statistics = buffer->GetArenaStatistics();
+
+  for (size_t frame = 0; frame < 3; frame++) {
+    for (size_t i = 0; i < 6; i++) {
+      ASSERT_TRUE(buffer->Emplace(Length128{}));
+    }
+    EXPECT_EQ(statistics.bytes_used, 6u * 128u);
+    buffer->Reset();
+    EXPECT_EQ(statistics.bytes_used, 0u);
+    EXPECT_EQ(buffer->GetLength(), 0u);
+  }
+  EXPECT_EQ(statistics.chunks_allocated, 3u);
+  EXPECT_EQ(statistics.chunks_reused, 6u);
+  EXPECT_EQ(buffer->GetSize(), 3u * 256u);
+}
+
+TEST(HostBufferTest, ArenaTrimKeepsLeadingChunks) {
+  struct Length128 {
+    uint8_t pad[128];
+  };
+  auto buffer = HostBuffer::CreateArena(256u);
+  const auto& statistics = buffer->GetArenaStatistics();
+
+  for (size_t i = 0; i < 12; i++) {
+    ASSERT_TRUE(buffer->Emplace(Length128{}));
+  }
+  EXPECT_EQ(buffer->GetSize(), 6u * 256u);
+  buffer->Reset();
+  buffer->Trim(600u);
+  EXPECT_EQ(buffer->GetSize(), 2u * 256u);
+
+  for (size_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(buffer->Emplace(Length128{}));
+  }
+  EXPECT_EQ(statistics.chunks_allocated, 6u);
+  EXPECT_EQ(statistics.chunks_reused, 2u);
+}
+
+TEST(HostBufferTest, ArenaGivesOversizedDataItsOwnAllocation) {
+  struct Length300 {
+    uint8_t pad[300];
+  };
+  auto buffer = HostBuffer::CreateArena(256u);
+
+  auto view = buffer->Emplace(Length300{});
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view.range, Range(0u, 300u));
+
+  const auto& statistics = buffer->GetArenaStatistics();
+  EXPECT_EQ(statistics.oversized_allocations, 1u);
+  EXPECT_EQ(statistics.chunks_allocated, 0u);
+  EXPECT_EQ(statistics.bytes_used, 300u);
+
+  buffer->Reset();
+  EXPECT_EQ(buffer->GetSize(), 0u);
+}
+
+TEST(HostBufferTest, ArenaEmplaceProcWritesIntoChunk) {
+  auto buffer = HostBuffer::CreateArena(256u);
+  ASSERT_TRUE(buffer->Emplace(Range{}));
+  auto view = buffer->Emplace(4u, 4u, [](uint8_t* data) {
+    data[0] = 1u;
+    data[3] = 4u;
+  });
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view.range, Range(16u, 4u));
+  EXPECT_EQ(view.contents[view.range.offset], 1u);
+  EXPECT_EQ(view.contents[view.range.offset + 3u], 4u);
+}
+
 }  // namespace  testing
 }  // namespace impeller
@@ -6,22 +6,31 @@
 #define FLUTTER_IMPELLER_RENDERER_POOL_H_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace impeller {
 
 /// @brief A thread-safe pool with a limited byte size.
-/// @tparam T The type that the pool will contain.
+/// @tparam T The type that the pool will contain. It provides |GetSize|,
+///           |Reset|, and a |Trim| method that releases memory until the
+///           object is at most the given size, if it can.
 template <typename T>
 class Pool {
  public:
-  explicit Pool(uint32_t limit_bytes) : limit_bytes_(limit_bytes) {}
+  using CreateProc = std::function<std::shared_ptr<T>()>;
+
+  /// @param limit_bytes The maximum total size of the pooled objects.
+  /// @param create      Creates an object when the pool is empty.
+  explicit Pool(uint32_t limit_bytes, CreateProc create = &T::Create)
+      : limit_bytes_(limit_bytes), create_(std::move(create)) {}
 
   std::shared_ptr<T> Grab() {
     std::scoped_lock lock(mutex_);
     if (pool_.empty()) {
-      return T::Create();
+      return create_();
     }
     std::shared_ptr<T> result = std::move(pool_.back());
     pool_.pop_back();
@@ -31,10 +40,18 @@ class Pool {
 
   void Recycle(std::shared_ptr<T> object) {
     std::scoped_lock lock(mutex_);
+    // Resetting may release memory, such as the oversized allocations of a
+    // |HostBuffer| arena, so the object is measured afterwards to match the
+    // size subtracted in |Grab|. An object that is too large to pool on its
+    // own, such as an arena that grew to hold a heavy frame, is trimmed to
+    // half of the limit so that it is still reused.
+    object->Reset();
+    if (object->GetSize() >= limit_bytes_ / 2) {
+      object->Trim(limit_bytes_ / 2 - 1);
+    }
     size_t object_size = object->GetSize();
     if (size_ + object_size <= limit_bytes_ &&
         object_size < (limit_bytes_ / 2)) {
-      object->Reset();
       size_ += object_size;
       pool_.emplace_back(std::move(object));
     }
@@ -48,6 +65,7 @@ class Pool {
  private:
   std::vector<std::shared_ptr<T>> pool_;
   const uint32_t limit_bytes_;
+  const CreateProc create_;
   uint32_t size_ = 0;
   // Note: This would perform better as a lockless ring buffer.
   mutable std::mutex mutex_;
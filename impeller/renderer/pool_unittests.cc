@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 
 #include "impeller/renderer/pool.h"
@@ -20,6 +22,8 @@ class Foobar {
 
   void Reset() { is_reset_ = true; }
 
+  void Trim(size_t max_size) { size_ = std::min(size_, max_size); }
+
   bool GetIsReset() const { return is_reset_; }
 
   void SetIsReset(bool is_reset) { is_reset_ = is_reset; }
@@ -28,6 +32,26 @@ class Foobar {
   size_t size_;
   bool is_reset_ = false;
 };
+
+// Releases memory on reset, like a |HostBuffer| arena with oversized
+// allocations.
+class ShrinkingFoobar {
+ public:
+  static std::shared_ptr<ShrinkingFoobar> Create() {
+    return std::make_shared<ShrinkingFoobar>();
+  }
+
+  size_t GetSize() const { return size_; }
+
+  void SetSize(size_t size) { size_ = size; }
+
+  void Reset() { size_ = std::min<size_t>(size_, 100u); }
+
+  void Trim(size_t max_size) {}
+
+ private:
+  size_t size_ = 0u;
+};
 }  // namespace
 
 TEST(PoolTest, Simple) {
@@ -60,5 +84,31 @@ TEST(PoolTest, Overload) {
   EXPECT_EQ(pool.GetSize(), 1'000u);
 }
 
+TEST(PoolTest, MeasuresRecycledObjectsAfterReset) {
+  Pool<ShrinkingFoobar> pool(1'000);
+  {
+    auto grabbed = pool.Grab();
+    grabbed->SetSize(450);
+    pool.Recycle(grabbed);
+    EXPECT_EQ(pool.GetSize(), 100u);
+  }
+  auto grabbed = pool.Grab();
+  EXPECT_EQ(grabbed->GetSize(), 100u);
+  EXPECT_EQ(pool.GetSize(), 0u);
+}
+
+TEST(PoolTest, TrimsObjectsTooLargeToPool) {
+  Pool<Foobar> pool(1'000);
+  {
+    auto grabbed = pool.Grab();
+    grabbed->SetSize(800);
+    pool.Recycle(grabbed);
+    EXPECT_EQ(pool.GetSize(), 499u);
+  }
+  auto grabbed = pool.Grab();
+  EXPECT_EQ(grabbed->GetSize(), 499u);
+  EXPECT_TRUE(grabbed->GetIsReset());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -96,6 +96,8 @@ bool RenderPass::EncodeCommands() const {
   if (!context) {
     return false;
   }
+  ScopedFramePhase phase(&context->GetFramePhaseTimings(),
+                         FramePhase::kEncode);
   return OnEncodeCommands(*context);
 }
 
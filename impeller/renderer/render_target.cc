@@ -27,6 +27,10 @@ std::shared_ptr<Texture> RenderTargetAllocator::CreateTexture(
   return allocator_->CreateTexture(desc);
 }
 
+ISize RenderTargetAllocator::GetAllocationSize(ISize size) const {
+  return size;
+}
+
 RenderTarget::RenderTarget() = default;
 
 RenderTarget::~RenderTarget() = default;
@@ -31,6 +31,15 @@ class RenderTargetAllocator {
   ///        target texture.
   virtual std::shared_ptr<Texture> CreateTexture(const TextureDescriptor& desc);
 
+  /// @brief The size to allocate a render target of the given size at.
+  ///
+  ///        Callers that only ever sample the top left |size| of a render
+  ///        target may allocate it at this size instead, which allocators
+  ///        that recycle textures may round up so that targets whose size
+  ///        changes slightly from frame to frame share textures. The result
+  ///        is never smaller than |size|. By default, it is |size|.
+  virtual ISize GetAllocationSize(ISize size) const;
+
   /// @brief Mark the beginning of a frame workload.
   ///
   ///       This may be used to reset any tracking state on whether or not a
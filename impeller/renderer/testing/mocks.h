@@ -164,6 +164,8 @@ class MockImpellerContext : public Context {
               GetCapabilities,
               (),
               (const, override));
+
+  MOCK_METHOD(void, EndFrameWork, (), (const, override));
 };
 
 class MockTexture : public Texture {
@@ -4,6 +4,7 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
@@ -64,10 +65,23 @@ static int ToTessWindingRule(FillType fill_type) {
 Tessellator::Result Tessellator::Tessellate(const Path& path,
                                             Scalar tolerance,
                                             const BuilderCallback& callback) {
+  ScopedFramePhase phase(frame_phase_timings_, FramePhase::kTessellation);
   if (!callback) {
     return Result::kInputError;
   }
 
+  size_t cache_key = GetCacheKey(path, tolerance, /*convex=*/false);
+  if (auto cached = FindCachedTessellation(cache_key, path, tolerance,
+                                           /*convex=*/false)) {
+    if (!callback(cached->vertices.data(), cached->vertex_count,
+                  cached->indices.empty() ? nullptr : cached->indices.data(),
+                  cached->indices.size())) {
+      return Result::kInputError;
+    }
+    return Result::kSuccess;
+  }
+  bool cache_result = ShouldCacheTessellation(cache_key);
+
   point_buffer_->clear();
   auto polyline =
       path.CreatePolyline(tolerance, std::move(point_buffer_),
@@ -144,6 +158,15 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
                   element_item_count)) {
       return Result::kInputError;
     }
+    if (cache_result) {
+      TessellationData data;
+      data.vertices.assign(vertices,
+                           vertices + vertex_item_count * kVertexSize);
+      data.vertex_count = vertex_item_count;
+      data.indices = std::move(indices);
+      CacheTessellation(cache_key, path, tolerance, /*convex=*/false,
+                        std::move(data));
+    }
   } else {
     std::vector<Point> points;
     std::vector<float> data;
@@ -165,6 +188,13 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
     if (!callback(data.data(), element_item_count, nullptr, 0u)) {
       return Result::kInputError;
     }
+    if (cache_result) {
+      TessellationData cached;
+      cached.vertices = std::move(data);
+      cached.vertex_count = element_item_count;
+      CacheTessellation(cache_key, path, tolerance, /*convex=*/false,
+                        std::move(cached));
+    }
   }
 
   return Result::kSuccess;
@@ -172,6 +202,14 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
 
 std::vector<Point> Tessellator::TessellateConvex(const Path& path,
                                                  Scalar tolerance) {
+  ScopedFramePhase phase(frame_phase_timings_, FramePhase::kTessellation);
+  size_t cache_key = GetCacheKey(path, tolerance, /*convex=*/true);
+  if (auto cached = FindCachedTessellation(cache_key, path, tolerance,
+                                           /*convex=*/true)) {
+    return cached->strip;
+  }
+  bool cache_result = ShouldCacheTessellation(cache_key);
+
   std::vector<Point> output;
 
   point_buffer_->clear();
@@ -215,9 +253,113 @@ std::vector<Point> Tessellator::TessellateConvex(const Path& path,
       output.emplace_back(polyline.GetPoint(a));
     }
   }
+  if (cache_result) {
+    TessellationData data;
+    data.strip = output;
+    CacheTessellation(cache_key, path, tolerance, /*convex=*/true,
+                      std::move(data));
+  }
   return output;
 }
 
+void Tessellator::SetCacheLimit(size_t max_bytes) {
+  cache_limit_bytes_ = max_bytes;
+  EvictCachedTessellations(max_bytes);
+}
+
+void Tessellator::PurgeCache() {
+  EvictCachedTessellations(0u);
+  seen_cache_keys_.fill(0u);
+}
+
+size_t Tessellator::GetCacheKey(const Path& path,
+                                Scalar tolerance,
+                                bool convex) const {
+  if (cache_limit_bytes_ == 0u || path.GetSourceId() == 0u) {
+    return 0u;
+  }
+  size_t key =
+      fml::HashCombine(path.GetSourceId(),
+                       static_cast<int>(path.GetFillType()), tolerance, convex);
+  return key == 0u ? 1u : key;
+}
+
+const Tessellator::TessellationData* Tessellator::FindCachedTessellation(
+    size_t key,
+    const Path& path,
+    Scalar tolerance,
+    bool convex) {
+  if (key == 0u) {
+    return nullptr;
+  }
+  auto [begin, end] = cache_index_.equal_range(key);
+  for (auto it = begin; it != end; ++it) {
+    CacheList::iterator entry = it->second;
+    if (entry->source_id == path.GetSourceId() &&
+        entry->fill_type == path.GetFillType() &&
+        entry->tolerance == tolerance && entry->convex == convex) {
+      cache_.splice(cache_.begin(), cache_, entry);
+      cache_stats_.hits++;
+      return &entry->data;
+    }
+  }
+  cache_stats_.misses++;
+  return nullptr;
+}
+
+bool Tessellator::ShouldCacheTessellation(size_t key) {
+  if (key == 0u) {
+    return false;
+  }
+  for (size_t& seen_key : seen_cache_keys_) {
+    if (seen_key == key) {
+      seen_key = 0u;
+      return true;
+    }
+  }
+  seen_cache_keys_[next_seen_cache_key_] = key;
+  next_seen_cache_key_ = (next_seen_cache_key_ + 1) % kSeenCacheKeyCount;
+  return false;
+}
+
+void Tessellator::CacheTessellation(size_t key,
+                                    const Path& path,
+                                    Scalar tolerance,
+                                    bool convex,
+                                    TessellationData data) {
+  size_t bytes = sizeof(CachedTessellation) +
+                 data.vertices.size() * sizeof(float) +
+                 data.indices.size() * sizeof(uint16_t) +
+                 data.strip.size() * sizeof(Point);
+  if (bytes > cache_limit_bytes_) {
+    return;
+  }
+  EvictCachedTessellations(cache_limit_bytes_ - bytes);
+  cache_.push_front(CachedTessellation{key, path.GetSourceId(),
+                                       path.GetFillType(), tolerance, convex,
+                                       std::move(data), bytes});
+  cache_index_.emplace(key, cache_.begin());
+  cache_stats_.entries++;
+  cache_stats_.bytes += bytes;
+}
+
+void Tessellator::EvictCachedTessellations(size_t max_bytes) {
+  while (cache_stats_.bytes > max_bytes && !cache_.empty()) {
+    CacheList::iterator entry = std::prev(cache_.end());
+    auto [begin, end] = cache_index_.equal_range(entry->key);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second == entry) {
+        cache_index_.erase(it);
+        break;
+      }
+    }
+    cache_stats_.entries--;
+    cache_stats_.bytes -= entry->bytes;
+    cache_stats_.evictions++;
+    cache_.erase(entry);
+  }
+}
+
 void DestroyTessellator(TESStesselator* tessellator) {
   if (tessellator != nullptr) {
     ::tessDeleteTess(tessellator);
@@ -5,11 +5,15 @@
 #ifndef FLUTTER_IMPELLER_TESSELLATOR_TESSELLATOR_H_
 #define FLUTTER_IMPELLER_TESSELLATOR_TESSELLATOR_H_
 
+#include <array>
 #include <functional>
+#include <list>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/core/formats.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/point.h"
@@ -218,6 +222,52 @@ class Tessellator {
   ///
   std::vector<Point> TessellateConvex(const Path& path, Scalar tolerance);
 
+  /// @brief   The default number of bytes of tessellation results that are
+  ///          retained between calls to |Tessellate| and |TessellateConvex|.
+  static constexpr size_t kDefaultCacheLimitBytes = 2 * 1024 * 1024;
+
+  struct CacheStatistics {
+    size_t hits = 0u;
+    size_t misses = 0u;
+    size_t evictions = 0u;
+    size_t entries = 0u;
+    size_t bytes = 0u;
+
+    /// The fraction of lookups that were served from the cache, or 0 if
+    /// there were no lookups.
+    double GetHitRate() const {
+      size_t lookups = hits + misses;
+      return lookups == 0u ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the number of bytes of tessellation results that are
+  ///             retained, evicting the least recently used results if the
+  ///             cache is now over the limit.
+  ///
+  ///             Only paths with a source id, see |Path::GetSourceId|, are
+  ///             cached, keyed by that id and the exact tolerance. A result
+  ///             is only retained the second time its path is tessellated,
+  ///             so paths that are drawn once are never copied. A limit of 0
+  ///             disables the cache.
+  ///
+  void SetCacheLimit(size_t max_bytes);
+
+  size_t GetCacheLimit() const { return cache_limit_bytes_; }
+
+  const CacheStatistics& GetCacheStatistics() const { return cache_stats_; }
+
+  /// @brief   Drops all cached tessellation results.
+  void PurgeCache();
+
+  /// @brief   Sets the timings that the time spent in |Tessellate| and
+  ///          |TessellateConvex| is added to. The timings must outlive the
+  ///          tessellator.
+  void SetFramePhaseTimings(FramePhaseTimings* timings) {
+    frame_phase_timings_ = timings;
+  }
+
   /// @brief   The pixel tolerance used by the algorighm to determine how
   ///          many divisions to create for a circle.
   ///
@@ -295,10 +345,63 @@ class Tessellator {
                                             const Size& radii);
 
  private:
+  /// The output of a single call to |Tessellate| or |TessellateConvex|.
+  struct TessellationData {
+    // For |Tessellate|, the arguments the callback was invoked with.
+    std::vector<float> vertices;
+    size_t vertex_count = 0u;
+    std::vector<uint16_t> indices;
+    // For |TessellateConvex|, the resulting triangle strip.
+    std::vector<Point> strip;
+  };
+
+  /// A tessellation result retained for a path at a given tolerance.
+  struct CachedTessellation {
+    size_t key;
+    uint32_t source_id;
+    FillType fill_type;
+    Scalar tolerance;
+    bool convex;
+    TessellationData data;
+    size_t bytes;
+  };
+  using CacheList = std::list<CachedTessellation>;
+
   /// Used for polyline generation.
   std::unique_ptr<std::vector<Point>> point_buffer_;
   CTessellator c_tessellator_;
 
+  // Most recently used results are at the front of the list.
+  size_t cache_limit_bytes_ = kDefaultCacheLimitBytes;
+  CacheList cache_;
+  std::unordered_multimap<size_t, CacheList::iterator> cache_index_;
+  CacheStatistics cache_stats_;
+  // The keys of results that were computed once but not yet cached.
+  static constexpr size_t kSeenCacheKeyCount = 64u;
+  std::array<size_t, kSeenCacheKeyCount> seen_cache_keys_ = {};
+  size_t next_seen_cache_key_ = 0u;
+  FramePhaseTimings* frame_phase_timings_ = nullptr;
+
+  /// Returns 0 if results for the path should not be cached.
+  size_t GetCacheKey(const Path& path, Scalar tolerance, bool convex) const;
+
+  const TessellationData* FindCachedTessellation(size_t key,
+                                                 const Path& path,
+                                                 Scalar tolerance,
+                                                 bool convex);
+
+  /// Whether a result that was not found in the cache should be added to
+  /// it, which is only the case the second time the key is missed.
+  bool ShouldCacheTessellation(size_t key);
+
+  void CacheTessellation(size_t key,
+                         const Path& path,
+                         Scalar tolerance,
+                         bool convex,
+                         TessellationData data);
+
+  void EvictCachedTessellations(size_t max_bytes);
+
   // Data for variouos Circle/EllipseGenerator classes, cached per
   // Tessellator instance which is usually the foreground life of an app
   // if not longer.
@@ -134,6 +134,141 @@ TEST(TessellatorTest, TessellateConvex) {
   }
 }
 
+namespace {
+
+struct TessellationResult {
+  std::vector<float> vertices;
+  std::vector<uint16_t> indices;
+};
+
+TessellationResult TessellateToResult(Tessellator& tessellator,
+                                      const Path& path,
+                                      Scalar tolerance) {
+  TessellationResult result;
+  Tessellator::Result status = tessellator.Tessellate(
+      path, tolerance,
+      [&result](const float* vertices, size_t vertices_count,
+                const uint16_t* indices, size_t indices_count) {
+        result.vertices.assign(vertices, vertices + vertices_count * 2);
+        result.indices.assign(indices, indices + indices_count);
+        return true;
+      });
+  EXPECT_EQ(status, Tessellator::Result::kSuccess);
+  return result;
+}
+
+Path CreateStar(Point offset, uint32_t source_id = 1u) {
+  return PathBuilder{}
+      .MoveTo(offset + Point(50, 0))
+      .LineTo(offset + Point(80, 100))
+      .LineTo(offset + Point(0, 40))
+      .LineTo(offset + Point(100, 40))
+      .QuadraticCurveTo(offset + Point(60, 80), offset + Point(20, 100))
+      .Close()
+      .SetSourceId(source_id)
+      .TakePath(FillType::kOdd);
+}
+
+}  // namespace
+
+TEST(TessellatorTest, CachesTessellationsSeenTwice) {
+  Tessellator t;
+  auto first = TessellateToResult(t, CreateStar({}), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 1u);
+  EXPECT_EQ(t.GetCacheStatistics().entries, 0u);
+
+  // The result is retained the second time the path is tessellated.
+  auto second = TessellateToResult(t, CreateStar({}), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 2u);
+  EXPECT_EQ(t.GetCacheStatistics().entries, 1u);
+
+  auto third = TessellateToResult(t, CreateStar({}), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 1u);
+  EXPECT_EQ(first.vertices, third.vertices);
+  EXPECT_EQ(first.indices, third.indices);
+
+  // Different ids, tolerances, and kinds of tessellation do not share
+  // entries.
+  for (int i = 0; i < 2; i++) {
+    TessellateToResult(t, CreateStar({1, 0}, 2u), 1.0f);
+    TessellateToResult(t, CreateStar({}), 3.0f);
+    t.TessellateConvex(CreateStar({}), 1.0f);
+  }
+  EXPECT_EQ(t.GetCacheStatistics().hits, 1u);
+  EXPECT_EQ(t.GetCacheStatistics().entries, 4u);
+}
+
+TEST(TessellatorTest, DoesNotCachePathsWithoutSourceId) {
+  Tessellator t;
+  TessellateToResult(t, CreateStar({}, 0u), 1.0f);
+  TessellateToResult(t, CreateStar({}, 0u), 1.0f);
+  t.TessellateConvex(CreateStar({}, 0u), 1.0f);
+  t.TessellateConvex(CreateStar({}, 0u), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 0u);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 0u);
+  EXPECT_EQ(t.GetCacheStatistics().entries, 0u);
+}
+
+TEST(TessellatorTest, CachedTessellationsMatchUncachedOnes) {
+  Tessellator t;
+  Tessellator uncached;
+  uncached.SetCacheLimit(0);
+
+  auto path = CreateStar({});
+  for (int i = 0; i < 3; i++) {
+    auto cached = TessellateToResult(t, path, 1.1f);
+    auto expected = TessellateToResult(uncached, path, 1.1f);
+    EXPECT_EQ(cached.vertices, expected.vertices);
+    EXPECT_EQ(cached.indices, expected.indices);
+  }
+  EXPECT_EQ(t.GetCacheStatistics().hits, 1u);
+  EXPECT_EQ(uncached.GetCacheStatistics().entries, 0u);
+  EXPECT_EQ(uncached.GetCacheStatistics().misses, 0u);
+}
+
+TEST(TessellatorTest, CacheEvictsLeastRecentlyUsedTessellations) {
+  Tessellator t;
+  TessellateToResult(t, CreateStar({}, 1u), 1.0f);
+  TessellateToResult(t, CreateStar({}, 1u), 1.0f);
+  size_t entry_bytes = t.GetCacheStatistics().bytes;
+  ASSERT_GT(entry_bytes, 0u);
+
+  // Room for two entries of this size.
+  t.SetCacheLimit(entry_bytes * 2 + entry_bytes / 2);
+  TessellateToResult(t, CreateStar({}, 2u), 1.0f);
+  TessellateToResult(t, CreateStar({}, 2u), 1.0f);
+  // Touch the first star so that the second one is the least recently used.
+  TessellateToResult(t, CreateStar({}, 1u), 1.0f);
+  TessellateToResult(t, CreateStar({}, 3u), 1.0f);
+  TessellateToResult(t, CreateStar({}, 3u), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().entries, 2u);
+  EXPECT_EQ(t.GetCacheStatistics().evictions, 1u);
+  EXPECT_LE(t.GetCacheStatistics().bytes, t.GetCacheLimit());
+
+  size_t hits = t.GetCacheStatistics().hits;
+  TessellateToResult(t, CreateStar({}, 1u), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().hits, hits + 1);
+  TessellateToResult(t, CreateStar({}, 2u), 1.0f);
+  EXPECT_EQ(t.GetCacheStatistics().hits, hits + 1);
+
+  t.PurgeCache();
+  EXPECT_EQ(t.GetCacheStatistics().entries, 0u);
+  EXPECT_EQ(t.GetCacheStatistics().bytes, 0u);
+}
+
+TEST(TessellatorTest, CachesConvexTessellations) {
+  Tessellator t;
+  auto path =
+      PathBuilder{}.AddCircle({50, 50}, 20).SetSourceId(1u).TakePath();
+  auto first = t.TessellateConvex(path, 2.0f);
+  auto second = t.TessellateConvex(path, 2.0f);
+  auto third = t.TessellateConvex(path, 2.0f);
+  EXPECT_EQ(first, third);
+  EXPECT_EQ(second, third);
+  EXPECT_EQ(t.GetCacheStatistics().hits, 1u);
+  EXPECT_EQ(t.GetCacheStatistics().misses, 2u);
+}
+
 TEST(TessellatorTest, CircleVertexCounts) {
   auto tessellator = std::make_shared<Tessellator>();
 
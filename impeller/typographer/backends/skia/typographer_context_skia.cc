@@ -4,10 +4,12 @@
 
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/parallel_for.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
@@ -27,12 +29,29 @@ namespace impeller {
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
+// Atlas updates with fewer new glyphs than this are rasterized on the calling
+// thread since posting the work would cost more than it saves.
+constexpr size_t kMinGlyphsForParallelRasterization = 16u;
+
 std::shared_ptr<TypographerContext> TypographerContextSkia::Make() {
   return std::make_shared<TypographerContextSkia>();
 }
 
+std::shared_ptr<TypographerContext> TypographerContextSkia::Make(
+    std::shared_ptr<fml::BasicTaskRunner> worker_runner,
+    size_t worker_count) {
+  return std::make_shared<TypographerContextSkia>(std::move(worker_runner),
+                                                  worker_count);
+}
+
 TypographerContextSkia::TypographerContextSkia() = default;
 
+TypographerContextSkia::TypographerContextSkia(
+    std::shared_ptr<fml::BasicTaskRunner> worker_runner,
+    size_t worker_count)
+    : worker_runner_(std::move(worker_runner)),
+      worker_count_(worker_runner_ ? worker_count : 0u) {}
+
 TypographerContextSkia::~TypographerContextSkia() = default;
 
 std::shared_ptr<GlyphAtlasContext>
@@ -40,6 +59,10 @@ TypographerContextSkia::CreateGlyphAtlasContext() const {
   return std::make_shared<GlyphAtlasContextSkia>();
 }
 
+static ISize ComputeGlyphSize(const FontGlyphPair& pair) {
+  return ISize::Ceil(pair.glyph.bounds.GetSize() * pair.scaled_font.scale);
+}
+
 static size_t PairsFitInAtlasOfSize(
     const std::vector<FontGlyphPair>& pairs,
     const ISize& atlas_size,
@@ -56,8 +79,7 @@ static size_t PairsFitInAtlasOfSize(
   for (auto it = pairs.begin(); it != pairs.end(); ++i, ++it) {
     const auto& pair = *it;
 
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.GetSize() * pair.scaled_font.scale);
+    const auto glyph_size = ComputeGlyphSize(pair);
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -75,44 +97,6 @@ static size_t PairsFitInAtlasOfSize(
   return 0;
 }
 
-static bool CanAppendToExistingAtlas(
-    const std::shared_ptr<GlyphAtlas>& atlas,
-    const std::vector<FontGlyphPair>& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    ISize atlas_size,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
-    return false;
-  }
-
-  // We assume that all existing glyphs will fit. After all, they fit before.
-  // The glyph_positions only contains the values for the additional glyphs
-  // from extra_pairs.
-  FML_DCHECK(glyph_positions.size() == 0);
-  glyph_positions.reserve(extra_pairs.size());
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
-    const FontGlyphPair& pair = extra_pairs[i];
-
-    const auto glyph_size =
-        ISize::Ceil(pair.glyph.bounds.GetSize() * pair.scaled_font.scale);
-    IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return false;
-    }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
-  }
-
-  return true;
-}
-
 static ISize OptimumAtlasSizeForFontGlyphPairs(
     const std::vector<FontGlyphPair>& pairs,
     std::vector<Rect>& glyph_positions,
@@ -130,7 +114,8 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   size_t total_pairs = pairs.size() + 1;
   do {
     auto rect_packer = std::shared_ptr<RectanglePacker>(
-        RectanglePacker::Factory(current_size.width, current_size.height));
+        RectanglePacker::FactoryWithRemoval(current_size.width,
+                                            current_size.height));
 
     auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
                                                  glyph_positions, rect_packer);
@@ -185,35 +170,97 @@ static void DrawGlyph(SkCanvas* canvas,
   );
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const std::vector<FontGlyphPair>& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
-
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return false;
+namespace {
+
+// A glyph along with the location it was packed into in the atlas.
+struct GlyphToRasterize {
+  ScaledFont scaled_font;
+  Glyph glyph;
+  Rect location;
+};
+
+// Draws the glyph through a canvas that wraps only the padded rect the rect
+// packer reserved for it. Glyphs therefore never touch each other's pixels,
+// whether they are drawn one after another or concurrently.
+void RasterizeGlyph(const SkPixmap& pixels,
+                    const GlyphToRasterize& entry,
+                    bool has_color) {
+  SkPixmap glyph_pixels;
+  if (!pixels.extractSubset(
+          &glyph_pixels,
+          SkIRect::MakeXYWH(entry.location.GetX(), entry.location.GetY(),
+                            entry.location.GetWidth() + kPadding,
+                            entry.location.GetHeight() + kPadding))) {
+    return;
   }
-  auto canvas = surface->getCanvas();
+  std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(
+      glyph_pixels.info(), glyph_pixels.writable_addr(),
+      glyph_pixels.rowBytes());
   if (!canvas) {
+    return;
+  }
+  DrawGlyph(canvas.get(), entry.scaled_font, entry.glyph,
+            Rect::MakeSize(entry.location.GetSize()), has_color);
+}
+
+}  // namespace
+
+static bool RasterizeGlyphs(
+    const SkBitmap& bitmap,
+    std::vector<GlyphToRasterize> glyphs,
+    bool has_color,
+    const std::shared_ptr<fml::BasicTaskRunner>& worker_runner,
+    size_t worker_count) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  const SkPixmap& pixels = bitmap.pixmap();
+  if (pixels.addr() == nullptr) {
     return false;
   }
+  size_t helpers =
+      glyphs.size() < kMinGlyphsForParallelRasterization ? 0u : worker_count;
+  fml::ParallelFor(worker_runner, helpers, glyphs.size(),
+                   [&pixels, &glyphs, has_color](size_t index) {
+                     RasterizeGlyph(pixels, glyphs[index], has_color);
+                   });
+  return true;
+}
+
+static bool UpdateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::vector<FontGlyphPair>& new_pairs,
+    const std::vector<Rect>& evicted_regions,
+    const std::shared_ptr<fml::BasicTaskRunner>& worker_runner,
+    size_t worker_count) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
+
+  for (const Rect& region : evicted_regions) {
+    bitmap->erase(SK_ColorTRANSPARENT,
+                  SkIRect::MakeXYWH(region.GetX(), region.GetY(),
+                                    region.GetWidth(), region.GetHeight()));
+  }
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
 
+  std::vector<GlyphToRasterize> glyphs;
+  glyphs.reserve(new_pairs.size());
   for (const FontGlyphPair& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphBounds(pair);
     if (!pos.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair.scaled_font, pair.glyph, pos.value(), has_color);
+    glyphs.push_back({pair.scaled_font, pair.glyph, pos.value()});
   }
-  return true;
+  return RasterizeGlyphs(*bitmap, std::move(glyphs), has_color, worker_runner,
+                         worker_count);
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const std::shared_ptr<fml::BasicTaskRunner>& worker_runner,
+    size_t worker_count) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
@@ -232,24 +279,21 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
     return nullptr;
   }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return nullptr;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return nullptr;
-  }
-
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
 
-  atlas.IterateGlyphs([canvas, has_color](const ScaledFont& scaled_font,
-                                          const Glyph& glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, scaled_font, glyph, location, has_color);
+  std::vector<GlyphToRasterize> glyphs;
+  glyphs.reserve(atlas.GetGlyphCount());
+  atlas.IterateGlyphs([&glyphs](const ScaledFont& scaled_font,
+                                const Glyph& glyph,
+                                const Rect& location) -> bool {
+    glyphs.push_back({scaled_font, glyph, location});
     return true;
   });
 
+  if (!RasterizeGlyphs(*bitmap, std::move(glyphs), has_color, worker_runner,
+                       worker_count)) {
+    return nullptr;
+  }
   return bitmap;
 }
 
@@ -325,6 +369,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
+  atlas_context->MarkGlyphsUsed(font_glyph_map);
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -353,14 +398,16 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas. This requires that
-  //         the type is identical.
+  //         existing bitmap without recreating the atlas, if necessary by
+  //         evicting glyphs that are not used by this frame. This requires
+  //         that the type is identical.
   // ---------------------------------------------------------------------------
   std::vector<Rect> glyph_positions;
+  std::vector<Rect> evicted_regions;
   if (last_atlas->GetType() == type &&
-      CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
-                               atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
+      atlas_context->AppendGlyphsWithEviction(new_glyphs, ComputeGlyphSize,
+                                              kPadding, glyph_positions,
+                                              evicted_regions)) {
     // The old bitmap will be reused and only the additional glyphs will be
     // added.
 
@@ -376,16 +423,31 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
     // Step 4a: Draw new font-glyph pairs into the existing bitmap.
     // ---------------------------------------------------------------------------
     auto bitmap = atlas_context_skia.GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs, evicted_regions,
+                           worker_runner_, worker_count_)) {
       return nullptr;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Update the texture with the updated bitmap. Frames that are
+    //          still in flight may sample the evicted glyphs from the current
+    //          texture, so after an eviction the bitmap is uploaded to a new
+    //          texture instead.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    std::shared_ptr<Texture> texture = last_atlas->GetTexture();
+    if (evicted_regions.empty()) {
+      if (!UpdateGlyphTextureAtlas(bitmap, texture)) {
+        return nullptr;
+      }
+      return last_atlas;
+    }
+    texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
+                                      texture->GetSize(),
+                                      texture->GetTextureDescriptor().format);
+    if (!texture) {
       return nullptr;
     }
+    last_atlas->SetTexture(std::move(texture));
     return last_atlas;
   }
   // A new glyph atlas must be created.
@@ -440,7 +502,8 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 6b: Draw font-glyph pairs in the correct spot in the atlas.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size, worker_runner_,
+                                  worker_count_);
   if (!bitmap) {
     return nullptr;
   }
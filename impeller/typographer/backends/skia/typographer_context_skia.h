@@ -5,17 +5,40 @@
 #ifndef FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 #define FLUTTER_IMPELLER_TYPOGRAPHER_BACKENDS_SKIA_TYPOGRAPHER_CONTEXT_SKIA_H_
 
+#include <memory>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "impeller/typographer/typographer_context.h"
 
 namespace impeller {
 
 class TypographerContextSkia : public TypographerContext {
  public:
+  static constexpr size_t kDefaultWorkerCount = 4u;
+
   static std::shared_ptr<TypographerContext> Make();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a typographer context that rasterizes the glyphs of
+  ///             large atlas updates in parallel.
+  ///
+  /// @param[in]  worker_runner  The runner on which glyphs are rasterized in
+  ///                            addition to the calling thread. Typically the
+  ///                            concurrent worker task runner. If null, all
+  ///                            glyphs are rasterized on the calling thread.
+  /// @param[in]  worker_count   The maximum number of tasks posted to the
+  ///                            worker runner for a single atlas update.
+  ///
+  static std::shared_ptr<TypographerContext> Make(
+      std::shared_ptr<fml::BasicTaskRunner> worker_runner,
+      size_t worker_count = kDefaultWorkerCount);
+
   TypographerContextSkia();
 
+  TypographerContextSkia(std::shared_ptr<fml::BasicTaskRunner> worker_runner,
+                         size_t worker_count);
+
   ~TypographerContextSkia() override;
 
   // |TypographerContext|
@@ -29,6 +52,9 @@ class TypographerContextSkia : public TypographerContext {
       const FontGlyphMap& font_glyph_map) const override;
 
  private:
+  const std::shared_ptr<fml::BasicTaskRunner> worker_runner_;
+  const size_t worker_count_ = 0u;
+
   TypographerContextSkia(const TypographerContextSkia&) = delete;
 
   TypographerContextSkia& operator=(const TypographerContextSkia&) = delete;
@@ -4,6 +4,8 @@
 
 #include "impeller/typographer/backends/stb/typographer_context_stb.h"
 
+#include <algorithm>
+#include <cstring>
 #include <numeric>
 #include <utility>
 
@@ -39,6 +41,29 @@ TypographerContextSTB::CreateGlyphAtlasContext() const {
   return std::make_shared<GlyphAtlasContextSTB>();
 }
 
+static ISize ComputeGlyphSize(const FontGlyphPair& pair) {
+  const Font& font = pair.scaled_font.font;
+
+  // We downcast to the correct typeface type to access `stb` specific
+  // methods.
+  std::shared_ptr<TypefaceSTB> typeface_stb =
+      std::reinterpret_pointer_cast<TypefaceSTB>(font.GetTypeface());
+  // Conversion factor to scale font size in Points to pixels.
+  // Note this assumes typical DPI.
+  float text_size_pixels =
+      font.GetMetrics().point_size * TypefaceSTB::kPointsToPixels;
+
+  int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+  // NOTE: We increase the size of the glyph by one pixel in all dimensions
+  // to allow us to cut out padding later.
+  float scale = stbtt_ScaleForPixelHeight(typeface_stb->GetFontInfo(),
+                                          text_size_pixels);
+  stbtt_GetGlyphBitmapBox(typeface_stb->GetFontInfo(), pair.glyph.index,
+                          scale, scale, &x0, &y0, &x1, &y1);
+
+  return ISize(x1 - x0, y1 - y0);
+}
+
 // Function returns the count of "remaining pairs" not packed into rect of given
 // size.
 static size_t PairsFitInAtlasOfSize(
@@ -56,30 +81,8 @@ static size_t PairsFitInAtlasOfSize(
   size_t i = 0;
   for (auto it = pairs.begin(); it != pairs.end(); ++i, ++it) {
     const auto& pair = *it;
-    const Font& font = pair.scaled_font.font;
-
-    // We downcast to the correct typeface type to access `stb` specific
-    // methods.
-    std::shared_ptr<TypefaceSTB> typeface_stb =
-        std::reinterpret_pointer_cast<TypefaceSTB>(font.GetTypeface());
-    // Conversion factor to scale font size in Points to pixels.
-    // Note this assumes typical DPI.
-    float text_size_pixels =
-        font.GetMetrics().point_size * TypefaceSTB::kPointsToPixels;
-
-    ISize glyph_size;
-    {
-      int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
-      // NOTE: We increase the size of the glyph by one pixel in all dimensions
-      // to allow us to cut out padding later.
-      float scale = stbtt_ScaleForPixelHeight(typeface_stb->GetFontInfo(),
-                                              text_size_pixels);
-      stbtt_GetGlyphBitmapBox(typeface_stb->GetFontInfo(), pair.glyph.index,
-                              scale, scale, &x0, &y0, &x1, &y1);
-
-      glyph_size = ISize(x1 - x0, y1 - y0);
-    }
 
+    const auto glyph_size = ComputeGlyphSize(pair);
     IPoint16 location_in_atlas;
     if (!rect_packer->addRect(glyph_size.width + kPadding,   //
                               glyph_size.height + kPadding,  //
@@ -97,65 +100,6 @@ static size_t PairsFitInAtlasOfSize(
   return 0;
 }
 
-static bool CanAppendToExistingAtlas(
-    const std::shared_ptr<GlyphAtlas>& atlas,
-    const std::vector<FontGlyphPair>& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    ISize atlas_size,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
-    return false;
-  }
-
-  // We assume that all existing glyphs will fit. After all, they fit before.
-  // The glyph_positions only contains the values for the additional glyphs
-  // from extra_pairs.
-  FML_DCHECK(glyph_positions.size() == 0);
-  glyph_positions.reserve(extra_pairs.size());
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
-    const FontGlyphPair& pair = extra_pairs[i];
-    const Font& font = pair.scaled_font.font;
-
-    // We downcast to the correct typeface type to access `stb` specific methods
-    std::shared_ptr<TypefaceSTB> typeface_stb =
-        std::reinterpret_pointer_cast<TypefaceSTB>(font.GetTypeface());
-    // Conversion factor to scale font size in Points to pixels.
-    // Note this assumes typical DPI.
-    float text_size_pixels =
-        font.GetMetrics().point_size * TypefaceSTB::kPointsToPixels;
-
-    ISize glyph_size;
-    {
-      int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
-      // NOTE: We increase the size of the glyph by one pixel in all dimensions
-      // to allow us to cut out padding later.
-      float scale_y = stbtt_ScaleForPixelHeight(typeface_stb->GetFontInfo(),
-                                                text_size_pixels);
-      float scale_x = scale_y;
-      stbtt_GetGlyphBitmapBox(typeface_stb->GetFontInfo(), pair.glyph.index,
-                              scale_x, scale_y, &x0, &y0, &x1, &y1);
-
-      glyph_size = ISize(x1 - x0, y1 - y0);
-    }
-
-    IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return false;
-    }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
-  }
-
-  return true;
-}
-
 static ISize OptimumAtlasSizeForFontGlyphPairs(
     const std::vector<FontGlyphPair>& pairs,
     std::vector<Rect>& glyph_positions,
@@ -173,7 +117,8 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
   size_t total_pairs = pairs.size() + 1;
   do {
     auto rect_packer = std::shared_ptr<RectanglePacker>(
-        RectanglePacker::Factory(current_size.width, current_size.height));
+        RectanglePacker::FactoryWithRemoval(current_size.width,
+                                            current_size.height));
 
     auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
                                                  glyph_positions, rect_packer);
@@ -271,10 +216,25 @@ static void DrawGlyph(BitmapSTB* bitmap,
 
 static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
                               const std::shared_ptr<BitmapSTB>& bitmap,
-                              const std::vector<FontGlyphPair>& new_pairs) {
+                              const std::vector<FontGlyphPair>& new_pairs,
+                              const std::vector<Rect>& evicted_regions) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   FML_DCHECK(bitmap != nullptr);
 
+  const size_t bytes_per_pixel = bitmap->GetRowBytes() / bitmap->GetWidth();
+  for (const Rect& region : evicted_regions) {
+    const size_t x = static_cast<size_t>(region.GetX());
+    const size_t y = static_cast<size_t>(region.GetY());
+    const size_t width = std::min(static_cast<size_t>(region.GetWidth()),
+                                  bitmap->GetWidth() - x);
+    const size_t height = std::min(static_cast<size_t>(region.GetHeight()),
+                                   bitmap->GetHeight() - y);
+    for (size_t row = 0; row < height; row++) {
+      memset(bitmap->GetPixelAddress({x, y + row}), 0,
+             width * bytes_per_pixel);
+    }
+  }
+
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
 
   for (const FontGlyphPair& pair : new_pairs) {
@@ -387,6 +347,7 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
   if (font_glyph_map.empty()) {
     return last_atlas;
   }
+  atlas_context->MarkGlyphsUsed(font_glyph_map);
 
   // ---------------------------------------------------------------------------
   // Step 1: Determine if the atlas type and font glyph pairs are compatible
@@ -415,14 +376,16 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas. This requires that
-  //         the type is identical.
+  //         existing bitmap without recreating the atlas, if necessary by
+  //         evicting glyphs that are not used by this frame. This requires
+  //         that the type is identical.
   // ---------------------------------------------------------------------------
   std::vector<Rect> glyph_positions;
+  std::vector<Rect> evicted_regions;
   if (last_atlas->GetType() == type &&
-      CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
-                               atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
+      atlas_context->AppendGlyphsWithEviction(new_glyphs, ComputeGlyphSize,
+                                              kPadding, glyph_positions,
+                                              evicted_regions)) {
     // The old bitmap will be reused and only the additional glyphs will be
     // added.
 
@@ -439,16 +402,30 @@ std::shared_ptr<GlyphAtlas> TypographerContextSTB::CreateGlyphAtlas(
     // ---------------------------------------------------------------------------
     // auto bitmap = atlas_context->GetBitmap();
     auto bitmap = atlas_context_stb.GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs, evicted_regions)) {
       return nullptr;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5a: Update the existing texture with the updated bitmap.
+    // Step 5a: Update the texture with the updated bitmap. Frames that are
+    //          still in flight may sample the evicted glyphs from the current
+    //          texture, so after an eviction the bitmap is uploaded to a new
+    //          texture instead.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
+    std::shared_ptr<Texture> texture = last_atlas->GetTexture();
+    if (evicted_regions.empty()) {
+      if (!UpdateGlyphTextureAtlas(bitmap, texture)) {
+        return nullptr;
+      }
+      return last_atlas;
+    }
+    texture = UploadGlyphTextureAtlas(context.GetResourceAllocator(), bitmap,
+                                      texture->GetSize(),
+                                      texture->GetTextureDescriptor().format);
+    if (!texture) {
       return nullptr;
     }
+    last_atlas->SetTexture(std::move(texture));
     return last_atlas;
   }
   // A new glyph atlas must be created.
@@ -4,9 +4,13 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
 #include <numeric>
 #include <utility>
 
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext()
@@ -31,6 +35,16 @@ void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
                                          ISize size) {
   atlas_ = std::move(atlas);
   atlas_size_ = size;
+  // A new atlas only holds the glyphs of the current update, so the usage of
+  // any other glyph no longer needs to be tracked.
+  for (auto font_it = last_used_.begin(); font_it != last_used_.end();) {
+    auto& glyphs = font_it->second;
+    for (auto glyph_it = glyphs.begin(); glyph_it != glyphs.end();) {
+      glyph_it = glyph_it->second == current_use_ ? std::next(glyph_it)
+                                                  : glyphs.erase(glyph_it);
+    }
+    font_it = glyphs.empty() ? last_used_.erase(font_it) : std::next(font_it);
+  }
 }
 
 void GlyphAtlasContext::UpdateRectPacker(
@@ -38,6 +52,160 @@ void GlyphAtlasContext::UpdateRectPacker(
   rect_packer_ = std::move(rect_packer);
 }
 
+void GlyphAtlasContext::MarkGlyphsUsed(const FontGlyphMap& font_glyph_map) {
+  current_use_++;
+  for (const auto& font_value : font_glyph_map) {
+    auto& glyphs = last_used_[font_value.first];
+    for (const Glyph& glyph : font_value.second) {
+      glyphs[glyph] = current_use_;
+    }
+  }
+}
+
+std::vector<Rect> GlyphAtlasContext::EvictUnusedGlyphs(size_t area,
+                                                       int padding) {
+  std::vector<Rect> freed;
+  if (!atlas_ || !rect_packer_ || !rect_packer_->supportsRemoval()) {
+    return freed;
+  }
+
+  struct Candidate {
+    uint64_t last_used;
+    const ScaledFont* scaled_font;
+    const Glyph* glyph;
+    Rect rect;
+  };
+  std::vector<Candidate> candidates;
+  atlas_->IterateGlyphs([&](const ScaledFont& scaled_font, const Glyph& glyph,
+                            const Rect& rect) {
+    uint64_t last_used = 0u;
+    const auto found_font = last_used_.find(scaled_font);
+    if (found_font != last_used_.end()) {
+      const auto found_glyph = found_font->second.find(glyph);
+      if (found_glyph != found_font->second.end()) {
+        last_used = found_glyph->second;
+      }
+    }
+    if (last_used != current_use_) {
+      candidates.push_back({last_used, &scaled_font, &glyph, rect});
+    }
+    return true;
+  });
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return a.last_used < b.last_used;
+            });
+
+  // Pick the glyphs first, as removing them from the atlas invalidates the
+  // candidates.
+  size_t freed_area = 0u;
+  std::vector<std::pair<ScaledFont, Glyph>> evicted;
+  for (const Candidate& candidate : candidates) {
+    if (freed_area >= area) {
+      break;
+    }
+    Rect region =
+        Rect::MakeXYWH(candidate.rect.GetX(), candidate.rect.GetY(),
+                       candidate.rect.GetWidth() + padding,
+                       candidate.rect.GetHeight() + padding);
+    if (!rect_packer_->removeRect(static_cast<int>(region.GetX()),
+                                  static_cast<int>(region.GetY()),
+                                  static_cast<int>(region.GetWidth()),
+                                  static_cast<int>(region.GetHeight()))) {
+      continue;
+    }
+    freed_area += region.GetWidth() * region.GetHeight();
+    freed.push_back(region);
+    evicted.emplace_back(*candidate.scaled_font, *candidate.glyph);
+  }
+
+  for (const auto& [scaled_font, glyph] : evicted) {
+    atlas_->RemoveTypefaceGlyphPosition({scaled_font, glyph});
+    auto found_font = last_used_.find(scaled_font);
+    if (found_font != last_used_.end()) {
+      found_font->second.erase(glyph);
+      if (found_font->second.empty()) {
+        last_used_.erase(found_font);
+      }
+    }
+  }
+  return freed;
+}
+
+bool GlyphAtlasContext::AppendGlyphsWithEviction(
+    const std::vector<FontGlyphPair>& pairs,
+    const GlyphSizeProc& glyph_size,
+    int padding,
+    std::vector<Rect>& glyph_positions,
+    std::vector<Rect>& evicted_regions) {
+  if (AppendGlyphs(pairs, glyph_size, padding, glyph_positions)) {
+    return true;
+  }
+  if (!rect_packer_ || !rect_packer_->supportsRemoval()) {
+    return false;
+  }
+
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  size_t needed_area = 0u;
+  for (const FontGlyphPair& pair : pairs) {
+    ISize size = glyph_size(pair);
+    needed_area += (size.width + padding) * (size.height + padding);
+  }
+  while (true) {
+    // Take back the glyphs that were placed by the failed attempt.
+    for (const Rect& position : glyph_positions) {
+      rect_packer_->removeRect(
+          static_cast<int>(position.GetX()), static_cast<int>(position.GetY()),
+          static_cast<int>(position.GetWidth() + padding),
+          static_cast<int>(position.GetHeight() + padding));
+    }
+    glyph_positions.clear();
+
+    std::vector<Rect> evicted = EvictUnusedGlyphs(needed_area, padding);
+    if (evicted.empty()) {
+      return false;
+    }
+    evicted_regions.insert(evicted_regions.end(), evicted.begin(),
+                           evicted.end());
+    if (AppendGlyphs(pairs, glyph_size, padding, glyph_positions)) {
+      return true;
+    }
+  }
+}
+
+bool GlyphAtlasContext::AppendGlyphs(const std::vector<FontGlyphPair>& pairs,
+                                     const GlyphSizeProc& glyph_size,
+                                     int padding,
+                                     std::vector<Rect>& glyph_positions) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!rect_packer_ || atlas_size_.IsEmpty()) {
+    return false;
+  }
+
+  // We assume that all existing glyphs will fit. After all, they fit before.
+  // The glyph_positions only contains the values for the additional glyphs
+  // from pairs.
+  FML_DCHECK(glyph_positions.size() == 0);
+  glyph_positions.reserve(pairs.size());
+  for (const FontGlyphPair& pair : pairs) {
+    ISize size = glyph_size(pair);
+    IPoint16 location_in_atlas;
+    if (!rect_packer_->addRect(size.width + padding,   //
+                               size.height + padding,  //
+                               &location_in_atlas      //
+                               )) {
+      return false;
+    }
+    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
+                                                location_in_atlas.y(),  //
+                                                size.width,             //
+                                                size.height             //
+                                                ));
+  }
+
+  return true;
+}
+
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 
 GlyphAtlas::~GlyphAtlas() = default;
@@ -63,6 +231,18 @@ void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
   font_atlas_map_[pair.scaled_font].positions_[pair.glyph] = rect;
 }
 
+bool GlyphAtlas::RemoveTypefaceGlyphPosition(const FontGlyphPair& pair) {
+  auto found = font_atlas_map_.find(pair.scaled_font);
+  if (found == font_atlas_map_.end() ||
+      found->second.positions_.erase(pair.glyph) == 0u) {
+    return false;
+  }
+  if (found->second.positions_.empty()) {
+    font_atlas_map_.erase(found);
+  }
+  return true;
+}
+
 std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
     const FontGlyphPair& pair) const {
   const auto& found = font_atlas_map_.find(pair.scaled_font);
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -83,6 +84,16 @@ class GlyphAtlas {
   ///
   void AddTypefaceGlyphPosition(const FontGlyphPair& pair, Rect rect);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Forget the location of a specific font-glyph pair so that its
+  ///             region of the atlas can be reused for other glyphs.
+  ///
+  /// @param[in]  pair  The font-glyph pair
+  ///
+  /// @return     Whether the pair was in the atlas.
+  ///
+  bool RemoveTypefaceGlyphPosition(const FontGlyphPair& pair);
+
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
   ///
@@ -164,6 +175,50 @@ class GlyphAtlasContext {
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record that the glyphs are used by the frame that the atlas
+  ///             is being updated for. This must be called once per update,
+  ///             before any calls to |EvictUnusedGlyphs|.
+  void MarkGlyphsUsed(const FontGlyphMap& font_glyph_map);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove glyphs that the current frame does not use from the
+  ///             current atlas and rect packer, least recently used first,
+  ///             until at least `area` pixels have been freed or there are no
+  ///             unused glyphs left.
+  ///
+  ///             This is only possible if the rect packer supports removal.
+  ///
+  /// @param[in]  area     The number of pixels to free.
+  /// @param[in]  padding  The padding that was added to the width and height
+  ///                      of each glyph when it was packed.
+  ///
+  /// @return     The padded regions of the atlas that were freed, which still
+  ///             contain the pixels of the evicted glyphs.
+  std::vector<Rect> EvictUnusedGlyphs(size_t area, int padding);
+
+  /// The size in pixels that a backend renders a glyph at, excluding padding.
+  using GlyphSizeProc = std::function<ISize(const FontGlyphPair& pair)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pack the pairs into the free space of the current rect packer
+  ///             and, if they do not fit, evict glyphs that the current frame
+  ///             does not use with |EvictUnusedGlyphs| until they do.
+  ///
+  /// @param[in]  pairs            The pairs to add to the current atlas.
+  /// @param[in]  glyph_size       The size of each glyph in the atlas.
+  /// @param[in]  padding          The padding to add to the width and height
+  ///                              of each glyph.
+  /// @param[out] glyph_positions  The positions of the pairs in the atlas.
+  /// @param[out] evicted_regions  The padded regions of the evicted glyphs.
+  ///
+  /// @return     Whether all of the pairs were packed.
+  bool AppendGlyphsWithEviction(const std::vector<FontGlyphPair>& pairs,
+                                const GlyphSizeProc& glyph_size,
+                                int padding,
+                                std::vector<Rect>& glyph_positions,
+                                std::vector<Rect>& evicted_regions);
+
  protected:
   GlyphAtlasContext();
 
@@ -171,6 +226,15 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
   std::shared_ptr<RectanglePacker> rect_packer_;
+  // The update in which each glyph was last used.
+  uint64_t current_use_ = 0u;
+  std::unordered_map<ScaledFont, std::unordered_map<Glyph, uint64_t>>
+      last_used_;
+
+  bool AppendGlyphs(const std::vector<FontGlyphPair>& pairs,
+                    const GlyphSizeProc& glyph_size,
+                    int padding,
+                    std::vector<Rect>& glyph_positions);
 
   GlyphAtlasContext(const GlyphAtlasContext&) = delete;
 
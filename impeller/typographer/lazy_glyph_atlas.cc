@@ -4,6 +4,7 @@
 
 #include "impeller/typographer/lazy_glyph_atlas.h"
 
+#include "impeller/base/frame_phase_timings.h"
 #include "impeller/base/validation.h"
 #include "impeller/typographer/typographer_context.h"
 
@@ -63,6 +64,8 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
                                                            : color_glyph_map_;
   auto atlas_context =
       type == GlyphAtlas::Type::kAlphaBitmap ? alpha_context_ : color_context_;
+  ScopedFramePhase phase(&context.GetFramePhaseTimings(),
+                         FramePhase::kGlyphAtlas);
   auto atlas = typographer_context_->CreateGlyphAtlas(context, type,
                                                       atlas_context, glyph_map);
   if (!atlas || !atlas->IsValid()) {
@@ -5,6 +5,8 @@
 #include "impeller/typographer/rectangle_packer.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace impeller {
@@ -166,8 +168,180 @@ void SkylineRectanglePacker::addSkylineLevel(int skylineIndex,
   }
 }
 
+// Packs rectangles into a list of free rectangles. Each added rectangle is
+// placed in the corner of the free rectangle that it fits best, and the rest
+// of that free rectangle is split in two along the shorter leftover side.
+//
+// Removing a rectangle returns it to the free list, merging it with free
+// neighbors that share a whole edge with it so that the space can be reused
+// by rectangles larger than the one that was removed.
+class GuillotineRectanglePacker final : public RectanglePacker {
+ public:
+  GuillotineRectanglePacker(int w, int h) : RectanglePacker(w, h) {
+    this->reset();
+  }
+
+  ~GuillotineRectanglePacker() final {}
+
+  void reset() final {
+    area_so_far_ = 0;
+    placed_.clear();
+    free_.clear();
+    free_.push_back(Area{0, 0, this->width(), this->height()});
+  }
+
+  bool addRect(int w, int h, IPoint16* loc) final;
+
+  bool supportsRemoval() const final { return true; }
+
+  bool removeRect(int x, int y, int w, int h) final;
+
+  float percentFull() const final {
+    return area_so_far_ / ((float)this->width() * this->height());
+  }
+
+ private:
+  struct Area {
+    int x_;
+    int y_;
+    int width_;
+    int height_;
+  };
+
+  static uint32_t PlacementKey(int x, int y) {
+    return (static_cast<uint32_t>(x) << 16) | static_cast<uint32_t>(y);
+  }
+
+  std::vector<Area> free_;
+  // The sizes of the placed rectangles, keyed by location.
+  std::unordered_map<uint32_t, Area> placed_;
+
+  int64_t area_so_far_;
+
+  // Add the area to the free list, merging it with its neighbors.
+  void addFreeArea(Area area);
+};
+
+bool GuillotineRectanglePacker::addRect(int width, int height, IPoint16* loc) {
+  loc->x_ = 0;
+  loc->y_ = 0;
+  if (width <= 0 || height <= 0 || width > this->width() ||
+      height > this->height()) {
+    return false;
+  }
+
+  // Best area fit, ties broken by the shorter leftover side.
+  int best_index = -1;
+  int64_t best_area = INT64_MAX;
+  int best_short_side = INT32_MAX;
+  for (int i = 0; i < (int)free_.size(); ++i) {
+    const Area& area = free_[i];
+    if (area.width_ < width || area.height_ < height) {
+      continue;
+    }
+    int64_t leftover_area =
+        (int64_t)area.width_ * area.height_ - (int64_t)width * height;
+    int short_side = std::min(area.width_ - width, area.height_ - height);
+    if (leftover_area < best_area ||
+        (leftover_area == best_area && short_side < best_short_side)) {
+      best_index = i;
+      best_area = leftover_area;
+      best_short_side = short_side;
+    }
+  }
+  if (best_index == -1) {
+    return false;
+  }
+
+  Area area = free_[best_index];
+  free_.erase(std::next(free_.begin(), best_index));
+
+  int leftover_width = area.width_ - width;
+  int leftover_height = area.height_ - height;
+  Area right;
+  Area bottom;
+  if (leftover_width < leftover_height) {
+    // Split horizontally, giving the bottom piece the full width.
+    right = Area{area.x_ + width, area.y_, leftover_width, height};
+    bottom = Area{area.x_, area.y_ + height, area.width_, leftover_height};
+  } else {
+    // Split vertically, giving the right piece the full height.
+    right = Area{area.x_ + width, area.y_, leftover_width, area.height_};
+    bottom = Area{area.x_, area.y_ + height, width, leftover_height};
+  }
+  if (right.width_ > 0 && right.height_ > 0) {
+    free_.push_back(right);
+  }
+  if (bottom.width_ > 0 && bottom.height_ > 0) {
+    free_.push_back(bottom);
+  }
+
+  placed_[PlacementKey(area.x_, area.y_)] =
+      Area{area.x_, area.y_, width, height};
+  area_so_far_ += (int64_t)width * height;
+  loc->x_ = area.x_;
+  loc->y_ = area.y_;
+  return true;
+}
+
+bool GuillotineRectanglePacker::removeRect(int x, int y, int w, int h) {
+  auto found = placed_.find(PlacementKey(x, y));
+  if (found == placed_.end() || found->second.width_ != w ||
+      found->second.height_ != h) {
+    return false;
+  }
+  placed_.erase(found);
+  area_so_far_ -= (int64_t)w * h;
+
+  if (placed_.empty()) {
+    // Everything is free again, so drop any remaining fragmentation.
+    this->reset();
+    return true;
+  }
+  this->addFreeArea(Area{x, y, w, h});
+  return true;
+}
+
+void GuillotineRectanglePacker::addFreeArea(Area area) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      const Area& other = *it;
+      if (other.x_ == area.x_ && other.width_ == area.width_) {
+        if (other.y_ + other.height_ == area.y_) {
+          area.y_ = other.y_;
+          area.height_ += other.height_;
+          merged = true;
+        } else if (area.y_ + area.height_ == other.y_) {
+          area.height_ += other.height_;
+          merged = true;
+        }
+      } else if (other.y_ == area.y_ && other.height_ == area.height_) {
+        if (other.x_ + other.width_ == area.x_) {
+          area.x_ = other.x_;
+          area.width_ += other.width_;
+          merged = true;
+        } else if (area.x_ + area.width_ == other.x_) {
+          area.width_ += other.width_;
+          merged = true;
+        }
+      }
+      if (merged) {
+        free_.erase(it);
+        break;
+      }
+    }
+  }
+  free_.push_back(area);
+}
+
 RectanglePacker* RectanglePacker::Factory(int width, int height) {
   return new SkylineRectanglePacker(width, height);
 }
 
+RectanglePacker* RectanglePacker::FactoryWithRemoval(int width, int height) {
+  return new GuillotineRectanglePacker(width, height);
+}
+
 }  // namespace impeller
@@ -29,6 +29,12 @@ class RectanglePacker {
   ///
   static RectanglePacker* Factory(int width, int height);
 
+  //----------------------------------------------------------------------------
+  /// @brief     Return an empty packer with area specified by width and height
+  ///            that also supports removing previously added rectangles.
+  ///
+  static RectanglePacker* FactoryWithRemoval(int width, int height);
+
   virtual ~RectanglePacker() {}
 
   //----------------------------------------------------------------------------
@@ -43,6 +49,27 @@ class RectanglePacker {
   ///
   virtual bool addRect(int width, int height, IPoint16* loc) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief     Whether this packer can remove rectangles with |removeRect|.
+  ///
+  virtual bool supportsRemoval() const { return false; }
+
+  //----------------------------------------------------------------------------
+  /// @brief     Return the area of a previously added rectangle to the free
+  ///            space so that later rectangles can be placed there.
+  ///
+  /// @param[in]   x       The left edge the rectangle was placed at.
+  /// @param[in]   y       The top edge the rectangle was placed at.
+  /// @param[in]   width   The width the rectangle was added with.
+  /// @param[in]   height  The height the rectangle was added with.
+  ///
+  /// @return     Return false if removal is not supported or if no rectangle
+  ///             of that size was placed at that location.
+  ///
+  virtual bool removeRect(int x, int y, int width, int height) {
+    return false;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief     Returns how much area has been filled with rectangles.
   ///
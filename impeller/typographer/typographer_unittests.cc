@@ -3,8 +3,10 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/glyph_atlas_context_skia.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
@@ -211,6 +213,44 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   EXPECT_TRUE(atlas->GetTexture()->GetSize().height > 0);
 }
 
+TEST_P(TypographerTest, ParallelGlyphRasterizationMatchesSerial) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto serial_context = TypographerContextSkia::Make();
+  auto parallel_context = TypographerContextSkia::Make(loop->GetTaskRunner());
+  auto serial_atlas_context = serial_context->CreateGlyphAtlasContext();
+  auto parallel_atlas_context = parallel_context->CreateGlyphAtlasContext();
+
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto blob = SkTextBlob::MakeFromString(
+      "the quick brown fox jumps over the lazy dog THE QUICK BROWN", sk_font);
+  ASSERT_TRUE(blob);
+
+  FontGlyphMap font_glyph_map;
+  MakeTextFrameFromTextBlobSkia(blob)->CollectUniqueFontGlyphPairs(
+      font_glyph_map, 1.0f);
+  auto serial_atlas = serial_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, serial_atlas_context,
+      font_glyph_map);
+  auto parallel_atlas = parallel_context->CreateGlyphAtlas(
+      *GetContext(), GlyphAtlas::Type::kAlphaBitmap, parallel_atlas_context,
+      font_glyph_map);
+  ASSERT_NE(serial_atlas, nullptr);
+  ASSERT_NE(parallel_atlas, nullptr);
+  ASSERT_GT(parallel_atlas->GetGlyphCount(), 16u);
+
+  const SkBitmap& serial_bitmap =
+      *GlyphAtlasContextSkia::Cast(*serial_atlas_context).GetBitmap();
+  const SkBitmap& parallel_bitmap =
+      *GlyphAtlasContextSkia::Cast(*parallel_atlas_context).GetBitmap();
+  ASSERT_EQ(serial_bitmap.dimensions(), parallel_bitmap.dimensions());
+  for (int y = 0; y < serial_bitmap.height(); y++) {
+    for (int x = 0; x < serial_bitmap.width(); x++) {
+      ASSERT_EQ(*serial_bitmap.getAddr8(x, y), *parallel_bitmap.getAddr8(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto context = TypographerContextSkia::Make();
   auto atlas_context = context->CreateGlyphAtlasContext();
@@ -355,23 +395,178 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledWhenContentsAreRecreated) {
   ASSERT_NE(atlas->GetTexture(), nullptr);
   ASSERT_EQ(atlas, atlas_context->GetGlyphAtlas());
 
-  auto* first_texture = atlas->GetTexture().get();
+  // Held so that a new texture cannot be allocated at the same address.
+  std::shared_ptr<Texture> first_texture = atlas->GetTexture();
 
   // Now create a new glyph atlas with a completely different textblob.
   // everything should be different except for the underlying atlas texture.
 
   auto blob2 = SkTextBlob::MakeFromString("abcdefghijklmnopqrstuvwxyz123456789",
                                           sk_font);
-  auto next_atlas = CreateGlyphAtlas(
-      *GetContext(), context.get(), GlyphAtlas::Type::kColorBitmap, 32.0f,
-      atlas_context, *MakeTextFrameFromTextBlobSkia(blob2));
-  ASSERT_NE(atlas, next_atlas);
-  auto* second_texture = next_atlas->GetTexture().get();
+  auto frame2 = MakeTextFrameFromTextBlobSkia(blob2);
+  auto next_atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(),
+                       GlyphAtlas::Type::kColorBitmap, 32.0f, atlas_context,
+                       *frame2);
+  // The glyphs of the first blob are no longer used, so they are either
+  // evicted to make room in the existing atlas or dropped when the atlas is
+  // recreated.
+  FontGlyphMap glyphs2;
+  frame2->CollectUniqueFontGlyphPairs(glyphs2, 32.0f);
+  for (const auto& [scaled_font, glyphs] : glyphs2) {
+    for (const Glyph& glyph : glyphs) {
+      ASSERT_TRUE(next_atlas->FindFontGlyphBounds({scaled_font, glyph}));
+    }
+  }
+  std::shared_ptr<Texture> second_texture = next_atlas->GetTexture();
 
   auto new_packer = atlas_context->GetRectPacker();
 
-  ASSERT_EQ(second_texture, first_texture);
-  ASSERT_NE(old_packer, new_packer);
+  if (next_atlas == atlas) {
+    // Frames in flight may still sample the evicted glyphs, so the updated
+    // atlas is uploaded to a new texture.
+    ASSERT_NE(second_texture, first_texture);
+    ASSERT_EQ(old_packer, new_packer);
+  } else {
+    ASSERT_EQ(second_texture, first_texture);
+    ASSERT_NE(old_packer, new_packer);
+  }
+}
+
+TEST_P(TypographerTest, RectanglePackerWithRemovalReusesRemovedSpace) {
+  auto packer = std::unique_ptr<RectanglePacker>(
+      RectanglePacker::FactoryWithRemoval(100, 100));
+  ASSERT_TRUE(packer->supportsRemoval());
+
+  IPoint16 left = {-1, -1};
+  IPoint16 top_right = {-1, -1};
+  IPoint16 bottom_right = {-1, -1};
+  ASSERT_TRUE(packer->addRect(50, 100, &left));
+  ASSERT_TRUE(packer->addRect(50, 50, &top_right));
+  ASSERT_TRUE(packer->addRect(50, 50, &bottom_right));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 1.0));
+
+  IPoint16 output;
+  ASSERT_FALSE(packer->addRect(50, 100, &output));
+
+  // Only rectangles that were added, with their original size, can be
+  // removed.
+  ASSERT_FALSE(packer->removeRect(top_right.x(), top_right.y(), 40, 50));
+  ASSERT_FALSE(packer->removeRect(25, 25, 50, 50));
+
+  // Removing both of the right hand rectangles frees a single region that is
+  // large enough for a rectangle as tall as the packer.
+  ASSERT_TRUE(packer->removeRect(top_right.x(), top_right.y(), 50, 50));
+  ASSERT_TRUE(packer->removeRect(bottom_right.x(), bottom_right.y(), 50, 50));
+  ASSERT_TRUE(flutter::testing::NumberNear(packer->percentFull(), 0.5));
+  ASSERT_TRUE(packer->addRect(50, 100, &output));
+  ASSERT_EQ(output.x(), 50);
+  ASSERT_EQ(output.y(), 0);
+
+  auto skyline = std::unique_ptr<RectanglePacker>(
+      RectanglePacker::Factory(100, 100));
+  ASSERT_FALSE(skyline->supportsRemoval());
+}
+
+TEST_P(TypographerTest, GlyphAtlasContextEvictsLeastRecentlyUsedGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto all = MakeTextFrameFromTextBlobSkia(
+      SkTextBlob::MakeFromString("ABCDEFGHIJ", sk_font));
+  auto recent = MakeTextFrameFromTextBlobSkia(
+      SkTextBlob::MakeFromString("ABCDE", sk_font));
+  auto current = MakeTextFrameFromTextBlobSkia(
+      SkTextBlob::MakeFromString("AB", sk_font));
+
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(),
+                       GlyphAtlas::Type::kColorBitmap, 1.0f, atlas_context,
+                       *all);
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(atlas->GetGlyphCount(), 10u);
+  ASSERT_EQ(atlas,
+            CreateGlyphAtlas(*GetContext(), context.get(),
+                             GlyphAtlas::Type::kColorBitmap, 1.0f,
+                             atlas_context, *recent));
+  float full = atlas_context->GetRectPacker()->percentFull();
+
+  FontGlyphMap recent_glyphs;
+  recent->CollectUniqueFontGlyphPairs(recent_glyphs, 1.0f);
+  FontGlyphMap current_glyphs;
+  current->CollectUniqueFontGlyphPairs(current_glyphs, 1.0f);
+  atlas_context->MarkGlyphsUsed(current_glyphs);
+
+  // The glyphs that were only used by the first frame go first.
+  constexpr int kSkiaPadding = 2;
+  auto evicted = atlas_context->EvictUnusedGlyphs(1u, kSkiaPadding);
+  ASSERT_EQ(evicted.size(), 1u);
+  ASSERT_EQ(atlas->GetGlyphCount(), 9u);
+  ASSERT_LT(atlas_context->GetRectPacker()->percentFull(), full);
+  for (const auto& [scaled_font, glyphs] : recent_glyphs) {
+    for (const Glyph& glyph : glyphs) {
+      ASSERT_TRUE(atlas->FindFontGlyphBounds({scaled_font, glyph}));
+    }
+  }
+
+  // Glyphs used by the current frame are never evicted.
+  evicted = atlas_context->EvictUnusedGlyphs(SIZE_MAX, kSkiaPadding);
+  ASSERT_EQ(evicted.size(), 7u);
+  ASSERT_EQ(atlas->GetGlyphCount(), 2u);
+  for (const auto& [scaled_font, glyphs] : current_glyphs) {
+    for (const Glyph& glyph : glyphs) {
+      ASSERT_TRUE(atlas->FindFontGlyphBounds({scaled_font, glyph}));
+    }
+  }
+}
+
+TEST_P(TypographerTest, GlyphAtlasContextEvictsGlyphsToAppendGlyphs) {
+  auto context = TypographerContextSkia::Make();
+  auto atlas_context = context->CreateGlyphAtlasContext();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font = flutter::testing::CreateTestFontOfSize(12);
+  auto all = MakeTextFrameFromTextBlobSkia(
+      SkTextBlob::MakeFromString("ABCDEFGHIJ", sk_font));
+  auto current = MakeTextFrameFromTextBlobSkia(
+      SkTextBlob::MakeFromString("AB", sk_font));
+  auto atlas =
+      CreateGlyphAtlas(*GetContext(), context.get(),
+                       GlyphAtlas::Type::kColorBitmap, 1.0f, atlas_context,
+                       *all);
+  ASSERT_NE(atlas, nullptr);
+
+  FontGlyphMap current_glyphs;
+  current->CollectUniqueFontGlyphPairs(current_glyphs, 1.0f);
+  atlas_context->MarkGlyphsUsed(current_glyphs);
+  const auto& [scaled_font, glyphs] = *current_glyphs.begin();
+  std::vector<FontGlyphPair> pairs = {{scaled_font, *glyphs.begin()}};
+
+  // A small glyph fits next to the existing ones.
+  constexpr int kSkiaPadding = 2;
+  std::vector<Rect> positions;
+  std::vector<Rect> evicted;
+  ASSERT_TRUE(atlas_context->AppendGlyphsWithEviction(
+      pairs, [](const FontGlyphPair&) { return ISize(1, 1); }, kSkiaPadding,
+      positions, evicted));
+  ASSERT_EQ(positions.size(), 1u);
+  ASSERT_TRUE(evicted.empty());
+  ASSERT_EQ(atlas->GetGlyphCount(), 10u);
+
+  // A glyph the size of the atlas only fits if the glyphs of the current
+  // frame are evicted, which they never are.
+  ISize atlas_size = atlas_context->GetAtlasSize();
+  positions.clear();
+  ASSERT_FALSE(atlas_context->AppendGlyphsWithEviction(
+      pairs,
+      [atlas_size](const FontGlyphPair&) {
+        return ISize(atlas_size.width - kSkiaPadding,
+                     atlas_size.height - kSkiaPadding);
+      },
+      kSkiaPadding, positions, evicted));
+  ASSERT_TRUE(positions.empty());
+  ASSERT_EQ(evicted.size(), 8u);
+  ASSERT_EQ(atlas->GetGlyphCount(), 2u);
 }
 
 }  // namespace testing
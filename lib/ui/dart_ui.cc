@@ -30,6 +30,7 @@
 #include "flutter/lib/ui/painting/path_measure.h"
 #include "flutter/lib/ui/painting/picture.h"
 #include "flutter/lib/ui/painting/picture_recorder.h"
+#include "flutter/lib/ui/painting/streaming_image_decoder.h"
 #include "flutter/lib/ui/painting/vertices.h"
 #include "flutter/lib/ui/semantics/semantics_update.h"
 #include "flutter/lib/ui/semantics/semantics_update_builder.h"
@@ -84,6 +85,7 @@ typedef CanvasPath Path;
   V(PictureRecorder::Create, 1)                                       \
   V(SceneBuilder::Create, 1)                                          \
   V(SemanticsUpdateBuilder::Create, 1)                                \
+  V(StreamingImageDecoder::Create, 2)                                 \
   /* Other */                                                         \
   V(FontCollection::LoadFontFromList, 3)                              \
   V(ImageDescriptor::initEncoded, 3)                                  \
@@ -98,6 +100,7 @@ typedef CanvasPath Path;
   V(NativeStringAttribute::initSpellOutStringAttribute, 3)            \
   V(PlatformConfigurationNativeApi::DefaultRouteName, 0)              \
   V(PlatformConfigurationNativeApi::ScheduleFrame, 0)                 \
+  V(PlatformConfigurationNativeApi::FlushMicrotasks, 0)               \
   V(PlatformConfigurationNativeApi::Render, 1)                        \
   V(PlatformConfigurationNativeApi::UpdateSemantics, 1)               \
   V(PlatformConfigurationNativeApi::SetNeedsReportTimings, 1)         \
@@ -197,6 +200,7 @@ typedef CanvasPath Path;
   V(ImageDescriptor, dispose, 1)                       \
   V(ImageDescriptor, height, 1)                        \
   V(ImageDescriptor, instantiateCodec, 4)              \
+  V(ImageDescriptor, instantiateRegionCodec, 7)        \
   V(ImageDescriptor, width, 1)                         \
   V(ImageFilter, initBlur, 4)                          \
   V(ImageFilter, initDilate, 3)                        \
@@ -305,6 +309,9 @@ typedef CanvasPath Path;
   V(SemanticsUpdateBuilder, updateCustomAction, 5)     \
   V(SemanticsUpdateBuilder, updateNode, 36)            \
   V(SemanticsUpdate, dispose, 1)                       \
+  V(StreamingImageDecoder, addChunk, 2)                \
+  V(StreamingImageDecoder, close, 1)                   \
+  V(StreamingImageDecoder, dispose, 1)                 \
   V(Vertices, dispose, 1)
 
 #ifdef IMPELLER_ENABLE_3D
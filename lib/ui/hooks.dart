@@ -257,6 +257,11 @@ void _dispatchPlatformMessage(String name, ByteData? data, int responseId) {
   PlatformDispatcher.instance._dispatchPlatformMessage(name, data, responseId);
 }
 
+@pragma('vm:entry-point')
+void _dispatchPlatformMessages(List<String> names, List<ByteData?> data, List<int> responseIds) {
+  PlatformDispatcher.instance._dispatchPlatformMessages(names, data, responseIds);
+}
+
 @pragma('vm:entry-point')
 void _dispatchPointerDataPacket(ByteData packet) {
   PlatformDispatcher.instance._dispatchPointerDataPacket(packet);
@@ -2371,6 +2371,125 @@ Future<void> _decodeImageFromListAsync(Uint8List list, ImageDecoderCallback call
   callback(frameInfo.image);
 }
 
+/// Signature for the callback that a [StreamingImageDecoder] calls with the
+/// image decoded so far.
+///
+/// The `isComplete` argument is true for the last image, which has all of the
+/// rows of the encoded data. The callee owns the `image` and must dispose it
+/// when it is no longer needed.
+typedef StreamingImageCallback = void Function(Image image, bool isComplete);
+
+/// Decodes an image from encoded bytes that arrive in chunks, such as the body
+/// of a network response, and reports the rows decoded so far as an [Image]
+/// before all of the bytes have arrived.
+///
+/// Chunks are added with [addChunk] and the end of the data is marked with
+/// [close]. PNG, GIF and BMP images are decoded row by row as chunks arrive,
+/// and [onImage] is called with images in which the rows that have not been
+/// decoded yet are transparent. Other formats, including JPEG, are decoded
+/// once [close] has been called. Animated images only report their first
+/// frame.
+///
+/// The chunks are not concatenated into one buffer, and they are released as
+/// soon as the image has been decoded. A new image is not created for every
+/// chunk: chunks that arrive while the previous image is being decoded and
+/// uploaded are decoded together.
+///
+/// If the data cannot be decoded, [onError] is called with a description of
+/// the failure, possibly after [onImage] was called with the rows decoded
+/// before the failure, and no further images are reported. If [onError] is
+/// null, the failure is reported as an uncaught exception instead.
+///
+/// The creator of this object is responsible for calling [dispose] when it is
+/// no longer needed, which stops any decode in progress.
+base class StreamingImageDecoder extends NativeFieldWrapperClass1 {
+  /// Creates a decoder that reports the images it decodes to [onImage].
+  StreamingImageDecoder({required this.onImage, this.onError}) {
+    _constructor(_handleImage);
+  }
+
+  /// Called with the image decoded so far each time more rows are decoded.
+  final StreamingImageCallback onImage;
+
+  /// Called if the data cannot be decoded.
+  final void Function(String error)? onError;
+
+  @Native<Void Function(Handle, Handle)>(symbol: 'StreamingImageDecoder::Create')
+  external void _constructor(void Function(_Image?, bool, String) callback);
+
+  void _handleImage(_Image? image, bool isComplete, String error) {
+    if (image != null) {
+      onImage(Image._(image, image.width, image.height), isComplete && error.isEmpty);
+    }
+    if (error.isNotEmpty) {
+      if (onError == null) {
+        throw Exception(error);
+      }
+      onError!(error);
+    }
+  }
+
+  /// Adds the next chunk of encoded bytes. The bytes are copied, so the
+  /// `chunk` may be reused once this method returns.
+  ///
+  /// Throws if [close] has been called.
+  void addChunk(Uint8List chunk) {
+    assert(!_debugDisposed);
+    final String? error = _addChunk(chunk);
+    if (error != null) {
+      throw Exception(error);
+    }
+  }
+
+  @Native<Handle Function(Pointer<Void>, Handle)>(symbol: 'StreamingImageDecoder::addChunk')
+  external String? _addChunk(Uint8List chunk);
+
+  /// Marks the end of the encoded bytes, so that the image is decoded in full
+  /// and [onImage] is called with `isComplete` set to true.
+  void close() {
+    assert(!_debugDisposed);
+    final String? error = _close();
+    if (error != null) {
+      throw Exception(error);
+    }
+  }
+
+  @Native<Handle Function(Pointer<Void>)>(symbol: 'StreamingImageDecoder::close')
+  external String? _close();
+
+  bool _debugDisposed = false;
+
+  /// Whether [dispose] has been called.
+  ///
+  /// This must only be used when asserts are enabled. Otherwise, it will throw.
+  bool get debugDisposed {
+    late bool disposed;
+    assert(() {
+      disposed = _debugDisposed;
+      return true;
+    }());
+    return disposed;
+  }
+
+  /// Releases the chunks and the decoded rows held by this object. No further
+  /// images are reported after this method is called.
+  ///
+  /// Images that were already passed to [onImage] are not affected.
+  void dispose() {
+    assert(() {
+      assert(!_debugDisposed);
+      _debugDisposed = true;
+      return true;
+    }());
+    _dispose();
+  }
+
+  /// This can't be a leaf call because the native function calls Dart API
+  /// (Dart_SetNativeInstanceField).
+  @Native<Void Function(Pointer<Void>)>(symbol: 'StreamingImageDecoder::dispose')
+  external void _dispose();
+}
+
 /// Convert an array of pixel values into an [Image] object.
 ///
 /// The `pixels` parameter is the pixel data. They are packed in bytes in the
@@ -6809,6 +6928,30 @@ abstract class ImageDescriptor {
   /// If either targetWidth or targetHeight is less than or equal to zero, it
   /// will be treated as if it is null.
   Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight});
+
+  /// Creates a [Codec] object which decodes only a region of the image to an
+  /// [Image].
+  ///
+  /// The region is given in pixels, in the coordinates of the image described
+  /// by [width] and [height], and must lie within the image. Only every
+  /// `sampleSize`th pixel of the region is decoded in each direction, so the
+  /// decoded image is `sampleSize` times smaller than the region, but at
+  /// least one pixel wide and high.
+  ///
+  /// For formats that support it, such as JPEG, PNG and WebP, only the rows
+  /// and columns of the image that are needed for the region are decoded.
+  /// This lets a viewer of a very large image decode the visible tiles
+  /// without ever holding the full image in memory. The codec decodes the
+  /// first frame of animated images.
+  ///
+  /// This is only supported for [encoded] images, and not on the Web.
+  Future<Codec> instantiateRegionCodec({
+    required int left,
+    required int top,
+    required int width,
+    required int height,
+    int sampleSize = 1,
+  });
 }
 
 base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements ImageDescriptor {
@@ -6899,6 +7042,25 @@ base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements Im
 
   @Native<Void Function(Pointer<Void>, Handle, Int32, Int32)>(symbol: 'ImageDescriptor::instantiateCodec')
   external void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight);
+
+  @override
+  Future<Codec> instantiateRegionCodec({
+    required int left,
+    required int top,
+    required int width,
+    required int height,
+    int sampleSize = 1,
+  }) async {
+    final Codec codec = _NativeCodec._();
+    final String? error = _instantiateRegionCodec(codec, left, top, width, height, sampleSize);
+    if (error != null) {
+      throw Exception(error);
+    }
+    return codec;
+  }
+
+  @Native<Handle Function(Pointer<Void>, Handle, Int32, Int32, Int32, Int32, Int32)>(symbol: 'ImageDescriptor::instantiateRegionCodec')
+  external String? _instantiateRegionCodec(Codec outCodec, int left, int top, int width, int height, int sampleSize);
 }
 
 /// Generic callback signature, used by [_futurize].
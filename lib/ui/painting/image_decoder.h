@@ -13,6 +13,7 @@
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
 
 namespace flutter {
 
@@ -44,6 +45,21 @@ class ImageDecoder {
                       uint32_t target_height,
                       const ImageResult& result) = 0;
 
+  using IncrementalImageResult =
+      std::function<void(sk_sp<DlImage>,
+                         IncrementalImageDecoder::Status,
+                         std::string)>;
+
+  // Decodes as much of the image as the chunks appended to the |decoder| so
+  // far allow, on a worker thread, and uploads the rows decoded so far like
+  // |Decode| does. The callback is invoked on the UI thread with the status
+  // of the decode. The image is null if no new rows were decoded or if the
+  // upload failed, in which case the string describes the failure. Only one
+  // decode of a given |decoder| may be in progress at a time.
+  virtual void DecodeIncrementally(
+      std::shared_ptr<IncrementalImageDecoder> decoder,
+      const IncrementalImageResult& result) = 0;
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  protected:
@@ -474,6 +474,67 @@ ImageDecoderImpeller::UploadTextureToStorage(
                         std::string());
 }
 
+// Uploads the result of a decompression with the fastest method that the
+// context supports. Must be called on the IO thread.
+static std::pair<sk_sp<DlImage>, std::string> UploadDecompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    const DecompressResult& bitmap_result,
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch) {
+  if (!kShouldUseMallocDeviceBuffer &&
+      context->GetCapabilities()->SupportsBufferToTextureBlits()) {
+    return ImageDecoderImpeller::UploadTextureToPrivate(
+        context, bitmap_result.device_buffer, bitmap_result.image_info,
+        bitmap_result.sk_bitmap, gpu_disabled_switch);
+  }
+  return ImageDecoderImpeller::UploadTextureToStorage(
+      context, bitmap_result.sk_bitmap, gpu_disabled_switch,
+      impeller::StorageMode::kDevicePrivate,
+      /*create_mips=*/true);
+}
+
+// Copies the rows of an incremental decode into a bitmap that is backed by a
+// device buffer, scaling it down if it exceeds the maximum texture size.
+static DecompressResult CopyIncrementalImage(
+    const sk_sp<SkImage>& image,
+    impeller::ISize max_texture_size,
+    const std::shared_ptr<impeller::Allocator>& allocator) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  SkPixmap source;
+  if (!image || !image->peekPixels(&source)) {
+    return DecompressResult{.decode_error = "Could not read decoded rows."};
+  }
+
+  const SkISize target_size = SkISize::Make(
+      std::min(static_cast<int32_t>(max_texture_size.width), image->width()),
+      std::min(static_cast<int32_t>(max_texture_size.height),
+               image->height()));
+  auto bitmap = std::make_shared<SkBitmap>();
+  bitmap->setInfo(image->imageInfo()
+                      .makeDimensions(target_size)
+                      .makeColorType(kRGBA_8888_SkColorType));
+  auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
+  if (!bitmap->tryAllocPixels(bitmap_allocator.get())) {
+    std::string decode_error(
+        "Could not allocate intermediate for incremental decode.");
+    FML_DLOG(ERROR) << decode_error;
+    return DecompressResult{.decode_error = decode_error};
+  }
+  if (!source.scalePixels(
+          bitmap->pixmap(),
+          SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone))) {
+    return DecompressResult{.decode_error = "Could not copy decoded rows."};
+  }
+  bitmap->setImmutable();
+
+  auto buffer = bitmap_allocator->GetDeviceBuffer();
+  if (!buffer) {
+    return DecompressResult{.decode_error = "Unable to get device buffer"};
+  }
+  return DecompressResult{.device_buffer = buffer,
+                          .sk_bitmap = bitmap,
+                          .image_info = bitmap->info()};
+}
+
 // |ImageDecoder|
 void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                                   uint32_t target_width,
@@ -520,21 +581,9 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         }
         auto upload_texture_and_invoke_result = [result, context, bitmap_result,
                                                  gpu_disabled_switch]() {
-          sk_sp<DlImage> image;
-          std::string decode_error;
-          if (!kShouldUseMallocDeviceBuffer &&
-              context->GetCapabilities()->SupportsBufferToTextureBlits()) {
-            std::tie(image, decode_error) = UploadTextureToPrivate(
-                context, bitmap_result.device_buffer, bitmap_result.image_info,
-                bitmap_result.sk_bitmap, gpu_disabled_switch);
-            result(image, decode_error);
-          } else {
-            std::tie(image, decode_error) = UploadTextureToStorage(
-                context, bitmap_result.sk_bitmap, gpu_disabled_switch,
-                impeller::StorageMode::kDevicePrivate,
-                /*create_mips=*/true);
-            result(image, decode_error);
-          }
+          auto [image, decode_error] = UploadDecompressedTexture(
+              context, bitmap_result, gpu_disabled_switch);
+          result(image, decode_error);
         };
         // TODO(jonahwilliams):
         // https://github.com/flutter/flutter/issues/123058 Technically we
@@ -545,6 +594,57 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
       });
 }
 
+// |ImageDecoder|
+void ImageDecoderImpeller::DecodeIncrementally(
+    std::shared_ptr<IncrementalImageDecoder> decoder,
+    const IncrementalImageResult& p_result) {
+  FML_DCHECK(decoder);
+  FML_DCHECK(p_result);
+
+  // Wrap the result callback so that it can be invoked from any thread.
+  IncrementalImageResult result =
+      [p_result, ui_runner = runners_.GetUITaskRunner()](
+          auto image, auto status, auto decode_error) {
+        ui_runner->PostTask([p_result, image, status, decode_error]() {
+          p_result(std::move(image), status, decode_error);
+        });
+      };
+
+  concurrent_task_runner_->PostTask(
+      [decoder = std::move(decoder),            //
+       context = context_.get(),                //
+       io_runner = runners_.GetIOTaskRunner(),  //
+       result,                                  //
+       gpu_disabled_switch = gpu_disabled_switch_]() {
+        // Always decode on the concurrent runner.
+        const int decoded_rows = decoder->GetDecodedRowCount();
+        const IncrementalImageDecoder::Status status = decoder->Decode();
+        if (decoder->GetDecodedRowCount() == decoded_rows) {
+          result(nullptr, status, std::string());
+          return;
+        }
+        if (!context) {
+          result(nullptr, status, "No Impeller context is available");
+          return;
+        }
+
+        auto bitmap_result = CopyIncrementalImage(
+            decoder->GetImage(),
+            context->GetResourceAllocator()->GetMaxTextureSizeSupported(),
+            context->GetResourceAllocator());
+        if (!bitmap_result.device_buffer) {
+          result(nullptr, status, bitmap_result.decode_error);
+          return;
+        }
+        io_runner->PostTask([result, status, context, bitmap_result,
+                             gpu_disabled_switch]() {
+          auto [image, decode_error] = UploadDecompressedTexture(
+              context, bitmap_result, gpu_disabled_switch);
+          result(image, status, decode_error);
+        });
+      });
+}
+
 ImpellerAllocator::ImpellerAllocator(
     std::shared_ptr<impeller::Allocator> allocator)
     : allocator_(std::move(allocator)) {}
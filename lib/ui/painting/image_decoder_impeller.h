@@ -61,6 +61,10 @@ class ImageDecoderImpeller final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  // |ImageDecoder|
+  void DecodeIncrementally(std::shared_ptr<IncrementalImageDecoder> decoder,
+                           const IncrementalImageResult& result) override;
+
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
       SkISize target_size,
@@ -216,6 +216,32 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+// Uploads a decompressed image to the GPU, or returns it as-is if there is
+// no resource context. Must be called on the IO thread.
+static SkiaGPUObject<SkImage> UploadDecompressedImage(
+    sk_sp<SkImage> decompressed,
+    const fml::WeakPtr<IOManager>& io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  if (!io_manager) {
+    FML_DLOG(ERROR) << "Could not acquire IO manager.";
+    return {};
+  }
+
+  // If the IO manager does not have a resource context, the caller might not
+  // have set one or a software backend could be in use. Either way, just
+  // return the image as-is.
+  if (!io_manager->GetResourceContext()) {
+    return {std::move(decompressed), io_manager->GetSkiaUnrefQueue()};
+  }
+
+  auto uploaded = UploadRasterImage(std::move(decompressed), io_manager, flow);
+  if (!uploaded.skia_object()) {
+    FML_DLOG(ERROR) << "Could not upload image to the GPU.";
+    return {};
+  }
+  return uploaded;
+}
+
 // |ImageDecoder|
 void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                               uint32_t target_width,
@@ -298,34 +324,67 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
         io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
                                                flow =
                                                    std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_DLOG(ERROR) << "Could not acquire IO manager.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
-                   std::move(flow));
-            return;
-          }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.skia_object()) {
-            FML_DLOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
+          auto uploaded = UploadDecompressedImage(std::move(decompressed),
+                                                  io_manager, flow);
           result(std::move(uploaded), std::move(flow));
         }));
       }));
 }
 
+// |ImageDecoder|
+void ImageDecoderSkia::DecodeIncrementally(
+    std::shared_ptr<IncrementalImageDecoder> decoder,
+    const IncrementalImageResult& callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  fml::tracing::TraceFlow flow(__FUNCTION__);
+
+  FML_DCHECK(decoder);
+  FML_DCHECK(callback);
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  // Always service the callback on the UI thread.
+  auto result = [callback, ui_runner = runners_.GetUITaskRunner()](
+                    SkiaGPUObject<SkImage> image,
+                    IncrementalImageDecoder::Status status,
+                    fml::tracing::TraceFlow flow) {
+    ui_runner->PostTask(
+        fml::MakeCopyable([callback, image = std::move(image), status,
+                           flow = std::move(flow)]() mutable {
+          TRACE_EVENT0("flutter", "IncrementalImageDecodeCallback");
+          flow.End();
+          callback(DlImageGPU::Make(std::move(image)), status, {});
+        }));
+  };
+
+  concurrent_task_runner_->PostTask(
+      fml::MakeCopyable([decoder = std::move(decoder),            //
+                         io_manager = io_manager_,                //
+                         io_runner = runners_.GetIOTaskRunner(),  //
+                         result,                                  //
+                         flow = std::move(flow)                   //
+  ]() mutable {
+        // Step 1: Decode the rows that the received chunks allow.
+        // On Worker.
+
+        const int decoded_rows = decoder->GetDecodedRowCount();
+        const IncrementalImageDecoder::Status status = decoder->Decode();
+        if (decoder->GetDecodedRowCount() == decoded_rows) {
+          result({}, status, std::move(flow));
+          return;
+        }
+        sk_sp<SkImage> decompressed = decoder->GetImage();
+
+        // Step 2: Upload the rows decoded so far to the GPU.
+        // On IO Thread.
+
+        io_runner->PostTask(fml::MakeCopyable(
+            [io_manager, decompressed = std::move(decompressed), status,
+             result, flow = std::move(flow)]() mutable {
+              auto uploaded = UploadDecompressedImage(std::move(decompressed),
+                                                      io_manager, flow);
+              result(std::move(uploaded), status, std::move(flow));
+            }));
+      }));
+}
+
 }  // namespace flutter
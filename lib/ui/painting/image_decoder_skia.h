@@ -25,6 +25,10 @@ class ImageDecoderSkia final : public ImageDecoder {
               uint32_t target_height,
               const ImageResult& result) override;
 
+  // |ImageDecoder|
+  void DecodeIncrementally(std::shared_ptr<IncrementalImageDecoder> decoder,
+                           const IncrementalImageResult& result) override;
+
   static sk_sp<SkImage> ImageFromCompressedData(
       ImageDescriptor* descriptor,
       uint32_t target_width,
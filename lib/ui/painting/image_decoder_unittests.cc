@@ -313,6 +313,62 @@ TEST_F(ImageDecoderFixtureTest, ValidImageResultsInSuccess) {
   latch.Wait();
 }
 
+TEST_F(ImageDecoderFixtureTest, IncrementalDecodeResultsInSuccess) {
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  fml::AutoResetWaitableEvent latch;
+
+  std::unique_ptr<TestIOManager> io_manager;
+
+  auto release_io_manager = [&]() {
+    io_manager.reset();
+    latch.Signal();
+  };
+  auto decode_image = [&]() {
+    Settings settings;
+    std::unique_ptr<ImageDecoder> image_decoder = ImageDecoder::Make(
+        settings, runners, loop->GetTaskRunner(),
+        io_manager->GetWeakIOManager(), std::make_shared<fml::SyncSwitch>());
+
+    auto data = flutter::testing::OpenFixtureAsSkData("DashInNooglerHat.jpg");
+    ASSERT_TRUE(data);
+    const SkISize dimensions = SkCodec::MakeFromData(data)->dimensions();
+
+    auto decoder = std::make_shared<IncrementalImageDecoder>();
+    const size_t half = data->size() / 2;
+    decoder->AppendData(SkData::MakeSubset(data.get(), 0, half));
+    decoder->AppendData(
+        SkData::MakeSubset(data.get(), half, data->size() - half));
+    decoder->SetDataComplete();
+
+    ImageDecoder::IncrementalImageResult callback =
+        [&](const sk_sp<DlImage>& image, IncrementalImageDecoder::Status status,
+            const std::string& decode_error) {
+          ASSERT_TRUE(runners.GetUITaskRunner()->RunsTasksOnCurrentThread());
+          EXPECT_EQ(status, IncrementalImageDecoder::Status::kComplete);
+          EXPECT_TRUE(decode_error.empty());
+          ASSERT_TRUE(image && image->skia_image());
+          EXPECT_EQ(image->dimensions(), dimensions);
+          runners.GetIOTaskRunner()->PostTask(release_io_manager);
+        };
+    image_decoder->DecodeIncrementally(decoder, callback);
+  };
+
+  auto set_up_io_manager_and_decode = [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+    runners.GetUITaskRunner()->PostTask(decode_image);
+  };
+
+  runners.GetIOTaskRunner()->PostTask(set_up_io_manager_and_decode);
+  latch.Wait();
+}
+
 TEST_F(ImageDecoderFixtureTest, ImpellerUploadToSharedNoGpu) {
 #if !IMPELLER_SUPPORTS_RENDERING
   GTEST_SKIP() << "Impeller only test.";
@@ -792,6 +848,170 @@ TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   assert_image(decode(300, 100), {});
 }
 
+namespace {
+
+// Expects that |image| holds the pixels of |expected| within |subset|.
+void ExpectImageMatchesSubset(const sk_sp<SkImage>& image,
+                              const sk_sp<SkImage>& expected,
+                              const SkIRect& subset) {
+  ASSERT_TRUE(image);
+  ASSERT_EQ(image->dimensions(), subset.size());
+  SkBitmap actual_pixels;
+  SkBitmap expected_pixels;
+  ASSERT_TRUE(actual_pixels.tryAllocPixels(image->imageInfo()));
+  ASSERT_TRUE(expected_pixels.tryAllocPixels(image->imageInfo()));
+  ASSERT_TRUE(image->readPixels(actual_pixels.pixmap(), 0, 0));
+  ASSERT_TRUE(expected->readPixels(expected_pixels.pixmap(), subset.left(),
+                                   subset.top()));
+  for (int y = 0; y < subset.height(); y++) {
+    for (int x = 0; x < subset.width(); x++) {
+      ASSERT_EQ(actual_pixels.getColor(x, y), expected_pixels.getColor(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ImageDecoderTest, SubsetDecodingMatchesFullDecode) {
+  auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto full_image = generator->GetImage();
+  ASSERT_TRUE(full_image);
+
+  const SkIRect subset = SkIRect::MakeXYWH(30, 50, 100, 70);
+  ExpectImageMatchesSubset(generator->GetSubsetImage(subset, 1), full_image,
+                           subset);
+
+  auto sampled = generator->GetSubsetImage(subset, 2);
+  ASSERT_TRUE(sampled);
+  ASSERT_EQ(sampled->dimensions(), SkISize::Make(50, 35));
+
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(std::move(data),
+                                                         std::move(generator));
+  auto region = descriptor->MakeRegion(subset, 1);
+  ASSERT_TRUE(region);
+  ASSERT_EQ(region->image_info().dimensions(), subset.size());
+  ExpectImageMatchesSubset(region->image(), full_image, subset);
+
+  SkBitmap region_pixels;
+  ASSERT_TRUE(region_pixels.tryAllocPixels(region->image_info()));
+  ASSERT_TRUE(region->get_pixels(region_pixels.pixmap()));
+  region_pixels.setImmutable();
+  ExpectImageMatchesSubset(SkImages::RasterFromBitmap(region_pixels),
+                           full_image, subset);
+
+  auto sampled_region = descriptor->MakeRegion(subset, 2);
+  ASSERT_TRUE(sampled_region);
+  ASSERT_EQ(sampled_region->image_info().dimensions(), SkISize::Make(50, 35));
+  EXPECT_FALSE(region->MakeRegion(subset, 1));
+  EXPECT_FALSE(descriptor->MakeRegion(SkIRect::MakeEmpty(), 1));
+  EXPECT_FALSE(descriptor->MakeRegion(subset, 0));
+}
+
+namespace {
+
+// Forwards to |generator| and records the size of the last full decode.
+class RecordingImageGenerator : public ImageGenerator {
+ public:
+  explicit RecordingImageGenerator(std::unique_ptr<ImageGenerator> generator)
+      : generator_(std::move(generator)) {}
+
+  const SkImageInfo& GetInfo() override { return generator_->GetInfo(); }
+
+  unsigned int GetFrameCount() const override {
+    return generator_->GetFrameCount();
+  }
+
+  unsigned int GetPlayCount() const override {
+    return generator_->GetPlayCount();
+  }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override {
+    return generator_->GetFrameInfo(frame_index);
+  }
+
+  SkISize GetScaledDimensions(float scale) override {
+    return generator_->GetScaledDimensions(scale);
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    last_decode_size_ = info.dimensions();
+    return generator_->GetPixels(info, pixels, row_bytes, frame_index,
+                                 prior_frame);
+  }
+
+  SkISize last_decode_size() const { return last_decode_size_; }
+
+ private:
+  std::unique_ptr<ImageGenerator> generator_;
+  SkISize last_decode_size_ = SkISize::MakeEmpty();
+};
+
+}  // namespace
+
+TEST(ImageDecoderTest, SubsetDecodingFallbackDecodesAtSampledSize) {
+  auto data = flutter::testing::OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ASSERT_TRUE(data);
+  auto codec = SkCodec::MakeFromData(data);
+  ASSERT_TRUE(codec);
+  // Without the encoded data, the generator cannot decode regions natively.
+  RecordingImageGenerator generator(
+      std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec)));
+  const SkISize size = generator.GetInfo().dimensions();
+
+  const SkIRect subset =
+      SkIRect::MakeXYWH(size.width() / 4, size.height() / 4,
+                        size.width() / 2, size.height() / 2);
+  auto sampled = generator.GetSubsetImage(subset, 4);
+  ASSERT_TRUE(sampled);
+  EXPECT_EQ(sampled->dimensions(),
+            ImageGenerator::GetSubsetDimensions(subset, 4));
+  EXPECT_LT(generator.last_decode_size().width(), size.width());
+  EXPECT_LT(generator.last_decode_size().height(), size.height());
+}
+
+TEST(ImageDecoderTest, SubsetDecodingPreservesExifOrientation) {
+  auto data = flutter::testing::OpenFixtureAsSkData("Horizontal.jpg");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  auto full_image = generator->GetImage();
+  ASSERT_TRUE(full_image);
+  ASSERT_EQ(full_image->dimensions(), SkISize::Make(600, 200));
+
+  // The subset is in the coordinates of the reoriented image.
+  const SkIRect subset = SkIRect::MakeXYWH(400, 20, 150, 100);
+  ExpectImageMatchesSubset(generator->GetSubsetImage(subset, 1), full_image,
+                           subset);
+}
+
+TEST(ImageDecoderTest, SubsetDecodingRejectsInvalidSubsets) {
+  auto data = flutter::testing::OpenFixtureAsSkData("heart_end.png");
+  ASSERT_TRUE(data);
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+  const SkISize size = generator->GetInfo().dimensions();
+
+  EXPECT_FALSE(generator->GetSubsetImage(SkIRect::MakeEmpty(), 1));
+  EXPECT_FALSE(generator->GetSubsetImage(
+      SkIRect::MakeXYWH(size.width() - 10, 0, 20, 20), 1));
+  EXPECT_FALSE(generator->GetSubsetImage(SkIRect::MakeWH(20, 20), 0));
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecCanBeCollectedBeforeIOTasksFinish) {
   // This test verifies that the MultiFrameCodec safely shares state between
@@ -957,6 +1177,105 @@ TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDidAccessGpuDisabledSyncSwitch) {
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecPrefetchesFramesWithinBudget) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto vm_data = vm_ref.GetVMData();
+
+  auto gif_mapping = flutter::testing::OpenFixtureAsSkData("hello_loop_2.gif");
+
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> gif_generator =
+      registry.CreateCompatibleGenerator(gif_mapping);
+  ASSERT_TRUE(gif_generator);
+  ASSERT_GT(gif_generator->GetFrameCount(), 2u);
+
+  // Leave room for exactly one prefetched frame.
+  const size_t frame_bytes = gif_generator->GetInfo()
+                                 .makeColorType(kN32_SkColorType)
+                                 .computeMinByteSize();
+  MultiFrameCodec::SetPrefetchLimits(2, frame_bytes);
+  ASSERT_EQ(MultiFrameCodec::GetPrefetchedBytes(), 0u);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+
+  std::unique_ptr<TestIOManager> io_manager;
+  fml::RefPtr<MultiFrameCodec> codec;
+  fml::AutoResetWaitableEvent latch;
+
+  auto validate_frame_callback = [&latch](Dart_NativeArguments args) {
+    EXPECT_FALSE(Dart_IsNull(Dart_GetNativeArgument(args, 0)));
+    latch.Signal();
+  };
+
+  AddNativeCallback("ValidateFrameCallback",
+                    CREATE_NATIVE_ENTRY(validate_frame_callback));
+  // Setup the IO manager.
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  auto get_next_frame = [&]() {
+    PostTaskSync(runners.GetUITaskRunner(), [&]() {
+      EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+        Dart_Handle library = Dart_RootLibrary();
+        if (Dart_IsError(library)) {
+          return false;
+        }
+        Dart_Handle closure =
+            Dart_GetField(library, Dart_NewStringFromCString("frameCallback"));
+        if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+          return false;
+        }
+        if (!codec) {
+          codec =
+              fml::MakeRefCounted<MultiFrameCodec>(std::move(gif_generator));
+        }
+        codec->getNextFrame(closure);
+        return true;
+      }));
+    });
+    latch.Wait();
+    // The isolate has no concurrent task runner, so the prefetch is posted to
+    // the IO task runner by the task that decoded the frame. Wait for that
+    // task to finish, and then for the prefetch.
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+    PostTaskSync(runners.GetIOTaskRunner(), [] {});
+  };
+
+  get_next_frame();
+  EXPECT_EQ(MultiFrameCodec::GetPrefetchedBytes(), frame_bytes);
+
+  // The prefetched frame is handed out, and the one after it takes its place.
+  get_next_frame();
+  EXPECT_EQ(MultiFrameCodec::GetPrefetchedBytes(), frame_bytes);
+
+  // Destroy the Isolate
+  isolate = nullptr;
+
+  // Destroy the MultiFrameCodec, which releases its prefetched frames.
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { codec = nullptr; });
+  EXPECT_EQ(MultiFrameCodec::GetPrefetchedBytes(), 0u);
+
+  // Destroy the IO manager
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+
+  MultiFrameCodec::SetPrefetchLimits(
+      MultiFrameCodec::kDefaultPrefetchFrameCount,
+      MultiFrameCodec::kDefaultPrefetchBudgetBytes);
+}
+
 TEST_F(ImageDecoderFixtureTest,
        MultiFrameCodecProducesATextureEvenIfGPUIsDisabledOnImpeller) {
   auto settings = CreateSettingsForFixture();
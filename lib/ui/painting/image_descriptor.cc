@@ -19,6 +19,11 @@ IMPLEMENT_WRAPPERTYPEINFO(ui, ImageDescriptor);
 
 const SkImageInfo ImageDescriptor::CreateImageInfo() const {
   FML_DCHECK(generator_);
+  if (region_) {
+    return generator_->GetInfo().makeDimensions(
+        ImageGenerator::GetSubsetDimensions(region_->subset,
+                                            region_->sample_size));
+  }
   return generator_->GetInfo();
 }
 
@@ -27,6 +32,7 @@ ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
                                  std::optional<size_t> row_bytes)
     : buffer_(std::move(buffer)),
       generator_(nullptr),
+      region_(std::nullopt),
       image_info_(image_info),
       row_bytes_(row_bytes) {}
 
@@ -34,6 +40,17 @@ ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
                                  std::shared_ptr<ImageGenerator> generator)
     : buffer_(std::move(buffer)),
       generator_(std::move(generator)),
+      region_(std::nullopt),
+      image_info_(CreateImageInfo()),
+      row_bytes_(std::nullopt) {}
+
+ImageDescriptor::ImageDescriptor(sk_sp<SkData> buffer,
+                                 std::shared_ptr<ImageGenerator> generator,
+                                 const SkIRect& subset,
+                                 int sample_size)
+    : buffer_(std::move(buffer)),
+      generator_(std::move(generator)),
+      region_(Region{subset, sample_size}),
       image_info_(CreateImageInfo()),
       row_bytes_(std::nullopt) {}
 
@@ -121,12 +138,53 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
 
+Dart_Handle ImageDescriptor::instantiateRegionCodec(Dart_Handle codec_handle,
+                                                    int left,
+                                                    int top,
+                                                    int width,
+                                                    int height,
+                                                    int sample_size) {
+  if (!generator_) {
+    return tonic::ToDart("Only encoded images can be decoded by region");
+  }
+  auto region =
+      MakeRegion(SkIRect::MakeXYWH(left, top, width, height), sample_size);
+  if (!region) {
+    return tonic::ToDart(
+        "The region must be non-empty and within the bounds of the image, "
+        "and the sample size must be at least 1");
+  }
+  auto ui_codec = fml::MakeRefCounted<SingleFrameCodec>(
+      region, region->width(), region->height());
+  ui_codec->AssociateWithDartWrapper(codec_handle);
+  return Dart_Null();
+}
+
+fml::RefPtr<ImageDescriptor> ImageDescriptor::MakeRegion(
+    const SkIRect& subset,
+    int sample_size) const {
+  if (!generator_ || region_ || sample_size < 1 || subset.isEmpty() ||
+      !SkIRect::MakeSize(image_info_.dimensions()).contains(subset)) {
+    return nullptr;
+  }
+  return fml::MakeRefCounted<ImageDescriptor>(buffer_, generator_, subset,
+                                              sample_size);
+}
+
 sk_sp<SkImage> ImageDescriptor::image() const {
+  if (region_) {
+    return generator_->GetSubsetImage(region_->subset, region_->sample_size);
+  }
   return generator_->GetImage();
 }
 
 bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
   FML_DCHECK(generator_);
+  if (region_) {
+    return generator_->GetSubsetPixels(pixmap.info(), pixmap.writable_addr(),
+                                       pixmap.rowBytes(), region_->subset,
+                                       region_->sample_size);
+  }
   return generator_->GetPixels(pixmap.info(), pixmap.writable_addr(),
                                pixmap.rowBytes());
 }
@@ -62,6 +62,21 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   /// @brief  Associates a flutter::Codec object with the dart.ui Codec handle.
   void instantiateCodec(Dart_Handle codec, int target_width, int target_height);
 
+  /// @brief  Associates a flutter::Codec object that decodes only a region of
+  ///         this image, downsampled by `sample_size`, with the dart.ui Codec
+  ///         handle. The codec decodes from a descriptor of the region, so
+  ///         the full image is never decoded if the `ImageGenerator` supports
+  ///         region decoding.
+  /// @return An error message if the region is not valid for this image, or
+  ///         null.
+  /// @see    `ImageGenerator::GetSubsetPixels`
+  Dart_Handle instantiateRegionCodec(Dart_Handle codec,
+                                     int left,
+                                     int top,
+                                     int width,
+                                     int height,
+                                     int sample_size);
+
   /// @brief  The width of this image, EXIF oriented if applicable.
   int width() const { return image_info_.width(); }
 
@@ -100,7 +115,7 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         `ImageGenerator` that can perform efficient subpixel scaling.
   /// @see    `ImageGenerator::GetScaledDimensions`
   SkISize get_scaled_dimensions(float scale) {
-    if (generator_) {
+    if (generator_ && !region_) {
       return generator_->GetScaledDimensions(scale);
     }
     return image_info_.dimensions();
@@ -110,6 +125,14 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Creates a descriptor for a region of this encoded image,
+  ///         downsampled by `sample_size`. The region descriptor decodes only
+  ///         that region when asked for its image or pixels.
+  /// @return The region descriptor, or nullptr if this descriptor is not for
+  ///         encoded data or the region is not within the image.
+  fml::RefPtr<ImageDescriptor> MakeRegion(const SkIRect& subset,
+                                          int sample_size) const;
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
@@ -122,9 +145,20 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
                   std::optional<size_t> row_bytes);
   ImageDescriptor(sk_sp<SkData> buffer,
                   std::shared_ptr<ImageGenerator> generator);
+  ImageDescriptor(sk_sp<SkData> buffer,
+                  std::shared_ptr<ImageGenerator> generator,
+                  const SkIRect& subset,
+                  int sample_size);
+
+  struct Region {
+    SkIRect subset;
+    int sample_size;
+  };
 
   sk_sp<SkData> buffer_;
   std::shared_ptr<ImageGenerator> generator_;
+  // Set for descriptors of a region of an encoded image.
+  const std::optional<Region> region_;
   const SkImageInfo image_info_;
   std::optional<size_t> row_bytes_;
 
@@ -4,6 +4,7 @@
 
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -11,6 +12,9 @@
 #include "third_party/skia/include/codec/SkPixmapUtils.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSamplingOptions.h"
 
 namespace flutter {
 
@@ -35,6 +39,90 @@ sk_sp<SkImage> ImageGenerator::GetImage() {
   return SkImages::RasterFromBitmap(bitmap);
 }
 
+SkISize ImageGenerator::GetSubsetDimensions(const SkIRect& subset,
+                                            int sample_size) {
+  return SkISize::Make(std::max(subset.width() / sample_size, 1),
+                       std::max(subset.height() / sample_size, 1));
+}
+
+bool ImageGenerator::IsValidSubset(const SkImageInfo& info,
+                                   const SkIRect& subset,
+                                   int sample_size) {
+  return sample_size >= 1 && !subset.isEmpty() &&
+         SkIRect::MakeSize(GetInfo().dimensions()).contains(subset) &&
+         info.dimensions() == GetSubsetDimensions(subset, sample_size);
+}
+
+bool ImageGenerator::GetSubsetPixels(const SkImageInfo& info,
+                                     void* pixels,
+                                     size_t row_bytes,
+                                     const SkIRect& subset,
+                                     int sample_size) {
+  if (!IsValidSubset(info, subset, sample_size)) {
+    return false;
+  }
+  // Decoding at a scaled down size, when the decoder supports it, avoids
+  // holding the full resolution image just to sample it afterwards.
+  const SkISize full_size = GetInfo().dimensions();
+  SkISize decode_size = GetScaledDimensions(1.0f / sample_size);
+  if (decode_size.width() < full_size.width() / sample_size ||
+      decode_size.height() < full_size.height() / sample_size ||
+      decode_size.width() > full_size.width() ||
+      decode_size.height() > full_size.height()) {
+    decode_size = full_size;
+  }
+
+  SkBitmap bitmap;
+  SkImageInfo decode_info = info.makeDimensions(decode_size);
+  if (!bitmap.tryAllocPixels(decode_info)) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                    << decode_info.computeMinByteSize() << "B";
+    return false;
+  }
+  if (!GetPixels(bitmap.info(), bitmap.getPixels(), bitmap.rowBytes())) {
+    FML_DLOG(ERROR) << "Failed to get pixels for image.";
+    return false;
+  }
+
+  const float scale_x =
+      static_cast<float>(decode_size.width()) / full_size.width();
+  const float scale_y =
+      static_cast<float>(decode_size.height()) / full_size.height();
+  SkIRect region =
+      SkRect::MakeLTRB(subset.left() * scale_x, subset.top() * scale_y,
+                       subset.right() * scale_x, subset.bottom() * scale_y)
+          .roundOut();
+  SkPixmap region_pixmap;
+  if (!bitmap.pixmap().extractSubset(&region_pixmap, region)) {
+    return false;
+  }
+  return region_pixmap.scalePixels(
+      SkPixmap(info, pixels, row_bytes),
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone));
+}
+
+sk_sp<SkImage> ImageGenerator::GetSubsetImage(const SkIRect& subset,
+                                              int sample_size) {
+  if (sample_size < 1 || subset.isEmpty()) {
+    return nullptr;
+  }
+  SkImageInfo info =
+      GetInfo().makeDimensions(GetSubsetDimensions(subset, sample_size));
+
+  SkBitmap bitmap;
+  if (!bitmap.tryAllocPixels(info)) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                    << info.computeMinByteSize() << "B";
+    return nullptr;
+  }
+  if (!GetSubsetPixels(bitmap.info(), bitmap.getPixels(), bitmap.rowBytes(),
+                       subset, sample_size)) {
+    return nullptr;
+  }
+  bitmap.setImmutable();
+  return SkImages::RasterFromBitmap(bitmap);
+}
+
 BuiltinSkiaImageGenerator::~BuiltinSkiaImageGenerator() = default;
 
 BuiltinSkiaImageGenerator::BuiltinSkiaImageGenerator(
@@ -103,7 +191,15 @@ BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
 
 BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
     sk_sp<SkData> buffer)
-    : codec_(SkCodec::MakeFromData(std::move(buffer)).release()) {
+    : codec_(SkCodec::MakeFromData(buffer).release()),
+      data_(std::move(buffer)) {
+  image_info_ = getInfoIncludingExif(codec_.get());
+}
+
+BuiltinSkiaCodecImageGenerator::BuiltinSkiaCodecImageGenerator(
+    std::unique_ptr<SkCodec> codec,
+    sk_sp<SkData> data)
+    : codec_(std::move(codec)), data_(std::move(data)) {
   image_info_ = getInfoIncludingExif(codec_.get());
 }
 
@@ -188,13 +284,107 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return SkPixmapUtils::Orient(output_pixmap, temp_pixmap, origin);
 }
 
+bool BuiltinSkiaCodecImageGenerator::GetSubsetPixels(const SkImageInfo& info,
+                                                     void* pixels,
+                                                     size_t row_bytes,
+                                                     const SkIRect& subset,
+                                                     int sample_size) {
+  if (!IsValidSubset(info, subset, sample_size)) {
+    return false;
+  }
+  if (!data_) {
+    return ImageGenerator::GetSubsetPixels(info, pixels, row_bytes, subset,
+                                           sample_size);
+  }
+
+  // Regions are decoded in the coordinates of the encoded image, and then
+  // reoriented like |GetPixels| does for the full image.
+  const SkEncodedOrigin origin = codec_->getOrigin();
+  SkIRect encoded_subset = subset;
+  SkImageInfo encoded_info = info;
+  if (origin != kTopLeft_SkEncodedOrigin) {
+    SkMatrix inverse;
+    if (!SkEncodedOriginToMatrix(origin, image_info_.width(),
+                                 image_info_.height())
+             .invert(&inverse)) {
+      return false;
+    }
+    encoded_subset = inverse.mapRect(SkRect::Make(subset)).round();
+    if (SkEncodedOriginSwapsWidthHeight(origin)) {
+      encoded_info = SkPixmapUtils::SwapWidthHeight(encoded_info);
+    }
+  }
+
+  std::scoped_lock lock(region_codec_mutex_);
+  if (!region_codec_) {
+    region_codec_ = SkAndroidCodec::MakeFromData(data_);
+  }
+  // Some decoders can only start a region on a block boundary, in which case
+  // the subset is grown to the supported region and cropped afterwards.
+  SkIRect supported_subset = encoded_subset;
+  if (!region_codec_ || !region_codec_->getSupportedSubset(&supported_subset)) {
+    return ImageGenerator::GetSubsetPixels(info, pixels, row_bytes, subset,
+                                           sample_size);
+  }
+  SkISize size =
+      region_codec_->getSampledSubsetDimensions(sample_size, supported_subset);
+
+  // Decode straight into the output buffer unless the pixels still have to
+  // be cropped or reoriented.
+  SkPixmap output_pixmap(info, pixels, row_bytes);
+  SkPixmap decoded_pixmap;
+  SkBitmap decoded_bitmap;
+  if (origin == kTopLeft_SkEncodedOrigin &&
+      supported_subset == encoded_subset && size == info.dimensions()) {
+    decoded_pixmap = output_pixmap;
+  } else {
+    SkImageInfo decoded_info = encoded_info.makeDimensions(size);
+    if (!decoded_bitmap.tryAllocPixels(decoded_info)) {
+      FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                      << decoded_info.computeMinByteSize() << "B";
+      return false;
+    }
+    decoded_pixmap = decoded_bitmap.pixmap();
+  }
+
+  SkAndroidCodec::AndroidOptions options;
+  options.fSampleSize = sample_size;
+  options.fSubset = &supported_subset;
+  SkCodec::Result result = region_codec_->getAndroidPixels(
+      decoded_pixmap.info(), decoded_pixmap.writable_addr(),
+      decoded_pixmap.rowBytes(), &options);
+  if (result != SkCodec::kSuccess) {
+    FML_DLOG(WARNING) << "codec could not get pixels for subset. "
+                      << SkCodec::ResultToString(result);
+    return false;
+  }
+  if (decoded_pixmap.addr() == pixels) {
+    return true;
+  }
+
+  SkPixmap cropped_pixmap;
+  SkIRect crop = SkIRect::MakeXYWH(
+      (encoded_subset.left() - supported_subset.left()) / sample_size,
+      (encoded_subset.top() - supported_subset.top()) / sample_size,
+      encoded_info.width(), encoded_info.height());
+  if (!decoded_pixmap.extractSubset(&cropped_pixmap, crop) ||
+      cropped_pixmap.dimensions() != encoded_info.dimensions()) {
+    return false;
+  }
+  if (origin == kTopLeft_SkEncodedOrigin) {
+    return cropped_pixmap.readPixels(output_pixmap);
+  }
+  return SkPixmapUtils::Orient(output_pixmap, cropped_pixmap, origin);
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
-  auto codec = SkCodec::MakeFromData(std::move(data));
+  auto codec = SkCodec::MakeFromData(data);
   if (!codec) {
     return nullptr;
   }
-  return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
+  return std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec),
+                                                          std::move(data));
 }
 
 }  // namespace flutter
@@ -5,8 +5,11 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <mutex>
 #include <optional>
+
 #include "flutter/fml/macros.h"
+#include "third_party/skia/include/codec/SkAndroidCodec.h"
 #include "third_party/skia/include/codec/SkCodec.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -139,6 +142,54 @@ class ImageGenerator {
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
   sk_sp<SkImage> GetImage();
+
+  /// @brief      The dimensions of the image that `GetSubsetPixels` and
+  ///             `GetSubsetImage` decode for `subset` and `sample_size`.
+  static SkISize GetSubsetDimensions(const SkIRect& subset, int sample_size);
+
+  /// @brief      Decode a rectangular region of the first frame of the image,
+  ///             optionally downsampled, into the given pixel buffer.
+  ///             Decoders that support region decoding only decode the rows
+  ///             and columns that are needed, so that a viewer of a very large
+  ///             image can decode the visible tiles without ever holding the
+  ///             full image in memory.
+  /// @param[in]  info         The image info of the output buffer. Its
+  ///                          dimensions must match `GetSubsetDimensions`.
+  /// @param[in]  pixels       The address for the output buffer.
+  /// @param[in]  row_bytes    The number of bytes per row in the output
+  ///                          buffer.
+  /// @param[in]  subset       The region to decode, in the coordinates of the
+  ///                          image described by `GetInfo`. It must be
+  ///                          non-empty and within the bounds of the image.
+  /// @param[in]  sample_size  Only every `sample_size`th pixel in each
+  ///                          direction is decoded. A value of 1 decodes the
+  ///                          region at full resolution.
+  /// @return     True if the region was decoded into the buffer.
+  /// @note       Like `GetPixels`, this method performs potentially long
+  ///             synchronous work and should never be executed on the UI
+  ///             thread. The default implementation decodes the full image,
+  ///             scaled down if `GetScaledDimensions` supports the sampled
+  ///             size, and then crops it. Generators that can decode regions
+  ///             natively should override it.
+  virtual bool GetSubsetPixels(const SkImageInfo& info,
+                               void* pixels,
+                               size_t row_bytes,
+                               const SkIRect& subset,
+                               int sample_size);
+
+  /// @brief   Creates an immutable image of a region of the first frame.
+  /// @see     `GetSubsetPixels`
+  /// @return  An image of the region, `sample_size` times smaller than
+  ///          `subset` in each direction, or nullptr if the region could not
+  ///          be decoded.
+  sk_sp<SkImage> GetSubsetImage(const SkIRect& subset, int sample_size);
+
+ protected:
+  /// @brief  Whether `subset` and `sample_size` are valid arguments for
+  ///         `GetSubsetPixels` with an output buffer described by `info`.
+  bool IsValidSubset(const SkImageInfo& info,
+                     const SkIRect& subset,
+                     int sample_size);
 };
 
 class BuiltinSkiaImageGenerator : public ImageGenerator {
@@ -186,6 +237,11 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
 
   explicit BuiltinSkiaCodecImageGenerator(std::unique_ptr<SkCodec> codec);
 
+  /// Creates a generator for a codec that decodes `data`. The data is kept
+  /// so that regions of the image can be decoded separately.
+  BuiltinSkiaCodecImageGenerator(std::unique_ptr<SkCodec> codec,
+                                 sk_sp<SkData> data);
+
   explicit BuiltinSkiaCodecImageGenerator(sk_sp<SkData> buffer);
 
   // |ImageGenerator|
@@ -212,12 +268,25 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  bool GetSubsetPixels(const SkImageInfo& info,
+                       void* pixels,
+                       size_t row_bytes,
+                       const SkIRect& subset,
+                       int sample_size) override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(BuiltinSkiaCodecImageGenerator);
   std::unique_ptr<SkCodec> codec_;
   SkImageInfo image_info_;
+  sk_sp<SkData> data_;
+  // Created on the first region decode, since it needs its own stream.
+  // Region decodes may run on several worker threads at once, so the codec
+  // is only created and used with |region_codec_mutex_| held.
+  std::mutex region_codec_mutex_;
+  std::unique_ptr<SkAndroidCodec> region_codec_;
 };
 
 }  // namespace flutter
@@ -103,14 +103,17 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
        ui_task_runner = std::move(ui_task_runner), ui_task] {
         std::unique_ptr<fml::Mapping> mapping =
             asset_manager->GetAsMapping(asset_name);
-
-        sk_sp<SkData> sk_data;
-        size_t buffer_size = 0;
-        if (mapping != nullptr) {
-          buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
-        }
+#if (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG)
+        // In debug mode assets may be served from the DevFS directory, which
+        // the tool rewrites on hot reload, so they are always copied.
+        sk_sp<SkData> sk_data =
+            mapping ? MakeSkDataWithCopy(mapping->GetMapping(),
+                                         mapping->GetSize())
+                    : nullptr;
+#else
+        sk_sp<SkData> sk_data = MakeSkDataFromAssetMapping(std::move(mapping));
+#endif  // (FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG)
+        size_t buffer_size = sk_data ? sk_data->size() : 0;
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
               ui_task(sk_data, buffer_size);
@@ -174,6 +177,8 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
         auto mapping = std::make_unique<fml::FileMapping>(fml::OpenFile(
             file_path.c_str(), false, fml::FilePermission::kRead));
 
+        // Arbitrary files may be truncated or rewritten by other processes,
+        // so their contents are copied rather than kept mapped.
         sk_sp<SkData> sk_data;
         size_t buffer_size = 0;
         if (mapping->IsValid()) {
@@ -189,6 +194,25 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromAssetMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  if (!mapping->IsDontNeedSafe() || mapping->GetMapping() == nullptr) {
+    return MakeSkDataWithCopy(mapping->GetMapping(), mapping->GetSize());
+  }
+
+  // The SkData takes ownership of the mapping and releases it on whichever
+  // thread drops the last reference, typically a decoder worker.
+  fml::Mapping* mapping_ptr = mapping.release();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(mapping_ptr->GetMapping(),
+                              mapping_ptr->GetSize(), proc, mapping_ptr);
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
@@ -6,8 +6,10 @@
 #define FLUTTER_LIB_UI_PAINTING_IMMUTABLE_BUFFER_H_
 
 #include <cstdint>
+#include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -79,6 +81,22 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
   /// Callers should not modify the returned data. This is not exposed to Dart.
   sk_sp<SkData> data() const { return data_; }
 
+  /// Wraps the contents of a mapping returned by an `AssetManager` in an
+  /// SkData.
+  ///
+  /// Assets that are backed by a file, such as a file of the application's
+  /// asset bundle or an uncompressed asset in an APK, are wrapped without
+  /// copying and stay mapped until the SkData is released. These files are
+  /// part of the installed application and are not modified while it runs.
+  /// Other mappings are copied, see `MakeSkDataWithCopy`.
+  ///
+  /// This must not be used for arbitrary files, which another process could
+  /// truncate or rewrite while they are mapped.
+  ///
+  /// Returns nullptr if `mapping` is null.
+  static sk_sp<SkData> MakeSkDataFromAssetMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
   /// Clears the Dart native fields and removes the reference to the underlying
   /// byte buffer.
   ///
@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(ImmutableBufferTest, FileBackedAssetIsWrappedWithoutCopy) {
+  auto mapping = OpenFixtureAsMapping("DashInNooglerHat.jpg");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_TRUE(mapping->IsDontNeedSafe());
+  const uint8_t* bytes = mapping->GetMapping();
+  size_t size = mapping->GetSize();
+
+  sk_sp<SkData> data =
+      ImmutableBuffer::MakeSkDataFromAssetMapping(std::move(mapping));
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(data->bytes(), bytes);
+  EXPECT_EQ(data->size(), size);
+}
+
+TEST(ImmutableBufferTest, HeapMappingIsCopied) {
+  std::vector<uint8_t> contents = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto mapping = std::make_unique<fml::DataMapping>(contents);
+  const uint8_t* bytes = mapping->GetMapping();
+
+  sk_sp<SkData> data =
+      ImmutableBuffer::MakeSkDataFromAssetMapping(std::move(mapping));
+  ASSERT_NE(data, nullptr);
+  EXPECT_NE(data->bytes(), bytes);
+  ASSERT_EQ(data->size(), contents.size());
+  EXPECT_EQ(memcmp(data->data(), contents.data(), contents.size()), 0);
+}
+
+TEST(ImmutableBufferTest, NullMappingReturnsNull) {
+  EXPECT_EQ(ImmutableBuffer::MakeSkDataFromAssetMapping(nullptr), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,277 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkStream.h"
+
+namespace flutter {
+
+// The chunks appended to the decoder. They are shared with the streams that
+// the codec reads from so that appending a chunk never moves the bytes that
+// were already received.
+class IncrementalImageDecoder::SegmentedData {
+ public:
+  void Append(sk_sp<SkData> chunk) {
+    std::scoped_lock lock(mutex_);
+    if (!chunk || chunk->size() == 0 || complete_) {
+      return;
+    }
+    offsets_.push_back(size_);
+    size_ += chunk->size();
+    chunks_.push_back(std::move(chunk));
+  }
+
+  void SetComplete() {
+    std::scoped_lock lock(mutex_);
+    complete_ = true;
+  }
+
+  // Drops all chunks and ignores any that are appended later.
+  void Release() {
+    std::scoped_lock lock(mutex_);
+    chunks_.clear();
+    offsets_.clear();
+    size_ = 0;
+    complete_ = true;
+  }
+
+  bool IsComplete() const {
+    std::scoped_lock lock(mutex_);
+    return complete_;
+  }
+
+  size_t GetSize() const {
+    std::scoped_lock lock(mutex_);
+    return size_;
+  }
+
+  // Copies up to |size| bytes starting at |position| into |buffer|, or
+  // skips them if |buffer| is null. Returns the number of bytes available.
+  size_t Read(size_t position, void* buffer, size_t size) const {
+    std::scoped_lock lock(mutex_);
+    if (position >= size_) {
+      return 0;
+    }
+    size = std::min(size, size_ - position);
+    if (buffer == nullptr) {
+      return size;
+    }
+    size_t index = std::upper_bound(offsets_.begin(), offsets_.end(),
+                                    position) -
+                   offsets_.begin() - 1;
+    auto* dest = static_cast<uint8_t*>(buffer);
+    size_t remaining = size;
+    while (remaining > 0) {
+      const sk_sp<SkData>& chunk = chunks_[index];
+      size_t offset = position - offsets_[index];
+      size_t count = std::min(remaining, chunk->size() - offset);
+      ::memcpy(dest, chunk->bytes() + offset, count);
+      dest += count;
+      position += count;
+      remaining -= count;
+      index++;
+    }
+    return size;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<sk_sp<SkData>> chunks_;
+  // The position of the first byte of each chunk.
+  std::vector<size_t> offsets_;
+  size_t size_ = 0;
+  bool complete_ = false;
+};
+
+// A stream over the chunks received so far. Reads past the last chunk
+// return fewer bytes than requested, which codecs report as incomplete
+// input, and they resume from the same position once more chunks arrive.
+class IncrementalImageDecoder::SegmentedStream final : public SkStream {
+ public:
+  explicit SegmentedStream(std::shared_ptr<const SegmentedData> data)
+      : data_(std::move(data)) {}
+
+  // |SkStream|
+  size_t read(void* buffer, size_t size) override {
+    size_t count = data_->Read(position_, buffer, size);
+    position_ += count;
+    return count;
+  }
+
+  // |SkStream|
+  size_t peek(void* buffer, size_t size) const override {
+    return data_->Read(position_, buffer, size);
+  }
+
+  // |SkStream|
+  bool isAtEnd() const override {
+    return data_->IsComplete() && position_ >= data_->GetSize();
+  }
+
+  // |SkStream|
+  bool rewind() override {
+    position_ = 0;
+    return true;
+  }
+
+  // |SkStream|
+  bool hasPosition() const override { return true; }
+
+  // |SkStream|
+  size_t getPosition() const override { return position_; }
+
+ private:
+  const std::shared_ptr<const SegmentedData> data_;
+  size_t position_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SegmentedStream);
+};
+
+IncrementalImageDecoder::IncrementalImageDecoder()
+    : data_(std::make_shared<SegmentedData>()) {}
+
+IncrementalImageDecoder::~IncrementalImageDecoder() = default;
+
+void IncrementalImageDecoder::AppendData(sk_sp<SkData> chunk) {
+  data_->Append(std::move(chunk));
+}
+
+void IncrementalImageDecoder::SetDataComplete() {
+  data_->SetComplete();
+}
+
+IncrementalImageDecoder::Status IncrementalImageDecoder::Decode() {
+  TRACE_EVENT0("flutter", "IncrementalImageDecoder::Decode");
+  if (status_ == Status::kComplete || status_ == Status::kError) {
+    return status_;
+  }
+  if (!codec_ && !CreateCodec()) {
+    return status_;
+  }
+  if (incremental_decode_supported_) {
+    status_ = DecodeIncrementally();
+  }
+  if (!incremental_decode_supported_) {
+    status_ = DecodeAll();
+  }
+  return status_;
+}
+
+bool IncrementalImageDecoder::CreateCodec() {
+  SkCodec::Result result;
+  codec_ = SkCodec::MakeFromStream(std::make_unique<SegmentedStream>(data_),
+                                   &result);
+  if (!codec_) {
+    // The header has not been received yet. A new stream is created on the
+    // next attempt since the codec takes ownership of the failed one.
+    if (result == SkCodec::Result::kIncompleteInput && !data_->IsComplete()) {
+      status_ = Status::kNeedsMoreData;
+    } else {
+      status_ = Finish(Status::kError);
+    }
+    return false;
+  }
+
+  SkImageInfo info = codec_->getInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    info = info.makeAlphaType(kPremul_SkAlphaType);
+  }
+  if (!bitmap_.tryAllocPixels(info)) {
+    FML_DLOG(ERROR) << "Failed to allocate memory for incremental decode.";
+    status_ = Finish(Status::kError);
+    return false;
+  }
+  bitmap_.eraseColor(SK_ColorTRANSPARENT);
+  return true;
+}
+
+IncrementalImageDecoder::Status
+IncrementalImageDecoder::DecodeIncrementally() {
+  if (!incremental_decode_started_) {
+    SkCodec::Result result = codec_->startIncrementalDecode(
+        bitmap_.info(), bitmap_.getPixels(), bitmap_.rowBytes());
+    switch (result) {
+      case SkCodec::Result::kSuccess:
+        incremental_decode_started_ = true;
+        break;
+      case SkCodec::Result::kIncompleteInput:
+        return data_->IsComplete() ? Finish(Status::kError)
+                                   : Status::kNeedsMoreData;
+      case SkCodec::Result::kUnimplemented:
+        incremental_decode_supported_ = false;
+        return Status::kNeedsMoreData;
+      default:
+        return Finish(Status::kError);
+    }
+  }
+
+  // Whether more data is coming is checked before decoding so that a chunk
+  // appended concurrently cannot be mistaken for the end of the data.
+  bool data_complete = data_->IsComplete();
+  int rows_decoded = 0;
+  SkCodec::Result result = codec_->incrementalDecode(&rows_decoded);
+  switch (result) {
+    case SkCodec::Result::kSuccess:
+      decoded_rows_ = bitmap_.height();
+      return Finish(Status::kComplete);
+    case SkCodec::Result::kIncompleteInput:
+      decoded_rows_ = std::max(decoded_rows_, rows_decoded);
+      if (data_complete) {
+        return Finish(Status::kError);
+      }
+      return decoded_rows_ > 0 ? Status::kPartial : Status::kNeedsMoreData;
+    default:
+      return Finish(Status::kError);
+  }
+}
+
+IncrementalImageDecoder::Status IncrementalImageDecoder::DecodeAll() {
+  if (!data_->IsComplete()) {
+    return Status::kNeedsMoreData;
+  }
+  SkCodec::Result result = codec_->getPixels(
+      bitmap_.info(), bitmap_.getPixels(), bitmap_.rowBytes());
+  switch (result) {
+    case SkCodec::Result::kSuccess:
+      decoded_rows_ = bitmap_.height();
+      return Finish(Status::kComplete);
+    case SkCodec::Result::kIncompleteInput:
+      // The codec fills the rows it could not decode, so the image is still
+      // usable, but the data is truncated.
+      decoded_rows_ = bitmap_.height();
+      return Finish(Status::kError);
+    default:
+      return Finish(Status::kError);
+  }
+}
+
+IncrementalImageDecoder::Status IncrementalImageDecoder::Finish(
+    Status status) {
+  // Neither the encoded bytes nor the codec are needed anymore.
+  codec_.reset();
+  data_->Release();
+  if (!bitmap_.drawsNothing()) {
+    bitmap_.setImmutable();
+  }
+  return status;
+}
+
+sk_sp<SkImage> IncrementalImageDecoder::GetImage() const {
+  if (decoded_rows_ == 0 || bitmap_.drawsNothing()) {
+    return nullptr;
+  }
+  // Immutable bitmaps are shared with the image, mutable ones are copied so
+  // that the image is a snapshot.
+  return SkImages::RasterFromBitmap(bitmap_);
+}
+
+}  // namespace flutter
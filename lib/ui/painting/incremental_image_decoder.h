@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes an image from encoded bytes that arrive in chunks,
+///             making the rows decoded so far available as an image before
+///             all of the bytes have been received.
+///
+///             The chunks are kept as a list of segments rather than being
+///             concatenated into one buffer, and they are released along
+///             with the codec as soon as the decode completes.
+///
+///             Formats that the codec can decode incrementally (PNG, GIF,
+///             and BMP) publish partial images as rows are decoded. Other
+///             formats, including JPEG, are decoded in one pass once the
+///             last chunk has been appended.
+///
+///             Chunks may be appended from any thread. |Decode| and the
+///             accessors must be called from one thread at a time, which
+///             is typically a worker of the concurrent task runner.
+///
+class IncrementalImageDecoder {
+ public:
+  enum class Status {
+    /// Not enough bytes have been appended to decode any rows.
+    kNeedsMoreData,
+    /// Some, but not all, rows have been decoded.
+    kPartial,
+    /// The image has been fully decoded.
+    kComplete,
+    /// The data could not be decoded. |GetImage| may still return the
+    /// rows that were decoded before the error.
+    kError,
+  };
+
+  IncrementalImageDecoder();
+
+  ~IncrementalImageDecoder();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Appends the next chunk of encoded bytes. The chunk is
+  ///             referenced, not copied.
+  ///
+  void AppendData(sk_sp<SkData> chunk);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the encoded bytes as complete. No further chunks may
+  ///             be appended.
+  ///
+  void SetDataComplete();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Decodes as much of the image as the appended bytes allow.
+  ///
+  Status Decode();
+
+  Status GetStatus() const { return status_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of rows decoded so far. Rows that have not been
+  ///             decoded yet are transparent in |GetImage|.
+  ///
+  int GetDecodedRowCount() const { return decoded_rows_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The info of the image being decoded, or an empty info if
+  ///             the header has not been decoded yet.
+  ///
+  const SkImageInfo& GetInfo() const { return bitmap_.info(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      A raster image holding the rows decoded so far, or nullptr
+  ///             if no rows have been decoded. Partial images are snapshots
+  ///             that are not affected by later calls to |Decode|.
+  ///
+  sk_sp<SkImage> GetImage() const;
+
+ private:
+  class SegmentedData;
+  class SegmentedStream;
+
+  std::shared_ptr<SegmentedData> data_;
+  std::unique_ptr<SkCodec> codec_;
+  SkBitmap bitmap_;
+  Status status_ = Status::kNeedsMoreData;
+  bool incremental_decode_started_ = false;
+  bool incremental_decode_supported_ = true;
+  int decoded_rows_ = 0;
+
+  bool CreateCodec();
+
+  Status DecodeIncrementally();
+
+  Status DecodeAll();
+
+  Status Finish(Status status);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IncrementalImageDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
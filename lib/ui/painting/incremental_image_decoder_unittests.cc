@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
+
+#include <algorithm>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/shell/common/shell_test.h"
+#include "flutter/testing/testing.h"
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// An opaque image with a different color in every row, so that each decoded
+// row can be told apart.
+SkBitmap MakeStripedBitmap(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32(width, height, kOpaque_SkAlphaType));
+  for (int y = 0; y < height; y++) {
+    SkColor color = SkColorSetARGB(0xFF, y & 0xFF, (y * 7) & 0xFF, 0x40);
+    for (int x = 0; x < width; x++) {
+      *bitmap.getAddr32(x, y) = SkPreMultiplyColor(color);
+    }
+  }
+  return bitmap;
+}
+
+sk_sp<SkData> EncodePng(const SkBitmap& bitmap) {
+  return SkPngEncoder::Encode(nullptr, SkImages::RasterFromBitmap(bitmap).get(),
+                              {});
+}
+
+// Appends the bytes of |data| in the given range as chunks of |chunk_size|
+// bytes, decoding after each one.
+IncrementalImageDecoder::Status AppendAndDecode(
+    IncrementalImageDecoder& decoder,
+    const sk_sp<SkData>& data,
+    size_t begin,
+    size_t end,
+    size_t chunk_size) {
+  IncrementalImageDecoder::Status status = decoder.GetStatus();
+  for (size_t offset = begin; offset < end; offset += chunk_size) {
+    size_t size = std::min(chunk_size, end - offset);
+    decoder.AppendData(SkData::MakeSubset(data.get(), offset, size));
+    status = decoder.Decode();
+    EXPECT_NE(status, IncrementalImageDecoder::Status::kError);
+  }
+  return status;
+}
+
+void ExpectSamePixels(const sk_sp<SkImage>& image, const SkBitmap& expected) {
+  ASSERT_NE(image, nullptr);
+  ASSERT_EQ(image->dimensions(), expected.dimensions());
+  SkBitmap actual;
+  ASSERT_TRUE(actual.tryAllocPixels(expected.info()));
+  ASSERT_TRUE(image->readPixels(actual.pixmap(), 0, 0));
+  for (int y = 0; y < expected.height(); y++) {
+    for (int x = 0; x < expected.width(); x++) {
+      ASSERT_EQ(actual.getColor(x, y), expected.getColor(x, y))
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+}  // namespace
+
+TEST_F(ShellTest, IncrementalImageDecoderPublishesRowsBeforeDataIsComplete) {
+  SkBitmap source = MakeStripedBitmap(64, 256);
+  sk_sp<SkData> png = EncodePng(source);
+  ASSERT_NE(png, nullptr);
+
+  IncrementalImageDecoder decoder;
+  auto status = AppendAndDecode(decoder, png, 0, png->size() / 2, 64);
+  EXPECT_EQ(status, IncrementalImageDecoder::Status::kPartial);
+  EXPECT_GT(decoder.GetDecodedRowCount(), 0);
+  EXPECT_LT(decoder.GetDecodedRowCount(), source.height());
+
+  sk_sp<SkImage> partial = decoder.GetImage();
+  ASSERT_NE(partial, nullptr);
+  EXPECT_EQ(partial->dimensions(), source.dimensions());
+  SkBitmap partial_pixels;
+  ASSERT_TRUE(partial_pixels.tryAllocPixels(source.info()));
+  ASSERT_TRUE(partial->readPixels(partial_pixels.pixmap(), 0, 0));
+  EXPECT_EQ(partial_pixels.getColor(0, 0), source.getColor(0, 0));
+  EXPECT_EQ(partial_pixels.getColor(0, source.height() - 1),
+            SK_ColorTRANSPARENT);
+
+  status = AppendAndDecode(decoder, png, png->size() / 2, png->size(), 64);
+  EXPECT_EQ(status, IncrementalImageDecoder::Status::kComplete);
+  EXPECT_EQ(decoder.GetDecodedRowCount(), source.height());
+  ExpectSamePixels(decoder.GetImage(), source);
+
+  // The partial image is a snapshot that does not change with the decode.
+  ASSERT_TRUE(partial->readPixels(partial_pixels.pixmap(), 0, 0));
+  EXPECT_EQ(partial_pixels.getColor(0, source.height() - 1),
+            SK_ColorTRANSPARENT);
+}
+
+TEST_F(ShellTest, IncrementalImageDecoderDecodesJpegOnceDataIsComplete) {
+  auto mapping = OpenFixtureAsMapping("DashInNooglerHat.jpg");
+  ASSERT_NE(mapping, nullptr);
+  sk_sp<SkData> jpeg =
+      SkData::MakeWithCopy(mapping->GetMapping(), mapping->GetSize());
+
+  IncrementalImageDecoder decoder;
+  auto status = AppendAndDecode(decoder, jpeg, 0, jpeg->size(), 4096);
+  EXPECT_EQ(status, IncrementalImageDecoder::Status::kNeedsMoreData);
+  EXPECT_EQ(decoder.GetImage(), nullptr);
+
+  decoder.SetDataComplete();
+  EXPECT_EQ(decoder.Decode(), IncrementalImageDecoder::Status::kComplete);
+
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(jpeg);
+  ASSERT_NE(codec, nullptr);
+  SkBitmap expected;
+  ASSERT_TRUE(expected.tryAllocPixels(decoder.GetInfo()));
+  ASSERT_EQ(codec->getPixels(expected.pixmap()), SkCodec::Result::kSuccess);
+  ExpectSamePixels(decoder.GetImage(), expected);
+}
+
+TEST_F(ShellTest, IncrementalImageDecoderReportsTruncatedData) {
+  sk_sp<SkData> png = EncodePng(MakeStripedBitmap(64, 256));
+  ASSERT_NE(png, nullptr);
+
+  IncrementalImageDecoder decoder;
+  AppendAndDecode(decoder, png, 0, png->size() / 2, 512);
+  decoder.SetDataComplete();
+  EXPECT_EQ(decoder.Decode(), IncrementalImageDecoder::Status::kError);
+  // The rows decoded before the data ran out are still available.
+  EXPECT_NE(decoder.GetImage(), nullptr);
+}
+
+TEST_F(ShellTest, IncrementalImageDecoderRejectsInvalidData) {
+  IncrementalImageDecoder decoder;
+  decoder.AppendData(SkData::MakeWithCString("not an image"));
+  decoder.SetDataComplete();
+  EXPECT_EQ(decoder.Decode(), IncrementalImageDecoder::Status::kError);
+  EXPECT_EQ(decoder.GetImage(), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
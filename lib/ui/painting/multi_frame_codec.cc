@@ -4,9 +4,12 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
@@ -21,6 +24,49 @@
 
 namespace flutter {
 
+namespace {
+
+std::atomic_int gPrefetchFrameCount =
+    MultiFrameCodec::kDefaultPrefetchFrameCount;
+std::atomic_size_t gPrefetchBudgetBytes =
+    MultiFrameCodec::kDefaultPrefetchBudgetBytes;
+// The bytes reserved by the prefetched frames of all codecs.
+std::atomic_size_t gPrefetchedBytes = 0u;
+
+// The number of frames to keep decoded ahead of the requested one. There is
+// no point in decoding a frame again before the previous decode of it has
+// been requested.
+size_t GetLookahead(int frame_count) {
+  int lookahead = std::min(gPrefetchFrameCount.load(), frame_count - 1);
+  return static_cast<size_t>(std::max(lookahead, 0));
+}
+
+bool ReservePrefetchBytes(size_t bytes) {
+  const size_t budget = gPrefetchBudgetBytes.load();
+  size_t used = gPrefetchedBytes.load();
+  do {
+    if (bytes > budget || used > budget - bytes) {
+      return false;
+    }
+  } while (!gPrefetchedBytes.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+void ReleasePrefetchBytes(size_t bytes) {
+  gPrefetchedBytes.fetch_sub(bytes);
+}
+
+}  // namespace
+
+void MultiFrameCodec::SetPrefetchLimits(int frame_count, size_t budget_bytes) {
+  gPrefetchFrameCount = std::max(frame_count, 0);
+  gPrefetchBudgetBytes = budget_bytes;
+}
+
+size_t MultiFrameCodec::GetPrefetchedBytes() {
+  return gPrefetchedBytes.load();
+}
+
 MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
     : state_(new State(std::move(generator))) {}
 
@@ -35,6 +81,12 @@ MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
                            : generator_->GetPlayCount() - 1),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
 
+MultiFrameCodec::State::~State() {
+  for (const DecodedFrame& frame : ready_frames_) {
+    ReleasePrefetchBytes(frame.reserved_bytes);
+  }
+}
+
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
     int duration,
@@ -53,30 +105,33 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
+static SkImageInfo GetDecodeInfo(const ImageGenerator& generator) {
+  SkImageInfo info = generator.GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
+    info = info.makeAlphaType(kPremul_SkAlphaType);
   }
+  return info;
+}
+
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::DecodeNextFrame");
+  DecodedFrame frame;
+  frame.index = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
+  SkBitmap bitmap = SkBitmap();
+  SkImageInfo info = GetDecodeInfo(*generator_);
   if (!bitmap.tryAllocPixels(info)) {
     std::ostringstream ostr;
     ostr << "Failed to allocate memory for bitmap of size "
          << info.computeMinByteSize() << "B";
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
-
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frame.index);
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
 
@@ -86,7 +141,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frame.index << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -102,12 +157,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frame.index, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
-    std::string decode_error = ostr.str();
-    FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    ostr << "Could not getPixels for frame " << frame.index;
+    frame.decode_error = ostr.str();
+    FML_LOG(ERROR) << frame.decode_error;
+    return frame;
   }
 
   const bool keep_current_frame =
@@ -132,7 +187,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frame.index;
   }
 
   if (frameInfo.disposal_method ==
@@ -142,6 +197,105 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  frame.duration = frameInfo.duration;
+  frame.bitmap = std::move(bitmap);
+  return frame;
+}
+
+std::optional<MultiFrameCodec::State::DecodedFrame>
+MultiFrameCodec::State::PopReadyFrame() {
+  std::scoped_lock ready_lock(ready_frames_mutex_);
+  if (ready_frames_.empty()) {
+    return std::nullopt;
+  }
+  DecodedFrame frame = std::move(ready_frames_.front());
+  ready_frames_.pop_front();
+  ReleasePrefetchBytes(frame.reserved_bytes);
+  frame.reserved_bytes = 0;
+  return frame;
+}
+
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::TakeNextFrame() {
+  if (std::optional<DecodedFrame> frame = PopReadyFrame()) {
+    return std::move(frame.value());
+  }
+
+  // The frame has not been prefetched. A prefetch that is decoding it right
+  // now pushes it to the ring before releasing the decoder, so the ring is
+  // checked again once the decoder is available.
+  std::scoped_lock decode_lock(decode_mutex_);
+  if (std::optional<DecodedFrame> frame = PopReadyFrame()) {
+    return std::move(frame.value());
+  }
+  return DecodeNextFrame();
+}
+
+void MultiFrameCodec::State::PrefetchFrames() {
+  TRACE_EVENT0("flutter", "MultiFrameCodec::PrefetchFrames");
+  const size_t lookahead = GetLookahead(frameCount_);
+  const size_t frame_bytes = GetDecodeInfo(*generator_).computeMinByteSize();
+  {
+    std::scoped_lock ready_lock(ready_frames_mutex_);
+    prefetch_scheduled_ = false;
+  }
+
+  while (true) {
+    // The decoder is released between frames so that a frame that is
+    // requested while the ring is being filled is not delayed by more than
+    // one decode.
+    std::scoped_lock decode_lock(decode_mutex_);
+    {
+      std::scoped_lock ready_lock(ready_frames_mutex_);
+      if (ready_frames_.size() >= lookahead) {
+        return;
+      }
+    }
+    if (!ReservePrefetchBytes(frame_bytes)) {
+      return;
+    }
+    DecodedFrame frame = DecodeNextFrame();
+    if (frame.bitmap.drawsNothing()) {
+      // Errors are reported when the frame is requested.
+      ReleasePrefetchBytes(frame_bytes);
+    } else {
+      frame.reserved_bytes = frame_bytes;
+    }
+    std::scoped_lock ready_lock(ready_frames_mutex_);
+    ready_frames_.push_back(std::move(frame));
+  }
+}
+
+void MultiFrameCodec::State::SchedulePrefetch(
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner,
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner) {
+  {
+    std::scoped_lock ready_lock(ready_frames_mutex_);
+    if (prefetch_scheduled_ ||
+        ready_frames_.size() >= GetLookahead(frameCount_)) {
+      return;
+    }
+    prefetch_scheduled_ = true;
+  }
+  auto task = [weak_state = weak_from_this()]() {
+    if (auto state = weak_state.lock()) {
+      state->PrefetchFrames();
+    }
+  };
+  // Without a concurrent task runner, frames are still decoded ahead of the
+  // request, but on the IO task runner.
+  if (concurrent_runner) {
+    concurrent_runner->PostTask(task);
+  } else {
+    io_task_runner->PostTask(task);
+  }
+}
+
+std::pair<sk_sp<DlImage>, std::string> MultiFrameCodec::State::UploadFrame(
+    const SkBitmap& bitmap,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -188,22 +342,25 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     size_t trace_id,
-    const std::shared_ptr<impeller::Context>& impeller_context) {
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner,
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
+  DecodedFrame frame = TakeNextFrame();
   sk_sp<DlImage> dlImage;
-  std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+  std::string decode_error = std::move(frame.decode_error);
+  if (!frame.bitmap.drawsNothing()) {
+    std::tie(dlImage, decode_error) =
+        UploadFrame(frame.bitmap, std::move(resourceContext),
+                    gpu_disable_sync_switch, impeller_context,
+                    std::move(unref_queue));
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -213,6 +370,9 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
         InvokeNextFrameCallback(image, duration, decode_error,
                                 std::move(callback), trace_id);
       }));
+
+  // Decode the frames that follow while the framework displays this one.
+  SchedulePrefetch(concurrent_runner, io_task_runner);
 }
 
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
@@ -245,6 +405,8 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_runner = dart_state->GetConcurrentTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -256,7 +418,8 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
             std::move(callback), ui_task_runner,
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
-            io_manager->GetImpellerContext());
+            io_manager->GetImpellerContext(), concurrent_runner,
+            io_task_runner);
       }));
 
   return Dart_Null();
@@ -5,16 +5,44 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MULTI_FRAME_CODEC_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
 
 namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
+  /// The number of frames decoded ahead of the frame being displayed.
+  static constexpr int kDefaultPrefetchFrameCount = 2;
+
+  /// The number of bytes that prefetched frames of all codecs may use.
+  static constexpr size_t kDefaultPrefetchBudgetBytes = 32 * 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets how many frames each codec decodes ahead of the frame
+  ///             requested by the framework, and the number of bytes the
+  ///             decoded frames waiting to be requested may use across all
+  ///             codecs in the process. A frame count of zero disables
+  ///             prefetching.
+  ///
+  ///             Frames that do not fit in the budget are decoded when they
+  ///             are requested, as they would be without prefetching.
+  ///
+  static void SetPrefetchLimits(int frame_count, size_t budget_bytes);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of bytes used by prefetched frames of all codecs.
+  ///
+  static size_t GetPrefetchedBytes();
+
   explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
 
   ~MultiFrameCodec() override;
@@ -38,17 +66,35 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
+  //
+  // Frames are decoded ahead of time on the concurrent task runner into a
+  // ring of ready frames, and uploaded on the IO task runner when they are
+  // requested.
+  struct State : public std::enable_shared_from_this<State> {
     explicit State(std::shared_ptr<ImageGenerator> generator);
 
+    ~State();
+
+    // A frame that has been decoded but not uploaded yet.
+    struct DecodedFrame {
+      int index = 0;
+      int duration = 0;
+      // Empty if the frame could not be decoded.
+      SkBitmap bitmap;
+      std::string decode_error;
+      // The number of bytes reserved in the prefetch budget for the frame.
+      size_t reserved_bytes = 0;
+    };
+
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
 
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    // Guards the decoder members below. Held while a frame is decoded, either
+    // on the IO thread or on a worker of the concurrent task runner.
+    std::mutex decode_mutex_;
+    // The index of the next frame to decode.
     int nextFrameIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
@@ -59,7 +105,35 @@ class MultiFrameCodec : public Codec {
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
-    std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
+    // Guards the ring of prefetched frames. May be acquired while holding
+    // |decode_mutex_|, but not the other way around.
+    std::mutex ready_frames_mutex_;
+    // Decoded frames in the order they will be requested.
+    std::deque<DecodedFrame> ready_frames_;
+    bool prefetch_scheduled_ = false;
+
+    // Decodes the frame at |nextFrameIndex_| and advances it. Must be called
+    // with |decode_mutex_| held.
+    DecodedFrame DecodeNextFrame();
+
+    // Removes the oldest frame from the ring of prefetched frames and
+    // releases its share of the prefetch budget.
+    std::optional<DecodedFrame> PopReadyFrame();
+
+    // Returns the next frame from the ring of prefetched frames, or decodes
+    // it if it has not been prefetched.
+    DecodedFrame TakeNextFrame();
+
+    // Decodes frames into the ring until it holds the lookahead number of
+    // frames or the prefetch budget is exhausted.
+    void PrefetchFrames();
+
+    void SchedulePrefetch(
+        const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner,
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner);
+
+    std::pair<sk_sp<DlImage>, std::string> UploadFrame(
+        const SkBitmap& bitmap,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         const std::shared_ptr<impeller::Context>& impeller_context,
@@ -72,7 +146,9 @@ class MultiFrameCodec : public Codec {
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         size_t trace_id,
-        const std::shared_ptr<impeller::Context>& impeller_context);
+        const std::shared_ptr<impeller::Context>& impeller_context,
+        const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_runner,
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner);
   };
 
   // Shared across the UI and IO task runners.
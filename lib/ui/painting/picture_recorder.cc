@@ -36,7 +36,9 @@ void PictureRecorder::endRecording(Dart_Handle dart_picture) {
     return;
   }
 
-  auto display_list = display_list_builder_->Build();
+  auto display_list = UIDartState::Current()->IsCompactDisplayListsEnabled()
+                          ? display_list_builder_->BuildCompact()
+                          : display_list_builder_->Build();
   display_list_builder_ = nullptr;
 
   FML_DCHECK(display_list->has_rtree());
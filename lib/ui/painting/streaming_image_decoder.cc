@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/streaming_image_decoder.h"
+
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/dart_binding_macros.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+#include "third_party/tonic/typed_data/typed_list.h"
+
+namespace flutter {
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, StreamingImageDecoder);
+
+void StreamingImageDecoder::Create(Dart_Handle wrapper, Dart_Handle callback) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto decoder = fml::MakeRefCounted<StreamingImageDecoder>(callback);
+  decoder->AssociateWithDartWrapper(wrapper);
+}
+
+StreamingImageDecoder::StreamingImageDecoder(Dart_Handle callback)
+    : decoder_(std::make_shared<IncrementalImageDecoder>()),
+      callback_(UIDartState::Current(), callback) {}
+
+StreamingImageDecoder::~StreamingImageDecoder() = default;
+
+Dart_Handle StreamingImageDecoder::addChunk(Dart_Handle data) {
+  if (closed_) {
+    return tonic::ToDart("Chunks cannot be added after close");
+  }
+  if (finished_) {
+    // The decode has already failed or the decoder has been disposed.
+    return Dart_Null();
+  }
+
+  tonic::Uint8List list(data);
+  decoder_->AppendData(SkData::MakeWithCopy(list.data(), list.num_elements()));
+  list.Release();
+
+  needs_decode_ = true;
+  DecodeIfNeeded();
+  return Dart_Null();
+}
+
+Dart_Handle StreamingImageDecoder::close() {
+  if (closed_ || finished_) {
+    closed_ = true;
+    return Dart_Null();
+  }
+  closed_ = true;
+  decoder_->SetDataComplete();
+
+  needs_decode_ = true;
+  DecodeIfNeeded();
+  return Dart_Null();
+}
+
+void StreamingImageDecoder::dispose() {
+  finished_ = true;
+  decoder_.reset();
+  callback_.Clear();
+  ClearDartWrapper();
+}
+
+void StreamingImageDecoder::DecodeIfNeeded() {
+  if (finished_ || decode_in_progress_ || !needs_decode_) {
+    return;
+  }
+
+  auto image_decoder = UIDartState::Current()->GetImageDecoder();
+  if (!image_decoder) {
+    OnDecoded(nullptr, IncrementalImageDecoder::Status::kError,
+              "Failed to access the internal image decoder registry on this "
+              "isolate.");
+    return;
+  }
+
+  // The StreamingImageDecoder must be deleted on the UI thread. Allocate a
+  // RefPtr on the heap to ensure that it remains alive until the decoder
+  // callback is invoked on the UI thread. The callback then drops the
+  // reference.
+  fml::RefPtr<StreamingImageDecoder>* raw_decoder_ref =
+      new fml::RefPtr<StreamingImageDecoder>(this);
+
+  needs_decode_ = false;
+  decode_in_progress_ = true;
+  image_decoder->DecodeIncrementally(
+      decoder_, [raw_decoder_ref](auto image, auto status, auto decode_error) {
+        std::unique_ptr<fml::RefPtr<StreamingImageDecoder>> decoder_ref(
+            raw_decoder_ref);
+        fml::RefPtr<StreamingImageDecoder> decoder(std::move(*decoder_ref));
+        decoder->decode_in_progress_ = false;
+        decoder->OnDecoded(std::move(image), status, decode_error);
+      });
+}
+
+void StreamingImageDecoder::OnDecoded(sk_sp<DlImage> image,
+                                      IncrementalImageDecoder::Status status,
+                                      const std::string& decode_error) {
+  if (finished_) {
+    return;
+  }
+
+  auto state = callback_.dart_state().lock();
+  if (!state) {
+    // This is probably because the isolate has been terminated before the
+    // image could be decoded.
+    return;
+  }
+  tonic::DartState::Scope scope(state.get());
+
+  std::string error = decode_error;
+  if (status == IncrementalImageDecoder::Status::kError && error.empty()) {
+    error = "Could not decode the image data.";
+  }
+  const bool finished =
+      status == IncrementalImageDecoder::Status::kComplete || !error.empty();
+
+  fml::RefPtr<CanvasImage> canvas_image;
+  if (image) {
+    canvas_image = CanvasImage::Create();
+    canvas_image->set_image(std::move(image));
+  }
+
+  if (finished) {
+    // Neither the encoded chunks nor the decoded rows are needed anymore.
+    finished_ = true;
+    decoder_.reset();
+    tonic::DartInvoke(callback_.value(),
+                      {tonic::ToDart(canvas_image), tonic::ToDart(true),
+                       tonic::ToDart(error)});
+    callback_.Clear();
+    return;
+  }
+
+  if (canvas_image) {
+    tonic::DartInvoke(callback_.value(),
+                      {tonic::ToDart(canvas_image), tonic::ToDart(false),
+                       tonic::ToDart(error)});
+  }
+
+  // Decode the chunks that were added while this decode was in progress.
+  DecodeIfNeeded();
+}
+
+}  // namespace flutter
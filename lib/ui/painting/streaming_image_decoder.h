@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_STREAMING_IMAGE_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_STREAMING_IMAGE_DECODER_H_
+
+#include <memory>
+#include <string>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
+#include "third_party/tonic/dart_persistent_value.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The engine side of the `StreamingImageDecoder` class of
+///             dart:ui, which decodes an image from encoded bytes that the
+///             application receives in chunks.
+///
+///             The chunks are handed to an |IncrementalImageDecoder|, which
+///             the |ImageDecoder| of the isolate decodes and uploads on its
+///             worker and IO threads. Each time a decode makes progress, the
+///             rows decoded so far are passed to the Dart callback as an
+///             image.
+///
+///             At most one decode is in progress at a time. Chunks that
+///             arrive while one is running are decoded by the next one, so a
+///             slow upload coalesces chunks instead of queueing an image for
+///             every chunk.
+///
+class StreamingImageDecoder
+    : public RefCountedDartWrappable<StreamingImageDecoder> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(StreamingImageDecoder);
+
+ public:
+  ~StreamingImageDecoder() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a decoder for the Dart `wrapper`. The `callback` is
+  ///             invoked with the image decoded so far, whether the decode
+  ///             has finished, and an error message that is empty unless the
+  ///             decode failed.
+  ///
+  static void Create(Dart_Handle wrapper, Dart_Handle callback);
+
+  /// Copies the bytes of a `Uint8List` and decodes them after the bytes
+  /// added before. Returns an error message on failure, null on success.
+  Dart_Handle addChunk(Dart_Handle data);
+
+  /// Marks the encoded bytes as complete. Returns an error message on
+  /// failure, null on success.
+  Dart_Handle close();
+
+  void dispose();
+
+ private:
+  explicit StreamingImageDecoder(Dart_Handle callback);
+
+  std::shared_ptr<IncrementalImageDecoder> decoder_;
+  tonic::DartPersistentValue callback_;
+  bool closed_ = false;
+  bool finished_ = false;
+  bool decode_in_progress_ = false;
+  // Whether bytes were added or the decoder was closed since the decode in
+  // progress started.
+  bool needs_decode_ = false;
+
+  void DecodeIfNeeded();
+
+  void OnDecoded(sk_sp<DlImage> image,
+                 IncrementalImageDecoder::Status status,
+                 const std::string& decode_error);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StreamingImageDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_STREAMING_IMAGE_DECODER_H_
@@ -740,6 +740,30 @@ class PlatformDispatcher {
     }
   }
 
+  /// Sends messages that the platform sent in quick succession to the
+  /// framework, in order, as if each had been sent in a task of its own.
+  ///
+  /// The microtasks that one message schedules run before the next message
+  /// is dispatched. An error thrown while dispatching one message does not
+  /// prevent the following messages from being dispatched; it is reported as
+  /// an uncaught error instead.
+  void _dispatchPlatformMessages(List<String> names, List<ByteData?> data, List<int> responseIds) {
+    assert(names.length == data.length && names.length == responseIds.length);
+    for (int i = 0; i < names.length; i += 1) {
+      if (i > 0) {
+        _flushMicrotasks();
+      }
+      try {
+        _dispatchPlatformMessage(names[i], data[i], responseIds[i]);
+      } catch (error, stackTrace) {
+        Zone.root.handleUncaughtError(error, stackTrace);
+      }
+    }
+  }
+
+  @Native<Void Function()>(symbol: 'PlatformConfigurationNativeApi::FlushMicrotasks')
+  external static void _flushMicrotasks();
+
   /// Set the debug name associated with this platform dispatcher's root
   /// isolate.
   ///
@@ -1608,6 +1632,43 @@ enum FramePhase {
   rasterFinishWallTime,
 }
 
+/// Stages of rasterizing a frame whose durations are measured by the engine.
+///
+/// [FrameTiming.rasterPhaseDuration] returns the time spent in each of them.
+/// Phases that do not apply to the renderer in use report [Duration.zero].
+enum FrameRasterPhase {
+  /// Computing the region of the frame that changed since the last frame.
+  diff,
+
+  /// Walking the layer tree before painting it.
+  preroll,
+
+  /// Evicting unused entries from the raster cache and populating it.
+  rasterCache,
+
+  /// Converting the display lists of the frame to Impeller entities.
+  dispatch,
+
+  /// Tessellating paths into vertices with Impeller.
+  tessellation,
+
+  /// Rendering glyphs into the glyph atlas with Impeller.
+  glyphAtlas,
+
+  /// Encoding the render and compute passes into command buffers.
+  encode,
+
+  /// Submitting command buffers to the GPU.
+  submit,
+
+  /// The time the GPU spent executing the most recently completed frame.
+  ///
+  /// GPU work completes asynchronously, so this usually belongs to a frame
+  /// one or two frames older than the one it is reported with. It is only
+  /// measured when GPU tracing is enabled.
+  gpu,
+}
+
 enum _FrameTimingInfo {
   /// The number of engine layers cached in the raster cache during the frame.
   layerCacheCount,
@@ -1657,6 +1718,7 @@ class FrameTiming {
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
     int frameNumber = -1,
+    Map<FrameRasterPhase, Duration> rasterPhaseDurations = const <FrameRasterPhase, Duration>{},
   }) {
     return FrameTiming._(<int>[
       vsyncStart,
@@ -1670,6 +1732,8 @@ class FrameTiming {
       pictureCacheCount,
       pictureCacheBytes,
       frameNumber,
+      for (final FrameRasterPhase phase in FrameRasterPhase.values)
+        rasterPhaseDurations[phase]?.inMicroseconds ?? 0,
     ]);
   }
 
@@ -1682,7 +1746,7 @@ class FrameTiming {
   /// To get the [FrameTiming] of your app, see [PlatformDispatcher.onReportTimings].
   FrameTiming._(this._data) : assert(_data.length == _dataLength);
 
-  static final int _dataLength = FramePhase.values.length + _FrameTimingInfo.values.length;
+  static final int _dataLength = FramePhase.values.length + _FrameTimingInfo.values.length + FrameRasterPhase.values.length;
 
   /// This is a raw timestamp in microseconds from some epoch. The epoch in all
   /// [FrameTiming] is the same, but it may not match [DateTime]'s epoch.
@@ -1760,7 +1824,15 @@ class FrameTiming {
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
   /// The frame key associated with this frame measurement.
-  int get frameNumber => _data.last;
+  int get frameNumber => _rawInfo(_FrameTimingInfo.frameNumber);
+
+  /// The time the raster thread spent in the given [phase] of the frame.
+  ///
+  /// The phases are not exhaustive, so their durations do not add up to
+  /// [rasterDuration]. See [FrameRasterPhase] for what each one measures.
+  Duration rasterPhaseDuration(FrameRasterPhase phase) {
+    return Duration(microseconds: _data[FramePhase.values.length + _FrameTimingInfo.values.length + phase.index]);
+  }
 
   final List<int> _data; // some elements in microseconds, some in bytes, some are counts
 
@@ -1776,7 +1848,7 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
-        'frameNumber: ${_data.last})';
+        'frameNumber: $frameNumber)';
   }
 }
 
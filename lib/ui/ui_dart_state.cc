@@ -41,7 +41,8 @@ UIDartState::Context::Context(
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     bool enable_impeller,
-    impeller::RuntimeStageBackend runtime_stage_backend)
+    impeller::RuntimeStageBackend runtime_stage_backend,
+    bool compact_display_lists)
     : task_runners(task_runners),
       snapshot_delegate(std::move(snapshot_delegate)),
       io_manager(std::move(io_manager)),
@@ -53,7 +54,8 @@ UIDartState::Context::Context(
       volatile_path_tracker(std::move(volatile_path_tracker)),
       concurrent_task_runner(std::move(concurrent_task_runner)),
       enable_impeller(enable_impeller),
-      runtime_stage_backend(runtime_stage_backend) {}
+      runtime_stage_backend(runtime_stage_backend),
+      compact_display_lists(compact_display_lists) {}
 
 UIDartState::UIDartState(
     TaskObserverAdd add_callback,
@@ -87,6 +89,10 @@ bool UIDartState::IsImpellerEnabled() const {
   return context_.enable_impeller;
 }
 
+bool UIDartState::IsCompactDisplayListsEnabled() const {
+  return context_.compact_display_lists;
+}
+
 impeller::RuntimeStageBackend UIDartState::GetRuntimeStageBackend() const {
   return context_.runtime_stage_backend;
 }
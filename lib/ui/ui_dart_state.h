@@ -56,7 +56,8 @@ class UIDartState : public tonic::DartState {
             std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
             std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
             bool enable_impeller,
-            impeller::RuntimeStageBackend runtime_stage_backend);
+            impeller::RuntimeStageBackend runtime_stage_backend,
+            bool compact_display_lists = false);
 
     /// The task runners used by the shell hosting this runtime controller. This
     /// may be used by the isolate to scheduled asynchronous texture uploads or
@@ -104,6 +105,9 @@ class UIDartState : public tonic::DartState {
 
     /// The expected backend for runtime stage shaders.
     impeller::RuntimeStageBackend runtime_stage_backend;
+
+    /// Whether pictures are recorded into the compact display list encoding.
+    bool compact_display_lists = false;
   };
 
   Dart_Port main_port() const { return main_port_; }
@@ -168,6 +172,8 @@ class UIDartState : public tonic::DartState {
   /// Whether Impeller is enabled for this application.
   bool IsImpellerEnabled() const;
 
+  bool IsCompactDisplayListsEnabled() const;
+
   /// The expected type for runtime stage shaders.
   impeller::RuntimeStageBackend GetRuntimeStageBackend() const;
 
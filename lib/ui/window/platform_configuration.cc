@@ -69,6 +69,9 @@ void PlatformConfiguration::DidCreateIsolate() {
   dispatch_platform_message_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessage")));
+  dispatch_platform_messages_.Set(
+      tonic::DartState::Current(),
+      Dart_GetField(library, tonic::ToDart("_dispatchPlatformMessages")));
   dispatch_pointer_data_packet_.Set(
       tonic::DartState::Current(),
       Dart_GetField(library, tonic::ToDart("_dispatchPointerDataPacket")));
@@ -319,6 +322,63 @@ void PlatformConfiguration::DispatchPlatformMessage(
                          tonic::ToDart(response_id)}));
 }
 
+void PlatformConfiguration::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  std::shared_ptr<tonic::DartState> dart_state =
+      dispatch_platform_messages_.dart_state().lock();
+  if (!dart_state) {
+    FML_DLOG(WARNING) << "Dropping " << messages.size()
+                      << " platform messages for lack of DartState.";
+    return;
+  }
+  tonic::DartState::Scope scope(dart_state);
+
+  std::vector<std::string> channels;
+  std::vector<Dart_Handle> data_handles;
+  std::vector<int> response_ids;
+  channels.reserve(messages.size());
+  data_handles.reserve(messages.size());
+  response_ids.reserve(messages.size());
+  for (const std::unique_ptr<PlatformMessage>& message : messages) {
+    Dart_Handle data_handle =
+        (message->hasData()) ? ToByteData(message->data()) : Dart_Null();
+    if (Dart_IsError(data_handle)) {
+      FML_DLOG(WARNING)
+          << "Dropping platform message because of a Dart error on channel: "
+          << message->channel();
+      continue;
+    }
+
+    int response_id = 0;
+    if (auto response = message->response()) {
+      response_id = next_response_id_++;
+      pending_responses_[response_id] = response;
+    }
+    channels.push_back(message->channel());
+    data_handles.push_back(data_handle);
+    response_ids.push_back(response_id);
+  }
+
+  Dart_Handle byte_data_type = Dart_GetNullableType(
+      Dart_LookupLibrary(tonic::ToDart("dart:typed_data")),
+      tonic::ToDart("ByteData"), 0, nullptr);
+  if (tonic::CheckAndHandleError(byte_data_type)) {
+    return;
+  }
+  Dart_Handle data_list =
+      Dart_NewListOfType(byte_data_type, data_handles.size());
+  if (tonic::CheckAndHandleError(data_list)) {
+    return;
+  }
+  for (size_t i = 0; i < data_handles.size(); i++) {
+    Dart_ListSetAt(data_list, i, data_handles[i]);
+  }
+
+  tonic::CheckAndHandleError(tonic::DartInvoke(
+      dispatch_platform_messages_.Get(),
+      {tonic::ToDart(channels), data_list, tonic::ToDart(response_ids)}));
+}
+
 void PlatformConfiguration::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   std::shared_ptr<tonic::DartState> dart_state =
@@ -585,6 +645,11 @@ void PlatformConfigurationNativeApi::ScheduleFrame() {
   UIDartState::Current()->platform_configuration()->client()->ScheduleFrame();
 }
 
+void PlatformConfigurationNativeApi::FlushMicrotasks() {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  UIDartState::Current()->FlushMicrotasksNow();
+}
+
 void PlatformConfigurationNativeApi::UpdateSemantics(SemanticsUpdate* update) {
   UIDartState::ThrowIfUIOperationsProhibited();
   UIDartState::Current()->platform_configuration()->client()->UpdateSemantics(
@@ -387,6 +387,19 @@ class PlatformConfiguration final {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the PlatformConfiguration that the client has sent
+  ///             it several messages. The messages are delivered to the
+  ///             framework in a single call into the isolate, in order,
+  ///             and the microtasks that each message schedules run before
+  ///             the next message is delivered.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the PlatformConfiguration that the client has sent
   ///             it pointer events. This call originates in the platform view
@@ -512,6 +525,7 @@ class PlatformConfiguration final {
   tonic::DartPersistentValue update_semantics_enabled_;
   tonic::DartPersistentValue update_accessibility_features_;
   tonic::DartPersistentValue dispatch_platform_message_;
+  tonic::DartPersistentValue dispatch_platform_messages_;
   tonic::DartPersistentValue dispatch_pointer_data_packet_;
   tonic::DartPersistentValue dispatch_semantics_action_;
   tonic::DartPersistentValue begin_frame_;
@@ -557,6 +571,14 @@ class PlatformConfigurationNativeApi {
 
   static void ScheduleFrame();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Runs the microtasks that are currently scheduled. Used to
+  ///             give each message of a batch of platform messages the
+  ///             microtask checkpoint that it would have had in a task of
+  ///             its own.
+  ///
+  static void FlushMicrotasks();
+
   static void Render(Scene* scene, double width, double height);
 
   static void UpdateSemantics(SemanticsUpdate* update);
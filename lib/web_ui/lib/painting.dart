@@ -547,6 +547,76 @@ Future<void> _decodeImageFromListAsync(Uint8List list, ImageDecoderCallback call
   callback(frameInfo.image);
 }
 
+typedef StreamingImageCallback = void Function(Image image, bool isComplete);
+
+// The web has no incremental decoder, so the chunks are collected and decoded
+// in one pass once the decoder is closed.
+class StreamingImageDecoder {
+  StreamingImageDecoder({required this.onImage, this.onError});
+
+  final StreamingImageCallback onImage;
+  final void Function(String error)? onError;
+
+  final BytesBuilder _chunks = BytesBuilder();
+  bool _closed = false;
+  bool _disposed = false;
+
+  void addChunk(Uint8List chunk) {
+    assert(!_disposed);
+    if (_closed) {
+      throw Exception('Chunks cannot be added after close');
+    }
+    _chunks.add(chunk);
+  }
+
+  void close() {
+    assert(!_disposed);
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    _decode(_chunks.takeBytes());
+  }
+
+  Future<void> _decode(Uint8List bytes) async {
+    final FrameInfo frameInfo;
+    try {
+      final Codec codec = await instantiateImageCodec(bytes);
+      frameInfo = await codec.getNextFrame();
+      codec.dispose();
+    } catch (error) {
+      if (_disposed) {
+        return;
+      }
+      if (onError == null) {
+        rethrow;
+      }
+      onError!(error.toString());
+      return;
+    }
+    if (_disposed) {
+      frameInfo.image.dispose();
+      return;
+    }
+    onImage(frameInfo.image, true);
+  }
+
+  bool get debugDisposed {
+    late bool disposed;
+    assert(() {
+      disposed = _disposed;
+      return true;
+    }());
+    return disposed;
+  }
+
+  void dispose() {
+    assert(!_disposed);
+    _disposed = true;
+    _chunks.clear();
+  }
+}
+
 // Encodes the input pixels into a BMP file that supports transparency.
 //
 // The `pixels` should be the scanlined raw pixels, 4 bytes per pixel, from left
@@ -853,6 +923,16 @@ class ImageDescriptor {
 
     return createBmp(_data!, width, height, _rowBytes ?? width, _format!);
   }
+
+  Future<Codec> instantiateRegionCodec({
+    required int left,
+    required int top,
+    required int width,
+    required int height,
+    int sampleSize = 1,
+  }) async {
+    throw UnsupportedError('ImageDescriptor.instantiateRegionCodec is not supported on web.');
+  }
 }
 
 abstract class FragmentProgram {
@@ -159,6 +159,18 @@ enum FramePhase {
   rasterFinishWallTime,
 }
 
+enum FrameRasterPhase {
+  diff,
+  preroll,
+  rasterCache,
+  dispatch,
+  tessellation,
+  glyphAtlas,
+  encode,
+  submit,
+  gpu,
+}
+
 enum _FrameTimingInfo {
   layerCacheCount,
   layerCacheBytes,
@@ -180,6 +192,7 @@ class FrameTiming {
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
     int frameNumber = 1,
+    Map<FrameRasterPhase, Duration> rasterPhaseDurations = const <FrameRasterPhase, Duration>{},
   }) {
     return FrameTiming._(<int>[
       vsyncStart,
@@ -193,13 +206,16 @@ class FrameTiming {
       pictureCacheCount,
       pictureCacheBytes,
       frameNumber,
+      for (final FrameRasterPhase phase in FrameRasterPhase.values)
+        rasterPhaseDurations[phase]?.inMicroseconds ?? 0,
     ]);
   }
 
   FrameTiming._(this._data)
       : assert(_data.length == _dataLength);
 
-  static final int _dataLength = FramePhase.values.length + _FrameTimingInfo.values.length;
+  static final int _dataLength =
+      FramePhase.values.length + _FrameTimingInfo.values.length + FrameRasterPhase.values.length;
 
   int timestampInMicroseconds(FramePhase phase) => _data[phase.index];
 
@@ -230,7 +246,10 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
-  int get frameNumber => _data.last;
+  int get frameNumber => _rawInfo(_FrameTimingInfo.frameNumber);
+
+  Duration rasterPhaseDuration(FrameRasterPhase phase) => Duration(
+      microseconds: _data[FramePhase.values.length + _FrameTimingInfo.values.length + phase.index]);
 
   final List<int> _data;  // some elements in microseconds, some in bytes, some are counts
 
@@ -246,7 +265,7 @@ class FrameTiming {
         'layerCacheBytes: $layerCacheBytes, '
         'pictureCacheCount: $pictureCacheCount, '
         'pictureCacheBytes: $pictureCacheBytes, '
-        'frameNumber: ${_data.last})';
+        'frameNumber: $frameNumber)';
   }
 }
 
@@ -63,7 +63,8 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
       std::move(image_decoder),       std::move(image_generator_registry),
       std::move(advisory_script_uri), std::move(advisory_script_entrypoint),
       context_.volatile_path_tracker, context_.concurrent_task_runner,
-      context_.enable_impeller,       context_.runtime_stage_backend};
+      context_.enable_impeller,       context_.runtime_stage_backend,
+      context_.compact_display_lists};
   auto result =
       std::make_unique<RuntimeController>(p_client,                      //
                                           vm_,                           //
@@ -299,6 +300,17 @@ bool RuntimeController::DispatchPlatformMessage(
   return false;
 }
 
+bool RuntimeController::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    TRACE_EVENT0("flutter", "RuntimeController::DispatchPlatformMessages");
+    platform_configuration->DispatchPlatformMessages(std::move(messages));
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::DispatchPointerDataPacket(
     const PointerDataPacket& packet) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
@@ -432,6 +432,20 @@ class RuntimeController : public PlatformConfigurationClient {
   virtual bool DispatchPlatformMessage(
       std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Dispatch the specified platform messages to the running root
+  ///             isolate, running the microtasks that each message schedules
+  ///             before the next message.
+  ///
+  /// @param[in]  messages  The messages to dispatch to the isolate, in the
+  ///                       order in which they were sent.
+  ///
+  /// @return     If the messages were dispatched to the running root isolate.
+  ///             This may fail is an isolate is not running.
+  ///
+  virtual bool DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatch the specified pointer data message to the running
   ///             root isolate.
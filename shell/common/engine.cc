@@ -109,6 +109,7 @@ Engine::Engine(Delegate& delegate,
           vm.GetConcurrentWorkerTaskRunner(),      // concurrent task runner
           settings_.enable_impeller,               // enable impeller
           runtime_stage_type,                      // runtime stage type
+          settings_.compact_display_lists,         // compact display lists
       });
 }
 
@@ -337,6 +338,43 @@ void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
   FML_DLOG(WARNING) << "Dropping platform message on channel: " << channel;
 }
 
+void Engine::DispatchPlatformMessages(
+    std::vector<std::unique_ptr<PlatformMessage>> messages) {
+  if (!runtime_controller_->IsRootIsolateRunning()) {
+    for (auto& message : messages) {
+      DispatchPlatformMessage(std::move(message));
+    }
+    return;
+  }
+
+  // Messages on the channels that the engine handles itself may change state
+  // that later messages depend on, so the messages before them are delivered
+  // first.
+  std::vector<std::unique_ptr<PlatformMessage>> batch;
+  auto flush_batch = [this, &batch]() {
+    size_t count = batch.size();
+    if (count == 1) {
+      DispatchPlatformMessage(std::move(batch.front()));
+    } else if (count > 1 &&
+               !runtime_controller_->DispatchPlatformMessages(
+                   std::move(batch))) {
+      FML_DLOG(WARNING) << "Dropping " << count << " platform messages";
+    }
+    batch.clear();
+  };
+  for (auto& message : messages) {
+    const std::string& channel = message->channel();
+    if (channel == kLifecycleChannel || channel == kLocalizationChannel ||
+        channel == kSettingsChannel) {
+      flush_batch();
+      DispatchPlatformMessage(std::move(message));
+    } else {
+      batch.push_back(std::move(message));
+    }
+  }
+  flush_batch();
+}
+
 bool Engine::HandleLifecyclePlatformMessage(PlatformMessage* message) {
   const auto& data = message->data();
   std::string state(reinterpret_cast<const char*>(data.GetMapping()),
@@ -766,6 +766,18 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the engine that the embedder has sent it messages
+  ///             in quick succession. The messages are handled in order, as
+  ///             if each had been sent on its own, without leaving the root
+  ///             isolate between the ones for the Dart application.
+  ///
+  /// @param[in]  messages  The messages sent from the embedder to the Dart
+  ///                       application.
+  ///
+  void DispatchPlatformMessages(
+      std::vector<std::unique_ptr<PlatformMessage>> messages);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the embedder has sent it a pointer
   ///             data packet. A pointer data packet may contain multiple
@@ -109,6 +109,10 @@ class MockRuntimeController : public RuntimeController {
               DispatchPlatformMessage,
               (std::unique_ptr<PlatformMessage>),
               (override));
+  MOCK_METHOD(bool,
+              DispatchPlatformMessages,
+              (std::vector<std::unique_ptr<PlatformMessage>>),
+              (override));
   MOCK_METHOD(void,
               LoadDartDeferredLibraryError,
               (intptr_t, const std::string, bool),
@@ -297,6 +301,60 @@ TEST_F(EngineTest, DispatchPlatformMessageInitialRouteIgnored) {
   });
 }
 
+TEST_F(EngineTest, DispatchPlatformMessagesBatchesMessagesInOrder) {
+  PostUITaskSync([this] {
+    MockRuntimeDelegate client;
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    std::vector<std::string> dispatched;
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*mock_runtime_controller,
+                DispatchPlatformMessages(::testing::_))
+        .WillRepeatedly(
+            [&dispatched](
+                const std::vector<std::unique_ptr<PlatformMessage>>& messages) {
+              std::string batch;
+              for (const auto& message : messages) {
+                batch += (batch.empty() ? "" : ",") + message->channel();
+              }
+              dispatched.push_back(batch);
+              return true;
+            });
+    EXPECT_CALL(*mock_runtime_controller, DispatchPlatformMessage(::testing::_))
+        .WillRepeatedly(
+            [&dispatched](const std::unique_ptr<PlatformMessage>& message) {
+              dispatched.push_back(message->channel());
+              return true;
+            });
+    auto engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller),
+        /*gpu_disabled_switch=*/std::make_shared<fml::SyncSwitch>());
+
+    // The localization message is handled by the engine, so the messages
+    // before it are delivered first.
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+    messages.push_back(std::make_unique<PlatformMessage>("a", nullptr));
+    messages.push_back(std::make_unique<PlatformMessage>("b", nullptr));
+    messages.push_back(MakePlatformMessage(
+        "flutter/localization", {{"method", "unknown"}}, nullptr));
+    messages.push_back(std::make_unique<PlatformMessage>("c", nullptr));
+    messages.push_back(std::make_unique<PlatformMessage>("d", nullptr));
+    engine->DispatchPlatformMessages(std::move(messages));
+
+    EXPECT_EQ(dispatched, std::vector<std::string>(
+                              {"a,b", "flutter/localization", "c,d"}));
+  });
+}
+
 TEST_F(EngineTest, SpawnSharesFontLibrary) {
   PostUITaskSync([this] {
     MockRuntimeDelegate client;
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:async';
 import 'dart:convert' show utf8, json;
 import 'dart:isolate';
 import 'dart:typed_data';
@@ -525,3 +526,29 @@ void testReportViewWidths() {
     nativeReportViewWidthsCallback(getCurrentViewWidths());
   };
 }
+
+@pragma('vm:external-name', 'NativeReportPlatformMessageEvents')
+external void nativeReportPlatformMessageEvents(List<String> events);
+
+// This entrypoint records the channel of every platform message it receives,
+// the microtask that each message schedules, and every metrics change. It
+// reports them once a message arrives on the 'done' channel.
+@pragma('vm:entry-point')
+void recordPlatformMessageEvents() {
+  final List<String> events = <String>[];
+  PlatformDispatcher.instance.onMetricsChanged = () {
+    events.add('metrics');
+  };
+  PlatformDispatcher.instance.onPlatformMessage =
+      (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    if (name == 'done') {
+      nativeReportPlatformMessageEvents(events);
+      return;
+    }
+    events.add(name);
+    scheduleMicrotask(() {
+      events.add('microtask $name');
+    });
+  };
+  notifyNative();
+}
@@ -199,5 +199,28 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, KeepsImpellerPipelineLogsPerGpu) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+
+  EXPECT_NE(PersistentCache::GetImpellerPipelineLogFileName("GPU A"),
+            PersistentCache::GetImpellerPipelineLogFileName("GPU B"));
+
+  persistent_cache->StoreImpellerPipelineLog(
+      "GPU A", std::make_unique<fml::DataMapping>(std::string("log")));
+  auto log = persistent_cache->LoadImpellerPipelineLog("GPU A");
+  ASSERT_NE(log, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(log->GetMapping()),
+                        log->GetSize()),
+            "log");
+  EXPECT_EQ(persistent_cache->LoadImpellerPipelineLog("GPU B"), nullptr);
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
 }  // namespace testing
 }  // namespace flutter
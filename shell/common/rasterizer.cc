@@ -49,6 +49,8 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  compositor_context_->raster_cache().SetDisplayListContentKeys(
+      delegate.GetSettings().enable_content_keyed_raster_cache);
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -555,6 +557,28 @@ Rasterizer::DoDrawResult Rasterizer::DrawToSurfaces(
   return result;
 }
 
+#if IMPELLER_SUPPORTS_RENDERING
+// Copies the phases that Impeller accumulated on its context while the views
+// were drawn into the frame's timings.
+static void RecordImpellerPhases(FrameTimingsRecorder& recorder,
+                                 const impeller::FramePhaseTimings& timings) {
+  static constexpr std::pair<impeller::FramePhase, FrameTiming::RasterPhase>
+      kPhases[] = {
+          {impeller::FramePhase::kDispatch, FrameTiming::kDispatch},
+          {impeller::FramePhase::kTessellation, FrameTiming::kTessellation},
+          {impeller::FramePhase::kGlyphAtlas, FrameTiming::kGlyphAtlas},
+          {impeller::FramePhase::kEncode, FrameTiming::kEncode},
+          {impeller::FramePhase::kSubmit, FrameTiming::kSubmit},
+      };
+  for (const auto& [impeller_phase, raster_phase] : kPhases) {
+    recorder.AddRasterPhaseDuration(
+        raster_phase,
+        timings.Get(impeller_phase) + timings.GetWorker(impeller_phase));
+  }
+  recorder.AddRasterPhaseDuration(FrameTiming::kGpu, timings.GetGPUDuration());
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     FrameTimingsRecorder& frame_timings_recorder,
     std::vector<std::unique_ptr<LayerTreeTask>> tasks) {
@@ -599,6 +623,13 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   }
 
   frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Context> impeller_context =
+      impeller_context_.lock();
+  if (impeller_context) {
+    impeller_context->GetFramePhaseTimings().Reset();
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
   // Second traverse: draw all layer trees.
   std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks;
@@ -607,8 +638,9 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
     std::unique_ptr<LayerTree> layer_tree = std::move(task->layer_tree);
     float device_pixel_ratio = task->device_pixel_ratio;
 
-    DrawSurfaceStatus status = DrawToSurfaceUnsafe(
-        view_id, *layer_tree, device_pixel_ratio, presentation_time);
+    DrawSurfaceStatus status =
+        DrawToSurfaceUnsafe(view_id, *layer_tree, device_pixel_ratio,
+                            presentation_time, frame_timings_recorder);
     FML_DCHECK(status != DrawSurfaceStatus::kDiscarded);
 
     auto& view_record = EnsureViewRecord(task->view_id);
@@ -621,6 +653,15 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
           view_id, std::move(layer_tree), device_pixel_ratio));
     }
   }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (impeller_context) {
+    // Encoding and submission may still be running on other threads. Their
+    // phases are reported with a later frame, like the GPU time.
+    impeller_context->EndFrameWork();
+    RecordImpellerPhases(frame_timings_recorder,
+                         impeller_context->GetFramePhaseTimings());
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
   // TODO(dkwingsmt): Pass in raster cache(s) for all views.
   // See https://github.com/flutter/flutter/issues/135530, item 4.
   frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
@@ -645,7 +686,8 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     int64_t view_id,
     flutter::LayerTree& layer_tree,
     float device_pixel_ratio,
-    std::optional<fml::TimePoint> presentation_time) {
+    std::optional<fml::TimePoint> presentation_time,
+    FrameTimingsRecorder& frame_timings_recorder) {
   FML_DCHECK(surface_);
 
   DlCanvas* embedder_root_canvas = nullptr;
@@ -685,6 +727,7 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
       surface_->GetAiksContext().get()  // aiks context
   );
   if (compositor_frame) {
+    compositor_frame->set_frame_timings_recorder(&frame_timings_recorder);
     compositor_context_->raster_cache().BeginFrame();
 
     std::unique_ptr<FrameDamage> damage;
@@ -701,10 +744,19 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
           (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
 
       damage = std::make_unique<FrameDamage>();
+      damage->SetWorkerTaskRunner(delegate_.GetConcurrentWorkerTaskRunner());
       auto existing_damage = frame->framebuffer_info().existing_damage;
       if (existing_damage.has_value() && !force_full_repaint) {
         damage->SetPreviousLayerTree(GetLastLayerTree(view_id));
-        damage->AddAdditionalDamage(existing_damage.value());
+        const auto& existing_damage_rects =
+            frame->framebuffer_info().existing_damage_rects;
+        if (existing_damage_rects.empty()) {
+          damage->AddAdditionalDamage(existing_damage.value());
+        }
+        for (const SkIRect& rect : existing_damage_rects) {
+          damage->AddAdditionalDamage(rect);
+        }
+        damage->SetMaxDamageRects(frame->framebuffer_info().max_damage_rects);
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
             frame->framebuffer_info().vertical_clip_alignment);
@@ -731,6 +783,8 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     if (damage) {
       submit_info.frame_damage = damage->GetFrameDamage();
       submit_info.buffer_damage = damage->GetBufferDamage();
+      submit_info.frame_damage_rects = damage->GetFrameDamageRects();
+      submit_info.buffer_damage_rects = damage->GetBufferDamageRects();
     }
 
     frame->set_submit_info(submit_info);
@@ -18,6 +18,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -169,6 +170,14 @@ class Rasterizer final : public SnapshotDelegate,
 
     virtual const Settings& GetSettings() const = 0;
 
+    /// The runner on which the rasterizer may spread work across worker
+    /// threads, such as diffing the layer tree for partial repaint. If
+    /// nullptr, all of that work happens on the raster thread.
+    virtual const std::shared_ptr<fml::ConcurrentTaskRunner>
+    GetConcurrentWorkerTaskRunner() const {
+      return nullptr;
+    }
+
     virtual bool ShouldDiscardLayerTree(int64_t view_id,
                                         const flutter::LayerTree& tree) = 0;
   };
@@ -704,7 +713,8 @@ class Rasterizer final : public SnapshotDelegate,
       int64_t view_id,
       flutter::LayerTree& layer_tree,
       float device_pixel_ratio,
-      std::optional<fml::TimePoint> presentation_time);
+      std::optional<fml::TimePoint> presentation_time,
+      FrameTimingsRecorder& frame_timings_recorder);
 
   ViewRecord& EnsureViewRecord(int64_t view_id);
 
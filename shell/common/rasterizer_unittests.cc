@@ -20,6 +20,10 @@
 #include "third_party/skia/include/gpu/GrTypes.h"
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/renderer/testing/mocks.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 #include "gmock/gmock.h"
 
 using testing::_;
@@ -1124,6 +1128,98 @@ TEST(RasterizerTest,
   latch.Wait();
 }
 
+#if IMPELLER_SUPPORTS_RENDERING
+TEST(RasterizerTest, drawRecordsImpellerPhasesWithoutWaitingForWorkers) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::kPlatform |
+                             ThreadHost::Type::kRaster | ThreadHost::Type::kIo |
+                             ThreadHost::Type::kUi);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  std::optional<FrameTiming> frame_timing;
+  EXPECT_CALL(delegate, OnFrameRasterized(_))
+      .WillOnce(::testing::Invoke(
+          [&](const FrameTiming& timing) { frame_timing = timing; }));
+
+  auto impeller_context =
+      std::make_shared<NiceMock<impeller::testing::MockImpellerContext>>();
+  impeller::FramePhaseTimings& timings =
+      impeller_context->GetFramePhaseTimings();
+  // Left over from earlier work, so it must not be reported for this frame.
+  timings.Add(impeller::FramePhase::kDispatch, fml::TimeDelta::FromSeconds(1));
+  // The worker tasks of an earlier frame have completed, while those of the
+  // frame being drawn are still running when it is reported.
+  timings.AddWorker(impeller::FramePhase::kEncode,
+                    fml::TimeDelta::FromMilliseconds(3));
+  timings.AddWorker(impeller::FramePhase::kSubmit,
+                    fml::TimeDelta::FromMilliseconds(4));
+  timings.CompleteWorkerFrame();
+  timings.AddWorker(impeller::FramePhase::kEncode,
+                    fml::TimeDelta::FromSeconds(1));
+  EXPECT_CALL(*impeller_context, EndFrameWork()).Times(1);
+
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  rasterizer->SetImpellerContext(impeller_context);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/
+      nullptr, framebuffer_info,
+      /*submit_callback=*/
+      [&](const SurfaceFrame&, DlCanvas*) {
+        timings.Add(impeller::FramePhase::kDispatch,
+                    fml::TimeDelta::FromMilliseconds(2));
+        return true;
+      },
+      /*frame_size=*/SkISize::Make(800, 600));
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  rasterizer->Setup(std::move(surface));
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<FramePipeline>(/*depth=*/10);
+    auto layer_tree = std::make_unique<LayerTree>(
+        /*config=*/LayerTree::Config(), /*frame_size=*/SkISize());
+    auto layer_tree_item = std::make_unique<FrameItem>(
+        SingleLayerTreeList(kImplicitViewId, std::move(layer_tree),
+                            kDevicePixelRatio),
+        CreateFinishedBuildRecorder());
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::move(layer_tree_item));
+    EXPECT_TRUE(result.success);
+    ON_CALL(delegate, ShouldDiscardLayerTree).WillByDefault(Return(false));
+    DrawStatus status = rasterizer->Draw(pipeline);
+    EXPECT_EQ(status, DrawStatus::kDone);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  ASSERT_TRUE(frame_timing.has_value());
+  EXPECT_EQ(frame_timing->GetRasterPhaseDuration(FrameTiming::kDispatch),
+            fml::TimeDelta::FromMilliseconds(2));
+  EXPECT_EQ(frame_timing->GetRasterPhaseDuration(FrameTiming::kEncode),
+            fml::TimeDelta::FromMilliseconds(3));
+  EXPECT_EQ(frame_timing->GetRasterPhaseDuration(FrameTiming::kSubmit),
+            fml::TimeDelta::FromMilliseconds(4));
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 TEST(RasterizerTest, TeardownFreesResourceCache) {
   std::string test_name =
       ::testing::UnitTest::GetInstance()->current_test_info()->name();
@@ -22,6 +22,7 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
@@ -50,6 +51,10 @@ constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
 
+// The most platform messages that are delivered to the UI thread by a single
+// task, so that a burst of messages cannot hold up the UI thread for long.
+constexpr size_t kMaxPlatformMessageBatchSize = 64;
+
 namespace {
 
 std::unique_ptr<Engine> CreateEngine(
@@ -143,6 +148,8 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  MultiFrameCodec::SetPrefetchLimits(settings.image_prefetch_frame_count,
+                                     settings.image_prefetch_budget_bytes);
 }
 
 }  // namespace
@@ -917,6 +924,7 @@ void Shell::OnPlatformViewDestroyed() {
 
   // Notify the Dart VM that the PlatformView has been destroyed and some
   // cleanup activity can be done (e.g: garbage collect the Dart heap).
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
     if (engine) {
       engine->NotifyDestroyed();
@@ -979,6 +987,7 @@ void Shell::OnPlatformViewScheduleFrame() {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
     if (engine) {
       engine->ScheduleFrame();
@@ -1011,6 +1020,7 @@ void Shell::OnPlatformViewSetViewportMetrics(int64_t view_id,
         }
       });
 
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), view_id, metrics]() {
         if (engine) {
@@ -1049,14 +1059,36 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   }
 #endif  // FLUTTER_RUNTIME_MODE == FLUTTER_RUNTIME_MODE_DEBUG
 
-  // The static leak checker gets confused by the use of fml::MakeCopyable.
-  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
-      [engine = engine_->GetWeakPtr(), message = std::move(message)]() mutable {
+  std::scoped_lock lock(platform_message_batches_->mutex);
+  std::shared_ptr<PlatformMessageBatch>& open = platform_message_batches_->open;
+  if (open && open->messages.size() < kMaxPlatformMessageBatchSize) {
+    open->messages.push_back(std::move(message));
+    return;
+  }
+
+  open = std::make_shared<PlatformMessageBatch>();
+  open->messages.push_back(std::move(message));
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), batches = platform_message_batches_,
+       batch = open]() {
+        std::vector<std::unique_ptr<PlatformMessage>> messages;
+        {
+          // Once its task runs the batch takes no more messages.
+          std::scoped_lock lock(batches->mutex);
+          if (batches->open == batch) {
+            batches->open.reset();
+          }
+          messages.swap(batch->messages);
+        }
         if (engine) {
-          engine->DispatchPlatformMessage(std::move(message));
+          engine->DispatchPlatformMessages(std::move(messages));
         }
-      }));
+      });
+}
+
+void Shell::ClosePlatformMessageBatch() {
+  std::scoped_lock lock(platform_message_batches_->mutex);
+  platform_message_batches_->open.reset();
 }
 
 // |PlatformView::Delegate|
@@ -1068,6 +1100,7 @@ void Shell::OnPlatformViewDispatchPointerDataPacket(
   TRACE_FLOW_BEGIN("flutter", "PointerEvent", next_pointer_flow_id_);
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = weak_engine_, packet = std::move(packet),
                          flow_id = next_pointer_flow_id_]() mutable {
@@ -1085,6 +1118,7 @@ void Shell::OnPlatformViewDispatchSemanticsAction(int32_t node_id,
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       fml::MakeCopyable([engine = engine_->GetWeakPtr(), node_id, action,
                          args = std::move(args)]() mutable {
@@ -1099,6 +1133,7 @@ void Shell::OnPlatformViewSetSemanticsEnabled(bool enabled) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), enabled] {
         if (engine) {
@@ -1112,6 +1147,7 @@ void Shell::OnPlatformViewSetAccessibilityFeatures(int32_t flags) {
   FML_DCHECK(is_set_up_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), flags] {
         if (engine) {
@@ -1175,6 +1211,7 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
       });
 
   // Schedule a new frame without having to rebuild the layer tree.
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr()]() {
     if (engine) {
       engine->ScheduleFrame(false);
@@ -1460,6 +1497,7 @@ void Shell::LoadDartDeferredLibrary(
     intptr_t loading_unit_id,
     std::unique_ptr<const fml::Mapping> snapshot_data,
     std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
       [engine = engine_->GetWeakPtr(), loading_unit_id,
        data = std::move(snapshot_data),
@@ -1474,6 +1512,7 @@ void Shell::LoadDartDeferredLibrary(
 void Shell::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                          const std::string error_message,
                                          bool transient) {
+  ClosePlatformMessageBatch();
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
       [engine = weak_engine_, loading_unit_id, error_message, transient] {
@@ -1561,6 +1600,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
   unreported_timings_.push_back(timing.GetFrameNumber());
+  for (auto phase : FrameTiming::kRasterPhases) {
+    unreported_timings_.push_back(
+        timing.GetRasterPhaseDuration(phase).ToMicroseconds());
+  }
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
 
@@ -1847,6 +1890,7 @@ void Shell::RegisterImageDecoder(ImageGeneratorFactory factory,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
   FML_DCHECK(is_set_up_);
 
+  ClosePlatformMessageBatch();
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
       [engine = engine_->GetWeakPtr(), factory = std::move(factory),
@@ -2101,6 +2145,7 @@ void Shell::AddView(int64_t view_id, const ViewportMetrics& viewport_metrics) {
       << "Unexpected request to add the implicit view #"
       << kFlutterImplicitViewId << ". This view should never be added.";
 
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask([engine = engine_->GetWeakPtr(),  //
                                              viewport_metrics,                //
                                              view_id                          //
@@ -2120,6 +2165,7 @@ void Shell::RemoveView(int64_t view_id) {
       << kFlutterImplicitViewId << ". This view should never be removed.";
 
   expected_frame_sizes_.erase(view_id);
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       [&task_runners = task_runners_,           //
        engine = engine_->GetWeakPtr(),          //
@@ -2246,6 +2292,7 @@ void Shell::OnDisplayUpdates(std::vector<std::unique_ptr<Display>> displays) {
   for (const auto& display : displays) {
     display_data.push_back(display->GetDisplayData());
   }
+  ClosePlatformMessageBatch();
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(),
        display_data = std::move(display_data)]() {
@@ -439,8 +439,9 @@ class Shell final : public PlatformView::Delegate,
 
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
+  // |Rasterizer::Delegate|
   const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  GetConcurrentWorkerTaskRunner() const override;
 
   // Infer the VM ref and the isolate snapshot based on the settings.
   //
@@ -467,6 +468,26 @@ class Shell final : public PlatformView::Delegate,
   /// multiple messages per second indefinitely.
   std::mutex misbehaving_message_channels_mutex_;
   std::set<std::string> misbehaving_message_channels_;
+
+  /// Platform messages that are delivered to the UI thread by a single task.
+  /// The root isolate receives them in a single call, and runs the
+  /// microtasks that each one schedules before the next.
+  struct PlatformMessageBatch {
+    std::vector<std::unique_ptr<PlatformMessage>> messages;
+  };
+
+  /// The batch that platform messages are added to until its task runs, it
+  /// is full, or another platform event is posted to the UI thread, which
+  /// must not be overtaken by later messages. The mutex also guards the
+  /// messages of every batch, so that adding a message and taking a batch
+  /// for dispatch each lock only once. It is shared with the posted tasks,
+  /// which may outlive the shell.
+  struct PlatformMessageBatches {
+    std::mutex mutex;
+    std::shared_ptr<PlatformMessageBatch> open;
+  };
+  const std::shared_ptr<PlatformMessageBatches> platform_message_batches_ =
+      std::make_shared<PlatformMessageBatches>();
   const TaskRunners task_runners_;
   const fml::RefPtr<fml::RasterThreadMerger> parent_raster_thread_merger_;
   std::shared_ptr<ResourceCacheLimitCalculator>
@@ -583,6 +604,10 @@ class Shell final : public PlatformView::Delegate,
 
   void ReportTimings();
 
+  /// Starts a new batch for the next platform message, so that it is
+  /// delivered after the platform event that is about to be posted.
+  void ClosePlatformMessageBatch();
+
   // |PlatformView::Delegate|
   void OnPlatformViewCreated(std::unique_ptr<Surface> surface) override;
 
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <chrono>
 #include <ctime>
+#include <functional>
 #include <future>
 #include <memory>
 #include <thread>
@@ -4356,6 +4357,90 @@ TEST_F(ShellTest, PrintsErrorWhenPlatformMessageSentFromWrongThread) {
 #endif
 }
 
+// Runs the "recordPlatformMessageEvents" entrypoint, calls |send| on the
+// platform thread while the UI thread is busy, and returns the events that the
+// entrypoint recorded until the "done" message.
+static std::vector<std::string> RecordPlatformMessageEvents(
+    ShellTest& test,
+    const std::function<void(Shell& shell)>& send) {
+  Settings settings = test.CreateSettingsForFixture();
+  TaskRunners task_runners = test.GetTaskRunnersForFixture();
+  std::unique_ptr<Shell> shell = test.CreateShell(settings, task_runners);
+  EXPECT_TRUE(ValidateShell(shell.get()));
+
+  fml::AutoResetWaitableEvent ready_latch;
+  test.AddNativeCallback("NotifyNative",
+                         CREATE_NATIVE_ENTRY([&ready_latch](auto args) {
+                           ready_latch.Signal();
+                         }));
+  fml::AutoResetWaitableEvent report_latch;
+  std::vector<std::string> events;
+  test.AddNativeCallback(
+      "NativeReportPlatformMessageEvents", CREATE_NATIVE_ENTRY([&](auto args) {
+        Dart_Handle exception = nullptr;
+        events = tonic::DartConverter<std::vector<std::string>>::FromArguments(
+            args, 0, exception);
+        EXPECT_EQ(exception, nullptr);
+        report_latch.Signal();
+      }));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("recordPlatformMessageEvents");
+  test.RunEngine(shell.get(), std::move(configuration));
+  ready_latch.Wait();
+
+  // Keep the UI thread busy so that the messages are sent before any of them
+  // is delivered.
+  fml::AutoResetWaitableEvent ui_latch;
+  task_runners.GetUITaskRunner()->PostTask([&ui_latch] { ui_latch.Wait(); });
+  fml::AutoResetWaitableEvent sent_latch;
+  task_runners.GetPlatformTaskRunner()->PostTask([&] {
+    send(*shell);
+    test.SendPlatformMessage(
+        shell.get(), std::make_unique<PlatformMessage>("done", nullptr));
+    sent_latch.Signal();
+  });
+  sent_latch.Wait();
+  ui_latch.Signal();
+  report_latch.Wait();
+
+  test.DestroyShell(std::move(shell), task_runners);
+  return events;
+}
+
+TEST_F(ShellTest, BatchedPlatformMessagesRunMicrotasksBetweenMessages) {
+  auto events = RecordPlatformMessageEvents(*this, [this](Shell& shell) {
+    SendPlatformMessage(&shell,
+                        std::make_unique<PlatformMessage>("a", nullptr));
+    SendPlatformMessage(&shell,
+                        std::make_unique<PlatformMessage>("b", nullptr));
+  });
+  EXPECT_EQ(events, std::vector<std::string>(
+                        {"a", "microtask a", "b", "microtask b"}));
+}
+
+TEST_F(ShellTest, BatchedPlatformMessagesDoNotOvertakeOtherEvents) {
+  // More messages than fit in one batch follow the metrics change.
+  constexpr int kMessageCount = 200;
+  auto events = RecordPlatformMessageEvents(*this, [this](Shell& shell) {
+    SendPlatformMessage(&shell,
+                        std::make_unique<PlatformMessage>("a", nullptr));
+    shell.GetPlatformView()->SetViewportMetrics(kImplicitViewId,
+                                                {0.8, 400, 200, 22, 0});
+    for (int i = 0; i < kMessageCount; i++) {
+      SendPlatformMessage(&shell, std::make_unique<PlatformMessage>(
+                                      std::to_string(i), nullptr));
+    }
+  });
+
+  std::vector<std::string> expected_events = {"a", "microtask a", "metrics"};
+  for (int i = 0; i < kMessageCount; i++) {
+    expected_events.push_back(std::to_string(i));
+    expected_events.push_back("microtask " + std::to_string(i));
+  }
+  EXPECT_EQ(events, expected_events);
+}
+
 TEST_F(ShellTest, DiesIfSoftwareRenderingAndImpellerAreEnabledDeathTest) {
 #if defined(OS_FUCHSIA)
   GTEST_SKIP() << "Fuchsia";
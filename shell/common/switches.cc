@@ -501,6 +501,11 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  settings.enable_content_keyed_raster_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnableContentKeyedRasterCache));
+  settings.compact_display_lists =
+      command_line.HasOption(FlagForSwitch(Switch::CompactDisplayLists));
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
@@ -518,6 +523,24 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::ImagePrefetchFrameCount))) {
+    std::string image_prefetch_frame_count;
+    command_line.GetOptionValue(FlagForSwitch(Switch::ImagePrefetchFrameCount),
+                                &image_prefetch_frame_count);
+    settings.image_prefetch_frame_count =
+        std::stoi(image_prefetch_frame_count);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImagePrefetchBudgetBytes))) {
+    std::string image_prefetch_budget_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImagePrefetchBudgetBytes),
+        &image_prefetch_budget_bytes);
+    settings.image_prefetch_budget_bytes =
+        std::stoull(image_prefetch_budget_bytes);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
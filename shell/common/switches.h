@@ -191,6 +191,15 @@ DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
            "purposes such as reproducing the shader compilation jank.")
+DEF_SWITCH(EnableContentKeyedRasterCache,
+           "enable-content-keyed-raster-cache",
+           "Key raster cache entries of pictures by the content of the "
+           "picture rather than by the picture object, so that identical "
+           "pictures recorded again in later frames reuse cached images.")
+DEF_SWITCH(CompactDisplayLists,
+           "compact-display-lists",
+           "Record pictures into a compact encoding of their drawing "
+           "operations that uses less memory but takes longer to render.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
@@ -262,6 +271,14 @@ DEF_SWITCH(OldGenHeapSize,
 DEF_SWITCH(ResourceCacheMaxBytesThreshold,
            "resource-cache-max-bytes-threshold",
            "The max bytes threshold of resource cache, or 0 for unlimited.")
+DEF_SWITCH(ImagePrefetchFrameCount,
+           "image-prefetch-frame-count",
+           "The number of frames of each animated image to decode ahead of "
+           "the frame being displayed, or 0 to disable prefetching.")
+DEF_SWITCH(ImagePrefetchBudgetBytes,
+           "image-prefetch-budget-bytes",
+           "The max bytes that the prefetched frames of all animated images "
+           "may use.")
 DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
@@ -87,6 +87,21 @@ TEST(SwitchesTest, MsaaSamples) {
   EXPECT_EQ(settings.msaa_samples, 0);
 }
 
+TEST(SwitchesTest, ImagePrefetchLimits) {
+  fml::CommandLine command_line =
+      fml::CommandLineFromInitializerList({"command"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.image_prefetch_frame_count, 2);
+  EXPECT_EQ(settings.image_prefetch_budget_bytes, 32u * 1024 * 1024);
+
+  command_line = fml::CommandLineFromInitializerList(
+      {"command", "--image-prefetch-frame-count=0",
+       "--image-prefetch-budget-bytes=1048576"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.image_prefetch_frame_count, 0);
+  EXPECT_EQ(settings.image_prefetch_budget_bytes, 1048576u);
+}
+
 TEST(SwitchesTest, EnableEmbedderAPI) {
   {
     // enable
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
@@ -29,6 +30,9 @@ struct GLFBOInfo {
   uint32_t fbo_id;
   // The frame buffer's existing damage (i.e. damage since it was last used).
   const std::optional<SkIRect> existing_damage;
+  // The rects that make up the existing damage, if known. Their bounds are
+  // the existing damage.
+  const std::vector<SkIRect> existing_damage_rects = {};
 };
 
 // Information passed during presentation of a frame.
@@ -46,6 +50,12 @@ struct GLPresentInfo {
   // The buffer damage refers to the region that needs to be set as damaged
   // within the frame buffer.
   const std::optional<SkIRect>& buffer_damage;
+
+  // The frame and buffer damage split into non-overlapping rects, at most
+  // |SurfaceFrame::FramebufferInfo::max_damage_rects| of each. Empty if the
+  // damage is empty or unspecified.
+  std::vector<SkIRect> frame_damage_rects = {};
+  std::vector<SkIRect> buffer_damage_rects = {};
 };
 
 class GPUSurfaceGLDelegate {
@@ -111,11 +111,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
         auto cull_rect =
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
+        auto dispatch_start = fml::TimePoint::Now();
         impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
         display_list->Dispatch(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        aiks_context->GetContext()->GetFramePhaseTimings().Add(
+            impeller::FramePhase::kDispatch,
+            fml::TimePoint::Now() - dispatch_start);
 
         return renderer->Render(
             std::move(surface),
@@ -202,6 +202,7 @@ bool GPUSurfaceGLSkia::CreateOrUpdateSurfaces(const SkISize& size) {
   onscreen_surface_ = std::move(onscreen_surface);
   fbo_id_ = fbo_info.fbo_id;
   existing_damage_ = fbo_info.existing_damage;
+  existing_damage_rects_ = fbo_info.existing_damage_rects;
 
   return true;
 }
@@ -257,6 +258,7 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLSkia::AcquireFrame(
   framebuffer_info = delegate_->GLContextFramebufferInfo();
   if (!framebuffer_info.existing_damage.has_value()) {
     framebuffer_info.existing_damage = existing_damage_;
+    framebuffer_info.existing_damage_rects = existing_damage_rects_;
   }
   return std::make_unique<SurfaceFrame>(surface, framebuffer_info,
                                         submit_callback, size,
@@ -281,6 +283,8 @@ bool GPUSurfaceGLSkia::PresentSurface(const SurfaceFrame& frame,
       .frame_damage = frame.submit_info().frame_damage,
       .presentation_time = frame.submit_info().presentation_time,
       .buffer_damage = frame.submit_info().buffer_damage,
+      .frame_damage_rects = frame.submit_info().frame_damage_rects,
+      .buffer_damage_rects = frame.submit_info().buffer_damage_rects,
   };
   if (!delegate_->GLContextPresent(present_info)) {
     return false;
@@ -309,6 +313,7 @@ bool GPUSurfaceGLSkia::PresentSurface(const SurfaceFrame& frame,
     onscreen_surface_ = std::move(new_onscreen_surface);
     fbo_id_ = fbo_info.fbo_id;
     existing_damage_ = fbo_info.existing_damage;
+    existing_damage_rects_ = fbo_info.existing_damage_rects;
   }
 
   return true;
@@ -12,6 +12,7 @@
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/renderer/backend/metal/context_mtl.h"
 #include "impeller/renderer/backend/metal/surface_mtl.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 
@@ -29,6 +30,17 @@ static std::shared_ptr<impeller::Renderer> CreateImpellerRenderer(
   return renderer;
 }
 
+static std::shared_ptr<impeller::TypographerContext> CreateTypographerContext(
+    const std::shared_ptr<impeller::Context>& context) {
+  if (!context || !context->IsValid()) {
+    return impeller::TypographerContextSkia::Make();
+  }
+  // Large glyph atlas updates are rasterized on the same workers that Impeller uses for
+  // the rest of the frame.
+  return impeller::TypographerContextSkia::Make(
+      impeller::ContextMTL::Cast(*context).GetWorkerTaskRunner());
+}
+
 GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
                                                  const std::shared_ptr<impeller::Context>& context,
                                                  bool render_to_surface)
@@ -37,7 +49,7 @@ GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delega
       impeller_renderer_(CreateImpellerRenderer(context)),
       aiks_context_(
           std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr,
-                                                  impeller::TypographerContextSkia::Make())),
+                                                  CreateTypographerContext(context))),
       render_to_surface_(render_to_surface) {
   // If this preference is explicitly set, we allow for disabling partial repaint.
   NSNumber* disablePartialRepaint =
@@ -45,6 +57,13 @@ GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delega
   if (disablePartialRepaint != nil) {
     disable_partial_repaint_ = disablePartialRepaint.boolValue;
   }
+
+  // Log the pipeline variants that this run uses, and compile the ones that previous runs used
+  // before the first frames need them.
+  if (IsValid()) {
+    pipeline_log_ = std::make_unique<GPUSurfacePipelineLog>(
+        aiks_context_, impeller::ContextMTL::Cast(*context).GetWorkerTaskRunner());
+  }
 }
 
 GPUSurfaceMetalImpeller::~GPUSurfaceMetalImpeller() = default;
@@ -68,6 +87,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrame(const SkISiz
     return nullptr;
   }
 
+  pipeline_log_->OnAcquireFrame();
+
   if (!render_to_surface_) {
     return std::make_unique<SurfaceFrame>(
         nullptr, SurfaceFrame::FramebufferInfo(),
@@ -155,9 +176,13 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
 
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.GetWidth(), cull_rect.GetHeight());
+        auto dispatch_start = fml::TimePoint::Now();
         impeller::DlDispatcher impeller_dispatcher(cull_rect);
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        aiks_context->GetContext()->GetFramePhaseTimings().Add(
+            impeller::FramePhase::kDispatch,
+            fml::TimePoint::Now() - dispatch_start);
 
         return renderer->Render(
             std::move(surface),
@@ -253,9 +278,13 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
 
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.GetWidth(), cull_rect.GetHeight());
+        auto dispatch_start = fml::TimePoint::Now();
         impeller::DlDispatcher impeller_dispatcher(cull_rect);
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        aiks_context->GetContext()->GetFramePhaseTimings().Add(
+            impeller::FramePhase::kDispatch,
+            fml::TimePoint::Now() - dispatch_start);
 
         bool render_result =
             renderer->Render(std::move(surface),
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/gpu/gpu_surface_pipeline_log.h"
+
+#include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+GPUSurfacePipelineLog::GPUSurfacePipelineLog(
+    std::shared_ptr<impeller::AiksContext> aiks_context,
+    std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
+    : aiks_context_(std::move(aiks_context)),
+      worker_task_runner_(std::move(worker_task_runner)),
+      gpu_model_(aiks_context_->GetContext()->DescribeGpuModel()),
+      log_(std::make_shared<impeller::PipelineWarmupLog>()),
+      load_result_(std::make_shared<LoadResult>()),
+      save_in_flight_(std::make_shared<std::atomic<bool>>(false)),
+      last_save_(fml::TimePoint::Now()) {
+  aiks_context_->GetContentContext().SetPipelineWarmupLog(log_);
+
+  PostToWorker([load_result = load_result_, gpu_model = gpu_model_]() {
+    TRACE_EVENT0("flutter", "GPUSurfacePipelineLog::Load");
+    std::shared_ptr<impeller::PipelineWarmupLog> log;
+    if (auto mapping = PersistentCache::GetCacheForProcess()
+                           ->LoadImpellerPipelineLog(gpu_model)) {
+      log = impeller::PipelineWarmupLog::Deserialize(*mapping);
+    }
+    std::scoped_lock lock(load_result->mutex);
+    load_result->log = std::move(log);
+    load_result->done = true;
+  });
+}
+
+GPUSurfacePipelineLog::~GPUSurfacePipelineLog() {
+  // If the saved log has not been loaded yet, the entries of this run are
+  // dropped rather than written over it.
+  if (!MergeLoadedLog(/*warm_up=*/false) || !log_->HasUnsavedEntries()) {
+    return;
+  }
+  // A save that is in flight may have serialized the log before the last
+  // entries were recorded, so this one is not skipped.
+  save_in_flight_->store(true);
+  Save();
+}
+
+void GPUSurfacePipelineLog::OnAcquireFrame() {
+  if (!MergeLoadedLog(/*warm_up=*/true)) {
+    return;
+  }
+
+  auto now = fml::TimePoint::Now();
+  if (now - last_save_ < kSaveInterval || !log_->HasUnsavedEntries()) {
+    return;
+  }
+  last_save_ = now;
+  if (save_in_flight_->exchange(true)) {
+    return;
+  }
+  Save();
+}
+
+bool GPUSurfacePipelineLog::MergeLoadedLog(bool warm_up) {
+  if (loaded_) {
+    return true;
+  }
+
+  std::shared_ptr<impeller::PipelineWarmupLog> loaded_log;
+  {
+    std::scoped_lock lock(load_result_->mutex);
+    if (!load_result_->done) {
+      return false;
+    }
+    loaded_log = std::move(load_result_->log);
+  }
+  loaded_ = true;
+  if (!loaded_log) {
+    return true;
+  }
+
+  for (const auto& entry : log_->GetEntries()) {
+    loaded_log->Record(entry.pipeline_name, entry.options_key);
+  }
+  auto& content_context = aiks_context_->GetContentContext();
+  content_context.SetPipelineWarmupLog(loaded_log);
+  log_ = std::move(loaded_log);
+  if (warm_up) {
+    content_context.WarmUpPipelines(*log_);
+  }
+  return true;
+}
+
+void GPUSurfacePipelineLog::Save() {
+  PostToWorker([log = log_,              //
+                gpu_model = gpu_model_,  //
+                save_in_flight = save_in_flight_]() {
+    TRACE_EVENT0("flutter", "GPUSurfacePipelineLog::Save");
+    PersistentCache::GetCacheForProcess()->StoreImpellerPipelineLog(
+        gpu_model, log->Serialize());
+    save_in_flight->store(false);
+  });
+}
+
+void GPUSurfacePipelineLog::PostToWorker(const fml::closure& task) const {
+  if (worker_task_runner_) {
+    worker_task_runner_->PostTask(task);
+  } else {
+    task();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_PIPELINE_LOG_H_
+#define FLUTTER_SHELL_GPU_GPU_SURFACE_PIPELINE_LOG_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/entity/contents/pipeline_warmup_log.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the |PipelineWarmupLog| of an Impeller surface in the
+///             |PersistentCache|, so that the pipeline variants that previous
+///             runs created are compiled before the first frames need them.
+///
+///             The surface owns this on the raster thread. The saved log is
+///             read and deserialized, and new entries are serialized, on the
+///             worker task runner of the backend, so neither the first frame
+///             nor the frames that save the log wait on file I/O. The
+///             variants are still created on the raster thread because the
+///             variant maps of the |ContentContext| are not thread-safe. The
+///             backends that use this compile pipelines asynchronously, so
+///             that only queues the compilations.
+///
+class GPUSurfacePipelineLog {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Starts logging the variants that `aiks_context` creates and
+  ///             starts loading the log of previous runs on
+  ///             `worker_task_runner`. Without a worker task runner, the
+  ///             tasks run on the calling thread.
+  ///
+  GPUSurfacePipelineLog(
+      std::shared_ptr<impeller::AiksContext> aiks_context,
+      std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
+
+  /// Saves the entries that were not saved yet.
+  ~GPUSurfacePipelineLog();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the surface on the raster thread before each
+  ///             frame. Warms up the variants of the saved log once it has
+  ///             been loaded and periodically saves the new entries.
+  ///
+  void OnAcquireFrame();
+
+ private:
+  struct LoadResult {
+    std::mutex mutex;
+    bool done = false;
+    std::shared_ptr<impeller::PipelineWarmupLog> log;
+  };
+
+  /// How often new entries of the log are saved while frames are being
+  /// rendered. The process may be killed without the surface ever being
+  /// destroyed.
+  static constexpr fml::TimeDelta kSaveInterval =
+      fml::TimeDelta::FromSeconds(2);
+
+  const std::shared_ptr<impeller::AiksContext> aiks_context_;
+  const std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
+  const std::string gpu_model_;
+  std::shared_ptr<impeller::PipelineWarmupLog> log_;
+  const std::shared_ptr<LoadResult> load_result_;
+  // Whether |load_result_| has been merged into |log_|.
+  bool loaded_ = false;
+  const std::shared_ptr<std::atomic<bool>> save_in_flight_;
+  fml::TimePoint last_save_;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replaces |log_| with the saved log once it has been loaded,
+  ///             keeping the entries recorded in the meantime.
+  ///
+  /// @return     Whether the load has finished. Until then, saving |log_|
+  ///             would overwrite the entries of previous runs.
+  ///
+  bool MergeLoadedLog(bool warm_up);
+
+  void Save();
+
+  void PostToWorker(const fml::closure& task) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfacePipelineLog);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_GPU_GPU_SURFACE_PIPELINE_LOG_H_
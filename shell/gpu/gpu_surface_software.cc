@@ -7,15 +7,19 @@
 #include <memory>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
-GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                                       bool render_to_surface)
+GPUSurfaceSoftware::GPUSurfaceSoftware(
+    GPUSurfaceSoftwareDelegate* delegate,
+    bool render_to_surface,
+    std::shared_ptr<DlSkTiledRasterizer> tiled_rasterizer)
     : delegate_(delegate),
       render_to_surface_(render_to_surface),
+      tiled_rasterizer_(std::move(tiled_rasterizer)),
       weak_factory_(this) {}
 
 GPUSurfaceSoftware::~GPUSurfaceSoftware() = default;
@@ -58,6 +62,10 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  if (tiled_rasterizer_) {
+    return AcquireTiledFrame(backing_store, framebuffer_info, size);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -81,6 +89,51 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
                                         on_submit, logical_size);
 }
 
+std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireTiledFrame(
+    const sk_sp<SkSurface>& backing_store,
+    const SurfaceFrame::FramebufferInfo& framebuffer_info,
+    const SkISize& size) {
+  // The frame is recorded into a DisplayList with an rtree so that each tile
+  // only dispatches the ops that intersect it.
+  SurfaceFrame::SubmitCallback on_submit =
+      [self = weak_factory_.GetWeakPtr(), backing_store](
+          SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+    // If the surface itself went away, there is nothing more to do.
+    if (!self || !self->IsValid() || canvas == nullptr) {
+      return false;
+    }
+
+    auto display_list = surface_frame.BuildDisplayList();
+    if (!display_list) {
+      return false;
+    }
+
+    // The pixels are written without going through the surface's canvas, so
+    // detach any snapshot that may still share them first.
+    backing_store->notifyContentWillChange(
+        SkSurface::kDiscard_ContentChangeMode);
+    SkPixmap pixmap;
+    if (!backing_store->peekPixels(&pixmap)) {
+      return false;
+    }
+
+    {
+      TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RasterizeTiles");
+      if (!self->tiled_rasterizer_->Rasterize(display_list, pixmap)) {
+        return false;
+      }
+    }
+
+    return self->delegate_->PresentBackingStore(backing_store);
+  };
+
+  return std::make_unique<SurfaceFrame>(nullptr, framebuffer_info, on_submit,
+                                        size,
+                                        /*context_result=*/nullptr,
+                                        /*display_list_fallback=*/true,
+                                        /*display_list_rtree=*/true);
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
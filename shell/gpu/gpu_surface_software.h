@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_H_
 
+#include "flutter/display_list/skia/dl_sk_tiled_rasterizer.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -14,8 +15,16 @@ namespace flutter {
 
 class GPUSurfaceSoftware : public Surface {
  public:
-  GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
-                     bool render_to_surface);
+  //----------------------------------------------------------------------------
+  /// @param[in]  tiled_rasterizer  When non-null, frames are recorded into a
+  ///                               DisplayList and rendered into the backing
+  ///                               store in parallel tiles on submit instead
+  ///                               of being drawn directly into it.
+  ///
+  GPUSurfaceSoftware(
+      GPUSurfaceSoftwareDelegate* delegate,
+      bool render_to_surface,
+      std::shared_ptr<DlSkTiledRasterizer> tiled_rasterizer = nullptr);
 
   ~GPUSurfaceSoftware() override;
 
@@ -38,7 +47,14 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  const std::shared_ptr<DlSkTiledRasterizer> tiled_rasterizer_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  std::unique_ptr<SurfaceFrame> AcquireTiledFrame(
+      const sk_sp<SkSurface>& backing_store,
+      const SurfaceFrame::FramebufferInfo& framebuffer_info,
+      const SkISize& size);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
@@ -6,6 +6,7 @@
 
 #include "flutter/fml/make_copyable.h"
 #include "impeller/display_list/dl_dispatcher.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_context_vk.h"
 #include "impeller/renderer/renderer.h"
 #include "impeller/renderer/surface.h"
@@ -24,12 +25,22 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     return;
   }
 
+  // Large glyph atlas updates are rasterized on the same workers that
+  // Impeller uses for the rest of the frame.
+  auto worker_task_runner = impeller::SurfaceContextVK::Cast(*context)
+                                .GetParent()
+                                ->GetConcurrentWorkerTaskRunner();
   auto aiks_context = std::make_shared<impeller::AiksContext>(
-      context, impeller::TypographerContextSkia::Make());
+      context, impeller::TypographerContextSkia::Make(worker_task_runner));
   if (!aiks_context->IsValid()) {
     return;
   }
 
+  // Log the pipeline variants that this run uses, and compile the ones that
+  // previous runs used before the first frames need them.
+  pipeline_log_ = std::make_unique<GPUSurfacePipelineLog>(
+      aiks_context, std::move(worker_task_runner));
+
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
   aiks_context_ = std::move(aiks_context);
@@ -57,6 +68,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
     return nullptr;
   }
 
+  pipeline_log_->OnAcquireFrame();
+
   auto& context_vk = impeller::SurfaceContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
 
@@ -83,11 +96,15 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
         auto cull_rect =
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
         impeller::Rect dl_cull_rect = impeller::Rect::MakeSize(cull_rect);
+        auto dispatch_start = fml::TimePoint::Now();
         impeller::DlDispatcher impeller_dispatcher(dl_cull_rect);
         display_list->Dispatch(
             impeller_dispatcher,
             SkIRect::MakeWH(cull_rect.width, cull_rect.height));
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
+        aiks_context->GetContext()->GetFramePhaseTimings().Add(
+            impeller::FramePhase::kDispatch,
+            fml::TimePoint::Now() - dispatch_start);
 
         return renderer->Render(
             std::move(surface),
@@ -11,6 +11,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/impeller/aiks/aiks_context.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/shell/gpu/gpu_surface_pipeline_log.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_delegate.h"
 
 namespace flutter {
@@ -29,6 +30,7 @@ class GPUSurfaceVulkanImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  std::unique_ptr<GPUSurfacePipelineLog> pipeline_log_;
   bool is_valid_ = false;
 
   // |Surface|
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_READER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "encodable_value.h"
+#include "standard_codec_serializer.h"
+
+namespace flutter {
+
+// A read-only view of a contiguous array of |T|s owned by someone else.
+template <typename T>
+class TypedDataView {
+ public:
+  TypedDataView() = default;
+  TypedDataView(const T* data, size_t size) : data_(data), size_(size) {}
+
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+
+  const T& operator[](size_t index) const { return data_[index]; }
+
+ private:
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Reads values one at a time from a message in the standard codec binary
+// representation, without building an EncodableValue tree.
+//
+// Strings and typed lists are returned as views into the message rather than
+// being copied. The message must outlive the reader and every view returned
+// by it. Typed lists are aligned relative to the start of the message, so
+// they can only be viewed in place if the message itself is suitably aligned,
+// which is the case for messages delivered by the engine; otherwise they are
+// copied into storage owned by the reader.
+//
+// Lists and maps are read as a length followed by that many values, or twice
+// as many for maps, alternating between keys and values.
+//
+// Each Read method returns false without consuming anything if the next value
+// is not of the requested type, so callers can try another type. Reading
+// past the end of the message is an error, after which every read fails.
+class StandardCodecReader {
+ public:
+  // Creates a reader for the |message_size| bytes at |message|.
+  explicit StandardCodecReader(const uint8_t* message, size_t message_size);
+
+  ~StandardCodecReader();
+
+  // Prevent copying.
+  StandardCodecReader(StandardCodecReader const&) = delete;
+  StandardCodecReader& operator=(StandardCodecReader const&) = delete;
+
+  // Returns true if the whole message has been read.
+  bool AtEnd() const { return location_ >= size_; }
+
+  // Returns true if the message was malformed or truncated.
+  bool has_error() const { return has_error_; }
+
+  // Returns the type of the next value without consuming it, or false if
+  // there are no more values.
+  bool PeekType(StandardCodecType* type) const;
+
+  bool ReadNull();
+
+  bool ReadBool(bool* value);
+
+  bool ReadInt32(int32_t* value);
+
+  // Also reads 32-bit integers, since integers are encoded in the smallest
+  // type that fits them.
+  bool ReadInt64(int64_t* value);
+
+  bool ReadDouble(double* value);
+
+  bool ReadString(std::string_view* value);
+
+  bool ReadUInt8List(TypedDataView<uint8_t>* value) {
+    return ReadTypedList(StandardCodecType::kUInt8List, value);
+  }
+
+  bool ReadInt32List(TypedDataView<int32_t>* value) {
+    return ReadTypedList(StandardCodecType::kInt32List, value);
+  }
+
+  bool ReadInt64List(TypedDataView<int64_t>* value) {
+    return ReadTypedList(StandardCodecType::kInt64List, value);
+  }
+
+  bool ReadFloat32List(TypedDataView<float>* value) {
+    return ReadTypedList(StandardCodecType::kFloat32List, value);
+  }
+
+  bool ReadFloat64List(TypedDataView<double>* value) {
+    return ReadTypedList(StandardCodecType::kFloat64List, value);
+  }
+
+  // Reads the number of elements of a list, which are read next.
+  bool ReadListLength(size_t* length);
+
+  // Reads the number of entries of a map, whose keys and values are read
+  // next.
+  bool ReadMapLength(size_t* length);
+
+  // Skips the next value, including all elements of a list or map. Values of
+  // types added by codec extensions cannot be skipped.
+  bool SkipValue();
+
+  // Reads the next value into an EncodableValue using |serializer|, copying
+  // its contents. This is how values of types added by codec extensions are
+  // read.
+  bool ReadEncodableValue(EncodableValue* value,
+                          const StandardCodecSerializer& serializer =
+                              StandardCodecSerializer::GetInstance());
+
+ private:
+  class Stream;
+
+  // The message to read from.
+  const uint8_t* bytes_;
+  // The total size of the message.
+  size_t size_;
+  // The current read location.
+  size_t location_ = 0;
+  // Whether a read went past the end of the message.
+  bool has_error_ = false;
+  // Copies of typed lists that were not aligned in memory.
+  std::vector<std::unique_ptr<uint64_t[]>> unaligned_copies_;
+
+  // Consumes the type byte if it is |type|.
+  bool ReadType(StandardCodecType type);
+
+  // Copies the next |length| bytes into |buffer|, or skips them if |buffer|
+  // is null.
+  bool ReadBytes(void* buffer, size_t length);
+
+  void ReadAlignment(size_t alignment);
+
+  bool ReadSize(size_t* size);
+
+  // Reads a typed list of |type|, whose elements are |element_size| bytes.
+  // The list is copied if it is not aligned in memory and |data| is not null.
+  bool ReadTypedListData(StandardCodecType type,
+                         size_t element_size,
+                         const void** data,
+                         size_t* count);
+
+  template <typename T>
+  bool ReadTypedList(StandardCodecType type, TypedDataView<T>* value) {
+    const void* data = nullptr;
+    size_t count = 0;
+    if (!ReadTypedListData(type, sizeof(T), &data, &count)) {
+      return false;
+    }
+    *value = TypedDataView<T>(static_cast<const T*>(data), count);
+    return true;
+  }
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_READER_H_
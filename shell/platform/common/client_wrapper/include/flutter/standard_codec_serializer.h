@@ -10,6 +10,28 @@
 
 namespace flutter {
 
+// The type discrimination byte that precedes each value in the standard codec
+// binary representation.
+//
+// The order/values here must match the constants in message_codecs.dart.
+enum class StandardCodecType : uint8_t {
+  kNull = 0,
+  kTrue,
+  kFalse,
+  kInt32,
+  kInt64,
+  kLargeInt,  // No longer used. If encountered, treat as kString.
+  kFloat64,
+  kString,
+  kUInt8List,
+  kInt32List,
+  kInt64List,
+  kFloat64List,
+  kList,
+  kMap,
+  kFloat32List,
+};
+
 // Encapsulates the logic for encoding/decoding EncodableValues to/from the
 // standard codec binary representation.
 //
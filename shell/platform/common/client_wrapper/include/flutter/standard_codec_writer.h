@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_WRITER_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_WRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "encodable_value.h"
+#include "standard_codec_serializer.h"
+
+namespace flutter {
+
+// Writes values one at a time in the standard codec binary representation
+// into a buffer provided by the caller, without building an EncodableValue
+// tree or allocating.
+//
+// Lists and maps are written as a length followed by that many values, or
+// twice as many for maps, alternating between keys and values.
+//
+// Writing more than fits in the buffer is an error, after which nothing more
+// is written. The buffer can be reused for the next message by calling
+// Reset.
+class StandardCodecWriter {
+ public:
+  // Creates a writer that writes into the |capacity| bytes at |buffer|.
+  // |buffer| must remain valid for the lifetime of this object.
+  explicit StandardCodecWriter(uint8_t* buffer, size_t capacity);
+
+  ~StandardCodecWriter();
+
+  // Prevent copying.
+  StandardCodecWriter(StandardCodecWriter const&) = delete;
+  StandardCodecWriter& operator=(StandardCodecWriter const&) = delete;
+
+  // The number of bytes of the message written so far.
+  size_t size() const { return location_; }
+
+  // Returns true if the message did not fit in the buffer.
+  bool has_error() const { return has_error_; }
+
+  // Discards the message written so far.
+  void Reset();
+
+  void WriteNull();
+
+  void WriteBool(bool value);
+
+  void WriteInt32(int32_t value);
+
+  void WriteInt64(int64_t value);
+
+  void WriteDouble(double value);
+
+  void WriteString(std::string_view value);
+
+  void WriteUInt8List(const uint8_t* data, size_t count) {
+    WriteTypedList(StandardCodecType::kUInt8List, data, sizeof(*data), count);
+  }
+
+  void WriteInt32List(const int32_t* data, size_t count) {
+    WriteTypedList(StandardCodecType::kInt32List, data, sizeof(*data), count);
+  }
+
+  void WriteInt64List(const int64_t* data, size_t count) {
+    WriteTypedList(StandardCodecType::kInt64List, data, sizeof(*data), count);
+  }
+
+  void WriteFloat32List(const float* data, size_t count) {
+    WriteTypedList(StandardCodecType::kFloat32List, data, sizeof(*data),
+                   count);
+  }
+
+  void WriteFloat64List(const double* data, size_t count) {
+    WriteTypedList(StandardCodecType::kFloat64List, data, sizeof(*data),
+                   count);
+  }
+
+  // Starts a list of |length| elements, which must be written next.
+  void WriteListLength(size_t length);
+
+  // Starts a map of |length| entries, whose keys and values must be written
+  // next.
+  void WriteMapLength(size_t length);
+
+  // Writes |value| using |serializer|. This is how values of types added by
+  // codec extensions are written.
+  void WriteEncodableValue(const EncodableValue& value,
+                           const StandardCodecSerializer& serializer =
+                               StandardCodecSerializer::GetInstance());
+
+ private:
+  class Stream;
+
+  // The buffer to write to.
+  uint8_t* bytes_;
+  // The total size of the buffer.
+  size_t capacity_;
+  // The current write location.
+  size_t location_ = 0;
+  // Whether a write did not fit in the buffer.
+  bool has_error_ = false;
+
+  void WriteType(StandardCodecType type);
+
+  void WriteBytes(const void* bytes, size_t length);
+
+  void WriteAlignment(size_t alignment);
+
+  void WriteSize(size_t size);
+
+  void WriteTypedList(StandardCodecType type,
+                      const void* data,
+                      size_t element_size,
+                      size_t count);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_CODEC_WRITER_H_
@@ -3,19 +3,24 @@
 // found in the LICENSE file.
 
 // This file contains what would normally be standard_codec_serializer.cc,
+// standard_codec_reader.cc, standard_codec_writer.cc,
 // standard_message_codec.cc, and standard_method_codec.cc. They are grouped
 // together to simplify use of the client wrapper, since the common case is
-// that any client that needs one of these files needs all three.
+// that any client that needs one of these files needs all of them.
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "byte_buffer_streams.h"
+#include "include/flutter/standard_codec_reader.h"
 #include "include/flutter/standard_codec_serializer.h"
+#include "include/flutter/standard_codec_writer.h"
 #include "include/flutter/standard_message_codec.h"
 #include "include/flutter/standard_method_codec.h"
 
@@ -25,57 +30,39 @@ namespace flutter {
 
 namespace {
 
-// The order/values here must match the constants in message_codecs.dart.
-enum class EncodedType {
-  kNull = 0,
-  kTrue,
-  kFalse,
-  kInt32,
-  kInt64,
-  kLargeInt,  // No longer used. If encountered, treat as kString.
-  kFloat64,
-  kString,
-  kUInt8List,
-  kInt32List,
-  kInt64List,
-  kFloat64List,
-  kList,
-  kMap,
-  kFloat32List,
-};
-
 // Returns the encoded type that should be written when serializing |value|.
-EncodedType EncodedTypeForValue(const EncodableValue& value) {
+StandardCodecType EncodedTypeForValue(const EncodableValue& value) {
   switch (value.index()) {
     case 0:
-      return EncodedType::kNull;
+      return StandardCodecType::kNull;
     case 1:
-      return std::get<bool>(value) ? EncodedType::kTrue : EncodedType::kFalse;
+      return std::get<bool>(value) ? StandardCodecType::kTrue
+                                   : StandardCodecType::kFalse;
     case 2:
-      return EncodedType::kInt32;
+      return StandardCodecType::kInt32;
     case 3:
-      return EncodedType::kInt64;
+      return StandardCodecType::kInt64;
     case 4:
-      return EncodedType::kFloat64;
+      return StandardCodecType::kFloat64;
     case 5:
-      return EncodedType::kString;
+      return StandardCodecType::kString;
     case 6:
-      return EncodedType::kUInt8List;
+      return StandardCodecType::kUInt8List;
     case 7:
-      return EncodedType::kInt32List;
+      return StandardCodecType::kInt32List;
     case 8:
-      return EncodedType::kInt64List;
+      return StandardCodecType::kInt64List;
     case 9:
-      return EncodedType::kFloat64List;
+      return StandardCodecType::kFloat64List;
     case 10:
-      return EncodedType::kList;
+      return StandardCodecType::kList;
     case 11:
-      return EncodedType::kMap;
+      return StandardCodecType::kMap;
     case 13:
-      return EncodedType::kFloat32List;
+      return StandardCodecType::kFloat32List;
   }
   assert(false);
-  return EncodedType::kNull;
+  return StandardCodecType::kNull;
 }
 
 }  // namespace
@@ -168,37 +155,37 @@ void StandardCodecSerializer::WriteValue(const EncodableValue& value,
 EncodableValue StandardCodecSerializer::ReadValueOfType(
     uint8_t type,
     ByteStreamReader* stream) const {
-  switch (static_cast<EncodedType>(type)) {
-    case EncodedType::kNull:
+  switch (static_cast<StandardCodecType>(type)) {
+    case StandardCodecType::kNull:
       return EncodableValue();
-    case EncodedType::kTrue:
+    case StandardCodecType::kTrue:
       return EncodableValue(true);
-    case EncodedType::kFalse:
+    case StandardCodecType::kFalse:
       return EncodableValue(false);
-    case EncodedType::kInt32:
+    case StandardCodecType::kInt32:
       return EncodableValue(stream->ReadInt32());
-    case EncodedType::kInt64:
+    case StandardCodecType::kInt64:
       return EncodableValue(stream->ReadInt64());
-    case EncodedType::kFloat64:
+    case StandardCodecType::kFloat64:
       stream->ReadAlignment(8);
       return EncodableValue(stream->ReadDouble());
-    case EncodedType::kLargeInt:
-    case EncodedType::kString: {
+    case StandardCodecType::kLargeInt:
+    case StandardCodecType::kString: {
       size_t size = ReadSize(stream);
       std::string string_value;
       string_value.resize(size);
       stream->ReadBytes(reinterpret_cast<uint8_t*>(&string_value[0]), size);
       return EncodableValue(string_value);
     }
-    case EncodedType::kUInt8List:
+    case StandardCodecType::kUInt8List:
       return ReadVector<uint8_t>(stream);
-    case EncodedType::kInt32List:
+    case StandardCodecType::kInt32List:
       return ReadVector<int32_t>(stream);
-    case EncodedType::kInt64List:
+    case StandardCodecType::kInt64List:
       return ReadVector<int64_t>(stream);
-    case EncodedType::kFloat64List:
+    case StandardCodecType::kFloat64List:
       return ReadVector<double>(stream);
-    case EncodedType::kList: {
+    case StandardCodecType::kList: {
       size_t length = ReadSize(stream);
       EncodableList list_value;
       list_value.reserve(length);
@@ -207,7 +194,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       }
       return EncodableValue(list_value);
     }
-    case EncodedType::kMap: {
+    case StandardCodecType::kMap: {
       size_t length = ReadSize(stream);
       EncodableMap map_value;
       for (size_t i = 0; i < length; ++i) {
@@ -217,7 +204,7 @@ EncodableValue StandardCodecSerializer::ReadValueOfType(
       }
       return EncodableValue(map_value);
     }
-    case EncodedType::kFloat32List: {
+    case StandardCodecType::kFloat32List: {
       return ReadVector<float>(stream);
     }
   }
@@ -287,6 +274,416 @@ void StandardCodecSerializer::WriteVector(const std::vector<T> vector,
                      count * type_size);
 }
 
+// ===== standard_codec_reader.h =====
+
+// Adapts a reader to the stream interface used by StandardCodecSerializer.
+class StandardCodecReader::Stream : public ByteStreamReader {
+ public:
+  explicit Stream(StandardCodecReader* reader) : reader_(reader) {}
+
+  // |ByteStreamReader|
+  uint8_t ReadByte() override {
+    uint8_t byte = 0;
+    reader_->ReadBytes(&byte, 1);
+    return byte;
+  }
+
+  // |ByteStreamReader|
+  void ReadBytes(uint8_t* buffer, size_t length) override {
+    reader_->ReadBytes(buffer, length);
+  }
+
+  // |ByteStreamReader|
+  void ReadAlignment(uint8_t alignment) override {
+    reader_->ReadAlignment(alignment);
+  }
+
+ private:
+  StandardCodecReader* reader_;
+};
+
+StandardCodecReader::StandardCodecReader(const uint8_t* message,
+                                         size_t message_size)
+    : bytes_(message), size_(message ? message_size : 0) {}
+
+StandardCodecReader::~StandardCodecReader() = default;
+
+bool StandardCodecReader::PeekType(StandardCodecType* type) const {
+  if (has_error_ || location_ >= size_) {
+    return false;
+  }
+  *type = static_cast<StandardCodecType>(bytes_[location_]);
+  return true;
+}
+
+bool StandardCodecReader::ReadNull() {
+  return ReadType(StandardCodecType::kNull);
+}
+
+bool StandardCodecReader::ReadBool(bool* value) {
+  StandardCodecType type;
+  if (!PeekType(&type) || (type != StandardCodecType::kTrue &&
+                           type != StandardCodecType::kFalse)) {
+    return false;
+  }
+  location_++;
+  *value = type == StandardCodecType::kTrue;
+  return true;
+}
+
+bool StandardCodecReader::ReadInt32(int32_t* value) {
+  return ReadType(StandardCodecType::kInt32) && ReadBytes(value, 4);
+}
+
+bool StandardCodecReader::ReadInt64(int64_t* value) {
+  StandardCodecType type;
+  if (!PeekType(&type)) {
+    return false;
+  }
+  if (type == StandardCodecType::kInt32) {
+    int32_t int32_value = 0;
+    if (!ReadInt32(&int32_value)) {
+      return false;
+    }
+    *value = int32_value;
+    return true;
+  }
+  return ReadType(StandardCodecType::kInt64) && ReadBytes(value, 8);
+}
+
+bool StandardCodecReader::ReadDouble(double* value) {
+  if (!ReadType(StandardCodecType::kFloat64)) {
+    return false;
+  }
+  ReadAlignment(8);
+  return ReadBytes(value, 8);
+}
+
+bool StandardCodecReader::ReadString(std::string_view* value) {
+  StandardCodecType type;
+  if (!PeekType(&type) || (type != StandardCodecType::kString &&
+                           type != StandardCodecType::kLargeInt)) {
+    return false;
+  }
+  location_++;
+  size_t size = 0;
+  if (!ReadSize(&size)) {
+    return false;
+  }
+  size_t start = location_;
+  if (!ReadBytes(nullptr, size)) {
+    return false;
+  }
+  *value =
+      std::string_view(reinterpret_cast<const char*>(bytes_ + start), size);
+  return true;
+}
+
+bool StandardCodecReader::ReadListLength(size_t* length) {
+  return ReadType(StandardCodecType::kList) && ReadSize(length);
+}
+
+bool StandardCodecReader::ReadMapLength(size_t* length) {
+  return ReadType(StandardCodecType::kMap) && ReadSize(length);
+}
+
+bool StandardCodecReader::SkipValue() {
+  StandardCodecType type;
+  if (!PeekType(&type)) {
+    return false;
+  }
+  size_t count = 0;
+  switch (type) {
+    case StandardCodecType::kNull:
+    case StandardCodecType::kTrue:
+    case StandardCodecType::kFalse:
+      location_++;
+      return true;
+    case StandardCodecType::kInt32:
+    case StandardCodecType::kInt64: {
+      int64_t value;
+      return ReadInt64(&value);
+    }
+    case StandardCodecType::kFloat64: {
+      double value;
+      return ReadDouble(&value);
+    }
+    case StandardCodecType::kLargeInt:
+    case StandardCodecType::kString: {
+      std::string_view value;
+      return ReadString(&value);
+    }
+    case StandardCodecType::kUInt8List:
+      return ReadTypedListData(type, 1, nullptr, &count);
+    case StandardCodecType::kInt32List:
+    case StandardCodecType::kFloat32List:
+      return ReadTypedListData(type, 4, nullptr, &count);
+    case StandardCodecType::kInt64List:
+    case StandardCodecType::kFloat64List:
+      return ReadTypedListData(type, 8, nullptr, &count);
+    case StandardCodecType::kList:
+    case StandardCodecType::kMap: {
+      size_t length = 0;
+      if (!ReadType(type) || !ReadSize(&length)) {
+        return false;
+      }
+      count = type == StandardCodecType::kMap ? length * 2 : length;
+      for (size_t i = 0; i < count; ++i) {
+        if (!SkipValue()) {
+          // Part of the collection has been consumed, so the rest of the
+          // message can no longer be read.
+          has_error_ = true;
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StandardCodecReader::ReadEncodableValue(
+    EncodableValue* value,
+    const StandardCodecSerializer& serializer) {
+  if (has_error_ || AtEnd()) {
+    return false;
+  }
+  Stream stream(this);
+  *value = serializer.ReadValue(&stream);
+  return !has_error_;
+}
+
+bool StandardCodecReader::ReadType(StandardCodecType type) {
+  StandardCodecType next_type;
+  if (!PeekType(&next_type) || next_type != type) {
+    return false;
+  }
+  location_++;
+  return true;
+}
+
+bool StandardCodecReader::ReadBytes(void* buffer, size_t length) {
+  if (has_error_ || location_ > size_ || length > size_ - location_) {
+    if (!has_error_) {
+      std::cerr << "Invalid read in StandardCodecReader" << std::endl;
+    }
+    has_error_ = true;
+    return false;
+  }
+  if (buffer && length > 0) {
+    std::memcpy(buffer, &bytes_[location_], length);
+  }
+  location_ += length;
+  return true;
+}
+
+void StandardCodecReader::ReadAlignment(size_t alignment) {
+  size_t mod = location_ % alignment;
+  if (mod) {
+    location_ += alignment - mod;
+  }
+}
+
+bool StandardCodecReader::ReadSize(size_t* size) {
+  uint8_t byte = 0;
+  if (!ReadBytes(&byte, 1)) {
+    return false;
+  }
+  if (byte < 254) {
+    *size = byte;
+    return true;
+  } else if (byte == 254) {
+    uint16_t value = 0;
+    if (!ReadBytes(&value, 2)) {
+      return false;
+    }
+    *size = value;
+    return true;
+  } else {
+    uint32_t value = 0;
+    if (!ReadBytes(&value, 4)) {
+      return false;
+    }
+    *size = value;
+    return true;
+  }
+}
+
+bool StandardCodecReader::ReadTypedListData(StandardCodecType type,
+                                            size_t element_size,
+                                            const void** data,
+                                            size_t* count) {
+  size_t length = 0;
+  if (!ReadType(type) || !ReadSize(&length)) {
+    return false;
+  }
+  if (element_size > 1) {
+    ReadAlignment(element_size);
+  }
+  if (length > SIZE_MAX / element_size) {
+    std::cerr << "Invalid read in StandardCodecReader" << std::endl;
+    has_error_ = true;
+    return false;
+  }
+  const uint8_t* start = bytes_ + location_;
+  size_t byte_length = length * element_size;
+  if (!ReadBytes(nullptr, byte_length)) {
+    return false;
+  }
+  if (data) {
+    if (reinterpret_cast<uintptr_t>(start) % element_size == 0) {
+      *data = start;
+    } else {
+      auto copy = std::make_unique<uint64_t[]>((byte_length + 7) / 8);
+      std::memcpy(copy.get(), start, byte_length);
+      *data = copy.get();
+      unaligned_copies_.push_back(std::move(copy));
+    }
+  }
+  *count = length;
+  return true;
+}
+
+// ===== standard_codec_writer.h =====
+
+// Adapts a writer to the stream interface used by StandardCodecSerializer.
+class StandardCodecWriter::Stream : public ByteStreamWriter {
+ public:
+  explicit Stream(StandardCodecWriter* writer) : writer_(writer) {}
+
+  // |ByteStreamWriter|
+  void WriteByte(uint8_t byte) override { writer_->WriteBytes(&byte, 1); }
+
+  // |ByteStreamWriter|
+  void WriteBytes(const uint8_t* bytes, size_t length) override {
+    writer_->WriteBytes(bytes, length);
+  }
+
+  // |ByteStreamWriter|
+  void WriteAlignment(uint8_t alignment) override {
+    writer_->WriteAlignment(alignment);
+  }
+
+ private:
+  StandardCodecWriter* writer_;
+};
+
+StandardCodecWriter::StandardCodecWriter(uint8_t* buffer, size_t capacity)
+    : bytes_(buffer), capacity_(buffer ? capacity : 0) {}
+
+StandardCodecWriter::~StandardCodecWriter() = default;
+
+void StandardCodecWriter::Reset() {
+  location_ = 0;
+  has_error_ = false;
+}
+
+void StandardCodecWriter::WriteNull() {
+  WriteType(StandardCodecType::kNull);
+}
+
+void StandardCodecWriter::WriteBool(bool value) {
+  WriteType(value ? StandardCodecType::kTrue : StandardCodecType::kFalse);
+}
+
+void StandardCodecWriter::WriteInt32(int32_t value) {
+  WriteType(StandardCodecType::kInt32);
+  WriteBytes(&value, 4);
+}
+
+void StandardCodecWriter::WriteInt64(int64_t value) {
+  WriteType(StandardCodecType::kInt64);
+  WriteBytes(&value, 8);
+}
+
+void StandardCodecWriter::WriteDouble(double value) {
+  WriteType(StandardCodecType::kFloat64);
+  WriteAlignment(8);
+  WriteBytes(&value, 8);
+}
+
+void StandardCodecWriter::WriteString(std::string_view value) {
+  WriteType(StandardCodecType::kString);
+  WriteSize(value.size());
+  WriteBytes(value.data(), value.size());
+}
+
+void StandardCodecWriter::WriteListLength(size_t length) {
+  WriteType(StandardCodecType::kList);
+  WriteSize(length);
+}
+
+void StandardCodecWriter::WriteMapLength(size_t length) {
+  WriteType(StandardCodecType::kMap);
+  WriteSize(length);
+}
+
+void StandardCodecWriter::WriteEncodableValue(
+    const EncodableValue& value,
+    const StandardCodecSerializer& serializer) {
+  Stream stream(this);
+  serializer.WriteValue(value, &stream);
+}
+
+void StandardCodecWriter::WriteType(StandardCodecType type) {
+  uint8_t byte = static_cast<uint8_t>(type);
+  WriteBytes(&byte, 1);
+}
+
+void StandardCodecWriter::WriteBytes(const void* bytes, size_t length) {
+  if (has_error_) {
+    return;
+  }
+  if (length > capacity_ - location_) {
+    std::cerr << "Message does not fit in the StandardCodecWriter buffer"
+              << std::endl;
+    has_error_ = true;
+    return;
+  }
+  if (length > 0) {
+    std::memcpy(&bytes_[location_], bytes, length);
+  }
+  location_ += length;
+}
+
+void StandardCodecWriter::WriteAlignment(size_t alignment) {
+  static constexpr uint8_t kZeros[8] = {};
+  size_t mod = location_ % alignment;
+  if (mod) {
+    WriteBytes(kZeros, alignment - mod);
+  }
+}
+
+void StandardCodecWriter::WriteSize(size_t size) {
+  if (size < 254) {
+    uint8_t value = static_cast<uint8_t>(size);
+    WriteBytes(&value, 1);
+  } else if (size <= 0xffff) {
+    uint8_t marker = 254;
+    uint16_t value = static_cast<uint16_t>(size);
+    WriteBytes(&marker, 1);
+    WriteBytes(&value, 2);
+  } else {
+    uint8_t marker = 255;
+    uint32_t value = static_cast<uint32_t>(size);
+    WriteBytes(&marker, 1);
+    WriteBytes(&value, 4);
+  }
+}
+
+void StandardCodecWriter::WriteTypedList(StandardCodecType type,
+                                         const void* data,
+                                         size_t element_size,
+                                         size_t count) {
+  WriteType(type);
+  WriteSize(count);
+  // Aligned even when empty, since that is what readers expect.
+  if (element_size > 1) {
+    WriteAlignment(element_size);
+  }
+  WriteBytes(data, count * element_size);
+}
+
 // ===== standard_message_codec.h =====
 
 // static
@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_reader.h"
+
+#include <string_view>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "flutter/shell/platform/common/client_wrapper/testing/test_codec_extensions.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+std::unique_ptr<std::vector<uint8_t>> Encode(const EncodableValue& value) {
+  return StandardMessageCodec::GetInstance().EncodeMessage(value);
+}
+
+}  // namespace
+
+TEST(StandardCodecReader, ReadsScalars) {
+  auto encoded = Encode(EncodableValue(EncodableList{
+      EncodableValue(), EncodableValue(true), EncodableValue(false),
+      EncodableValue(7), EncodableValue(int64_t{0x1234567890abcdef}),
+      EncodableValue(3.5)}));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  size_t length = 0;
+  ASSERT_TRUE(reader.ReadListLength(&length));
+  EXPECT_EQ(length, 6u);
+  EXPECT_TRUE(reader.ReadNull());
+  bool bool_value = false;
+  EXPECT_TRUE(reader.ReadBool(&bool_value));
+  EXPECT_TRUE(bool_value);
+  EXPECT_TRUE(reader.ReadBool(&bool_value));
+  EXPECT_FALSE(bool_value);
+  int32_t int32_value = 0;
+  EXPECT_TRUE(reader.ReadInt32(&int32_value));
+  EXPECT_EQ(int32_value, 7);
+  int64_t int64_value = 0;
+  EXPECT_TRUE(reader.ReadInt64(&int64_value));
+  EXPECT_EQ(int64_value, 0x1234567890abcdef);
+  double double_value = 0;
+  EXPECT_TRUE(reader.ReadDouble(&double_value));
+  EXPECT_EQ(double_value, 3.5);
+  EXPECT_TRUE(reader.AtEnd());
+  EXPECT_FALSE(reader.has_error());
+}
+
+TEST(StandardCodecReader, ReadsInt32AsInt64) {
+  auto encoded = Encode(EncodableValue(-3));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  int64_t value = 0;
+  EXPECT_TRUE(reader.ReadInt64(&value));
+  EXPECT_EQ(value, -3);
+}
+
+TEST(StandardCodecReader, ReadsStringInPlace) {
+  auto encoded = Encode(EncodableValue("hello"));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  std::string_view value;
+  ASSERT_TRUE(reader.ReadString(&value));
+  EXPECT_EQ(value, "hello");
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(value.data()),
+            encoded->data() + 2);
+}
+
+TEST(StandardCodecReader, ReadsTypedListsInPlace) {
+  auto encoded = Encode(EncodableValue(EncodableList{
+      EncodableValue(std::vector<uint8_t>{1, 2, 3}),
+      EncodableValue(std::vector<int32_t>{-1, 0x12345678}),
+      EncodableValue(std::vector<int64_t>{0x1234567890abcdef}),
+      EncodableValue(std::vector<float>{1.5f, 2.5f}),
+      EncodableValue(std::vector<double>{3.25, -1.0}),
+  }));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  size_t length = 0;
+  ASSERT_TRUE(reader.ReadListLength(&length));
+  EXPECT_EQ(length, 5u);
+
+  TypedDataView<uint8_t> bytes;
+  ASSERT_TRUE(reader.ReadUInt8List(&bytes));
+  EXPECT_EQ(std::vector<uint8_t>(bytes.begin(), bytes.end()),
+            std::vector<uint8_t>({1, 2, 3}));
+  EXPECT_GE(bytes.data(), encoded->data());
+  EXPECT_LT(bytes.data(), encoded->data() + encoded->size());
+
+  TypedDataView<int32_t> int32s;
+  ASSERT_TRUE(reader.ReadInt32List(&int32s));
+  ASSERT_EQ(int32s.size(), 2u);
+  EXPECT_EQ(int32s[0], -1);
+  EXPECT_EQ(int32s[1], 0x12345678);
+
+  TypedDataView<int64_t> int64s;
+  ASSERT_TRUE(reader.ReadInt64List(&int64s));
+  ASSERT_EQ(int64s.size(), 1u);
+  EXPECT_EQ(int64s[0], 0x1234567890abcdef);
+
+  TypedDataView<float> floats;
+  ASSERT_TRUE(reader.ReadFloat32List(&floats));
+  EXPECT_EQ(std::vector<float>(floats.begin(), floats.end()),
+            std::vector<float>({1.5f, 2.5f}));
+
+  TypedDataView<double> doubles;
+  ASSERT_TRUE(reader.ReadFloat64List(&doubles));
+  EXPECT_EQ(std::vector<double>(doubles.begin(), doubles.end()),
+            std::vector<double>({3.25, -1.0}));
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(StandardCodecReader, CopiesUnalignedTypedLists) {
+  auto encoded = Encode(EncodableValue(std::vector<double>{1.0, 2.0}));
+  // Shift the message so that the list is not aligned in memory.
+  std::vector<uint8_t> shifted(encoded->size() + 1);
+  std::copy(encoded->begin(), encoded->end(), shifted.begin() + 1);
+  StandardCodecReader reader(shifted.data() + 1, encoded->size());
+
+  TypedDataView<double> doubles;
+  ASSERT_TRUE(reader.ReadFloat64List(&doubles));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(doubles.data()) % alignof(double),
+            0u);
+  EXPECT_EQ(std::vector<double>(doubles.begin(), doubles.end()),
+            std::vector<double>({1.0, 2.0}));
+}
+
+TEST(StandardCodecReader, ReadsMaps) {
+  auto encoded = Encode(EncodableValue(EncodableMap{
+      {EncodableValue("x"), EncodableValue(1)},
+  }));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  size_t length = 0;
+  ASSERT_TRUE(reader.ReadMapLength(&length));
+  EXPECT_EQ(length, 1u);
+  std::string_view key;
+  EXPECT_TRUE(reader.ReadString(&key));
+  EXPECT_EQ(key, "x");
+  int32_t value = 0;
+  EXPECT_TRUE(reader.ReadInt32(&value));
+  EXPECT_EQ(value, 1);
+}
+
+TEST(StandardCodecReader, DoesNotConsumeMismatchedType) {
+  auto encoded = Encode(EncodableValue("text"));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  int32_t int_value = 0;
+  EXPECT_FALSE(reader.ReadInt32(&int_value));
+  StandardCodecType type;
+  ASSERT_TRUE(reader.PeekType(&type));
+  EXPECT_EQ(type, StandardCodecType::kString);
+  std::string_view string_value;
+  EXPECT_TRUE(reader.ReadString(&string_value));
+  EXPECT_FALSE(reader.has_error());
+}
+
+TEST(StandardCodecReader, SkipsNestedValues) {
+  auto encoded = Encode(EncodableValue(EncodableList{
+      EncodableValue(EncodableMap{
+          {EncodableValue("a"), EncodableValue(std::vector<double>{1.0})},
+          {EncodableValue(2), EncodableValue(EncodableList{})},
+      }),
+      EncodableValue(42),
+  }));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  size_t length = 0;
+  ASSERT_TRUE(reader.ReadListLength(&length));
+  EXPECT_TRUE(reader.SkipValue());
+  int32_t value = 0;
+  EXPECT_TRUE(reader.ReadInt32(&value));
+  EXPECT_EQ(value, 42);
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(StandardCodecReader, ReadsCustomTypesWithSerializer) {
+  const auto& serializer = PointExtensionSerializer::GetInstance();
+  auto encoded = StandardMessageCodec::GetInstance(&serializer)
+                     .EncodeMessage(EncodableValue(EncodableList{
+                         CustomEncodableValue(Point(9, 16)),
+                         EncodableValue(5),
+                     }));
+  StandardCodecReader reader(encoded->data(), encoded->size());
+
+  size_t length = 0;
+  ASSERT_TRUE(reader.ReadListLength(&length));
+  EncodableValue value;
+  ASSERT_TRUE(reader.ReadEncodableValue(&value, serializer));
+  EXPECT_EQ(std::any_cast<Point>(std::get<CustomEncodableValue>(value)),
+            Point(9, 16));
+  int32_t int_value = 0;
+  EXPECT_TRUE(reader.ReadInt32(&int_value));
+  EXPECT_EQ(int_value, 5);
+}
+
+TEST(StandardCodecReader, FailsOnTruncatedMessage) {
+  auto encoded = Encode(EncodableValue("truncated"));
+  StandardCodecReader reader(encoded->data(), encoded->size() - 1);
+
+  std::string_view value;
+  EXPECT_FALSE(reader.ReadString(&value));
+  EXPECT_TRUE(reader.has_error());
+  EXPECT_FALSE(reader.SkipValue());
+}
+
+}  // namespace flutter
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_codec_writer.h"
+
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "flutter/shell/platform/common/client_wrapper/testing/test_codec_extensions.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+// Checks that |writer| wrote the same bytes as the message codec does for
+// |expected|.
+void ExpectEncodes(const StandardCodecWriter& writer,
+                   const std::vector<uint8_t>& buffer,
+                   const EncodableValue& expected,
+                   const StandardCodecSerializer* serializer = nullptr) {
+  auto encoded =
+      StandardMessageCodec::GetInstance(serializer).EncodeMessage(expected);
+  ASSERT_FALSE(writer.has_error());
+  std::vector<uint8_t> written(buffer.begin(), buffer.begin() + writer.size());
+  EXPECT_EQ(written, *encoded);
+}
+
+}  // namespace
+
+TEST(StandardCodecWriter, WritesScalars) {
+  std::vector<uint8_t> buffer(64);
+  StandardCodecWriter writer(buffer.data(), buffer.size());
+  writer.WriteListLength(7);
+  writer.WriteNull();
+  writer.WriteBool(true);
+  writer.WriteBool(false);
+  writer.WriteInt32(-7);
+  writer.WriteInt64(0x1234567890abcdef);
+  writer.WriteDouble(3.5);
+  writer.WriteString("hello");
+
+  ExpectEncodes(writer, buffer,
+                EncodableValue(EncodableList{
+                    EncodableValue(), EncodableValue(true),
+                    EncodableValue(false), EncodableValue(-7),
+                    EncodableValue(int64_t{0x1234567890abcdef}),
+                    EncodableValue(3.5), EncodableValue("hello")}));
+}
+
+TEST(StandardCodecWriter, WritesTypedLists) {
+  const std::vector<uint8_t> bytes = {1, 2, 3};
+  const std::vector<int32_t> int32s = {-1, 0x12345678};
+  const std::vector<int64_t> int64s = {0x1234567890abcdef};
+  const std::vector<float> floats = {1.5f, 2.5f};
+  const std::vector<double> doubles = {3.25, -1.0};
+
+  std::vector<uint8_t> buffer(128);
+  StandardCodecWriter writer(buffer.data(), buffer.size());
+  writer.WriteListLength(5);
+  writer.WriteUInt8List(bytes.data(), bytes.size());
+  writer.WriteInt32List(int32s.data(), int32s.size());
+  writer.WriteInt64List(int64s.data(), int64s.size());
+  writer.WriteFloat32List(floats.data(), floats.size());
+  writer.WriteFloat64List(doubles.data(), doubles.size());
+
+  ExpectEncodes(writer, buffer,
+                EncodableValue(EncodableList{
+                    EncodableValue(bytes), EncodableValue(int32s),
+                    EncodableValue(int64s), EncodableValue(floats),
+                    EncodableValue(doubles)}));
+}
+
+TEST(StandardCodecWriter, WritesMaps) {
+  std::vector<uint8_t> buffer(16);
+  StandardCodecWriter writer(buffer.data(), buffer.size());
+  writer.WriteMapLength(1);
+  writer.WriteString("x");
+  writer.WriteInt32(1);
+
+  ExpectEncodes(writer, buffer,
+                EncodableValue(EncodableMap{
+                    {EncodableValue("x"), EncodableValue(1)},
+                }));
+}
+
+TEST(StandardCodecWriter, WritesCustomTypesWithSerializer) {
+  const auto& serializer = PointExtensionSerializer::GetInstance();
+  std::vector<uint8_t> buffer(32);
+  StandardCodecWriter writer(buffer.data(), buffer.size());
+  writer.WriteListLength(2);
+  writer.WriteEncodableValue(CustomEncodableValue(Point(9, 16)), serializer);
+  writer.WriteInt32(5);
+
+  ExpectEncodes(writer, buffer,
+                EncodableValue(EncodableList{
+                    CustomEncodableValue(Point(9, 16)),
+                    EncodableValue(5),
+                }),
+                &serializer);
+}
+
+TEST(StandardCodecWriter, FailsWhenBufferIsTooSmall) {
+  std::vector<uint8_t> buffer(8);
+  StandardCodecWriter writer(buffer.data(), buffer.size());
+  writer.WriteString("too long");
+  EXPECT_TRUE(writer.has_error());
+
+  writer.Reset();
+  EXPECT_FALSE(writer.has_error());
+  EXPECT_EQ(writer.size(), 0u);
+  writer.WriteInt32(1);
+  EXPECT_FALSE(writer.has_error());
+  EXPECT_EQ(writer.size(), 5u);
+}
+
+}  // namespace flutter
@@ -14,6 +14,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/thread.h"
@@ -304,28 +305,36 @@ InferOpenGLPlatformViewCreationCallback(
     if (present) {
       return present(user_data);
     } else {
-      // Format the frame and buffer damages accordingly. Note that, since the
-      // current compute damage algorithm only returns one rectangle for damage
-      // we are assuming the number of rectangles provided in frame and buffer
-      // damage are always 1. Once the function that computes damage implements
-      // support for multiple damage rectangles, GLPresentInfo should also
-      // contain the number of damage rectangles.
-      const size_t num_rects = 1;
-
-      std::array<FlutterRect, num_rects> frame_damage_rect = {
-          SkIRectToFlutterRect(*(gl_present_info.frame_damage))};
-      std::array<FlutterRect, num_rects> buffer_damage_rect = {
-          SkIRectToFlutterRect(*(gl_present_info.buffer_damage))};
+      // Format the frame and buffer damages accordingly. The damage is split
+      // into at most |max_damage_rects| rectangles, or is a single rectangle
+      // if the rasterizer did not split it.
+      auto to_flutter_rects = [](const std::optional<SkIRect>& damage,
+                                 const std::vector<SkIRect>& damage_rects) {
+        std::vector<FlutterRect> rects;
+        if (damage_rects.empty()) {
+          rects.push_back(SkIRectToFlutterRect(*damage));
+        }
+        for (const SkIRect& rect : damage_rects) {
+          rects.push_back(SkIRectToFlutterRect(rect));
+        }
+        return rects;
+      };
+      std::vector<FlutterRect> frame_damage_rects =
+          to_flutter_rects(gl_present_info.frame_damage,
+                           gl_present_info.frame_damage_rects);
+      std::vector<FlutterRect> buffer_damage_rects =
+          to_flutter_rects(gl_present_info.buffer_damage,
+                           gl_present_info.buffer_damage_rects);
 
       FlutterDamage frame_damage{
           .struct_size = sizeof(FlutterDamage),
-          .num_rects = frame_damage_rect.size(),
-          .damage = frame_damage_rect.data(),
+          .num_rects = frame_damage_rects.size(),
+          .damage = frame_damage_rects.data(),
       };
       FlutterDamage buffer_damage{
           .struct_size = sizeof(FlutterDamage),
-          .num_rects = buffer_damage_rect.size(),
-          .damage = buffer_damage_rect.data(),
+          .num_rects = buffer_damage_rects.size(),
+          .damage = buffer_damage_rects.data(),
       };
 
       // Construct the present information concerning the frame being rendered.
@@ -372,6 +381,7 @@ InferOpenGLPlatformViewCreationCallback(
     populate_existing_damage(user_data, id, &existing_damage);
 
     std::optional<SkIRect> existing_damage_rect = std::nullopt;
+    std::vector<SkIRect> existing_damage_rects;
 
     // Verify that at least one damage rectangle was provided.
     if (existing_damage.num_rects <= 0 || existing_damage.damage == nullptr) {
@@ -379,8 +389,9 @@ InferOpenGLPlatformViewCreationCallback(
     } else {
       existing_damage_rect = SkIRect::MakeEmpty();
       for (size_t i = 0; i < existing_damage.num_rects; i++) {
-        existing_damage_rect->join(
-            FlutterRectToSkIRect(existing_damage.damage[i]));
+        SkIRect rect = FlutterRectToSkIRect(existing_damage.damage[i]);
+        existing_damage_rect->join(rect);
+        existing_damage_rects.push_back(rect);
       }
     }
 
@@ -388,6 +399,7 @@ InferOpenGLPlatformViewCreationCallback(
     return flutter::GLFBOInfo{
         .fbo_id = static_cast<uint32_t>(id),
         .existing_damage = existing_damage_rect,
+        .existing_damage_rects = std::move(existing_damage_rects),
     };
   };
 
@@ -440,6 +452,8 @@ InferOpenGLPlatformViewCreationCallback(
   bool fbo_reset_after_present =
       SAFE_ACCESS(open_gl_config, fbo_reset_after_present, false);
 
+  size_t max_damage_rects = SAFE_ACCESS(open_gl_config, max_damage_rects, 1);
+
   flutter::EmbedderSurfaceGL::GLDispatchTable gl_dispatch_table = {
       gl_make_current,                     // gl_make_current_callback
       gl_clear_current,                    // gl_clear_current_callback
@@ -452,8 +466,8 @@ InferOpenGLPlatformViewCreationCallback(
   };
 
   return fml::MakeCopyable(
-      [gl_dispatch_table, fbo_reset_after_present, platform_dispatch_table,
-       enable_impeller,
+      [gl_dispatch_table, fbo_reset_after_present, max_damage_rects,
+       platform_dispatch_table, enable_impeller,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         std::shared_ptr<flutter::EmbedderExternalViewEmbedder> view_embedder =
@@ -473,8 +487,8 @@ InferOpenGLPlatformViewCreationCallback(
             shell,                   // delegate
             shell.GetTaskRunners(),  // task runners
             std::make_unique<flutter::EmbedderSurfaceGL>(
-                gl_dispatch_table, fbo_reset_after_present,
-                view_embedder),       // embedder_surface
+                gl_dispatch_table, fbo_reset_after_present, view_embedder,
+                max_damage_rects),    // embedder_surface
             platform_dispatch_table,  // embedder platform dispatch table
             view_embedder             // external view embedder
         );
@@ -682,16 +696,27 @@ InferSoftwarePlatformViewCreationCallback(
           software_present_backing_store,  // required
       };
 
+  const int raster_tile_size =
+      static_cast<int>(SAFE_ACCESS(&config->software, raster_tile_size, 0));
+
   return fml::MakeCopyable(
-      [software_dispatch_table, platform_dispatch_table,
+      [software_dispatch_table, platform_dispatch_table, raster_tile_size,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
+        std::shared_ptr<flutter::DlSkTiledRasterizer> tiled_rasterizer;
+        if (raster_tile_size > 0) {
+          tiled_rasterizer = std::make_shared<flutter::DlSkTiledRasterizer>(
+              shell.GetConcurrentWorkerTaskRunner(),
+              shell.GetDartVM()->GetConcurrentMessageLoop()->GetWorkerCount(),
+              raster_tile_size);
+        }
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            std::move(tiled_rasterizer)         // tiled rasterizer
         );
       });
 }
@@ -1766,6 +1791,49 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
   if (SAFE_ACCESS(args, log_tag, nullptr) != nullptr) {
     settings.log_tag = SAFE_ACCESS(args, log_tag, nullptr);
   }
+  if (SAFE_ACCESS(args, frame_timing_callback, nullptr) != nullptr) {
+    FlutterFrameTimingCallback callback =
+        SAFE_ACCESS(args, frame_timing_callback, nullptr);
+    settings.frame_rasterized_callback =
+        [callback, user_data](const flutter::FrameTiming& timing) {
+          auto timestamp = [&timing](flutter::FrameTiming::Phase phase) {
+            return static_cast<uint64_t>(
+                timing.Get(phase).ToEpochDelta().ToNanoseconds());
+          };
+          auto duration = [&timing](flutter::FrameTiming::RasterPhase phase) {
+            return static_cast<uint64_t>(
+                timing.GetRasterPhaseDuration(phase).ToNanoseconds());
+          };
+          FlutterFrameTiming frame_timing = {};
+          frame_timing.struct_size = sizeof(FlutterFrameTiming);
+          frame_timing.frame_number = timing.GetFrameNumber();
+          frame_timing.vsync_start_nanos =
+              timestamp(flutter::FrameTiming::kVsyncStart);
+          frame_timing.build_start_nanos =
+              timestamp(flutter::FrameTiming::kBuildStart);
+          frame_timing.build_finish_nanos =
+              timestamp(flutter::FrameTiming::kBuildFinish);
+          frame_timing.raster_start_nanos =
+              timestamp(flutter::FrameTiming::kRasterStart);
+          frame_timing.raster_finish_nanos =
+              timestamp(flutter::FrameTiming::kRasterFinish);
+          frame_timing.diff_nanos = duration(flutter::FrameTiming::kDiff);
+          frame_timing.preroll_nanos =
+              duration(flutter::FrameTiming::kPreroll);
+          frame_timing.raster_cache_nanos =
+              duration(flutter::FrameTiming::kRasterCache);
+          frame_timing.dispatch_nanos =
+              duration(flutter::FrameTiming::kDispatch);
+          frame_timing.tessellation_nanos =
+              duration(flutter::FrameTiming::kTessellation);
+          frame_timing.glyph_atlas_nanos =
+              duration(flutter::FrameTiming::kGlyphAtlas);
+          frame_timing.encode_nanos = duration(flutter::FrameTiming::kEncode);
+          frame_timing.submit_nanos = duration(flutter::FrameTiming::kSubmit);
+          frame_timing.gpu_nanos = duration(flutter::FrameTiming::kGpu);
+          callback(&frame_timing, user_data);
+        };
+  }
 
   bool has_update_semantics_2_callback =
       SAFE_ACCESS(args, update_semantics_callback2, nullptr) != nullptr;
@@ -588,6 +588,12 @@ typedef struct {
   /// ID. Not specifying populate_existing_damage will result in full
   /// repaint (i.e. rendering all the pixels on the screen at every frame).
   FlutterFrameBufferWithDamageCallback populate_existing_damage;
+  /// The maximum number of rectangles in the frame and buffer damage passed to
+  /// `present_with_info`. Damaged areas are merged until they fit. If zero or
+  /// one, the damage is a single rectangle bounding all of the changes, which
+  /// may be much larger than the changed area when several distant parts of
+  /// the screen change. Only used when dirty region management is enabled.
+  size_t max_damage_rects;
 } FlutterOpenGLRendererConfig;
 
 /// Alias for id<MTLDevice>.
@@ -819,6 +825,13 @@ typedef struct {
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The edge length, in physical pixels, of the square tiles the engine
+  /// splits each frame into in order to rasterize it on multiple threads. The
+  /// tiles are rendered in parallel on the engine's concurrent worker threads.
+  /// A value of 0 (the default) rasterizes every frame on the raster thread
+  /// alone. This has no effect if a FlutterCompositor is supplied in
+  /// FlutterProjectArgs.
+  size_t raster_tile_size;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -1445,6 +1458,51 @@ typedef void (*FlutterChannelUpdateCallback)(
     const FlutterChannelUpdate* /* channel update */,
     void* /* user data */);
 
+/// The timings of a frame that has been rasterized. Timestamps are in
+/// nanoseconds on the same clock as `FlutterEngineGetCurrentTime`. Durations
+/// are in nanoseconds, and are zero for phases that do not apply to the
+/// renderer in use.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterFrameTiming).
+  size_t struct_size;
+  /// The frame number of the frame.
+  uint64_t frame_number;
+  /// When the vsync signal for the frame was received.
+  uint64_t vsync_start_nanos;
+  /// When the UI thread started building the frame.
+  uint64_t build_start_nanos;
+  /// When the UI thread finished building the frame.
+  uint64_t build_finish_nanos;
+  /// When the raster thread started rasterizing the frame.
+  uint64_t raster_start_nanos;
+  /// When the raster thread finished rasterizing the frame.
+  uint64_t raster_finish_nanos;
+  /// Computing the region of the frame that changed since the last frame.
+  uint64_t diff_nanos;
+  /// Walking the layer tree before painting it.
+  uint64_t preroll_nanos;
+  /// Evicting unused entries from the raster cache and populating it.
+  uint64_t raster_cache_nanos;
+  /// Converting the display lists of the frame to Impeller entities.
+  uint64_t dispatch_nanos;
+  /// Tessellating paths into vertices with Impeller.
+  uint64_t tessellation_nanos;
+  /// Rendering glyphs into the glyph atlas with Impeller.
+  uint64_t glyph_atlas_nanos;
+  /// Encoding render and compute passes into command buffers.
+  uint64_t encode_nanos;
+  /// Submitting command buffers to the GPU.
+  uint64_t submit_nanos;
+  /// The GPU execution time of the most recently completed frame, which is
+  /// usually one or two frames older than this one. Only measured when GPU
+  /// tracing is enabled.
+  uint64_t gpu_nanos;
+} FlutterFrameTiming;
+
+typedef void (*FlutterFrameTimingCallback)(
+    const FlutterFrameTiming* /* frame timing */,
+    void* /* user data */);
+
 typedef struct _FlutterTaskRunner* FlutterTaskRunner;
 
 typedef struct {
@@ -2267,6 +2325,11 @@ typedef struct {
   /// being registered on the framework side. The callback is invoked from
   /// a task posted to the platform thread.
   FlutterChannelUpdateCallback channel_update_callback;
+
+  /// The callback invoked by the engine with the timings of each frame after
+  /// it has been rasterized. The callback is invoked on the raster thread and
+  /// the timing is only valid for the duration of the call.
+  FlutterFrameTimingCallback frame_timing_callback;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_surface_gl.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "flutter/shell/common/shell_io_manager.h"
@@ -13,9 +14,11 @@ namespace flutter {
 EmbedderSurfaceGL::EmbedderSurfaceGL(
     GLDispatchTable gl_dispatch_table,
     bool fbo_reset_after_present,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    size_t max_damage_rects)
     : gl_dispatch_table_(std::move(gl_dispatch_table)),
       fbo_reset_after_present_(fbo_reset_after_present),
+      max_damage_rects_(max_damage_rects),
       external_view_embedder_(std::move(external_view_embedder)) {
   // Make sure all required members of the dispatch table are checked.
   if (!gl_dispatch_table_.gl_make_current_callback ||
@@ -90,6 +93,7 @@ SurfaceFrame::FramebufferInfo EmbedderSurfaceGL::GLContextFramebufferInfo()
   info.supports_readback = true;
   info.supports_partial_repaint =
       gl_dispatch_table_.gl_populate_existing_damage != nullptr;
+  info.max_damage_rects = std::max<size_t>(max_damage_rects_, 1);
   return info;
 }
 
@@ -30,7 +30,8 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   EmbedderSurfaceGL(
       GLDispatchTable gl_dispatch_table,
       bool fbo_reset_after_present,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      size_t max_damage_rects = 1);
 
   ~EmbedderSurfaceGL() override;
 
@@ -38,6 +39,7 @@ class EmbedderSurfaceGL final : public EmbedderSurface,
   bool valid_ = false;
   GLDispatchTable gl_dispatch_table_;
   bool fbo_reset_after_present_;
+  size_t max_damage_rects_;
 
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
 
@@ -24,7 +24,8 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      std::shared_ptr<DlSkTiledRasterizer> tiled_rasterizer = nullptr);
 
   ~EmbedderSurfaceSoftware() override;
 
@@ -33,6 +34,7 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  std::shared_ptr<DlSkTiledRasterizer> tiled_rasterizer_;
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+import 'dart:async';
 import 'dart:io';
+import 'dart:math' as math;
 import 'dart:typed_data';
 import 'dart:ui' as ui;
 
@@ -252,6 +254,53 @@ void main() {
     imageData = (await image.toByteData())!;
     expect(imageData.getUint32(imageData.lengthInBytes - 4), 0x00000000);
   });
+
+  test('StreamingImageDecoder decodes chunked data', () async {
+    final Uint8List data = await _getSkiaResource('baby_tux.png').readAsBytes();
+    final Completer<ui.Image> completer = Completer<ui.Image>();
+    final List<bool> completions = <bool>[];
+    final ui.StreamingImageDecoder decoder = ui.StreamingImageDecoder(
+      onImage: (ui.Image image, bool isComplete) {
+        completions.add(isComplete);
+        if (isComplete) {
+          completer.complete(image);
+        } else {
+          image.dispose();
+        }
+      },
+      onError: (String error) => completer.completeError(Exception(error)),
+    );
+    const int chunkSize = 1024;
+    for (int offset = 0; offset < data.length; offset += chunkSize) {
+      decoder.addChunk(Uint8List.sublistView(
+        data, offset, math.min(offset + chunkSize, data.length),
+      ));
+      await Future<void>.delayed(Duration.zero);
+    }
+    decoder.close();
+    final ui.Image image = await completer.future;
+    expect(() => decoder.addChunk(data), throwsException);
+    decoder.dispose();
+
+    final ui.Codec codec = await ui.instantiateImageCodec(data);
+    final ui.Image expected = (await codec.getNextFrame()).image;
+    expect(image.width, expected.width);
+    expect(image.height, expected.height);
+    expect(completions.where((bool isComplete) => isComplete).length, 1);
+    expect(completions.last, true);
+  });
+
+  test('StreamingImageDecoder reports invalid data', () async {
+    final Completer<String> completer = Completer<String>();
+    final ui.StreamingImageDecoder decoder = ui.StreamingImageDecoder(
+      onImage: (ui.Image image, bool isComplete) => image.dispose(),
+      onError: completer.complete,
+    );
+    decoder.addChunk(Uint8List.fromList(<int>[1, 2, 3]));
+    decoder.close();
+    expect(await completer.future, contains('Could not decode'));
+    decoder.dispose();
+  });
 }
 
 /// Returns a File handle to a file in the skia/resources directory.
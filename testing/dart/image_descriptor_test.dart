@@ -70,6 +70,56 @@ void main() {
     expect(codec.frameCount, 1);
   });
 
+  test('image descriptor - encoded - region codec', () async {
+    final Uint8List bytes = await _getSkiaResource('test640x479.gif').readAsBytes();
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    final Codec codec = await descriptor.instantiateRegionCodec(
+      left: 100,
+      top: 50,
+      width: 200,
+      height: 101,
+    );
+    expect(codec.frameCount, 1);
+    final FrameInfo frame = await codec.getNextFrame();
+    expect(frame.image.width, 200);
+    expect(frame.image.height, 101);
+
+    final Codec sampledCodec = await descriptor.instantiateRegionCodec(
+      left: 100,
+      top: 50,
+      width: 200,
+      height: 101,
+      sampleSize: 2,
+    );
+    final FrameInfo sampledFrame = await sampledCodec.getNextFrame();
+    expect(sampledFrame.image.width, 100);
+    expect(sampledFrame.image.height, 50);
+  });
+
+  test('image descriptor - region codec rejects invalid regions', () async {
+    final Uint8List bytes = await readFile('square.png');
+    final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
+    final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+
+    Object? error;
+    try {
+      await descriptor.instantiateRegionCodec(left: 5, top: 5, width: 10, height: 10);
+    } catch (e) {
+      error = e;
+    }
+    expect(error is Exception, true);
+
+    error = null;
+    try {
+      await descriptor.instantiateRegionCodec(left: 0, top: 0, width: 5, height: 5, sampleSize: 0);
+    } catch (e) {
+      error = e;
+    }
+    expect(error is Exception, true);
+  });
+
   test('HEIC image', () async {
     final Uint8List bytes = await readFile('grill_chicken.heic');
     final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(bytes);
@@ -68,6 +68,26 @@ void main() {
             'frameNumber: 29)');
   });
 
+  test('FrameTiming.rasterPhaseDuration returns the given durations', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      frameNumber: 31,
+      rasterPhaseDurations: const <FrameRasterPhase, Duration>{
+        FrameRasterPhase.preroll: Duration(microseconds: 700),
+        FrameRasterPhase.gpu: Duration(milliseconds: 6),
+      },
+    );
+    expect(timing.rasterPhaseDuration(FrameRasterPhase.preroll), const Duration(microseconds: 700));
+    expect(timing.rasterPhaseDuration(FrameRasterPhase.gpu), const Duration(milliseconds: 6));
+    expect(timing.rasterPhaseDuration(FrameRasterPhase.encode), Duration.zero);
+    expect(timing.frameNumber, 31);
+  });
+
   test('computePlatformResolvedLocale basic', () {
     final List<Locale> supportedLocales = <Locale>[
       const Locale.fromSubtags(languageCode: 'zh', scriptCode: 'Hans', countryCode: 'CN'),